@@ -0,0 +1,158 @@
+/******************************************************************************
+* Throughput of the NEON fixsliced AES (8 blocks per call) and of the Crypto
+* Extension backend (if available) compared with the 32-bit fixsliced C
+* implementations of 'opt32' (2 blocks per call), together with a known-answer
+* test from FIPS-197.
+*
+* Build (from the 'aarch64' directory):
+*	gcc -O3 -o bench_aes bench/bench_aes.c fixslicing/aes_encrypt.c \
+*		fixslicing/aes_keyschedule.c ../opt32/fixslicing/aes_encrypt.c \
+*		../opt32/fixslicing/aes_keyschedule.c ../opt32/profile/profile.c
+* With the Crypto Extension (e.g. -march=armv8-a+crypto), the AESE/AESMC
+* backend is benchmarked as well, in which case 'ce/aes_encrypt.c',
+* 'ce/aes_keyschedule.c', 'ce/aes_gcm.c', '../opt32/gf128/gf128.c' and
+* '../opt32/gf128/gf128_pmull.c' have to be added to the build.
+* The S-box circuit can be selected with -DAES_SBOX=<circuit> (see
+* 'opt32/common/sbox.h'), the lowest depths suiting wide cores.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h>
+#include "../fixslicing/aes.h"
+#include "../../opt32/fixslicing/aes.h"
+#if defined(__ARM_FEATURE_AES) || defined(__ARM_FEATURE_CRYPTO)
+#define BENCH_CE
+#include "../ce/aes.h"
+#endif
+#include "../../opt32/bench/bench.h"
+
+/* FIPS-197, appendix C.1 and C.3 */
+static const unsigned char key[32] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+static const unsigned char ptext[16] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+	0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const unsigned char ctext128[16] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+	0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+static const unsigned char ctext256[16] = {
+	0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+	0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+static int failures;
+
+static void check(const char* name, const unsigned char* out,
+				const unsigned char* expected, int nblocks) {
+	for(int i = 0; i < nblocks; i++) {
+		if (memcmp(out + 16*i, expected, 16)) {
+			printf("  %s: KAT FAILED\n", name);
+			failures++;
+			return;
+		}
+	}
+}
+
+/******************************************************************************
+* Prints the elapsed time, and the cost per byte if 'nblocks' were processed.
+******************************************************************************/
+static void report(const char* name, uint64_t t, int nblocks) {
+	printf("  %-28s %8llu %s", name, (unsigned long long)t, BENCH_UNIT);
+	if (nblocks)
+		printf(" (%.2f %s per byte)", (double)t / (16*nblocks), BENCH_UNIT);
+	printf("\n");
+}
+
+static void bench_neon(void) {
+	unsigned char in[128], out[128];
+	uint32_t rkeys[480];
+	uint64_t t;
+	printf("neon (8 blocks)\n");
+	for(int i = 0; i < 8; i++)
+		memcpy(in + 16*i, ptext, 16);
+	BENCH(t, aes128_keyschedule_ffs_neon(rkeys, key));
+	report("aes128_keyschedule_ffs_neon", t, 0);
+	BENCH(t, aes128_encrypt_ffs_neon(out, in, rkeys));
+	report("aes128_encrypt_ffs_neon", t, 8);
+	check("aes128_encrypt_ffs_neon", out, ctext128, 8);
+	BENCH(t, aes128_keyschedule_sfs_neon(rkeys, key));
+	report("aes128_keyschedule_sfs_neon", t, 0);
+	BENCH(t, aes128_encrypt_sfs_neon(out, in, rkeys));
+	report("aes128_encrypt_sfs_neon", t, 8);
+	check("aes128_encrypt_sfs_neon", out, ctext128, 8);
+	BENCH(t, aes256_keyschedule_ffs_neon(rkeys, key));
+	report("aes256_keyschedule_ffs_neon", t, 0);
+	BENCH(t, aes256_encrypt_ffs_neon(out, in, rkeys));
+	report("aes256_encrypt_ffs_neon", t, 8);
+	check("aes256_encrypt_ffs_neon", out, ctext256, 8);
+	BENCH(t, aes256_keyschedule_sfs_neon(rkeys, key));
+	report("aes256_keyschedule_sfs_neon", t, 0);
+	BENCH(t, aes256_encrypt_sfs_neon(out, in, rkeys));
+	report("aes256_encrypt_sfs_neon", t, 8);
+	check("aes256_encrypt_sfs_neon", out, ctext256, 8);
+}
+
+#ifdef BENCH_CE
+static void bench_ce(void) {
+	static unsigned char in[4096], out[4096];
+	unsigned char ctr[16] = {0}, tag[16], nonce[12] = {0};
+	uint32_t rkeys[60];
+	uint64_t t;
+	printf("ce (%d bytes)\n", (int)sizeof(in));
+	for(size_t i = 0; i < sizeof(in); i += 16)
+		memcpy(in + i, ptext, 16);
+	BENCH(t, aes128_keyschedule_ce(rkeys, key));
+	report("aes128_keyschedule_ce", t, 0);
+	BENCH(t, aes128_ecb_encrypt_ce(out, in, sizeof(in)/16, rkeys));
+	report("aes128_ecb_encrypt_ce", t, sizeof(in)/16);
+	check("aes128_ecb_encrypt_ce", out, ctext128, sizeof(in)/16);
+	BENCH(t, aes128_ctr32_ce(out, in, sizeof(in), ctr, rkeys));
+	report("aes128_ctr32_ce", t, sizeof(in)/16);
+	BENCH(t, aes128_gcm_encrypt_ce(out, tag, in, sizeof(in), NULL, 0, nonce,
+				rkeys));
+	report("aes128_gcm_encrypt_ce", t, sizeof(in)/16);
+	BENCH(t, aes256_keyschedule_ce(rkeys, key));
+	report("aes256_keyschedule_ce", t, 0);
+	BENCH(t, aes256_ecb_encrypt_ce(out, in, sizeof(in)/16, rkeys));
+	report("aes256_ecb_encrypt_ce", t, sizeof(in)/16);
+	check("aes256_ecb_encrypt_ce", out, ctext256, sizeof(in)/16);
+	BENCH(t, aes256_ctr32_ce(out, in, sizeof(in), ctr, rkeys));
+	report("aes256_ctr32_ce", t, sizeof(in)/16);
+	BENCH(t, aes256_gcm_encrypt_ce(out, tag, in, sizeof(in), NULL, 0, nonce,
+				rkeys));
+	report("aes256_gcm_encrypt_ce", t, sizeof(in)/16);
+}
+#endif
+
+static void bench_opt32(void) {
+	unsigned char out[32];
+	uint32_t rkeys[120];
+	uint64_t t;
+	printf("opt32 (2 blocks)\n");
+	aes128_keyschedule_ffs(rkeys, key, key);
+	BENCH(t, aes128_encrypt_ffs(out, out+16, ptext, ptext, rkeys));
+	report("aes128_encrypt_ffs", t, 2);
+	check("aes128_encrypt_ffs", out, ctext128, 2);
+	aes256_keyschedule_ffs(rkeys, key, key);
+	BENCH(t, aes256_encrypt_ffs(out, out+16, ptext, ptext, rkeys));
+	report("aes256_encrypt_ffs", t, 2);
+	check("aes256_encrypt_ffs", out, ctext256, 2);
+}
+
+int main(void) {
+	bench_neon();
+#ifdef BENCH_CE
+	bench_ce();
+#endif
+	bench_opt32();
+	return failures != 0;
+}
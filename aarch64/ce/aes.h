@@ -0,0 +1,49 @@
+#ifndef AES_CE_H_
+#define AES_CE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Encryption functions (2 blocks), same shape as the fixsliced ones */
+void aes128_encrypt_ce(unsigned char ctext0[16], unsigned char ctext1[16],
+				const unsigned char ptext0[16], const unsigned char ptext1[16],
+				const uint32_t rkeys[44]);
+void aes256_encrypt_ce(unsigned char ctext0[16], unsigned char ctext1[16],
+				const unsigned char ptext0[16], const unsigned char ptext1[16],
+				const uint32_t rkeys[60]);
+
+/* ECB encryption of any number of blocks, 8 blocks interleaved */
+void aes128_ecb_encrypt_ce(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t rkeys[44]);
+void aes256_ecb_encrypt_ce(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t rkeys[60]);
+
+/* CTR with a 32-bit big-endian counter (updated), 8 blocks interleaved */
+void aes128_ctr32_ce(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char ctr[16], const uint32_t rkeys[44]);
+void aes256_ctr32_ce(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char ctr[16], const uint32_t rkeys[60]);
+
+/* AES-GCM authenticated encryption with 96-bit nonces and 16-byte tags */
+int aes128_gcm_encrypt_ce(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[44]);
+int aes128_gcm_decrypt_ce(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[44]);
+int aes256_gcm_encrypt_ce(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[60]);
+int aes256_gcm_decrypt_ce(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[60]);
+
+/* Key schedule functions (standard round keys) */
+void aes128_keyschedule_ce(uint32_t rkeys[44], const unsigned char key[16]);
+void aes256_keyschedule_ce(uint32_t rkeys[60], const unsigned char key[32]);
+
+#endif 	// AES_CE_H_
@@ -0,0 +1,151 @@
+/******************************************************************************
+* AES-128 and AES-256 (encryption-only) relying on the AESE/AESMC instructions
+* of the ARMv8 Crypto Extension (build with e.g. -march=armv8-a+crypto).
+*
+* Unlike the bitsliced implementations, the round keys are the ones from the
+* standard key schedule (see 'aes_keyschedule.c') and the blocks are processed
+* independently. The bulk ECB and CTR functions interleave 8 blocks so that
+* the latency of AESE/AESMC is hidden, the remaining blocks being processed
+* one at a time.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+
+/******************************************************************************
+* Encryption of two blocks, as for the fixsliced implementations.
+******************************************************************************/
+static void encrypt_2(unsigned char* ctext0, unsigned char* ctext1,
+				const unsigned char* ptext0, const unsigned char* ptext1,
+				const uint32_t* rkeys, int nr) {
+	uint8x16_t rk[15], b[2];
+	load_rkeys(rk, rkeys, nr);
+	b[0] = vld1q_u8(ptext0);
+	b[1] = vld1q_u8(ptext1);
+	aes_enc(b, 2, rk, nr);
+	vst1q_u8(ctext0, b[0]);
+	vst1q_u8(ctext1, b[1]);
+}
+
+/******************************************************************************
+* ECB encryption of nblocks blocks, 8 at a time.
+******************************************************************************/
+void ecb_ce(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys, int nr) {
+	uint8x16_t rk[15], b[AES_CE_WAYS];
+	load_rkeys(rk, rkeys, nr);
+	for(; nblocks >= AES_CE_WAYS; nblocks -= AES_CE_WAYS) {
+		for(int j = 0; j < AES_CE_WAYS; j++)
+			b[j] = vld1q_u8(ptext + 16*j);
+		aes_enc(b, AES_CE_WAYS, rk, nr);
+		for(int j = 0; j < AES_CE_WAYS; j++)
+			vst1q_u8(ctext + 16*j, b[j]);
+		ptext += 16*AES_CE_WAYS;
+		ctext += 16*AES_CE_WAYS;
+	}
+	for(; nblocks; nblocks--) {
+		b[0] = vld1q_u8(ptext);
+		aes_enc(b, 1, rk, nr);
+		vst1q_u8(ctext, b[0]);
+		ptext += 16;
+		ctext += 16;
+	}
+}
+
+/******************************************************************************
+* CTR encryption of len bytes, where the last 4 bytes of ctr are incremented
+* as a big-endian counter (modulo 2^32) for each block. On return, ctr holds
+* the counter block following the last one used.
+******************************************************************************/
+void ctr32_ce(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys, int nr) {
+	uint8x16_t rk[15], b[AES_CE_WAYS], iv;
+	uint8_t ks[16];
+	uint32_t n = BE_LOAD_32(ctr + 12);
+	load_rkeys(rk, rkeys, nr);
+	iv = vld1q_u8(ctr);
+	for(; len >= 16*AES_CE_WAYS; len -= 16*AES_CE_WAYS) {
+		for(int j = 0; j < AES_CE_WAYS; j++)
+			b[j] = ctr_block(iv, n + j);
+		aes_enc(b, AES_CE_WAYS, rk, nr);
+		for(int j = 0; j < AES_CE_WAYS; j++)
+			vst1q_u8(out + 16*j, veorq_u8(b[j], vld1q_u8(in + 16*j)));
+		n += AES_CE_WAYS;
+		in += 16*AES_CE_WAYS;
+		out += 16*AES_CE_WAYS;
+	}
+	for(; len; n++) {
+		b[0] = ctr_block(iv, n);
+		aes_enc(b, 1, rk, nr);
+		if (len < 16) { 					// last partial block
+			vst1q_u8(ks, b[0]);
+			for(size_t i = 0; i < len; i++)
+				out[i] = in[i] ^ ks[i];
+			len = 0;
+		} else {
+			vst1q_u8(out, veorq_u8(b[0], vld1q_u8(in)));
+			in += 16;
+			out += 16;
+			len -= 16;
+		}
+	}
+	BE_STORE_32(ctr + 12, n);
+}
+
+/******************************************************************************
+* AES-128 encryption of the two blocks ptext0, ptext1 into ctext0, ctext1.
+* Note that ptext0, ptext1 can refer to the same block and that the ctext
+* parameters can be the same as the ptext parameters.
+******************************************************************************/
+void aes128_encrypt_ce(unsigned char* ctext0, unsigned char* ctext1,
+				const unsigned char* ptext0, const unsigned char* ptext1,
+				const uint32_t* rkeys) {
+	encrypt_2(ctext0, ctext1, ptext0, ptext1, rkeys, 10);
+}
+
+/******************************************************************************
+* AES-256 encryption of the two blocks ptext0, ptext1 into ctext0, ctext1.
+* Note that ptext0, ptext1 can refer to the same block and that the ctext
+* parameters can be the same as the ptext parameters.
+******************************************************************************/
+void aes256_encrypt_ce(unsigned char* ctext0, unsigned char* ctext1,
+				const unsigned char* ptext0, const unsigned char* ptext1,
+				const uint32_t* rkeys) {
+	encrypt_2(ctext0, ctext1, ptext0, ptext1, rkeys, 14);
+}
+
+/******************************************************************************
+* AES-128 encryption of nblocks blocks without any operating mode.
+******************************************************************************/
+void aes128_ecb_encrypt_ce(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys) {
+	ecb_ce(ctext, ptext, nblocks, rkeys, 10);
+}
+
+/******************************************************************************
+* AES-256 encryption of nblocks blocks without any operating mode.
+******************************************************************************/
+void aes256_ecb_encrypt_ce(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys) {
+	ecb_ce(ctext, ptext, nblocks, rkeys, 14);
+}
+
+/******************************************************************************
+* AES-128 in CTR mode over len bytes (see 'ctr32_ce').
+******************************************************************************/
+void aes128_ctr32_ce(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys) {
+	ctr32_ce(out, in, len, ctr, rkeys, 10);
+}
+
+/******************************************************************************
+* AES-256 in CTR mode over len bytes (see 'ctr32_ce').
+******************************************************************************/
+void aes256_ctr32_ce(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys) {
+	ctr32_ce(out, in, len, ctr, rkeys, 14);
+}
@@ -0,0 +1,170 @@
+/******************************************************************************
+* AES-GCM (NIST SP 800-38D) with 96-bit nonces and 16-byte tags, on top of the
+* Crypto Extension AES and of GHASH from 'opt32/gf128' (to be linked with the
+* 'gf128_pmull.c' backend on AArch64).
+*
+* The payload is processed in chunks of GCM_CHUNK bytes: each chunk is
+* encrypted 8 blocks at a time and then absorbed by GHASH with the aggregated
+* reduction over 8 blocks, so that it is still in the L1 cache.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy, memset
+#include "aes.h"
+#include "internal-aes.h"
+#include "../../opt32/gf128/gf128.h"
+
+#define GCM_CHUNK 		1024 		// multiple of 128
+
+/******************************************************************************
+* Returns 0 if the lengths are within the limits of SP 800-38D (i.e. 2^39-256
+* bits of payload and 2^64-1 bits of additional data), -1 otherwise.
+******************************************************************************/
+static int gcm_check_lengths(size_t ptext_len, size_t ad_len) {
+	if ((uint64_t)ptext_len > (1ULL << 36) - 32)
+		return -1;
+	if ((uint64_t)ad_len >= (1ULL << 61))
+		return -1;
+	return 0;
+}
+
+/******************************************************************************
+* Compares two byte strings in constant time. Returns 0 if they are equal, -1
+* otherwise.
+******************************************************************************/
+static int ct_memcmp(const unsigned char* a, const unsigned char* b,
+				size_t len) {
+	unsigned char diff = 0;
+	for(size_t i = 0; i < len; i++)
+		diff |= a[i] ^ b[i];
+	return -(int)((diff + 0xff) >> 8);
+}
+
+/******************************************************************************
+* Derives the hash key H = E(0^128) along with the encrypted initial counter
+* block E(J0), and sets ctr to the first counter block of the payload.
+******************************************************************************/
+static void gcm_init(gf128_key* hkey, unsigned char* ej0, unsigned char* ctr,
+				const unsigned char* nonce, const uint32_t* rkeys, int nr) {
+	unsigned char blocks[32] = {0}; 			// 0^128 || J0
+	memcpy(blocks + 16, nonce, 12);
+	BE_STORE_32(blocks + 28, 1);
+	ecb_ce(blocks, blocks, 2, rkeys, nr);
+	ghash_init(hkey, blocks);
+	memcpy(ej0, blocks + 16, 16);
+	memcpy(ctr, nonce, 12);
+	BE_STORE_32(ctr + 12, 2);
+}
+
+/******************************************************************************
+* Final GHASH block (lengths in bits) and tag computation.
+******************************************************************************/
+static void gcm_tag(unsigned char* tag, unsigned char* s, const gf128_key* hkey,
+				size_t ad_len, size_t ptext_len, const unsigned char* ej0) {
+	unsigned char lens[16];
+	uint64_t ad_bits = (uint64_t)ad_len << 3, ptext_bits = (uint64_t)ptext_len << 3;
+	BE_STORE_32(lens, ad_bits >> 32);
+	BE_STORE_32(lens + 4, ad_bits);
+	BE_STORE_32(lens + 8, ptext_bits >> 32);
+	BE_STORE_32(lens + 12, ptext_bits);
+	ghash_update(s, hkey, lens, 16);
+	for(int i = 0; i < 16; i++)
+		tag[i] = s[i] ^ ej0[i];
+}
+
+static int gcm_encrypt(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, const uint32_t* rkeys, int nr) {
+	gf128_key hkey;
+	unsigned char ctr[16], ej0[16], s[16] = {0};
+	size_t blen;
+	if (gcm_check_lengths(ptext_len, ad_len))
+		return -1;
+	gcm_init(&hkey, ej0, ctr, nonce, rkeys, nr);
+	ghash_update(s, &hkey, ad, ad_len);
+	for(size_t i = 0; i < ptext_len; i += blen) {
+		blen = ptext_len - i < GCM_CHUNK ? ptext_len - i : GCM_CHUNK;
+		ctr32_ce(ctext + i, ptext + i, blen, ctr, rkeys, nr);
+		ghash_update(s, &hkey, ctext + i, blen);
+	}
+	gcm_tag(tag, s, &hkey, ad_len, ptext_len, ej0);
+	return 0;
+}
+
+static int gcm_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, const uint32_t* rkeys, int nr) {
+	gf128_key hkey;
+	unsigned char ctr[16], ej0[16], s[16] = {0}, t[16];
+	size_t blen;
+	if (gcm_check_lengths(ctext_len, ad_len))
+		return -1;
+	gcm_init(&hkey, ej0, ctr, nonce, rkeys, nr);
+	ghash_update(s, &hkey, ad, ad_len);
+	for(size_t i = 0; i < ctext_len; i += blen) {
+		blen = ctext_len - i < GCM_CHUNK ? ctext_len - i : GCM_CHUNK;
+		ghash_update(s, &hkey, ctext + i, blen); 	// before in-place decryption
+		ctr32_ce(ptext + i, ctext + i, blen, ctr, rkeys, nr);
+	}
+	gcm_tag(t, s, &hkey, ad_len, ctext_len, ej0);
+	if (ct_memcmp(t, tag, 16)) {
+		memset(ptext, 0x00, ctext_len);
+		return -1;
+	}
+	return 0;
+}
+
+/******************************************************************************
+* AES-128-GCM encryption of 'ptext_len' bytes from 'ptext' into 'ctext' along
+* with the authentication of 'ad_len' bytes of additional data. The 16-byte
+* tag is written in 'tag'.
+* Returns 0 on success, -1 if the input lengths exceed the limits.
+******************************************************************************/
+int aes128_gcm_encrypt_ce(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, const uint32_t* rkeys) {
+	return gcm_encrypt(ctext, tag, ptext, ptext_len, ad, ad_len, nonce,
+				rkeys, 10);
+}
+
+/******************************************************************************
+* AES-128-GCM decryption of 'ctext_len' bytes from 'ctext' into 'ptext' and
+* verification of the 16-byte tag 'tag'.
+* Returns 0 if the tag is valid, -1 otherwise (in which case 'ptext' is
+* zeroized).
+******************************************************************************/
+int aes128_gcm_decrypt_ce(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, const uint32_t* rkeys) {
+	return gcm_decrypt(ptext, ctext, ctext_len, tag, ad, ad_len, nonce,
+				rkeys, 10);
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_gcm_encrypt_ce'.
+******************************************************************************/
+int aes256_gcm_encrypt_ce(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, const uint32_t* rkeys) {
+	return gcm_encrypt(ctext, tag, ptext, ptext_len, ad, ad_len, nonce,
+				rkeys, 14);
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_gcm_decrypt_ce'.
+******************************************************************************/
+int aes256_gcm_decrypt_ce(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, const uint32_t* rkeys) {
+	return gcm_decrypt(ptext, ctext, ctext_len, tag, ad, ad_len, nonce,
+				rkeys, 14);
+}
@@ -0,0 +1,59 @@
+/******************************************************************************
+* AES-128 and AES-256 key schedules relying on the AESE instruction of the
+* ARMv8 Crypto Extension for SubWord. The round keys are stored as in the
+* standard (i.e. 4*(Nr+1) words, the bytes being in the FIPS-197 order).
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy
+#include "aes.h"
+#include "internal-aes.h"
+
+#define ROR(x,y) 		(((x) >> (y)) | ((x) << (32 - (y))))
+
+/******************************************************************************
+* Computes SubWord(w). The word is copied in the 4 columns so that ShiftRows
+* has no effect, and the round key of AESE is zero.
+******************************************************************************/
+static uint32_t subword(uint32_t w) {
+	uint8x16_t x = vreinterpretq_u8_u32(vdupq_n_u32(w));
+	x = vaeseq_u8(x, vdupq_n_u8(0));
+	return vgetq_lane_u32(vreinterpretq_u32_u8(x), 0);
+}
+
+/******************************************************************************
+* Key expansion of FIPS-197, where nk is the number of 32-bit words in the
+* key (4 or 8) and nr the number of rounds.
+******************************************************************************/
+static void keyschedule(uint32_t* rkeys, const unsigned char* key, int nk,
+				int nr) {
+	uint32_t tmp, rconst = 0x01;
+	memcpy(rkeys, key, 4*nk);
+	for(int i = nk; i < 4*(nr+1); i++) {
+		tmp = rkeys[i-1];
+		if (i % nk == 0) { 					// RotWord, SubWord and rconst
+			tmp = subword(ROR(tmp, 8)) ^ rconst;
+			rconst = (rconst << 1) ^ ((rconst >> 7) * 0x11b);
+		} else if (nk == 8 && i % nk == 4) {
+			tmp = subword(tmp);
+		}
+		rkeys[i] = rkeys[i-nk] ^ tmp;
+	}
+}
+
+/******************************************************************************
+* AES-128 key schedule.
+******************************************************************************/
+void aes128_keyschedule_ce(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 4, 10);
+}
+
+/******************************************************************************
+* AES-256 key schedule.
+******************************************************************************/
+void aes256_keyschedule_ce(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 8, 14);
+}
@@ -0,0 +1,68 @@
+#ifndef INTERNAL_AES_H_
+#define INTERNAL_AES_H_
+
+#if !defined(__ARM_FEATURE_AES) && !defined(__ARM_FEATURE_CRYPTO)
+#error "the AES instructions are required (e.g. -march=armv8-a+crypto)"
+#endif
+#if defined(__ARM_BIG_ENDIAN)
+#error "the Crypto Extension implementations only support little-endian AArch64"
+#endif
+
+#include <arm_neon.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Number of blocks interleaved to hide the latency of AESE/AESMC */
+#define AES_CE_WAYS 	8
+
+#define BE_LOAD_32(x) 										\
+    ((((uint32_t)((x)[0])) << 24) | 						\
+     (((uint32_t)((x)[1])) << 16) | 						\
+     (((uint32_t)((x)[2])) << 8) | 							\
+      ((uint32_t)((x)[3])))
+
+#define BE_STORE_32(x, y)									\
+	(x)[0] = ((y) >> 24) & 0xff; 							\
+	(x)[1] = ((y) >> 16) & 0xff; 							\
+	(x)[2] = ((y) >> 8) & 0xff; 							\
+	(x)[3] = (y) & 0xff;
+
+/******************************************************************************
+* Loads the nr+1 round keys into registers.
+******************************************************************************/
+static inline void load_rkeys(uint8x16_t* rk, const uint32_t* rkeys, int nr) {
+	for(int i = 0; i <= nr; i++)
+		rk[i] = vld1q_u8((const uint8_t*)(rkeys + 4*i));
+}
+
+/******************************************************************************
+* Encrypts the n blocks b[0], ..., b[n-1] with nr rounds. AESE (AddRoundKey,
+* ShiftRows, SubBytes) and AESMC (MixColumns) of the same block are kept next
+* to each other so that cores which fuse them can do so, while the n
+* independent blocks hide their latency.
+******************************************************************************/
+static inline void aes_enc(uint8x16_t* b, int n, const uint8x16_t* rk,
+				int nr) {
+	for(int i = 0; i < nr-1; i++)
+		for(int j = 0; j < n; j++)
+			b[j] = vaesmcq_u8(vaeseq_u8(b[j], rk[i]));
+	for(int j = 0; j < n; j++)
+		b[j] = veorq_u8(vaeseq_u8(b[j], rk[nr-1]), rk[nr]);
+}
+
+/******************************************************************************
+* Returns the counter block whose last 32-bit (big-endian) word is ctr.
+******************************************************************************/
+static inline uint8x16_t ctr_block(uint8x16_t iv, uint32_t ctr) {
+	uint32x4_t x = vreinterpretq_u32_u8(iv);
+	x = vsetq_lane_u32(__builtin_bswap32(ctr), x, 3);
+	return vreinterpretq_u8_u32(x);
+}
+
+void ecb_ce(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys, int nr);
+
+void ctr32_ce(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys, int nr);
+
+#endif 	// INTERNAL_AES_H_
@@ -0,0 +1,30 @@
+#ifndef AES_NEON_FIXSLICING_H_
+#define AES_NEON_FIXSLICING_H_
+
+#include <stdint.h>
+
+/* Fully-fixsliced encryption functions (8 blocks) */
+void aes128_encrypt_ffs_neon(unsigned char ctext[128],
+				const unsigned char ptext[128], const uint32_t rkeys[352]);
+void aes256_encrypt_ffs_neon(unsigned char ctext[128],
+				const unsigned char ptext[128], const uint32_t rkeys[480]);
+
+/* Semi-fixsliced encryption functions (8 blocks) */
+void aes128_encrypt_sfs_neon(unsigned char ctext[128],
+				const unsigned char ptext[128], const uint32_t rkeys[352]);
+void aes256_encrypt_sfs_neon(unsigned char ctext[128],
+				const unsigned char ptext[128], const uint32_t rkeys[480]);
+
+/* Fully-fixsliced key schedule functions */
+void aes128_keyschedule_ffs_neon(uint32_t rkeys[352],
+				const unsigned char key[16]);
+void aes256_keyschedule_ffs_neon(uint32_t rkeys[480],
+				const unsigned char key[32]);
+
+/* Semi-fixsliced key schedule functions */
+void aes128_keyschedule_sfs_neon(uint32_t rkeys[352],
+				const unsigned char key[16]);
+void aes256_keyschedule_sfs_neon(uint32_t rkeys[480],
+				const unsigned char key[32]);
+
+#endif 	// AES_NEON_FIXSLICING_H_
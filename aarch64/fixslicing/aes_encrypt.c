@@ -0,0 +1,378 @@
+/******************************************************************************
+* Fixsliced implementations of AES-128 and AES-256 (encryption-only) in C with
+* NEON intrinsics for AArch64.
+*
+* The 32-bit fixsliced state of 'opt32/fixslicing' is held in the 4 lanes of
+* 128-bit vectors so that 8 blocks are processed at a time. Rotations by 8 and
+* 16 bits are computed with 'tbl' and 'rev32' while the rotations within bytes
+* rely on 'shl' and 'sri'.
+*
+* See the paper at https://eprint.iacr.org/2020/1123.pdf for more details.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+#define SBOX_WORD 		uint32x4_t
+#include "../../opt32/common/sbox.h"
+
+/******************************************************************************
+* Packs the internal state in place, where state[2*i] and state[2*i+1] hold
+* the i-th 32-bit word of the first and second block of each lane pair,
+* respectively. Same SWAPMOVE network as 'opt32/fixslicing' on each lane.
+******************************************************************************/
+void packing_neon(uint32x4_t* state) {
+	uint32x4_t tmp;
+	SWAPMOVE(state[1], state[0], 0x55555555, 1);
+	SWAPMOVE(state[3], state[2], 0x55555555, 1);
+	SWAPMOVE(state[5], state[4], 0x55555555, 1);
+	SWAPMOVE(state[7], state[6], 0x55555555, 1);
+	SWAPMOVE(state[2], state[0], 0x33333333, 2);
+	SWAPMOVE(state[3], state[1], 0x33333333, 2);
+	SWAPMOVE(state[6], state[4], 0x33333333, 2);
+	SWAPMOVE(state[7], state[5], 0x33333333, 2);
+	SWAPMOVE(state[4], state[0], 0x0f0f0f0f, 4);
+	SWAPMOVE(state[5], state[1], 0x0f0f0f0f, 4);
+	SWAPMOVE(state[6], state[2], 0x0f0f0f0f, 4);
+	SWAPMOVE(state[7], state[3], 0x0f0f0f0f, 4);
+}
+
+/******************************************************************************
+* Loads 8 128-bit blocks into the internal state: the 'ld4' instructions
+* deinterleave the words so that lane i pairs block i with block i+4.
+******************************************************************************/
+static void load_state(uint32x4_t* state, const unsigned char* in) {
+	uint32x4x4_t b0 = vld4q_u32((const uint32_t*)in);
+	uint32x4x4_t b1 = vld4q_u32((const uint32_t*)(in + 64));
+	for(int i = 0; i < 4; i++) {
+		state[2*i] = b0.val[i];
+		state[2*i+1] = b1.val[i];
+	}
+	packing_neon(state);
+}
+
+/******************************************************************************
+* Unpacks the internal state and stores the 8 128-bit blocks.
+******************************************************************************/
+static void store_state(unsigned char* out, uint32x4_t* state) {
+	uint32x4_t tmp;
+	uint32x4x4_t b0, b1;
+	SWAPMOVE(state[4], state[0], 0x0f0f0f0f, 4);
+	SWAPMOVE(state[5], state[1], 0x0f0f0f0f, 4);
+	SWAPMOVE(state[6], state[2], 0x0f0f0f0f, 4);
+	SWAPMOVE(state[7], state[3], 0x0f0f0f0f, 4);
+	SWAPMOVE(state[2], state[0], 0x33333333, 2);
+	SWAPMOVE(state[3], state[1], 0x33333333, 2);
+	SWAPMOVE(state[6], state[4], 0x33333333, 2);
+	SWAPMOVE(state[7], state[5], 0x33333333, 2);
+	SWAPMOVE(state[1], state[0], 0x55555555, 1);
+	SWAPMOVE(state[3], state[2], 0x55555555, 1);
+	SWAPMOVE(state[5], state[4], 0x55555555, 1);
+	SWAPMOVE(state[7], state[6], 0x55555555, 1);
+	for(int i = 0; i < 4; i++) {
+		b0.val[i] = state[2*i];
+		b1.val[i] = state[2*i+1];
+	}
+	vst4q_u32((uint32_t*)out, b0);
+	vst4q_u32((uint32_t*)(out + 64), b1);
+}
+
+/******************************************************************************
+* XOR the round key to the internal state.
+******************************************************************************/
+static inline void ark(uint32x4_t* state, const uint32_t* rkey) {
+	for(int i = 0; i < 8; i++)
+		state[i] ^= vld1q_u32(rkey + 4*i);
+}
+
+/******************************************************************************
+* Bitsliced implementation of the AES Sbox, the circuit being selected at
+* build time (see 'opt32/common/sbox.h').
+* Note that the 4 NOT (^= 0xffffffff) are moved to the key schedule.
+******************************************************************************/
+void sbox_neon(uint32x4_t* state) {
+	SBOX(state[0], state[1], state[2], state[3],
+		state[4], state[5], state[6], state[7]);
+}
+
+/******************************************************************************
+* Applies the ShiftRows transformation twice (i.e. SR^2) on the internal state.
+******************************************************************************/
+static void double_shiftrows(uint32x4_t* state) {
+	uint32x4_t tmp;
+	for(int i = 0; i < 8; i++)
+		SWAPMOVE(state[i], state[i], 0x0f000f00, 4);
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations, it is used for rounds i s.t. (i%4) == 0.
+* For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 0.
+******************************************************************************/
+static void mixcolumns_0(uint32x4_t* state) {
+	uint32x4_t t0, t1, t2, t3, t4;
+	t3 = ror_8(BYTE_ROR(state[0], 6));
+	t0 = state[0] ^ t3;
+	t1 = ror_8(BYTE_ROR(state[7], 6));
+	t2 = state[7] ^ t1;
+	state[7] = ror_16(BYTE_ROR(t2, 4)) ^ t1 ^ t0;
+	t1 = ror_8(BYTE_ROR(state[6], 6));
+	t4 = t1 ^ state[6];
+	state[6] = t2 ^ t0 ^ t1 ^ ror_16(BYTE_ROR(t4, 4));
+	t1 = ror_8(BYTE_ROR(state[5], 6));
+	t2 = t1 ^ state[5];
+	state[5] = t4 ^ t1 ^ ror_16(BYTE_ROR(t2, 4));
+	t1 = ror_8(BYTE_ROR(state[4], 6));
+	t4 = t1 ^ state[4];
+	state[4] = t2 ^ t0 ^ t1 ^ ror_16(BYTE_ROR(t4, 4));
+	t1 = ror_8(BYTE_ROR(state[3], 6));
+	t2 = t1 ^ state[3];
+	state[3] = t4 ^ t0 ^ t1 ^ ror_16(BYTE_ROR(t2, 4));
+	t1 = ror_8(BYTE_ROR(state[2], 6));
+	t4 = t1 ^ state[2];
+	state[2] = t2 ^ t1 ^ ror_16(BYTE_ROR(t4, 4));
+	t1 = ror_8(BYTE_ROR(state[1], 6));
+	t2 = t1 ^ state[1];
+	state[1] = t4 ^ t1 ^ ror_16(BYTE_ROR(t2, 4));
+	state[0] = t2 ^ t3 ^ ror_16(BYTE_ROR(t0, 4));
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations only, for round i s.t. (i%4) == 1.
+******************************************************************************/
+static void mixcolumns_1(uint32x4_t* state) {
+	uint32x4_t t0, t1, t2;
+	t0 = state[0] ^ ror_8(BYTE_ROR(state[0], 4));
+	t1 = state[7] ^ ror_8(BYTE_ROR(state[7], 4));
+	t2 = state[6];
+	state[6] = t1 ^ t0;
+	state[7] ^= state[6] ^ ror_16(t1);
+	t1 = ror_8(BYTE_ROR(t2, 4));
+	state[6] ^= t1;
+	t1 ^= t2;
+	state[6] ^= ror_16(t1);
+	t2 = state[5];
+	state[5] = t1;
+	t1 = ror_8(BYTE_ROR(t2, 4));
+	state[5] ^= t1;
+	t1 ^= t2;
+	state[5] ^= ror_16(t1);
+	t2 = state[4];
+	state[4] = t1 ^ t0;
+	t1 = ror_8(BYTE_ROR(t2, 4));
+	state[4] ^= t1;
+	t1 ^= t2;
+	state[4] ^= ror_16(t1);
+	t2 = state[3];
+	state[3] = t1 ^ t0;
+	t1 = ror_8(BYTE_ROR(t2, 4));
+	state[3] ^= t1;
+	t1 ^= t2;
+	state[3] ^= ror_16(t1);
+	t2 = state[2];
+	state[2] = t1;
+	t1 = ror_8(BYTE_ROR(t2, 4));
+	state[2] ^= t1;
+	t1 ^= t2;
+	state[2] ^= ror_16(t1);
+	t2 = state[1];
+	state[1] = t1;
+	t1 = ror_8(BYTE_ROR(t2, 4));
+	state[1] ^= t1;
+	t1 ^= t2;
+	state[1] ^= ror_16(t1);
+	t2 = state[0];
+	state[0] = t1;
+	t1 = ror_8(BYTE_ROR(t2, 4));
+	state[0] ^= t1;
+	t1 ^= t2;
+	state[0] ^= ror_16(t1);
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations only, for rounds i s.t. (i%4) == 2.
+******************************************************************************/
+static void mixcolumns_2(uint32x4_t* state) {
+	uint32x4_t t0, t1, t2, t3, t4;
+	t3 = ror_8(BYTE_ROR(state[0], 2));
+	t0 = state[0] ^ t3;
+	t1 = ror_8(BYTE_ROR(state[7], 2));
+	t2 = state[7] ^ t1;
+	state[7] = ror_16(BYTE_ROR(t2, 4)) ^ t1 ^ t0;
+	t1 = ror_8(BYTE_ROR(state[6], 2));
+	t4 = t1 ^ state[6];
+	state[6] = t2 ^ t0 ^ t1 ^ ror_16(BYTE_ROR(t4, 4));
+	t1 = ror_8(BYTE_ROR(state[5], 2));
+	t2 = t1 ^ state[5];
+	state[5] = t4 ^ t1 ^ ror_16(BYTE_ROR(t2, 4));
+	t1 = ror_8(BYTE_ROR(state[4], 2));
+	t4 = t1 ^ state[4];
+	state[4] = t2 ^ t0 ^ t1 ^ ror_16(BYTE_ROR(t4, 4));
+	t1 = ror_8(BYTE_ROR(state[3], 2));
+	t2 = t1 ^ state[3];
+	state[3] = t4 ^ t0 ^ t1 ^ ror_16(BYTE_ROR(t2, 4));
+	t1 = ror_8(BYTE_ROR(state[2], 2));
+	t4 = t1 ^ state[2];
+	state[2] = t2 ^ t1 ^ ror_16(BYTE_ROR(t4, 4));
+	t1 = ror_8(BYTE_ROR(state[1], 2));
+	t2 = t1 ^ state[1];
+	state[1] = t4 ^ t1 ^ ror_16(BYTE_ROR(t2, 4));
+	state[0] = t2 ^ t3 ^ ror_16(BYTE_ROR(t0, 4));
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations, it is used for rounds i s.t. (i%4) == 3.
+* For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 1.
+* Based on Käsper-Schwabe, similar to https://github.com/Ko-/aes-armcortexm.
+******************************************************************************/
+static void mixcolumns_3(uint32x4_t* state) {
+	uint32x4_t t0, t1, t2;
+	t0 = state[7] ^ ror_8(state[7]);
+	t2 = state[0] ^ ror_8(state[0]);
+	state[7] = t2 ^ ror_8(state[7]) ^ ror_16(t0);
+	t1 = state[6] ^ ror_8(state[6]);
+	state[6] = t0 ^ t2 ^ ror_8(state[6]) ^ ror_16(t1);
+	t0 = state[5] ^ ror_8(state[5]);
+	state[5] = t1 ^ ror_8(state[5]) ^ ror_16(t0);
+	t1 = state[4] ^ ror_8(state[4]);
+	state[4] = t0 ^ t2 ^ ror_8(state[4]) ^ ror_16(t1);
+	t0 = state[3] ^ ror_8(state[3]);
+	state[3] = t1 ^ t2 ^ ror_8(state[3]) ^ ror_16(t0);
+	t1 = state[2] ^ ror_8(state[2]);
+	state[2] = t0 ^ ror_8(state[2]) ^ ror_16(t1);
+	t0 = state[1] ^ ror_8(state[1]);
+	state[1] = t1 ^ ror_8(state[1]) ^ ror_16(t0);
+	state[0] = t0 ^ ror_8(state[0]) ^ ror_16(t2);
+}
+
+/******************************************************************************
+* Fully-fixsliced AES-128 encryption (the ShiftRows is completely omitted).
+* The 8 128-bit blocks of ptext are encrypted into ctext without any operating
+* mode. The round keys are assumed to be pre-computed.
+* Note that ctext can be the same as ptext.
+******************************************************************************/
+void aes128_encrypt_ffs_neon(unsigned char* ctext, const unsigned char* ptext,
+					const uint32_t* rkeys_ffs) {
+	uint32x4_t state[8]; 				// 1024-bit internal state
+	load_state(state, ptext); 			// packs into bitsliced representation
+	for(int i = 0; i < 256; i+=128) { 	// loop over quadruple rounds
+		ark(state, rkeys_ffs + i);
+		sbox_neon(state);
+		mixcolumns_0(state);
+		ark(state, rkeys_ffs + i+32);
+		sbox_neon(state);
+		mixcolumns_1(state);
+		ark(state, rkeys_ffs + i+64);
+		sbox_neon(state);
+		mixcolumns_2(state);
+		ark(state, rkeys_ffs + i+96);
+		sbox_neon(state);
+		mixcolumns_3(state);
+	}
+	ark(state, rkeys_ffs + 256);
+	sbox_neon(state);
+	mixcolumns_0(state);
+	ark(state, rkeys_ffs + 288);
+	sbox_neon(state);
+	double_shiftrows(state); 			// resynchronization
+	ark(state, rkeys_ffs + 320);
+	store_state(ctext, state); 			// unpacks the state to the output
+}
+
+/******************************************************************************
+* Fully-fixsliced AES-256 encryption (the ShiftRows is completely omitted).
+* The 8 128-bit blocks of ptext are encrypted into ctext without any operating
+* mode. The round keys are assumed to be pre-computed.
+* Note that ctext can be the same as ptext.
+******************************************************************************/
+void aes256_encrypt_ffs_neon(unsigned char* ctext, const unsigned char* ptext,
+					const uint32_t* rkeys_ffs) {
+	uint32x4_t state[8]; 				// 1024-bit internal state
+	load_state(state, ptext); 			// packs into bitsliced representation
+	for(int i = 0; i < 384; i+=128) { 	// loop over quadruple rounds
+		ark(state, rkeys_ffs + i);
+		sbox_neon(state);
+		mixcolumns_0(state);
+		ark(state, rkeys_ffs + i+32);
+		sbox_neon(state);
+		mixcolumns_1(state);
+		ark(state, rkeys_ffs + i+64);
+		sbox_neon(state);
+		mixcolumns_2(state);
+		ark(state, rkeys_ffs + i+96);
+		sbox_neon(state);
+		mixcolumns_3(state);
+	}
+	ark(state, rkeys_ffs + 384);
+	sbox_neon(state);
+	mixcolumns_0(state);
+	ark(state, rkeys_ffs + 416);
+	sbox_neon(state);
+	double_shiftrows(state); 			// resynchronization
+	ark(state, rkeys_ffs + 448);
+	store_state(ctext, state); 			// unpacks the state to the output
+}
+
+/******************************************************************************
+* Semi-fixsliced AES-128 encryption (the ShiftRows is computed every 2 rounds).
+* The 8 128-bit blocks of ptext are encrypted into ctext without any operating
+* mode. The round keys are assumed to be pre-computed.
+* Note that ctext can be the same as ptext.
+******************************************************************************/
+void aes128_encrypt_sfs_neon(unsigned char* ctext, const unsigned char* ptext,
+					const uint32_t* rkeys_sfs) {
+	uint32x4_t state[8]; 				// 1024-bit internal state
+	load_state(state, ptext); 			// packs into bitsliced representation
+	for(int i = 0; i < 4; i++) { 		// loop over double rounds
+		ark(state, rkeys_sfs + i*64);
+		sbox_neon(state);
+		mixcolumns_0(state);
+		ark(state, rkeys_sfs + i*64+32);
+		sbox_neon(state);
+		double_shiftrows(state);
+		mixcolumns_3(state);
+	}
+	ark(state, rkeys_sfs + 256);
+	sbox_neon(state);
+	mixcolumns_0(state);
+	ark(state, rkeys_sfs + 288);
+	sbox_neon(state);
+	double_shiftrows(state); 			// No MixColumns in the last round
+	ark(state, rkeys_sfs + 320); 		// last AddRoundKey
+	store_state(ctext, state); 			// unpacks the state to the output
+}
+
+/******************************************************************************
+* Semi-fixsliced AES-256 encryption (the ShiftRows is computed every 2 rounds).
+* The 8 128-bit blocks of ptext are encrypted into ctext without any operating
+* mode. The round keys are assumed to be pre-computed.
+* Note that ctext can be the same as ptext.
+******************************************************************************/
+void aes256_encrypt_sfs_neon(unsigned char* ctext, const unsigned char* ptext,
+					const uint32_t* rkeys_sfs) {
+	uint32x4_t state[8]; 				// 1024-bit internal state
+	load_state(state, ptext); 			// packs into bitsliced representation
+	for(int i = 0; i < 6; i++) { 		// loop over double rounds
+		ark(state, rkeys_sfs + i*64);
+		sbox_neon(state);
+		mixcolumns_0(state);
+		ark(state, rkeys_sfs + i*64+32);
+		sbox_neon(state);
+		double_shiftrows(state);
+		mixcolumns_3(state);
+	}
+	ark(state, rkeys_sfs + 384);
+	sbox_neon(state);
+	mixcolumns_0(state);
+	ark(state, rkeys_sfs + 416);
+	sbox_neon(state);
+	double_shiftrows(state); 			// No MixColumns in the last round
+	ark(state, rkeys_sfs + 448); 		// last AddRoundKey
+	store_state(ctext, state); 			// unpacks the state to the output
+}
@@ -0,0 +1,160 @@
+/******************************************************************************
+* C language implementations of the AES-128 and AES-256 key schedules with
+* NEON intrinsics for AArch64, to match the fixsliced representation of
+* 'aes_encrypt.c'. As in 'opt32/fixslicing/aes_keyschedule.c', they are fully
+* bitsliced and do not rely on any Look-Up Table (LUT).
+*
+* The round keys are computed for the same key in all lanes, and each round
+* key word is stored 4 times (i.e. 88 and 120 vectors for AES-128 and AES-256,
+* respectively) so that the encryption loads whole vectors.
+*
+* See the paper at https://eprint.iacr.org/2020/1123.pdf for more details.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+
+/******************************************************************************
+* Applies ShiftRows^(-1) on a round key to match the fixsliced representation.
+******************************************************************************/
+static void inv_shiftrows_1(uint32x4_t* rkey) {
+	uint32x4_t tmp;
+	for(int i = 0; i < 8; i++) {
+		SWAPMOVE(rkey[i], rkey[i], 0x0c0f0300, 4);
+		SWAPMOVE(rkey[i], rkey[i], 0x33003300, 2);
+	}
+}
+
+/******************************************************************************
+* Applies ShiftRows^(-2) on a round key to match the fixsliced representation.
+******************************************************************************/
+static void inv_shiftrows_2(uint32x4_t* rkey) {
+	uint32x4_t tmp;
+	for(int i = 0; i < 8; i++)
+		SWAPMOVE(rkey[i], rkey[i], 0x0f000f00, 4);
+}
+
+/******************************************************************************
+* Applies ShiftRows^(-3) on a round key to match the fixsliced representation.
+******************************************************************************/
+static void inv_shiftrows_3(uint32x4_t* rkey) {
+	uint32x4_t tmp;
+	for(int i = 0; i < 8; i++) {
+		SWAPMOVE(rkey[i], rkey[i], 0x030f0c00, 4);
+		SWAPMOVE(rkey[i], rkey[i], 0x33003300, 2);
+	}
+}
+
+/******************************************************************************
+* XOR the columns after the S-box during the key schedule round function.
+* Note that the NOT omitted in the S-box calculations have to be applied to
+* ensure output correctness.
+* The idx_xor parameter refers to the index of the previous round key that is
+* involved in the XOR computation (should be 8 and 16 for AES-128 and AES-256,
+* respectively).
+* The rotword parameter has to be set if a RotWord is applied (i.e. rotation
+* by 2 instead of 26).
+******************************************************************************/
+static void xor_columns(uint32x4_t* rkeys, int idx_xor, int rotword) {
+	uint32x4_t tmp;
+	rkeys[1] = vmvnq_u32(rkeys[1]); 	// NOT that are omitted in S-box
+	rkeys[2] = vmvnq_u32(rkeys[2]); 	// NOT that are omitted in S-box
+	rkeys[6] = vmvnq_u32(rkeys[6]); 	// NOT that are omitted in S-box
+	rkeys[7] = vmvnq_u32(rkeys[7]); 	// NOT that are omitted in S-box
+	for(int i = 0; i < 8; i++) {
+		tmp = rotword ? ROR(rkeys[i], 2) : ROR(rkeys[i], 26);
+		rkeys[i] = (rkeys[i-idx_xor] ^ tmp) & vdupq_n_u32(0xc0c0c0c0);
+		tmp = rkeys[i-idx_xor] ^ vshrq_n_u32(rkeys[i], 2);
+		rkeys[i] |= tmp & vdupq_n_u32(0x30303030);
+		tmp = rkeys[i-idx_xor] ^ vshrq_n_u32(rkeys[i], 2);
+		rkeys[i] |= tmp & vdupq_n_u32(0x0c0c0c0c);
+		tmp = rkeys[i-idx_xor] ^ vshrq_n_u32(rkeys[i], 2);
+		rkeys[i] |= tmp & vdupq_n_u32(0x03030303);
+	}
+}
+
+/******************************************************************************
+* Fully bitsliced key schedule shared by all variants, where 'nk' is the number
+* of 128-bit words in the key (1 or 2) and 'nr' the number of rounds.
+* The round key i is derived from the round key i-1 (and i-2 for AES-256) in
+* the classical representation. ShiftRows^(-i) (fully-fixsliced) or
+* ShiftRows^(-1) for odd rounds only (semi-fixsliced) is applied afterwards,
+* except for the last round key since the last round resynchronizes the state.
+******************************************************************************/
+static void keyschedule(uint32_t* rkeys, const unsigned char* key,
+						int nk, int nr, int ffs) {
+	uint32x4_t rk[120];
+	uint8_t rconst = 0x01;
+	for(int i = 0; i < nk; i++) { 			// packs the key words
+		for(int j = 0; j < 4; j++) {
+			rk[8*i + 2*j] = vld1q_dup_u32((const uint32_t*)(key + 16*i + 4*j));
+			rk[8*i + 2*j+1] = rk[8*i + 2*j];
+		}
+		packing_neon(rk + 8*i);
+	}
+	for(int i = nk; i <= nr; i++) {
+		for(int j = 0; j < 8; j++)
+			rk[8*i + j] = rk[8*i + j-8];
+		sbox_neon(rk + 8*i);
+		if (nk == 1 || !(i & 1)) {
+			for(int j = 0; j < 8; j++) 		// rconst bit j goes to word 7-j
+				if ((rconst >> j) & 1)
+					rk[8*i + 7-j] ^= vdupq_n_u32(0x00000300);
+			rconst = (rconst << 1) ^ ((rconst >> 7) * 0x1b);
+			xor_columns(rk + 8*i, 8*nk, 1);	// Rotword and XOR between the columns
+		} else {
+			xor_columns(rk + 8*i, 16, 0); 	// XOR between the columns
+		}
+	}
+	for(int i = 1; i < nr; i++) { 			// to match fixslicing
+		switch (ffs ? i % 4 : i % 2) {
+			case 1: inv_shiftrows_1(rk + 8*i); break;
+			case 2: inv_shiftrows_2(rk + 8*i); break;
+			case 3: inv_shiftrows_3(rk + 8*i); break;
+		}
+	}
+	for(int i = 1; i <= nr; i++) {
+		rk[i*8 + 1] = vmvnq_u32(rk[i*8 + 1]); 	// NOT to speed up SBox calculations
+		rk[i*8 + 2] = vmvnq_u32(rk[i*8 + 2]); 	// NOT to speed up SBox calculations
+		rk[i*8 + 6] = vmvnq_u32(rk[i*8 + 6]); 	// NOT to speed up SBox calculations
+		rk[i*8 + 7] = vmvnq_u32(rk[i*8 + 7]); 	// NOT to speed up SBox calculations
+	}
+	for(int i = 0; i < 8*(nr+1); i++)
+		vst1q_u32(rkeys + 4*i, rk[i]);
+}
+
+/******************************************************************************
+* Fully bitsliced AES-128 key schedule to match the fully-fixsliced (ffs)
+* representation.
+******************************************************************************/
+void aes128_keyschedule_ffs_neon(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 1, 10, 1);
+}
+
+/******************************************************************************
+* Fully bitsliced AES-256 key schedule to match the fully-fixsliced (ffs)
+* representation.
+******************************************************************************/
+void aes256_keyschedule_ffs_neon(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 2, 14, 1);
+}
+
+/******************************************************************************
+* Fully bitsliced AES-128 key schedule to match the semi-fixsliced (sfs)
+* representation.
+******************************************************************************/
+void aes128_keyschedule_sfs_neon(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 1, 10, 0);
+}
+
+/******************************************************************************
+* Fully bitsliced AES-256 key schedule to match the semi-fixsliced (sfs)
+* representation.
+******************************************************************************/
+void aes256_keyschedule_sfs_neon(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 2, 14, 0);
+}
@@ -0,0 +1,51 @@
+#ifndef INTERNAL_AES_H_
+#define INTERNAL_AES_H_
+
+#include <arm_neon.h>
+#include <stdint.h>
+
+#if defined(__ARM_BIG_ENDIAN)
+#error "the NEON implementations only support little-endian AArch64"
+#endif
+
+/******************************************************************************
+* The internal state consists of 8 128-bit vectors, each 32-bit lane holding
+* the fixsliced state word of a pair of blocks (see 'opt32/fixslicing'). The
+* round keys are stored accordingly, i.e. each round key word is repeated in
+* the 4 lanes so that it can be loaded with a single 'ld1'.
+******************************************************************************/
+#define U8(x) 			vreinterpretq_u8_u32(x)
+#define U32(x) 			vreinterpretq_u32_u8(x)
+
+#define ROR(x,y) 		vsriq_n_u32(vshlq_n_u32((x), 32 - (y)), (x), (y))
+
+#define BYTE_ROR(x,y) 										\
+	U32(vsriq_n_u8(vshlq_n_u8(U8(x), 8 - (y)), U8(x), (y)))
+
+#define SWAPMOVE(a, b, mask, n)	({							\
+	tmp = (b ^ vshrq_n_u32(a, n)) & vdupq_n_u32(mask);		\
+	b ^= tmp;												\
+	a ^= vshlq_n_u32(tmp, n);								\
+})
+
+/******************************************************************************
+* Rotations by 8 and 16 bits are byte permutations, computed with 'tbl' and
+* 'rev32' on 16-bit elements, respectively.
+******************************************************************************/
+static const uint8_t ror_8_idx[16] = {
+	1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12
+};
+
+static inline uint32x4_t ror_8(uint32x4_t x) {
+	return U32(vqtbl1q_u8(U8(x), vld1q_u8(ror_8_idx)));
+}
+
+static inline uint32x4_t ror_16(uint32x4_t x) {
+	return vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(x)));
+}
+
+void packing_neon(uint32x4_t* state);
+
+void sbox_neon(uint32x4_t* state);
+
+#endif 	// INTERNAL_AES_H_
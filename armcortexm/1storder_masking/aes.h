@@ -17,4 +17,9 @@ extern void aes128_keyschedule_ffs(uint32_t rkeys[121], const unsigned char key0
 extern void aes128_keyschedule_sfs(uint32_t rkeys[121], const unsigned char key0[16],
 					const unsigned char key1[16]);
 
+extern void aes128_encrypt_bsr(unsigned char ctext[128], const unsigned char ptext[128],
+				const uint32_t rkeys[385]);
+
+extern void aes128_keyschedule_bsr(uint32_t rkeys[385], const unsigned char key[16]);
+
 #endif 	// AES_H_
\ No newline at end of file
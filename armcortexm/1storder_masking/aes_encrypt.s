@@ -1,5 +1,6 @@
 /******************************************************************************
-* ARM assembly 1st-order masked fixsliced implementation of the AES-128.
+* ARM assembly 1st-order masked fixsliced and barrel-shiftrows implementations
+* of the AES-128.
 *
 * The masking scheme is the one described in "Masking AES with 2 random bits"
 * available at https://eprint.iacr.org/2018/1007.
@@ -10,6 +11,13 @@
 * bits. Note that because each round key is assumed to be masked using the same
 * masking scheme with different random bits, the mask is updated at every
 * AddRoundKey operation.
+* In the barrel-shiftrows representation, each bit of a byte belongs to a
+* different block so that m0, m1 are picked for each of the 8 blocks, which
+* amounts to the same 2 random bits per block as the fixsliced versions.
+*
+* If AES_UNROLL is defined at build time (e.g. --defsym AES_UNROLL=1), the
+* subroutines are expanded in place instead of being called, which saves the
+* branches and the link register spills at the cost of a larger code size.
 *
 * @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
 *           alexandre.adomnicai@ntu.edu.sg
@@ -31,6 +39,28 @@
     eor     \out0, \in0, \tmp, lsl \n
 .endm
 
+/******************************************************************************
+* The subroutines below are defined as macros (suffixed by '_body'), from which
+* 'subroutine' generates the code called by 'invoke'. If AES_UNROLL is defined,
+* 'invoke' expands them in place instead.
+******************************************************************************/
+.macro subroutine name
+.ifndef AES_UNROLL
+.align 2
+\name:
+    \name\()_body
+    bx      lr
+.endif
+.endm
+
+.macro invoke name
+.ifdef AES_UNROLL
+    \name\()_body
+.else
+    bl      \name
+.endif
+.endm
+
 /******************************************************************************
 * Packs two 128-bit input blocs stored in r4-r7 and r8-r11, respectively, into
 * the 256-bit internal state where the bits are packed as follows:
@@ -43,8 +73,7 @@
 * r10 = b_30 b_62 b_94 b_126 || ... || b_6 b_38 b_70 b_102
 * r11 = b_31 b_63 b_95 b_127 || ... || b_7 b_39 b_71 b_103
 ******************************************************************************/
-.align 2
-packing:
+.macro packing_body
     movw    r3, #0x0f0f
     movt    r3, #0x0f0f             // r3 <- 0x0f0f0f0f (mask for SWAPMOVE)
     eor     r2, r3, r3, lsl #2      // r2 <- 0x33333333 (mask for SWAPMOVE)
@@ -61,13 +90,13 @@ packing:
     swpmv   r10, r6, r7, r0, r3, #4, r12
     swpmv   r11, r7, r11, r9, r3, #4, r12
     swpmv   r9, r5, r2, r5, r3, #4, r12
-    bx      lr
+.endm
+subroutine packing
 
 /******************************************************************************
 * Unpacks the 256-bit internal state in two 128-bit blocs.
 ******************************************************************************/
-.align 2
-unpacking:
+.macro unpacking_body
     movw    r3, #0x0f0f
     movt    r3, #0x0f0f                 // r3 <- 0x0f0f0f0f (mask for SWAPMOVE)
     swpmv   r2, r5, r9, r5, r3, #4, r12
@@ -84,7 +113,8 @@ unpacking:
     swpmv   r9, r5,r9, r5, r1, #1, r12
     swpmv   r10, r6, r10, r6, r1, #1, r12
     swpmv   r11, r7, r11, r7, r1, #1, r12
-    bx      lr
+.endm
+subroutine unpacking
 
 /******************************************************************************
 * Subroutine that computes the AddRoundKey.
@@ -92,9 +122,10 @@ unpacking:
 * with different shares by following the same masking scheme that the one used
 * in the encrption function.
 ******************************************************************************/
-.align 2
-add_round_key:
+.macro add_round_key_body
+.ifndef AES_UNROLL
     str     r14, [sp]                   // save link register
+.endif
     ldr.w   r3, [sp, #116]              // load 'rkey' argument from the stack
     ldr     r12, [sp, #128]             // load m0 in r12
     ldrd    r1, r14, [r3], #8           // load km0, km1
@@ -122,8 +153,11 @@ add_round_key:
     str.w   r3, [sp, #116]
     eor     r10, r10, r1
     eor     r11, r11, r14
+.ifndef AES_UNROLL
     ldr.w   r14, [sp]                   // restore link register
-    bx      lr
+.endif
+.endm
+subroutine add_round_key
 
 /******************************************************************************
 * 1st-order masked implementation of the S-box in a bitsliced manner.
@@ -131,9 +165,10 @@ add_round_key:
 * The bitsliced key state should be contained in r4-r11 while the masks
 * m2=m0^m1, m1, m0 are supposed to be stored in sp[120,124,128].
 ******************************************************************************/
-.align 2
-sbox:
+.macro sbox_body
+.ifndef AES_UNROLL
     str     r14, [sp, #132]             // save link register
+.endif
     mov.w   r14, r2
     orr   r0, r12, r14                  //Exec (m0 | m1) = m0 | m1 into r0
     eor   r2,  r7,  r9                  //Exec y14 = i4 ^ i2 into r2
@@ -552,17 +587,20 @@ sbox:
     ldr.w r2, [sp, #124]                //Load m1 into r2
     ldr   r9, [sp, #128]                //Load m0 into r9
     ldr  r10, [sp, #120]                //Load m2 into r10
+.ifndef AES_UNROLL
     ldr     r14, [sp, #132]             // restore link register
+.endif
     eor     r12,  r8,  r9               //Exec o5 = S2 ^ m0 into r12
     eor     r8,  r5,  r2                //Exec o3 = S4 ^ m1 into r8
     eor     r5,  r6,  r2                //Exec o6 = S1 ^ m1 into r5
     eor     r4,  r4, r10                //Exec o4 = S3 ^ m2 into r4
     eor     r0,  r0,  r9                //Exec o2 = S5 ^ m0 into r0
     eor     r6,  r7, r10                //Exec o0 = S7 ^ m2 into r6
-    bx      lr 
     //[('r0', 'S5'), ('r1', 'S0'), ('r2', 'm1'), ('r3', 'S6'), ('r4', 'S3'),('r5', 'S1'),
     //('r6', 'S7'), ('r7', -), ('r8', 'S4'), ('r9', 'm0'), ('r10', 'm0^m1'), ('r11', -),
     //('r12', 'S2'), ('r14', -)]
+.endm
+subroutine sbox
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
@@ -571,9 +609,10 @@ sbox:
 * Note that 1st-order masking forces to do some remasking to ensure that masks
 * are not cancelled through XOR operations.
 ******************************************************************************/
-.align 2
-mixcolumns_0:
+.macro mixcolumns_0_body
+.ifndef AES_UNROLL
     str     r14, [sp, #132]
+.endif
     eor     r14, r1, r9                 // r14<- S0 ^ m1 ^ m0           remask S0
     movw    r9, #0x0303
     movt    r9, #0x0303                 // r9<- 0x03030303 (mask for BYTE_ROR_6)
@@ -689,12 +728,15 @@ mixcolumns_0:
     bic     r14, r4, r3                 // r14<- S0 ^m1 & 0xfcfcfcfc
     and     r4, r4, r3                  // r4 <- S0 ^m1 & 0x03030303
     orr     r4, r4, r14, ror #8         // r4 <- r4^r14 >>> 8
+.ifndef AES_UNROLL
     ldr.w   r14, [sp, #132]             // restore link register
+.endif
     eor     r4, r1, r4, ror #18         // r4 <- S1^ BYTE_ROR_6(S1) ^ BYTE_ROR_2(S0) ^ m0 ^ m1
     eor     r4, r4, r12, ror #8         // r4 <- S'0 ^ m1
-    bx      lr
     //(r0, m0^m1), (r1, S0), (r2, m1), (r3, S6), (r4, S0),(r5, S1), (r6, S2),
     //(r7, S3), (r8, S4), (r9, S5), (r10, S6), (r11, S7), (r12, -), (r14, -)]
+.endm
+subroutine mixcolumns_0
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
@@ -702,9 +744,10 @@ mixcolumns_0:
 * Note that 1st-order masking forces to do some remasking to ensure that masks
 * are not cancelled through XOR operations.
 ******************************************************************************/
-.align 2
-mixcolumns_1:
+.macro mixcolumns_1_body
+.ifndef AES_UNROLL
     str     r14, [sp, #132]
+.endif
     eor     r14, r1, r9                 // r14<- S0 ^ m1 ^ m0           remask S0
     movw    r9, #0x0f0f
     movt    r9, #0x0f0f                 // r9<- 0x0f0f0f0f (mask for BYTE_ROR_4)
@@ -773,11 +816,14 @@ mixcolumns_1:
     eor     r4, r12, r14, ror #16       // r4 <- S1^BYTE_ROR_4(S1)>>>8 ^ (S0^BYTE_ROR_4(S0) >>> 8)>>>16 ^ m1
     eor     r4, r4, r1, ror #8          // r4 <- ^ m0
     eor     r4, r4, r0                  // r4 <- S'0 ^ m1                   remask
+.ifndef AES_UNROLL
     ldr     r14, [sp, #132]              // restore link register
+.endif
     ldr.w   r2, [sp, #124]              // load m1 in r2
-    bx      lr
     //(r0, m0^m1), (r1, S0), (r2, m1), (r3, S6), (r4, S0),(r5, S1), (r6, S2),
     //(r7, S3), (r8, S4), (r9, S5), (r10, S6), (r11, S7), (r12, -), (r14, -)]
+.endm
+subroutine mixcolumns_1
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
@@ -785,9 +831,10 @@ mixcolumns_1:
 * Note that 1st-order masking forces to do some remasking to ensure that masks
 * are not cancelled through XOR operations.
 ******************************************************************************/
-.align 2
-mixcolumns_2:
+.macro mixcolumns_2_body
+.ifndef AES_UNROLL
     str     r14, [sp, #132]
+.endif
     eor     r14, r1, r9                 // r14<- S0 ^ m1 ^ m0           remask S0
     movw    r9, #0x3f3f
     movt    r9, #0x3f3f                 // r9 <- 0x03030303 (mask for BYTE_ROR_2)
@@ -903,12 +950,15 @@ mixcolumns_2:
     bic     r14, r4, r3                 // r14<- S0 ^m1 & 0xfcfcfcfc
     and     r4, r4, r3                  // r4 <- S0 ^m1 & 0x3f3f3f3f
     orr     r4, r4, r14, ror #8         // r4 <- r4^r14 >>> 8
+.ifndef AES_UNROLL
     ldr     r14, [sp, #132]
+.endif
     eor     r4, r1, r4, ror #22         // r4 <- S1^ BYTE_ROR_2(S1) ^ BYTE_ROR_6(S0) ^ m0 ^ m1
     eor     r4, r4, r12, ror #8         // r4 <- S'0 ^ m1
-    bx      lr
     //(r0, m0^m1), (r1, S0), (r2, m1), (r3, S6), (r4, S0),(r5, S1), (r6, S2),
     //(r7, S3), (r8, S4), (r9, S5), (r10, S6), (r11, S7), (r12, -), (r14, -)]
+.endm
+subroutine mixcolumns_2
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
@@ -918,9 +968,10 @@ mixcolumns_2:
 * Note that 1st-order masking forces to do some remasking to ensure that masks
 * are not cancelled through XOR operations.
 ******************************************************************************/
-.align 2
-mixcolumns_3:
+.macro mixcolumns_3_body
+.ifndef AES_UNROLL
     str     r14, [sp, #132]
+.endif
     eor     r14, r1, r9                 // r14<- S0 ^ m1 ^ m0           remask S0
     eor     r14, r1, r14, ror #8        // r14<- (S0 ^ S0 >>> 8) ^ m0
     eor     r7, r6, r10                 // r7 <- S7 ^ m1 ^ (m0 ^ m1)    remask S7
@@ -961,17 +1012,21 @@ mixcolumns_3:
     eor     r4, r4, r2                  // r4 <- (S1 ^ S1 >>> 8) ^ m0   remask r4
     eor     r4, r4, r1, ror #8          // r4 <- S1 ^ S1 >>> 8 ^ S0 >>> 8 ^ m0 ^ m1
     eor     r4, r4, r14, ror #16        // r4 <- S'0 ^ m1
+.ifndef AES_UNROLL
     ldr     r14, [sp, #132]
-    bx      lr
+.endif
     //(r0, m0^m1), (r1, S0), (r2, m1), (r3, S6), (r4, S0),(r5, S1), (r6, S2),
     //(r7, S3), (r8, S4), (r9, S5), (r10, S6), (r11, S7), (r12, -), (r14, -)]
+.endm
+subroutine mixcolumns_3
 
 /******************************************************************************
 * Applies the ShiftRows transformation twice (i.e. SR^2) on the internal state.
 ******************************************************************************/
-.align 2
-double_shiftrows:
+.macro double_shiftrows_body
+.ifndef AES_UNROLL
     str     r14, [sp, #132]
+.endif
     movw    r14, #0x0f00
     movt    r14, #0x0f00            // r14<- 0x0f000f00
     swpmv   r6,r6,r6,r6, r14, #4, r11
@@ -982,9 +1037,12 @@ double_shiftrows:
     swpmv   r12,r12,r12,r12, r14, #4, r11
     swpmv   r5,r5,r5,r5, r14, #4, r11
     swpmv   r1,r1,r1,r1, r14, #4, r11
+.ifndef AES_UNROLL
     ldr     r14, [sp, #132]
+.endif
     ldr.w   r2, [sp, #124]          // loads m1 in r2
-    bx      lr
+.endm
+subroutine double_shiftrows
 
 /******************************************************************************
 * Fully fixsliced implementation of AES-128 with 1st-order masking.
@@ -1013,7 +1071,7 @@ aes128_encrypt_ffs:
     ldr     r9, [r3, #4]
     ldr     r10,[r3, #8]
     ldr     r11,[r3, #12]
-    bl      packing
+    invoke  packing
     // ------------------ MASKING ------------------
     // generation of 1 random word
     movw    r0, 0x0804
@@ -1049,36 +1107,36 @@ aes128_ffs_get_random_mask:
     str.w   r3, [sp, #116]          // to match add_round_key routine
     str     r12, [sp, #128]
     strd    r0, r2, [sp, #120]
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_0
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_1
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_2
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_3
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_0
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_1
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_2
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_3
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_0
-    bl      add_round_key
-    bl      sbox
-    bl      double_shiftrows
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_0
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_1
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_2
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_3
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_0
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_1
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_2
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_3
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_0
+    invoke  add_round_key
+    invoke  sbox
+    invoke  double_shiftrows
     mov     r11, r6                 // to match add_round_key routine
     mov     r10, r3                 // to match add_round_key routine
     mov     r9, r0                  // to match add_round_key routine
@@ -1086,7 +1144,7 @@ aes128_ffs_get_random_mask:
     mov.w   r6, r12                 // to match add_round_key routine
     mov.w   r4, r1                  // to match add_round_key routine
     ldr.w   r0, [sp, #120]          // loads m0^m1 in r0
-    bl      add_round_key
+    invoke  add_round_key
     // ------------------ CORE FUNCTION ------------------
     // ------------------ UNMASKING ------------------
     eor     r4, r4, r2              // r4 <- state[0] ^ m1
@@ -1098,7 +1156,7 @@ aes128_ffs_get_random_mask:
     eor     r10, r10, r0            // r10<- state[6] ^ m0 ^ m1
     eor     r11, r11, r2            // r11<- state[7] ^ m1
     // ------------------ UNMASKING ------------------
-    bl      unpacking
+    invoke  unpacking
     ldrd    r0, r1, [sp, #136]
     add.w   sp, #144
     stm     r0, {r4-r7}
@@ -1133,7 +1191,7 @@ aes128_encrypt_sfs:
     ldr     r9, [r3, #4]
     ldr     r10,[r3, #8]
     ldr     r11,[r3, #12]
-    bl      packing
+    invoke  packing
     // ------------------ MASKING ------------------
     // generation of 1 random word
     movw    r0, 0x0804
@@ -1169,40 +1227,40 @@ aes128_sfs_get_random_mask:
     str.w   r3, [sp, #116]          // to be compliant with add_round_key routine
     str     r12, [sp, #128]
     strd    r0, r2, [sp, #120]
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_0
-    bl      add_round_key
-    bl      sbox
-    bl      double_shiftrows
-    bl      mixcolumns_3
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_0
-    bl      add_round_key
-    bl      sbox
-    bl      double_shiftrows
-    bl      mixcolumns_3
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_0
-    bl      add_round_key
-    bl      sbox
-    bl      double_shiftrows
-    bl      mixcolumns_3
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_0
-    bl      add_round_key
-    bl      sbox
-    bl      double_shiftrows
-    bl      mixcolumns_3
-    bl      add_round_key
-    bl      sbox
-    bl      mixcolumns_0
-    bl      add_round_key
-    bl      sbox
-    bl      double_shiftrows
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_0
+    invoke  add_round_key
+    invoke  sbox
+    invoke  double_shiftrows
+    invoke  mixcolumns_3
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_0
+    invoke  add_round_key
+    invoke  sbox
+    invoke  double_shiftrows
+    invoke  mixcolumns_3
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_0
+    invoke  add_round_key
+    invoke  sbox
+    invoke  double_shiftrows
+    invoke  mixcolumns_3
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_0
+    invoke  add_round_key
+    invoke  sbox
+    invoke  double_shiftrows
+    invoke  mixcolumns_3
+    invoke  add_round_key
+    invoke  sbox
+    invoke  mixcolumns_0
+    invoke  add_round_key
+    invoke  sbox
+    invoke  double_shiftrows
     mov     r11, r6                 // to match add_round_key routine
     mov     r10, r3                 // to match add_round_key routine
     mov     r9, r0                  // to match add_round_key routine
@@ -1210,7 +1268,7 @@ aes128_sfs_get_random_mask:
     mov.w   r6, r12                 // to match add_round_key routine
     mov.w   r4, r1                  // to match add_round_key routine
     ldr.w   r0, [sp, #120]          // loads m0^m1 in r0
-    bl      add_round_key
+    invoke  add_round_key
     // ------------------ CORE FUNCTION ------------------
     // ------------------ UNMASKING ------------------
     eor     r4, r4, r2              // r4 <- state[0] ^ m1
@@ -1222,10 +1280,615 @@ aes128_sfs_get_random_mask:
     eor     r10, r10, r0            // r10<- state[6] ^ m0 ^ m1
     eor     r11, r11, r2            // r11<- state[7] ^ m1
     // ------------------ UNMASKING ------------------
-    bl      unpacking
+    invoke  unpacking
     ldrd    r0, r1, [sp, #136]
     add.w   sp, #144
     stm     r0, {r4-r7}
     stm     r1, {r8-r11}
     pop     {r2-r12, r14}
     bx      lr
+
+/******************************************************************************
+* Packing routines for the barrel-shiftrows representation (see 'aes_encrypt.s'
+* in 'armcortexm/barrel_shiftrows') where r2 points to the 8 input blocks.
+* The internal state is stored in sp[136..263] such that the word i+8*j holds
+* the bit i of each byte of the j-th row of the 8 blocks.
+******************************************************************************/
+.align 2
+packing_bsr_0:
+    movw    r0, #0x00ff
+    movt    r0, #0x00ff                 // mask for SWAPMOVE
+    add.w   r1, sp, #136                // r1 points to the internal state
+    mov     r3, #0                      // loop counter
+loop_bsr_p0:
+    ldmia   r2!, {r4-r7}                // load input
+    add.w   r3, r3, 1                   // increment loop counter
+    swpmv   r4, r5, r4, r5, r0, 8, r12
+    swpmv   r6, r7, r6, r7, r0, 8, r12
+    str.w   r4, [r1], #4                // store state words on the stack
+    str.w   r5, [r1, #28]               // store state words on the stack
+    str.w   r6, [r1, #60]               // store state words on the stack
+    str.w   r7, [r1, #92]               // store state words on the stack
+    cmp     r3, #7
+    ble     loop_bsr_p0                 // loop until r3 <= 7
+    bx      lr
+
+.align 2
+packing_bsr_1:
+    movw    r0, #0xffff                 // mask for SWAPMOVE
+    add.w   r1, sp, #136                // r1 points to the internal state
+    mov     r3, #0                      // loop counter
+loop_bsr_p1:
+    ldrd    r4, r5, [r1]                // load state from the stack
+    ldrd    r6, r7, [r1, #64]           // load state from the stack
+    add.w   r3, r3, 1                   // increment loop counter
+    swpmv   r4, r6, r4, r6, r0, 16, r12
+    swpmv   r5, r7, r5, r7, r0, 16, r12
+    strd    r6, r7, [r1, #64]           // store state words on the stack
+    strd    r4, r5, [r1], #8            // store state words on the stack
+    cmp     r3, #7
+    ble     loop_bsr_p1                 // loop until r3 <= 7
+    bx      lr
+
+/******************************************************************************
+* 3rd packing layer, which also masks the internal state with the masks stored
+* in sp[120,124,128] according to the masking scheme.
+******************************************************************************/
+.align 2
+packing_bsr_2:
+    movw    r2, #0x0f0f
+    movt    r2, #0x0f0f                 // mask for SWAPMOVE
+    eor     r1, r2, r2, lsl #2          // mask for SWAPMOVE (0x33333333)
+    eor     r0, r1, r1, lsl #1          // mask for SWAPMOVE (0x55555555)
+    add.w   r3, sp, #136                // r3 points to the internal state
+loop_bsr_p2:
+    ldm     r3, {r4-r11}
+    swpmv   r5, r4, r5, r4, r0, 1, r12
+    swpmv   r7, r6, r7, r6, r0, 1, r12
+    swpmv   r9, r8, r9, r8, r0, 1, r12
+    swpmv   r11, r10, r11, r10, r0, 1, r12
+    swpmv   r6, r4, r6, r4, r1, 2, r12
+    swpmv   r7, r5, r7, r5, r1, 2, r12
+    swpmv   r10, r8, r10, r8, r1, 2, r12
+    swpmv   r11, r9, r11, r9, r1, 2, r12
+    swpmv   r8, r4, r8, r4, r2, 4, r12
+    swpmv   r9, r5, r9, r5, r2, 4, r12
+    swpmv   r10, r6, r10, r6, r2, 4, r12
+    swpmv   r11, r7, r11, r7, r2, 4, r12
+    ldr.w   r12, [sp, #124]             // load m1
+    eor     r4, r4, r12                 // r4 <- state[0] ^ m1
+    eor     r6, r6, r12                 // r6 <- state[2] ^ m1
+    eor     r11, r11, r12               // r11<- state[7] ^ m1
+    ldr.w   r12, [sp, #128]             // load m0
+    eor     r5, r5, r12                 // r5 <- state[1] ^ m0
+    eor     r7, r7, r12                 // r7 <- state[3] ^ m0
+    eor     r8, r8, r12                 // r8 <- state[4] ^ m0
+    ldr.w   r12, [sp, #120]             // load m0 ^ m1
+    eor     r9, r9, r12                 // r9 <- state[5] ^ m0 ^ m1
+    eor     r10, r10, r12               // r10<- state[6] ^ m0 ^ m1
+    stmia   r3!, {r4-r11}               // store the state words on the stack
+    add.w   r12, sp, #264               // r12 points to the end of the state
+    cmp     r3, r12
+    bne     loop_bsr_p2                 // loop until the whole state is packed
+    bx      lr
+
+/******************************************************************************
+* Unmasks the internal state and undoes the 3rd packing layer.
+******************************************************************************/
+.align 2
+unpacking_bsr_2:
+    movw    r2, #0x0f0f
+    movt    r2, #0x0f0f                 // mask for SWAPMOVE
+    eor     r1, r2, r2, lsl #2          // mask for SWAPMOVE (0x33333333)
+    eor     r0, r1, r1, lsl #1          // mask for SWAPMOVE (0x55555555)
+    add.w   r3, sp, #136                // r3 points to the internal state
+loop_bsr_up2:
+    ldm     r3, {r4-r11}
+    ldr.w   r12, [sp, #124]             // load m1
+    eor     r4, r4, r12                 // r4 <- state[0] ^ m1
+    eor     r6, r6, r12                 // r6 <- state[2] ^ m1
+    eor     r11, r11, r12               // r11<- state[7] ^ m1
+    ldr.w   r12, [sp, #128]             // load m0
+    eor     r5, r5, r12                 // r5 <- state[1] ^ m0
+    eor     r7, r7, r12                 // r7 <- state[3] ^ m0
+    eor     r8, r8, r12                 // r8 <- state[4] ^ m0
+    ldr.w   r12, [sp, #120]             // load m0 ^ m1
+    eor     r9, r9, r12                 // r9 <- state[5] ^ m0 ^ m1
+    eor     r10, r10, r12               // r10<- state[6] ^ m0 ^ m1
+    swpmv   r8, r4, r8, r4, r2, 4, r12
+    swpmv   r9, r5, r9, r5, r2, 4, r12
+    swpmv   r10, r6, r10, r6, r2, 4, r12
+    swpmv   r11, r7, r11, r7, r2, 4, r12
+    swpmv   r6, r4, r6, r4, r1, 2, r12
+    swpmv   r7, r5, r7, r5, r1, 2, r12
+    swpmv   r10, r8, r10, r8, r1, 2, r12
+    swpmv   r11, r9, r11, r9, r1, 2, r12
+    swpmv   r5, r4, r5, r4, r0, 1, r12
+    swpmv   r7, r6, r7, r6, r0, 1, r12
+    swpmv   r9, r8, r9, r8, r0, 1, r12
+    swpmv   r11, r10, r11, r10, r0, 1, r12
+    stmia   r3!, {r4-r11}               // store the state words on the stack
+    add.w   r12, sp, #264               // r12 points to the end of the state
+    cmp     r3, r12
+    bne     loop_bsr_up2                // loop until the whole state is unpacked
+    bx      lr
+
+/******************************************************************************
+* Undoes the 1st packing layer where r2 points to the 8 output blocks.
+******************************************************************************/
+.align 2
+unpacking_bsr_0:
+    movw    r0, #0x00ff
+    movt    r0, #0x00ff                 // mask for SWAPMOVE
+    add.w   r1, sp, #136                // r1 points to the internal state
+    mov     r3, #0                      // loop counter
+loop_bsr_up0:
+    ldr.w   r4, [r1], #4
+    ldr.w   r5, [r1, #28]
+    ldr.w   r6, [r1, #60]
+    ldr.w   r7, [r1, #92]
+    add.w   r3, r3, 1                   // increment loop counter
+    swpmv   r4, r5, r4, r5, r0, 8, r12
+    swpmv   r6, r7, r6, r7, r0, 8, r12
+    stmia   r2!, {r4-r7}                // store to output array
+    cmp     r3, #7
+    ble     loop_bsr_up0                // loop until r3 <= 7
+    bx      lr
+
+/******************************************************************************
+* Updates the masks stored in sp[120,124,128] with the ones of the round key.
+* Each barrel-shiftrows round key starts with its masks km0, km1, km0^km1.
+******************************************************************************/
+.macro update_masks_bsr
+    ldr.w   r3, [sp, #116]              // load 'rkey' argument from the stack
+    ldrd    r0, r1, [sp, #120]          // load m0^m1, m1
+    ldr     r2, [sp, #128]              // load m0
+    ldmia   r3!, {r4-r6}                // load km0, km1, km0^km1
+    eor     r2, r2, r4                  // m0 ^ km0
+    eor     r1, r1, r5                  // m1 ^ km1
+    eor     r0, r0, r6                  // m0 ^ m1 ^ km0 ^ km1
+    str.w   r3, [sp, #116]
+    strd    r0, r1, [sp, #120]          // store new m0^m1, m1
+    str     r2, [sp, #128]              // store new m0
+.endm
+
+/******************************************************************************
+* Subroutine that computes the AddRoundKey on the quarter of the internal state
+* pointed by r12, and loads the masks m0, m1 in r12, r2 to match the S-box.
+******************************************************************************/
+.macro add_round_key_bsr_body
+    ldr.w   r3, [sp, #116]              // load 'rkey' argument from the stack
+    ldm     r12, {r4-r11}               // load a quarter of the state
+    ldmia   r3!, {r0-r2,r12}            // load 4 round key words
+    eor     r4, r4, r0
+    eor     r5, r5, r1
+    eor     r6, r6, r2
+    eor     r7, r7, r12
+    ldmia   r3!, {r0-r2,r12}            // load 4 round key words
+    eor     r8, r8, r0
+    eor     r9, r9, r1
+    eor     r10, r10, r2
+    eor     r11, r11, r12
+    str.w   r3, [sp, #116]
+    ldr     r12, [sp, #128]             // load m0 in r12
+    ldr     r2, [sp, #124]              // load m1 in r2
+.endm
+subroutine add_round_key_bsr
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the barrel-shiftrows
+* representation, where the S-box outputs are read from sp[264..391] and the
+* result is written in sp[136..263].
+* The ShiftRows is computed on the fly by rotating the words of the j-th row by
+* 8*j bits through the barrel shifter.
+* Because all bytes of a slice are masked with the same mask, the XORs are
+* ordered so that no intermediate result is unmasked (i.e. two operands masked
+* with different masks are added first), and m0 is added twice for the slices 5
+* and 7 where all the operands share the same mask.
+******************************************************************************/
+.macro mixcolumns_bsr_body
+.ifndef AES_UNROLL
+    str     r14, [sp, #132]             // save link register
+.endif
+    ldr.w   r0, [sp, #264]              // load S0
+    ldr.w   r1, [sp, #296]              // load S8
+    ldr.w   r2, [sp, #328]              // load S16
+    ldr.w   r3, [sp, #360]              // load S24
+    ldr.w   r4, [sp, #268]              // load S1
+    ldr.w   r5, [sp, #300]              // load S9
+    ldr.w   r6, [sp, #332]              // load S17
+    ldr.w   r7, [sp, #364]              // load S25
+    eor     r12, r4, r1, ror #8         // r12 <- S1 ^ S8
+    eor     r12, r12, r2, ror #16       // ^ S16
+    eor     r12, r12, r3, ror #24       // ^ S24
+    eor     r12, r12, r5, ror #8        // ^ S9
+    str.w   r12, [sp, #136]             // store S'0
+    eor     r12, r0, r5, ror #8         // r12 <- S0 ^ S9
+    eor     r12, r12, r2, ror #16       // ^ S16
+    eor     r12, r12, r3, ror #24       // ^ S24
+    eor     r12, r12, r6, ror #16       // ^ S17
+    str.w   r12, [sp, #168]             // store S'8
+    eor     r12, r0, r6, ror #16        // r12 <- S0 ^ S17
+    eor     r12, r12, r3, ror #24       // ^ S24
+    eor     r12, r12, r1, ror #8        // ^ S8
+    eor     r12, r12, r7, ror #24       // ^ S25
+    str.w   r12, [sp, #200]             // store S'16
+    eor     r12, r0, r7, ror #24        // r12 <- S0 ^ S25
+    eor     r12, r12, r1, ror #8        // ^ S8
+    eor     r12, r12, r2, ror #16       // ^ S16
+    eor     r12, r12, r4                // ^ S1
+    str.w   r12, [sp, #232]             // store S'24
+    ldr.w   r8, [sp, #272]              // load S2
+    ldr.w   r9, [sp, #304]              // load S10
+    ldr.w   r10, [sp, #336]             // load S18
+    ldr.w   r11, [sp, #368]             // load S26
+    eor     r12, r8, r5, ror #8         // r12 <- S2 ^ S9
+    eor     r12, r12, r6, ror #16       // ^ S17
+    eor     r12, r12, r7, ror #24       // ^ S25
+    eor     r12, r12, r9, ror #8        // ^ S10
+    str.w   r12, [sp, #140]             // store S'1
+    eor     r12, r4, r9, ror #8         // r12 <- S1 ^ S10
+    eor     r12, r12, r6, ror #16       // ^ S17
+    eor     r12, r12, r7, ror #24       // ^ S25
+    eor     r12, r12, r10, ror #16      // ^ S18
+    str.w   r12, [sp, #172]             // store S'9
+    eor     r12, r4, r10, ror #16       // r12 <- S1 ^ S18
+    eor     r12, r12, r7, ror #24       // ^ S25
+    eor     r12, r12, r5, ror #8        // ^ S9
+    eor     r12, r12, r11, ror #24      // ^ S26
+    str.w   r12, [sp, #204]             // store S'17
+    eor     r12, r4, r11, ror #24       // r12 <- S1 ^ S26
+    eor     r12, r12, r5, ror #8        // ^ S9
+    eor     r12, r12, r6, ror #16       // ^ S17
+    eor     r12, r12, r8                // ^ S2
+    str.w   r12, [sp, #236]             // store S'25
+    ldr.w   r4, [sp, #276]              // load S3
+    ldr.w   r5, [sp, #308]              // load S11
+    ldr.w   r6, [sp, #340]              // load S19
+    ldr.w   r7, [sp, #372]              // load S27
+    eor     r12, r4, r9, ror #8         // r12 <- S3 ^ S10
+    eor     r12, r12, r10, ror #16      // ^ S18
+    eor     r12, r12, r11, ror #24      // ^ S26
+    eor     r12, r12, r5, ror #8        // ^ S11
+    str.w   r12, [sp, #144]             // store S'2
+    eor     r12, r8, r5, ror #8         // r12 <- S2 ^ S11
+    eor     r12, r12, r10, ror #16      // ^ S18
+    eor     r12, r12, r11, ror #24      // ^ S26
+    eor     r12, r12, r6, ror #16       // ^ S19
+    str.w   r12, [sp, #176]             // store S'10
+    eor     r12, r8, r6, ror #16        // r12 <- S2 ^ S19
+    eor     r12, r12, r11, ror #24      // ^ S26
+    eor     r12, r12, r9, ror #8        // ^ S10
+    eor     r12, r12, r7, ror #24       // ^ S27
+    str.w   r12, [sp, #208]             // store S'18
+    eor     r12, r8, r7, ror #24        // r12 <- S2 ^ S27
+    eor     r12, r12, r9, ror #8        // ^ S10
+    eor     r12, r12, r10, ror #16      // ^ S18
+    eor     r12, r12, r4                // ^ S3
+    str.w   r12, [sp, #240]             // store S'26
+    ldr.w   r8, [sp, #280]              // load S4
+    ldr.w   r9, [sp, #312]              // load S12
+    ldr.w   r10, [sp, #344]             // load S20
+    ldr.w   r11, [sp, #376]             // load S28
+    eor     r12, r8, r0                 // r12 <- S4 ^ S0
+    eor     r12, r12, r5, ror #8        // ^ S11
+    eor     r12, r12, r6, ror #16       // ^ S19
+    eor     r12, r12, r7, ror #24       // ^ S27
+    eor     r12, r12, r9, ror #8        // ^ S12
+    eor     r12, r12, r1, ror #8        // ^ S8
+    str.w   r12, [sp, #148]             // store S'3
+    eor     r12, r4, r1, ror #8         // r12 <- S3 ^ S8
+    eor     r12, r12, r6, ror #16       // ^ S19
+    eor     r12, r12, r7, ror #24       // ^ S27
+    eor     r12, r12, r9, ror #8        // ^ S12
+    eor     r12, r12, r10, ror #16      // ^ S20
+    eor     r12, r12, r2, ror #16       // ^ S16
+    str.w   r12, [sp, #180]             // store S'11
+    eor     r12, r4, r2, ror #16        // r12 <- S3 ^ S16
+    eor     r12, r12, r7, ror #24       // ^ S27
+    eor     r12, r12, r5, ror #8        // ^ S11
+    eor     r12, r12, r10, ror #16      // ^ S20
+    eor     r12, r12, r11, ror #24      // ^ S28
+    eor     r12, r12, r3, ror #24       // ^ S24
+    str.w   r12, [sp, #212]             // store S'19
+    eor     r12, r4, r3, ror #24        // r12 <- S3 ^ S24
+    eor     r12, r12, r5, ror #8        // ^ S11
+    eor     r12, r12, r6, ror #16       // ^ S19
+    eor     r12, r12, r11, ror #24      // ^ S28
+    eor     r12, r12, r8                // ^ S4
+    eor     r12, r12, r0                // ^ S0
+    str.w   r12, [sp, #244]             // store S'27
+    ldr.w   r4, [sp, #284]              // load S5
+    ldr.w   r5, [sp, #316]              // load S13
+    ldr.w   r6, [sp, #348]              // load S21
+    ldr.w   r7, [sp, #380]              // load S29
+    eor     r12, r4, r9, ror #8         // r12 <- S5 ^ S12
+    eor     r12, r12, r10, ror #16      // ^ S20
+    eor     r12, r12, r11, ror #24      // ^ S28
+    eor     r12, r12, r5, ror #8        // ^ S13
+    eor     r12, r12, r0                // ^ S0
+    eor     r12, r12, r1, ror #8        // ^ S8
+    str.w   r12, [sp, #152]             // store S'4
+    eor     r12, r8, r5, ror #8         // r12 <- S4 ^ S13
+    eor     r12, r12, r10, ror #16      // ^ S20
+    eor     r12, r12, r11, ror #24      // ^ S28
+    eor     r12, r12, r6, ror #16       // ^ S21
+    eor     r12, r12, r1, ror #8        // ^ S8
+    eor     r12, r12, r2, ror #16       // ^ S16
+    str.w   r12, [sp, #184]             // store S'12
+    eor     r12, r8, r6, ror #16        // r12 <- S4 ^ S21
+    eor     r12, r12, r11, ror #24      // ^ S28
+    eor     r12, r12, r9, ror #8        // ^ S12
+    eor     r12, r12, r7, ror #24       // ^ S29
+    eor     r12, r12, r2, ror #16       // ^ S16
+    eor     r12, r12, r3, ror #24       // ^ S24
+    str.w   r12, [sp, #216]             // store S'20
+    eor     r12, r8, r7, ror #24        // r12 <- S4 ^ S29
+    eor     r12, r12, r9, ror #8        // ^ S12
+    eor     r12, r12, r10, ror #16      // ^ S20
+    eor     r12, r12, r4                // ^ S5
+    eor     r12, r12, r3, ror #24       // ^ S24
+    eor     r12, r12, r0                // ^ S0
+    str.w   r12, [sp, #248]             // store S'28
+    ldr.w   r8, [sp, #288]              // load S6
+    ldr.w   r9, [sp, #320]              // load S14
+    ldr.w   r10, [sp, #352]             // load S22
+    ldr.w   r11, [sp, #384]             // load S30
+    ldr.w   r14, [sp, #128]             // load m0 (remask)
+    eor     r12, r8, r14                // S6 ^ m0
+    eor     r12, r12, r5, ror #8        // ^ S13
+    eor     r12, r12, r6, ror #16       // ^ S21
+    eor     r12, r12, r7, ror #24       // ^ S29
+    eor     r12, r12, r9, ror #8        // ^ S14
+    eor     r12, r12, r14               // ^ m0
+    str.w   r12, [sp, #156]             // store S'5
+    eor     r12, r4, r14                // S5 ^ m0
+    eor     r12, r12, r6, ror #16       // ^ S21
+    eor     r12, r12, r7, ror #24       // ^ S29
+    eor     r12, r12, r9, ror #8        // ^ S14
+    eor     r12, r12, r10, ror #16      // ^ S22
+    eor     r12, r12, r14               // ^ m0
+    str.w   r12, [sp, #188]             // store S'13
+    eor     r12, r4, r14                // S5 ^ m0
+    eor     r12, r12, r7, ror #24       // ^ S29
+    eor     r12, r12, r5, ror #8        // ^ S13
+    eor     r12, r12, r10, ror #16      // ^ S22
+    eor     r12, r12, r11, ror #24      // ^ S30
+    eor     r12, r12, r14               // ^ m0
+    str.w   r12, [sp, #220]             // store S'21
+    eor     r12, r4, r14                // S5 ^ m0
+    eor     r12, r12, r5, ror #8        // ^ S13
+    eor     r12, r12, r6, ror #16       // ^ S21
+    eor     r12, r12, r11, ror #24      // ^ S30
+    eor     r12, r12, r8                // ^ S6
+    eor     r12, r12, r14               // ^ m0
+    str.w   r12, [sp, #252]             // store S'29
+    ldr.w   r4, [sp, #292]              // load S7
+    ldr.w   r5, [sp, #324]              // load S15
+    ldr.w   r6, [sp, #356]              // load S23
+    ldr.w   r7, [sp, #388]              // load S31
+    eor     r12, r4, r9, ror #8         // r12 <- S7 ^ S14
+    eor     r12, r12, r10, ror #16      // ^ S22
+    eor     r12, r12, r11, ror #24      // ^ S30
+    eor     r12, r12, r5, ror #8        // ^ S15
+    eor     r12, r12, r0                // ^ S0
+    eor     r12, r12, r1, ror #8        // ^ S8
+    str.w   r12, [sp, #160]             // store S'6
+    eor     r12, r8, r5, ror #8         // r12 <- S6 ^ S15
+    eor     r12, r12, r10, ror #16      // ^ S22
+    eor     r12, r12, r11, ror #24      // ^ S30
+    eor     r12, r12, r6, ror #16       // ^ S23
+    eor     r12, r12, r1, ror #8        // ^ S8
+    eor     r12, r12, r2, ror #16       // ^ S16
+    str.w   r12, [sp, #192]             // store S'14
+    eor     r12, r8, r6, ror #16        // r12 <- S6 ^ S23
+    eor     r12, r12, r11, ror #24      // ^ S30
+    eor     r12, r12, r9, ror #8        // ^ S14
+    eor     r12, r12, r7, ror #24       // ^ S31
+    eor     r12, r12, r2, ror #16       // ^ S16
+    eor     r12, r12, r3, ror #24       // ^ S24
+    str.w   r12, [sp, #224]             // store S'22
+    eor     r12, r8, r7, ror #24        // r12 <- S6 ^ S31
+    eor     r12, r12, r9, ror #8        // ^ S14
+    eor     r12, r12, r10, ror #16      // ^ S22
+    eor     r12, r12, r4                // ^ S7
+    eor     r12, r12, r3, ror #24       // ^ S24
+    eor     r12, r12, r0                // ^ S0
+    str.w   r12, [sp, #256]             // store S'30
+    eor     r12, r0, r14                // S0 ^ m0
+    eor     r12, r12, r5, ror #8        // ^ S15
+    eor     r12, r12, r6, ror #16       // ^ S23
+    eor     r12, r12, r7, ror #24       // ^ S31
+    eor     r12, r12, r1, ror #8        // ^ S8
+    eor     r12, r12, r14               // ^ m0
+    str.w   r12, [sp, #164]             // store S'7
+    eor     r12, r4, r14                // S7 ^ m0
+    eor     r12, r12, r6, ror #16       // ^ S23
+    eor     r12, r12, r7, ror #24       // ^ S31
+    eor     r12, r12, r1, ror #8        // ^ S8
+    eor     r12, r12, r2, ror #16       // ^ S16
+    eor     r12, r12, r14               // ^ m0
+    str.w   r12, [sp, #196]             // store S'15
+    eor     r12, r4, r14                // S7 ^ m0
+    eor     r12, r12, r7, ror #24       // ^ S31
+    eor     r12, r12, r5, ror #8        // ^ S15
+    eor     r12, r12, r2, ror #16       // ^ S16
+    eor     r12, r12, r3, ror #24       // ^ S24
+    eor     r12, r12, r14               // ^ m0
+    str.w   r12, [sp, #228]             // store S'23
+    eor     r12, r4, r14                // S7 ^ m0
+    eor     r12, r12, r5, ror #8        // ^ S15
+    eor     r12, r12, r6, ror #16       // ^ S23
+    eor     r12, r12, r3, ror #24       // ^ S24
+    eor     r12, r12, r0                // ^ S0
+    eor     r12, r12, r14               // ^ m0
+    str.w   r12, [sp, #260]             // store S'31
+.ifndef AES_UNROLL
+    ldr.w   r14, [sp, #132]             // restore link register
+.endif
+.endm
+subroutine mixcolumns_bsr
+
+/******************************************************************************
+* AddRoundKey and S-box on the j-th quarter of the internal state, whose output
+* is stored in sp[264+32*j..295+32*j].
+******************************************************************************/
+.macro sbox_quarter_bsr j
+    add.w   r12, sp, #(136+32*\j)       // r12 points to the quarter of the state
+    invoke  add_round_key_bsr
+    invoke  sbox
+    strd    r1, r5, [sp, #(264+32*\j)]  // store the S-box output
+    strd    r12, r4, [sp, #(272+32*\j)]
+    strd    r8, r0, [sp, #(280+32*\j)]
+    strd    r3, r6, [sp, #(288+32*\j)]
+.endm
+
+/******************************************************************************
+* Computes a full AES round in the barrel-shiftrows representation.
+******************************************************************************/
+.macro aes_round_bsr
+    update_masks_bsr
+    sbox_quarter_bsr 0
+    sbox_quarter_bsr 1
+    sbox_quarter_bsr 2
+    sbox_quarter_bsr 3
+    invoke  mixcolumns_bsr
+.endm
+
+/******************************************************************************
+* Barrel-shiftrows implementation of AES-128 with 1st-order masking.
+*
+* Eight blocks are encrypted in parallel. Since the 8 bits of each byte of the
+* internal state belong to the 8 blocks, the masks m0, m1 are picked for each
+* block by replicating 2 random bytes over the words. Only 16 random bits are
+* required per call, i.e. 2 random bits per block.
+*
+* The round keys are expected to be computed by 'aes128_keyschedule_bsr'.
+*
+* The masking step is specific to the STM32F407VG due to some specific values
+* values and addresses related to the randomn number generator (RNG).
+******************************************************************************/
+@ void aes128_encrypt_bsr(u8* ctext, const u8* ptext, const u32* rkey);
+.global aes128_encrypt_bsr
+.type   aes128_encrypt_bsr,%function
+.align 2
+aes128_encrypt_bsr:
+    push    {r0-r12,r14}
+    sub.w   sp, #400
+    str.w   r2, [sp, #116]              // to match add_round_key_bsr routine
+    // ------------------ MASKING ------------------
+    // generation of 1 random word
+    movw    r0, 0x0804
+    movt    r0, 0x5006                  // r0 <- RNG_SR = 0x50060804
+    add.w   r1, r0, #4                  // r1 <- RNG_DR = 0x50060808
+aes128_bsr_get_random_mask:
+    ldr.w   r2, [r0]
+    cmp     r2, #1                      // check if RNG_SR == RNG_SR_DRDY
+    bne     aes128_bsr_get_random_mask  // loop while RNG status is not ready
+    ldr.w   r2, [r1]                    // load the random number in r2
+    uxtb    r12, r2                     // r12<- ab (1 bit per block)
+    orr     r12, r12, r12, lsl #8       // r12<- abab
+    orr     r12, r12, r12, lsl #16      // r12<- abababab
+    ubfx    r3, r2, #8, #8              // r3 <- cd (1 bit per block)
+    orr     r3, r3, r3, lsl #8          // r3 <- cdcd
+    orr     r3, r3, r3, lsl #16         // r3 <- cdcdcdcd
+    eor     r0, r12, r3                 // r0 <- m0 ^ m1
+    str.w   r12, [sp, #128]
+    strd    r0, r3, [sp, #120]
+    ldr.w   r2, [sp, #404]              // load 'ptext' argument from the stack
+    bl      packing_bsr_0               // 1st packing layer
+    bl      packing_bsr_1               // 2nd packing layer
+    bl      packing_bsr_2               // 3rd packing layer and masking
+    // ------------------ MASKING ------------------
+    // ------------------ CORE FUNCTION ------------------
+.ifdef AES_UNROLL
+    .rept 9
+    aes_round_bsr
+    .endr
+.else
+    mov     r1, #0                      // init loop counter
+    str.w   r1, [sp, #392]              // store loop counter on the stack
+loop_aes128_bsr_core:
+    aes_round_bsr
+    ldr.w   r1, [sp, #392]              // load loop counter
+    add.w   r1, r1, #1                  // increment loop counter
+    str.w   r1, [sp, #392]              // store loop counter on the stack
+    cmp     r1, #8
+    ble     loop_aes128_bsr_core        // loop until r1 <= 8
+.endif
+    // Last round
+    update_masks_bsr
+    sbox_quarter_bsr 0
+    sbox_quarter_bsr 1
+    sbox_quarter_bsr 2
+    sbox_quarter_bsr 3
+    update_masks_bsr                    // r3 points to the last round key
+    // last AddRoundKey with ShiftRows computed on the fly
+    ldmia   r3!, {r4-r11}               // load the round key words
+    ldrd    r0, r1, [sp, #264]          // load the S-box outputs
+    eor     r4, r4, r0
+    eor     r5, r5, r1
+    ldrd    r0, r1, [sp, #272]
+    eor     r6, r6, r0
+    eor     r7, r7, r1
+    ldrd    r0, r1, [sp, #280]
+    eor     r8, r8, r0
+    eor     r9, r9, r1
+    ldrd    r0, r1, [sp, #288]
+    eor     r10, r10, r0
+    eor     r11, r11, r1
+    add.w   r12, sp, #136               // store the quarter of the state
+    stm     r12, {r4-r11}
+    ldmia   r3!, {r4-r11}               // load the round key words
+    ldrd    r0, r1, [sp, #296]          // load the S-box outputs
+    eor     r4, r4, r0, ror #8
+    eor     r5, r5, r1, ror #8
+    ldrd    r0, r1, [sp, #304]
+    eor     r6, r6, r0, ror #8
+    eor     r7, r7, r1, ror #8
+    ldrd    r0, r1, [sp, #312]
+    eor     r8, r8, r0, ror #8
+    eor     r9, r9, r1, ror #8
+    ldrd    r0, r1, [sp, #320]
+    eor     r10, r10, r0, ror #8
+    eor     r11, r11, r1, ror #8
+    add.w   r12, sp, #168               // store the quarter of the state
+    stm     r12, {r4-r11}
+    ldmia   r3!, {r4-r11}               // load the round key words
+    ldrd    r0, r1, [sp, #328]          // load the S-box outputs
+    eor     r4, r4, r0, ror #16
+    eor     r5, r5, r1, ror #16
+    ldrd    r0, r1, [sp, #336]
+    eor     r6, r6, r0, ror #16
+    eor     r7, r7, r1, ror #16
+    ldrd    r0, r1, [sp, #344]
+    eor     r8, r8, r0, ror #16
+    eor     r9, r9, r1, ror #16
+    ldrd    r0, r1, [sp, #352]
+    eor     r10, r10, r0, ror #16
+    eor     r11, r11, r1, ror #16
+    add.w   r12, sp, #200               // store the quarter of the state
+    stm     r12, {r4-r11}
+    ldmia   r3!, {r4-r11}               // load the round key words
+    ldrd    r0, r1, [sp, #360]          // load the S-box outputs
+    eor     r4, r4, r0, ror #24
+    eor     r5, r5, r1, ror #24
+    ldrd    r0, r1, [sp, #368]
+    eor     r6, r6, r0, ror #24
+    eor     r7, r7, r1, ror #24
+    ldrd    r0, r1, [sp, #376]
+    eor     r8, r8, r0, ror #24
+    eor     r9, r9, r1, ror #24
+    ldrd    r0, r1, [sp, #384]
+    eor     r10, r10, r0, ror #24
+    eor     r11, r11, r1, ror #24
+    add.w   r12, sp, #232               // store the quarter of the state
+    stm     r12, {r4-r11}
+    // ------------------ CORE FUNCTION ------------------
+    bl      unpacking_bsr_2             // unmasking and 3rd unpacking layer
+    bl      packing_bsr_1               // 2nd unpacking layer (same as packing)
+    ldr.w   r2, [sp, #400]              // load 'ctext' argument from the stack
+    bl      unpacking_bsr_0             // 1st unpacking layer
+    add.w   sp, #400
+    pop     {r0-r12, r14}
+    bx      lr
@@ -10,6 +10,8 @@
 * Note that because the function prototype allows to pass 2 different keys as
 * input parameters, 4 random bits are used instead of 2 to ensure that
 * different round keys are masked with different masks.
+* The barrel-shiftrows key schedule picks m0, m1 for each of the 8 blocks, i.e.
+* 16 random bits per round key.
 *
 * @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
 *           alexandre.adomnicai@ntu.edu.sg
@@ -1725,3 +1727,761 @@ sfs_get_random_mask:
     add.w   sp, #144                // restore stack
     pop     {r0-r12, r14}           // restore context
     bx      lr
+
+/******************************************************************************
+* SWAPMOVE calls used in the 'packing_rkey' subroutine (see the barrel-shiftrows
+* key schedule in 'armcortexm/barrel_shiftrows/aes_keyschedule_lut.s').
+******************************************************************************/
+.align 2
+swapmove_rkey:
+    str     r14, [sp, #-4]          // store link register on the stack
+    eor     r14, r5, r4, lsr #8     // SWAPMOVE(r4, r5, 0x00ff00ff, 8) ...
+    and     r14, r14, r3
+    eor     r5, r5, r14
+    eor     r4, r4, r14, lsl #8     // ... SWAPMOVE(r4, r5, 0x00ff00ff, 8)
+    eor     r14, r7, r6, lsr #8     // SWAPMOVE(r6, r7, 0x00ff00ff, 8) ...
+    and     r14, r14, r3
+    eor     r7, r7, r14
+    eor     r6, r6, r14, lsl #8     // ... SWAPMOVE(r6, r7, 0x00ff00ff, 8)
+    eor     r14, r6, r4, lsr #16    // SWAPMOVE(r4, r6, 0x0000ffff, 16) ...
+    and     r14, r14, r2
+    eor     r6, r6, r14
+    eor     r4, r4, r14, lsl #16    // ... SWAPMOVE(r4, r6, 0x0000ffff, 16)
+    eor     r14, r7, r5, lsr #16    // SWAPMOVE(r5, r7, 0x0000ffff, 16) ...
+    and     r14, r14, r2
+    eor     r7, r7, r14
+    eor     r5, r5, r14, lsl #16    // ... SWAPMOVE(r5, r7, 0x0000ffff, 16)
+    ldr     r14, [sp, #-4]          // restore link register
+    bx      lr
+
+/******************************************************************************
+* Packing subroutine used to rearrange a row of the key to match the barrel-
+* shiftrows. Since the 8 blocks are encrypted with the same key, each bit is
+* replicated over the 8 bits of the corresponding byte.
+******************************************************************************/
+.align 2
+packing_rkey:
+    and     r8, r4, r1              // r8 <- r4 & 0x80808080
+    orr     r8, r8, r8, lsr #1      // r8 <- r8 | r8 >> 1
+    orr     r8, r8, r8, lsr #2      // r8 <- r8 | r8 >> 2
+    orr     r8, r8, r8, lsr #4      // r8 <- r8 | r8 >> 4
+    and     r9, r1, r4, lsl #1      // r9 <- r4 << 1 & 0x80808080
+    orr     r9, r9, r9, lsr #1      // r9 <- r9 | r9 >> 1
+    orr     r9, r9, r9, lsr #2      // r9 <- r9 | r9 >> 2
+    orr     r9, r9, r9, lsr #4      // r9 <- r9 | r9 >> 4
+    and     r10, r1, r4, lsl #2     // r10<- r4 << 2 & 0x80808080
+    orr     r10, r10, r10, lsr #1   // r10<- r10 | r10 >> 1
+    orr     r10, r10, r10, lsr #2   // r10<- r10 | r10 >> 2
+    orr     r10, r10, r10, lsr #4   // r10<- r10 | r10 >> 4
+    and     r11, r1, r4, lsl #3     // r11<- r4 << 3 & 0x80808080
+    orr     r11, r11, r11, lsr #1   // r11<- r11 | r11 >> 1
+    orr     r11, r11, r11, lsr #2   // r11<- r11 | r11 >> 2
+    orr     r11, r11, r11, lsr #4   // r11<- r11 | r11 >> 4
+    stmia   r0!, {r8-r11}
+    and     r8, r1, r4, lsl #4      // r8 <- r4 << 4 & 0x80808080
+    orr     r8, r8, r8, lsr #1      // r8 <- r8 | r8 >> 1
+    orr     r8, r8, r8, lsr #2      // r8 <- r8 | r8 >> 2
+    orr     r8, r8, r8, lsr #4      // r8 <- r8 | r8 >> 4
+    and     r9, r1, r4, lsl #5      // r9 <- r4 << 5 & 0x80808080
+    orr     r9, r9, r9, lsr #1      // r9 <- r9 | r9 >> 1
+    orr     r9, r9, r9, lsr #2      // r9 <- r9 | r9 >> 2
+    orr     r9, r9, r9, lsr #4      // r9 <- r9 | r9 >> 4
+    and     r10, r1, r4, lsl #6     // r10<- r4 << 6 & 0x80808080
+    orr     r10, r10, r10, lsr #1   // r10<- r10 | r10 >> 1
+    orr     r10, r10, r10, lsr #2   // r10<- r10 | r10 >> 2
+    orr     r10, r10, r10, lsr #4   // r10<- r10 | r10 >> 4
+    and     r11, r1, r4, lsl #7     // r11<- r4 << 7 & 0x80808080
+    orr     r11, r11, r11, lsr #1   // r11<- r11 | r11 >> 1
+    orr     r11, r11, r11, lsr #2   // r11<- r11 | r11 >> 2
+    orr     r11, r11, r11, lsr #4   // r11<- r11 | r11 >> 4
+    stmia   r0!, {r8-r11}
+    bx      lr
+
+/******************************************************************************
+* Subroutine that gathers the last column of the previous round key (whose
+* address is stored in sp[116]) into r4-r11 for the sbox, where the byte i of
+* each slice corresponds to the row i. Also loads the masks m0, m1 in r12, r2.
+******************************************************************************/
+.align 2
+gather_bsr:
+    ldr.w   r0, [sp, #116]          // load the prev rkey address
+    ldr.w   r1, [r0, #12]               // load S0 of the 4 rows
+    ldr.w   r2, [r0, #44]
+    ldr.w   r3, [r0, #76]
+    ldr.w   r4, [r0, #108]
+    and     r4, r4, #0xff000000         // keep the last column of the 4th row
+    orr     r4, r4, r1, lsr #24
+    lsr     r2, r2, #24
+    orr     r4, r4, r2, lsl #8
+    lsr     r3, r3, #24
+    orr     r4, r4, r3, lsl #16
+    ldr.w   r1, [r0, #16]               // load S1 of the 4 rows
+    ldr.w   r2, [r0, #48]
+    ldr.w   r3, [r0, #80]
+    ldr.w   r5, [r0, #112]
+    and     r5, r5, #0xff000000         // keep the last column of the 4th row
+    orr     r5, r5, r1, lsr #24
+    lsr     r2, r2, #24
+    orr     r5, r5, r2, lsl #8
+    lsr     r3, r3, #24
+    orr     r5, r5, r3, lsl #16
+    ldr.w   r1, [r0, #20]               // load S2 of the 4 rows
+    ldr.w   r2, [r0, #52]
+    ldr.w   r3, [r0, #84]
+    ldr.w   r6, [r0, #116]
+    and     r6, r6, #0xff000000         // keep the last column of the 4th row
+    orr     r6, r6, r1, lsr #24
+    lsr     r2, r2, #24
+    orr     r6, r6, r2, lsl #8
+    lsr     r3, r3, #24
+    orr     r6, r6, r3, lsl #16
+    ldr.w   r1, [r0, #24]               // load S3 of the 4 rows
+    ldr.w   r2, [r0, #56]
+    ldr.w   r3, [r0, #88]
+    ldr.w   r7, [r0, #120]
+    and     r7, r7, #0xff000000         // keep the last column of the 4th row
+    orr     r7, r7, r1, lsr #24
+    lsr     r2, r2, #24
+    orr     r7, r7, r2, lsl #8
+    lsr     r3, r3, #24
+    orr     r7, r7, r3, lsl #16
+    ldr.w   r1, [r0, #28]               // load S4 of the 4 rows
+    ldr.w   r2, [r0, #60]
+    ldr.w   r3, [r0, #92]
+    ldr.w   r8, [r0, #124]
+    and     r8, r8, #0xff000000         // keep the last column of the 4th row
+    orr     r8, r8, r1, lsr #24
+    lsr     r2, r2, #24
+    orr     r8, r8, r2, lsl #8
+    lsr     r3, r3, #24
+    orr     r8, r8, r3, lsl #16
+    ldr.w   r1, [r0, #32]               // load S5 of the 4 rows
+    ldr.w   r2, [r0, #64]
+    ldr.w   r3, [r0, #96]
+    ldr.w   r9, [r0, #128]
+    and     r9, r9, #0xff000000         // keep the last column of the 4th row
+    orr     r9, r9, r1, lsr #24
+    lsr     r2, r2, #24
+    orr     r9, r9, r2, lsl #8
+    lsr     r3, r3, #24
+    orr     r9, r9, r3, lsl #16
+    ldr.w   r1, [r0, #36]               // load S6 of the 4 rows
+    ldr.w   r2, [r0, #68]
+    ldr.w   r3, [r0, #100]
+    ldr.w   r10, [r0, #132]
+    and     r10, r10, #0xff000000       // keep the last column of the 4th row
+    orr     r10, r10, r1, lsr #24
+    lsr     r2, r2, #24
+    orr     r10, r10, r2, lsl #8
+    lsr     r3, r3, #24
+    orr     r10, r10, r3, lsl #16
+    ldr.w   r1, [r0, #40]               // load S7 of the 4 rows
+    ldr.w   r2, [r0, #72]
+    ldr.w   r3, [r0, #104]
+    ldr.w   r11, [r0, #136]
+    and     r11, r11, #0xff000000       // keep the last column of the 4th row
+    orr     r11, r11, r1, lsr #24
+    lsr     r2, r2, #24
+    orr     r11, r11, r2, lsl #8
+    lsr     r3, r3, #24
+    orr     r11, r11, r3, lsl #16
+    ldr     r12, [sp, #128]         // load m0 in r12 (for sbox routine)
+    ldr     r2, [sp, #124]          // load m1 in r2 (for sbox routine)
+    bx      lr
+
+/******************************************************************************
+* Subroutine that applies new masks on the sbox output. Before this subroutine
+* the sbox output is masked with m0, m1, m0^m1 while after the masks are now
+* m'0, m'1, m'0^m'1 where m' refers to the new masks, derived from the next 16
+* random bits. The new masks are stored in sp[120,124,128] and the NOTs omitted
+* in the sbox are added.
+******************************************************************************/
+.align 2
+remask_rkey_bsr:
+    str     r14, [sp, #132]         // save link register
+    ldr.w   r14, [sp, #160]         // load the address of the next random bits
+    ldrh    r7, [r14], #2           // r7 <- 16 random bits
+    str.w   r14, [sp, #160]
+    uxtb    r11, r7                 // r11<- ab (1 bit per block)
+    orr     r11, r11, r11, lsl #8   // r11<- abab
+    orr     r11, r11, r11, lsl #16  // r11<- abababab
+    ubfx    r7, r7, #8, #8          // r7 <- cd (1 bit per block)
+    orr     r7, r7, r7, lsl #8      // r7 <- cdcd
+    orr     r7, r7, r7, lsl #16     // r7 <- cdcdcdcd
+    eor     r14, r11, r7            // r14<- new_m0 ^ new_m1
+    str.w   r11, [sp, #128]         // store the new masks on the stack
+    strd    r14, r7, [sp, #120]     // store the new masks on the stack
+    eor     r9, r9, r11             // r9 <- m0 ^ new_m0
+    eor     r2, r2, r7              // r2 <- m1 ^ new_m1
+    eor     r10, r10, r14           // r10<- m0 ^ m1 ^ new_m0 ^ new_m1
+    eor     r1, r1, r2              // r1 <- key[0] ^ m1 ^ new_m1
+    eor     r5, r5, r9              // r5 <- key[1] ^ m0 ^ new_m0
+    eor     r12, r12, r2            // r12<- key[2] ^ m1 ^ new_m1
+    eor     r4, r4, r9              // r4 <- key[3] ^ m0 ^ new_m0
+    eor     r8, r8, r9              // r8 <- key[4] ^ m0 ^ new_m0
+    eor     r0, r0, r10             // r0 <- key[5] ^ m0 ^ m1 ^ new_m0 ^ new_m1
+    eor     r3, r3, r10             // r3 <- key[6] ^ m0 ^ m1 ^ new_m0 ^ new_m1
+    eor     r6, r6, r2              // r6 <- key[7] ^ m1 ^ new_m1
+    mvn     r5, r5                  // NOT omitted in sbox
+    mvn     r12, r12                // NOT omitted in sbox
+    mvn     r3, r3                  // NOT omitted in sbox
+    mvn     r6, r6                  // NOT omitted in sbox
+    ldr.w   r14, [sp, #132]         // restore link register
+    bx      lr
+
+/******************************************************************************
+* Subroutine that XORs the columns after the S-box during the key schedule
+* round function, where the sbox output S0-S7 is in r1,r5,r12,r4,r8,r0,r3,r6.
+* The byte (i+1)%4 of each sbox output word is XORed to the 1st column of the
+* row i (RotWord), before XORing the columns from left to right.
+* The previous round key being masked with the old masks, the 1st and 3rd
+* columns end up being masked with both. Those columns are then remasked so
+* that the whole round key is masked with the new masks only.
+******************************************************************************/
+.align 2
+xor_columns_bsr:
+    str     r14, [sp, #132]         // save link register
+    ldr.w   r14, [sp, #116]         // load the prev rkey address
+    ldrd    r2, r7, [sp, #120]      // load new km0 ^ km1, km1
+    ldr.w   r9, [sp, #128]          // load new km0
+    str.w   r9, [r14, #140]         // store new km0 in output array
+    strd    r7, r2, [r14, #144]     // store new km1, km0 ^ km1 in output array
+    ldrd    r9, r10, [r14]          // load old km0, km1
+    ldr.w   r11, [r14, #8]          // load old km0 ^ km1
+    and     r9, r9, #0x00ff00ff     // remask for the 1st and 3rd columns
+    and     r10, r10, #0x00ff00ff   // remask for the 1st and 3rd columns
+    and     r11, r11, #0x00ff00ff   // remask for the 1st and 3rd columns
+    ldr.w   r2, [r14, #12]              // load word 0 of the prev rkey
+    ubfx    r7, r1, #8, #8              // r7 <- byte 1 of S0 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #152]
+    ldr.w   r2, [r14, #16]              // load word 1 of the prev rkey
+    ubfx    r7, r5, #8, #8              // r7 <- byte 1 of S1 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #156]
+    ldr.w   r2, [r14, #20]              // load word 2 of the prev rkey
+    ubfx    r7, r12, #8, #8             // r7 <- byte 1 of S2 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #160]
+    ldr.w   r2, [r14, #24]              // load word 3 of the prev rkey
+    ubfx    r7, r4, #8, #8              // r7 <- byte 1 of S3 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #164]
+    ldr.w   r2, [r14, #28]              // load word 4 of the prev rkey
+    ubfx    r7, r8, #8, #8              // r7 <- byte 1 of S4 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #168]
+    ldr.w   r2, [r14, #32]              // load word 5 of the prev rkey
+    ubfx    r7, r0, #8, #8              // r7 <- byte 1 of S5 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r11                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #172]
+    ldr.w   r2, [r14, #36]              // load word 6 of the prev rkey
+    ubfx    r7, r3, #8, #8              // r7 <- byte 1 of S6 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r11                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #176]
+    ldr.w   r2, [r14, #40]              // load word 7 of the prev rkey
+    ubfx    r7, r6, #8, #8              // r7 <- byte 1 of S7 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #180]
+    ldr.w   r2, [r14, #44]              // load word 8 of the prev rkey
+    ubfx    r7, r1, #16, #8             // r7 <- byte 2 of S0 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #184]
+    ldr.w   r2, [r14, #48]              // load word 9 of the prev rkey
+    ubfx    r7, r5, #16, #8             // r7 <- byte 2 of S1 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #188]
+    ldr.w   r2, [r14, #52]              // load word 10 of the prev rkey
+    ubfx    r7, r12, #16, #8            // r7 <- byte 2 of S2 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #192]
+    ldr.w   r2, [r14, #56]              // load word 11 of the prev rkey
+    ubfx    r7, r4, #16, #8             // r7 <- byte 2 of S3 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #196]
+    ldr.w   r2, [r14, #60]              // load word 12 of the prev rkey
+    ubfx    r7, r8, #16, #8             // r7 <- byte 2 of S4 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #200]
+    ldr.w   r2, [r14, #64]              // load word 13 of the prev rkey
+    ubfx    r7, r0, #16, #8             // r7 <- byte 2 of S5 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r11                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #204]
+    ldr.w   r2, [r14, #68]              // load word 14 of the prev rkey
+    ubfx    r7, r3, #16, #8             // r7 <- byte 2 of S6 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r11                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #208]
+    ldr.w   r2, [r14, #72]              // load word 15 of the prev rkey
+    ubfx    r7, r6, #16, #8             // r7 <- byte 2 of S7 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #212]
+    ldr.w   r2, [r14, #76]              // load word 16 of the prev rkey
+    ubfx    r7, r1, #24, #8             // r7 <- byte 3 of S0 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #216]
+    ldr.w   r2, [r14, #80]              // load word 17 of the prev rkey
+    ubfx    r7, r5, #24, #8             // r7 <- byte 3 of S1 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #220]
+    ldr.w   r2, [r14, #84]              // load word 18 of the prev rkey
+    ubfx    r7, r12, #24, #8            // r7 <- byte 3 of S2 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #224]
+    ldr.w   r2, [r14, #88]              // load word 19 of the prev rkey
+    ubfx    r7, r4, #24, #8             // r7 <- byte 3 of S3 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #228]
+    ldr.w   r2, [r14, #92]              // load word 20 of the prev rkey
+    ubfx    r7, r8, #24, #8             // r7 <- byte 3 of S4 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #232]
+    ldr.w   r2, [r14, #96]              // load word 21 of the prev rkey
+    ubfx    r7, r0, #24, #8             // r7 <- byte 3 of S5 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r11                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #236]
+    ldr.w   r2, [r14, #100]             // load word 22 of the prev rkey
+    ubfx    r7, r3, #24, #8             // r7 <- byte 3 of S6 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r11                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #240]
+    ldr.w   r2, [r14, #104]             // load word 23 of the prev rkey
+    ubfx    r7, r6, #24, #8             // r7 <- byte 3 of S7 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #244]
+    ldr.w   r2, [r14, #108]             // load word 24 of the prev rkey
+    ubfx    r7, r1, #0, #8              // r7 <- byte 0 of S0 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #248]
+    ldr.w   r2, [r14, #112]             // load word 25 of the prev rkey
+    ubfx    r7, r5, #0, #8              // r7 <- byte 0 of S1 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #252]
+    ldr.w   r2, [r14, #116]             // load word 26 of the prev rkey
+    ubfx    r7, r12, #0, #8             // r7 <- byte 0 of S2 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #256]
+    ldr.w   r2, [r14, #120]             // load word 27 of the prev rkey
+    ubfx    r7, r4, #0, #8              // r7 <- byte 0 of S3 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #260]
+    ldr.w   r2, [r14, #124]             // load word 28 of the prev rkey
+    ubfx    r7, r8, #0, #8              // r7 <- byte 0 of S4 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r9                  // remask the 1st and 3rd columns
+    str.w   r2, [r14, #264]
+    ldr.w   r2, [r14, #128]             // load word 29 of the prev rkey
+    ubfx    r7, r0, #0, #8              // r7 <- byte 0 of S5 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r11                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #268]
+    ldr.w   r2, [r14, #132]             // load word 30 of the prev rkey
+    ubfx    r7, r3, #0, #8              // r7 <- byte 0 of S6 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r11                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #272]
+    ldr.w   r2, [r14, #136]             // load word 31 of the prev rkey
+    ubfx    r7, r6, #0, #8              // r7 <- byte 0 of S7 (RotWord)
+    eor     r2, r2, r7
+    and     r7, r2, #0xff
+    eor     r2, r2, r7, lsl #8          // XOR between the 1st and 2nd columns
+    and     r7, r2, #0xff00
+    eor     r2, r2, r7, lsl #8          // XOR between the 2nd and 3rd columns
+    and     r7, r2, #0xff0000
+    eor     r2, r2, r7, lsl #8          // XOR between the 3rd and 4th columns
+    eor     r2, r2, r10                 // remask the 1st and 3rd columns
+    str.w   r2, [r14, #276]
+    add.w   r14, r14, #140
+    str.w   r14, [sp, #116]         // store the new rkey address on the stack
+    ldr.w   r14, [sp, #132]         // restore link register
+    bx      lr
+
+/******************************************************************************
+* First-order masked AES-128 key schedule to match the barrel-shiftrows (bsr)
+* representation.
+* Each round key is stored on 35 words: the masks km0, km1, km0^km1 followed
+* by the 32 masked words. The masks are picked for each of the 8 blocks so that
+* 16 random bits are used per round key, i.e. 176 bits in total.
+******************************************************************************/
+@ void aes128_keyschedule_bsr(u32* rkeys, const u8* key);
+.global aes128_keyschedule_bsr
+.type   aes128_keyschedule_bsr,%function
+.align 2
+aes128_keyschedule_bsr:
+    push    {r0-r12,r14}
+    sub.w   sp, #168                // allow space on the stack for tmp var
+    // ------------------ MASKING ------------------
+    // generation of 6 random words
+    movw    r0, 0x0804
+    movt    r0, 0x5006              // r0 <- RNG_SR = 0x50060804
+    add     r12, r0, #4             // r12<- RNG_DR = 0x50060808
+    add.w   r3, sp, #136            // random words stored in sp[136..159]
+    str.w   r3, [sp, #160]          // address of the next random bits
+    mov     r14, #6                 // 6 random words to be generated
+bsr_get_random_mask:
+    ldr.w   r2, [r0]
+    cmp     r2, #1                  // check if RNG_SR == RNG_SR_DRDY
+    bne     bsr_get_random_mask     // loop while RNG status is not ready
+    ldr.w   r1, [r12]               // load the random number in r1
+    str     r1, [r3], #4            // store the random word on the stack
+    subs    r14, #1                 // r14<- r14 -1
+    bne     bsr_get_random_mask     // loop till r14 > 0
+    // ------------------ MASKING ------------------
+    ldr.w   r1, [sp, #172]          // load 'key' address
+    ldm     r1, {r4-r7}             // load the encryption key
+    ldr.w   r0, [sp, #168]          // load 'rkeys' address
+    str.w   r0, [sp, #116]          // store the rkey address on the stack
+    add.w   r0, r0, #12             // skip the masks of the 1st rkey
+    movw    r1, #0x8080
+    movt    r1, #0x8080             // r1 <- 0x80808080
+    movw    r2, #0xffff             // r2 <- 0x0000ffff
+    eor     r3, r2, r2, lsl #8      // r3 <- 0x00ff00ff
+    bl      swapmove_rkey
+    bl      packing_rkey            // pack the 1st row of the key
+    mov     r4, r5
+    bl      packing_rkey            // pack the 2nd row of the key
+    mov     r4, r6
+    bl      packing_rkey            // pack the 3rd row of the key
+    mov     r4, r7
+    bl      packing_rkey            // pack the 4th row of the key
+    // ------------------ MASKING ------------------
+    ldr.w   r2, [sp, #160]          // load the address of the next random bits
+    ldrh    r1, [r2], #2            // r1 <- 16 random bits
+    str.w   r2, [sp, #160]
+    uxtb    r12, r1                 // r12<- ab (1 bit per block)
+    orr     r12, r12, r12, lsl #8   // r12<- abab
+    orr     r12, r12, r12, lsl #16  // r12<- abababab
+    ubfx    r14, r1, #8, #8         // r14<- cd (1 bit per block)
+    orr     r14, r14, r14, lsl #8   // r14<- cdcd
+    orr     r14, r14, r14, lsl #16  // r14<- cdcdcdcd
+    eor     r3, r12, r14            // r3 <- m0 ^ m1
+    str.w   r12, [sp, #128]         // store the masks on the stack for sbox computations
+    strd    r3, r14, [sp, #120]     // store the masks on the stack for sbox computations
+    ldr.w   r0, [sp, #168]          // load 'rkeys' address
+    str.w   r12, [r0], #4           // store the corresponding masks
+    strd    r14, r3, [r0], #8       // store the corresponding masks
+    add.w   r2, r0, #128            // r2 points to the end of the 1st rkey
+bsr_mask_key:
+    ldm     r0, {r4-r11}
+    eor     r4, r4, r14             // r4 <- key[0] ^ m1
+    eor     r5, r5, r12             // r5 <- key[1] ^ m0
+    eor     r6, r6, r14             // r6 <- key[2] ^ m1
+    eor     r7, r7, r12             // r7 <- key[3] ^ m0
+    eor     r8, r8, r12             // r8 <- key[4] ^ m0
+    eor     r9, r9, r3              // r9 <- key[5] ^ m2
+    eor     r10, r10, r3            // r10<- key[6] ^ m2
+    eor     r11, r11, r14           // r11<- key[7] ^ m1
+    stmia   r0!, {r4-r11}           // store the masked key
+    cmp     r0, r2
+    bne     bsr_mask_key            // loop until the 4 rows are masked
+    // ------------------ MASKING ------------------
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r6, r6, #0x0000ff00         // add the 1st rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r3, r3, #0x0000ff00         // add the 2nd rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r0, r0, #0x0000ff00         // add the 3rd rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r8, r8, #0x0000ff00         // add the 4th rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r4, r4, #0x0000ff00         // add the 5th rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r12, r12, #0x0000ff00       // add the 6th rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r5, r5, #0x0000ff00         // add the 7th rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r1, r1, #0x0000ff00         // add the 8th rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r6, r6, #0x0000ff00         // add the 9th rconst
+    eor     r3, r3, #0x0000ff00         // add the 9th rconst
+    eor     r8, r8, #0x0000ff00         // add the 9th rconst
+    eor     r4, r4, #0x0000ff00         // add the 9th rconst
+    bl      xor_columns_bsr
+    bl      gather_bsr              // last column of the prev rkey
+    bl      sbox                    // apply the sbox to the last column
+    bl      remask_rkey_bsr
+    eor     r3, r3, #0x0000ff00         // add the 10th rconst
+    eor     r0, r0, #0x0000ff00         // add the 10th rconst
+    eor     r4, r4, #0x0000ff00         // add the 10th rconst
+    eor     r12, r12, #0x0000ff00       // add the 10th rconst
+    bl      xor_columns_bsr
+    ldr.w   r0, [sp, #168]          // load 'rkeys' address
+    add.w   r0, r0, #156            // r0 points to the 2nd word of the 2nd rkey
+    add.w   r1, r0, #1400           // r1 points to the end of the rkeys
+bsr_add_not:
+    ldrd    r2, r3, [r0]            // load key[1], key[2] of the 1st row
+    ldrd    r4, r5, [r0, #20]       // load key[6], key[7] of the 1st row
+    ldrd    r6, r7, [r0, #32]       // load key[1], key[2] of the 2nd row
+    ldrd    r8, r9, [r0, #52]       // load key[6], key[7] of the 2nd row
+    mvn     r2, r2                  // NOT to speed up sbox calculations
+    mvn     r3, r3                  // NOT to speed up sbox calculations
+    mvn     r4, r4                  // NOT to speed up sbox calculations
+    mvn     r5, r5                  // NOT to speed up sbox calculations
+    mvn     r6, r6                  // NOT to speed up sbox calculations
+    mvn     r7, r7                  // NOT to speed up sbox calculations
+    mvn     r8, r8                  // NOT to speed up sbox calculations
+    mvn     r9, r9                  // NOT to speed up sbox calculations
+    strd    r2, r3, [r0]
+    strd    r4, r5, [r0, #20]
+    strd    r6, r7, [r0, #32]
+    strd    r8, r9, [r0, #52]
+    ldrd    r2, r3, [r0, #64]       // load key[1], key[2] of the 3rd row
+    ldrd    r4, r5, [r0, #84]       // load key[6], key[7] of the 3rd row
+    ldrd    r6, r7, [r0, #96]       // load key[1], key[2] of the 4th row
+    ldrd    r8, r9, [r0, #116]      // load key[6], key[7] of the 4th row
+    mvn     r2, r2                  // NOT to speed up sbox calculations
+    mvn     r3, r3                  // NOT to speed up sbox calculations
+    mvn     r4, r4                  // NOT to speed up sbox calculations
+    mvn     r5, r5                  // NOT to speed up sbox calculations
+    mvn     r6, r6                  // NOT to speed up sbox calculations
+    mvn     r7, r7                  // NOT to speed up sbox calculations
+    mvn     r8, r8                  // NOT to speed up sbox calculations
+    mvn     r9, r9                  // NOT to speed up sbox calculations
+    strd    r2, r3, [r0, #64]
+    strd    r4, r5, [r0, #84]
+    strd    r6, r7, [r0, #96]
+    strd    r8, r9, [r0, #116]
+    add.w   r0, r0, #140            // next rkey
+    cmp     r0, r1
+    bne     bsr_add_not             // loop until the 10 rkeys are processed
+    add.w   sp, #168                // restore stack
+    pop     {r0-r12, r14}           // restore context
+    bx      lr
@@ -2,6 +2,11 @@
 * Bitsliced implementations of AES-128 and AES-256 (encryption only) in C using
 * the barrel-shiftrows representation.
 *
+* If AES_UNROLL is defined at build time (e.g. --defsym AES_UNROLL=1), the
+* round loop is fully unrolled and the round functions are expanded in place
+* instead of being called, which saves the branches, the link register spills
+* and the loop counter updates at the cost of a larger code size.
+*
 * See the paper at https://eprint.iacr.org/2020/1123.pdf for more details.
 *
 * @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
@@ -25,10 +30,31 @@
 .endm
 
 /******************************************************************************
-* AddRoundKey on a quarter state (i.e. 1024/4 = 256 bits).
+* The round functions below are defined as macros (suffixed by '_body'), from
+* which 'subroutine' generates the code called by 'invoke'. If AES_UNROLL is
+* defined, 'invoke' expands them in place instead.
 ******************************************************************************/
+.macro subroutine name
+.ifndef AES_UNROLL
 .align 2
-add_round_key:
+\name:
+    \name\()_body
+    bx      lr
+.endif
+.endm
+
+.macro invoke name
+.ifdef AES_UNROLL
+    \name\()_body
+.else
+    bl      \name
+.endif
+.endm
+
+/******************************************************************************
+* AddRoundKey on a quarter state (i.e. 1024/4 = 256 bits).
+******************************************************************************/
+.macro add_round_key_body
     ldm     r12, {r4-r11}       //state[0] ... state[7]
     ldr.w   r12, [sp, #180]     //load rkeys' address
     ldmia.w r12!, {r0-r3}       //rkeys for state[0]...state[3]
@@ -42,7 +68,8 @@ add_round_key:
     eor     r10, r2, r10
     eor     r11, r3, r11
     str     r12, [sp, #180]     //save rkeys' address
-    bx      lr
+.endm
+subroutine add_round_key
 
 /******************************************************************************
 * Bitsliced implementation of the AES Sbox based on Boyar, Peralta and Calik.
@@ -51,9 +78,10 @@ add_round_key:
 * Updates only a quarter of the state (i.e. 256 bits) => need to be applied 4
 * times per round when considering the barrel-shiftrows representation.
 ******************************************************************************/
-.align 2
-sbox:
+.macro sbox_body
+.ifndef AES_UNROLL
     str.w   r14, [sp, #176] //save link register
+.endif
     eor     r1, r7, r9      //Exec y14 = U3 ^ U5; into r1
     eor     r3, r4, r10     //Exec y13 = U0 ^ U6; into r3
     eor     r2, r3, r1      //Exec y12 = y13 ^ y14; into r2
@@ -198,19 +226,21 @@ sbox:
     eor     r14, r11, r12   //Exec tc18 = tc13 ^ tc14; into r14
     eor     r2, r2, r14     //Exec S6 = tc10 ^ tc18 ^ 1; into r2
     eor     r11, r8, r14    //Exec S7 = z12 ^ tc18 ^ 1; into r11
+.ifndef AES_UNROLL
     ldr     r14, [sp, #176] //restore link register
+.endif
     eor     r4, r12,  r9    //Exec S4 = tc14 ^ S3; into r4
-    bx      lr
     //[('r0', 'S5'), ('r1', 'S0'), ('r2', 'S6'), ('r3', 'S1'),
     // ('r4', 'S4'), ('r6', 'S2'), ('r9', 'S3'), ('r11', 'S7')] 
+.endm
+subroutine sbox
 
 /******************************************************************************
 * Shifts the second row.
 * Note that one can take advantage of the inline barrel-shiftrows to compute
 * the rotations for free by doing some rework.
 ******************************************************************************/
-.align 2
-shiftrows_1:
+.macro shiftrows_1_body
     ror     r0, r0, #8
     ror     r1, r1, #8
     ror     r2, r2, #8
@@ -223,15 +253,15 @@ shiftrows_1:
     strd    r6, r9, [sp, #40]
     strd    r4, r0, [sp, #48]
     strd    r2, r11, [sp, #56]
-    bx      lr
+.endm
+subroutine shiftrows_1
 
 /******************************************************************************
 * Shifts the third row.
 * Note that one can take advantage of the inline barrel-shiftrows to compute
 * the rotations for free by doing some rework.
 ******************************************************************************/
-.align 2
-shiftrows_2:
+.macro shiftrows_2_body
     ror     r0, r0, #16
     ror     r1, r1, #16
     ror     r2, r2, #16
@@ -244,15 +274,15 @@ shiftrows_2:
     strd    r6, r9, [sp, #72]
     strd    r4, r0, [sp, #80]
     strd    r2, r11, [sp, #88]
-    bx      lr
+.endm
+subroutine shiftrows_2
 
 /******************************************************************************
 * Shifts the fourth row.
 * Note that one can take advantage of the inline barrel-shiftrows to compute
 * the rotations for free by doing some rework.
 ******************************************************************************/
-.align 2
-shiftrows_3:
+.macro shiftrows_3_body
     ror     r0, r0, #24
     ror     r1, r1, #24
     ror     r2, r2, #24
@@ -261,14 +291,16 @@ shiftrows_3:
     ror     r6, r6, #24
     ror     r9, r9, #24
     ror     r11, r11, #24
-    bx      lr
+.endm
+subroutine shiftrows_3
 
 /******************************************************************************
 * MixColumns according to the barrel-shiftrows representation.
 ******************************************************************************/
-.align 2
-mixcolumns:
+.macro mixcolumns_body
+.ifndef AES_UNROLL
     str.w   r14, [sp, #176]         //save link register
+.endif
     ldr.w   r0, [sp]                //load S0 in r0
     ldr.w   r2, [sp, #32]           //load s8 in r2
     ldr.w   r3, [sp, #64]           //load s16 in r3
@@ -440,12 +472,15 @@ mixcolumns:
     str.w   r3, [sp, #32]           //store S'8
     eor     r4, r4, r9              //r4 <- S17 ^ S25 ^ S24 ^ S0
     eor     r4, r4, r12             //r4 <- S'16 = S17 ^ S25 ^ S24 ^ S0 ^ S8
+.ifndef AES_UNROLL
     ldr.w   r14, [sp, #176]         //restore link register
+.endif
     str.w   r4, [sp, #64]           //store S'16
     eor     r0, r0, r6              //r0 <- S25 ^ S1 ^ S0 ^ S8
     eor     r0, r0, r11             //r0 <- S'24 = S25 ^ S1 ^ S0 ^ S8 ^ S16
     str     r0, [sp, #96]
-    bx      lr
+.endm
+subroutine mixcolumns
 
 /******************************************************************************
 * Subroutine for the first layer of packing.
@@ -568,6 +603,35 @@ loop_up2:
     ble     loop_up2                //loop until r3 <= 3
     bx      lr
 
+/******************************************************************************
+* AES round (i.e. AddRoundKey, SubBytes, ShiftRows and MixColumns) on the entire
+* state according to the barrel-shiftrows representation.
+******************************************************************************/
+.macro aes_round
+    mov     r12, sp             // r12 points to 1st quarter state
+    invoke  add_round_key       // addroundkey on 1st quarter state
+    invoke  sbox                // sbox on 1st quarter state
+    stm     sp, {r1,r3,r6,r9}
+    strd    r4, r0, [sp, #16]
+    strd    r2, r11, [sp, #24]
+    add.w   r12, sp, #32        // r12 points to 2nd quarter state
+    invoke  add_round_key       // addroundkey on 2nd quarter state
+    invoke  sbox                // sbox on 2nd quarter state
+    invoke  shiftrows_1         // shiftrows on 2nd quarter state
+    add.w   r12, sp, #64        // r12 points to 3rd quarter state
+    invoke  add_round_key       // addroundkey on 3rd quarter state
+    invoke  sbox                // sbox on 3rd quarter state
+    invoke  shiftrows_2         // shiftrows on 3rd quarter state
+    add.w   r12, sp, #96        // r12 points to 4th quarter state
+    invoke  add_round_key       // addroundkey on 4th quarter state
+    invoke  sbox                // sbox on 4th quarter state
+    invoke  shiftrows_3         // shiftrows on 4t quarter state
+    strd    r1, r3, [sp, #96]
+    strd    r6, r9, [sp, #104]
+    strd    r0, r2, [sp, #116]
+    invoke  mixcolumns          // mixcolumns on the entire state
+.endm
+
 /******************************************************************************
 * Encryption of 8 128-bit blocks of data in parallel using AES-128 with the
 * barrel-shiftrows representation.
@@ -581,85 +645,72 @@ aes128_encrypt:
     push {r0-r12,r14}
     sub.w   sp, sp, #188
     str.w   r1, [sp, #180]      // store pointer to rkey on the stack
+.ifndef AES_UNROLL
     mov     r1, #0              // init loop counter
     str.w   r1, [sp, #184]      // store loop counter on the stack
+.endif
     bl      packing_0           // 1st packing layer
     sub.w   sp, sp, #32
     bl      packing_1           // 2nd packing layer
     sub.w   sp, sp, #64
     bl      packing_2           // 3rd packing layer
     sub.w   sp, sp, #128
+.ifdef AES_UNROLL
+    .rept 9
+    aes_round
+    .endr
+.else
 loop_aes128_core:
-    mov     r12, sp             // r12 points to 1st quarter state
-    bl      add_round_key       // addroundkey on 1st quarter state
-    bl      sbox                // sbox on 1st quarter state
-    stm     sp, {r1,r3,r6,r9}
-    strd    r4, r0, [sp, #16]
-    strd    r2, r11, [sp, #24]
-    add.w   r12, sp, #32        // r12 points to 2nd quarter state
-    bl      add_round_key       // addroundkey on 2nd quarter state
-    bl      sbox                // sbox on 2nd quarter state
-    bl      shiftrows_1         // shiftrows on 2nd quarter state
-    add.w   r12, sp, #64        // r12 points to 3rd quarter state
-    bl      add_round_key       // addroundkey on 3rd quarter state
-    bl      sbox                // sbox on 3rd quarter state
-    bl      shiftrows_2         // shiftrows on 3rd quarter state
-    add.w   r12, sp, #96        // r12 points to 4th quarter state
-    bl      add_round_key       // addroundkey on 4th quarter state
-    bl      sbox                // sbox on 4th quarter state
-    bl      shiftrows_3         // shiftrows on 4t quarter state
-    strd    r1, r3, [sp, #96]
-    strd    r6, r9, [sp, #104]
-    strd    r0, r2, [sp, #116]
-    bl      mixcolumns          // mixcolumns on the entire state
+    aes_round
     ldr.w   r1, [sp, #184]      // load loop counter
     add.w   r1, r1, #1          // increment loop counter
     str.w   r1, [sp, #184]      // store loop counter on the stack
     cmp     r1, #8
     ble     loop_aes128_core    // loop until r1 <= 8
+.endif
     // Last round
     mov     r12, sp             // r12 points to 1st quarter state
-    bl      add_round_key       // addroundkey on 1st quarter state
-    bl      sbox                // sbox on 1st quarter state
+    invoke  add_round_key       // addroundkey on 1st quarter state
+    invoke  sbox                // sbox on 1st quarter state
     stm     sp, {r1,r3,r6,r9}
     strd    r4, r0, [sp, #16]
     strd    r2, r11, [sp, #24]
     add.w   r12, sp, #32        // r12 points to 2nd quarter state
-    bl      add_round_key       // addroundkey on 2nd quarter state
-    bl      sbox                // sbox on 2nd quarter state
-    bl      shiftrows_1         // shiftrows on 2nd quarter state
+    invoke  add_round_key       // addroundkey on 2nd quarter state
+    invoke  sbox                // sbox on 2nd quarter state
+    invoke  shiftrows_1         // shiftrows on 2nd quarter state
     add.w   r12, sp, #64        // r12 points to 3rd quarter state
-    bl      add_round_key       // addroundkey on 3rd quarter state
-    bl      sbox                // sbox on 3rd quarter state
-    bl      shiftrows_2         // shiftrows on 3rd quarter state
+    invoke  add_round_key       // addroundkey on 3rd quarter state
+    invoke  sbox                // sbox on 3rd quarter state
+    invoke  shiftrows_2         // shiftrows on 3rd quarter state
     add.w   r12, sp, #96        // r12 points to 4th quarter state
-    bl      add_round_key       // addroundkey on 4th quarter state
-    bl      sbox                // sbox on 4th quarter state
-    bl      shiftrows_3         // shiftrows on 4t quarter state
+    invoke  add_round_key       // addroundkey on 4th quarter state
+    invoke  sbox                // sbox on 4th quarter state
+    invoke  shiftrows_3         // shiftrows on 4t quarter state
     strd    r1, r3, [sp, #96]
     strd    r6, r9, [sp, #104]
     strd    r4, r0, [sp, #112]
     strd    r2, r11, [sp, #120]
     mov     r12, sp             // r12 points to 1st quarter state     
-    bl      add_round_key       // last addroundkey on 1st quarter state
+    invoke  add_round_key       // last addroundkey on 1st quarter state
     strd    r4, r5, [sp]
     strd    r6, r7, [sp, #8]
     strd    r8, r9, [sp, #16]
     strd    r10, r11, [sp, #24]
     add.w   r12, sp, #32        // r12 points to 2nd quarter state
-    bl      add_round_key       // last addroundkey on 2nd quarter state
+    invoke  add_round_key       // last addroundkey on 2nd quarter state
     strd    r4, r5, [sp, #32]
     strd    r6, r7, [sp, #40]
     strd    r8, r9, [sp, #48]
     strd    r10, r11, [sp, #56]
     add.w   r12, sp, #64        // r12 points to 3rd quarter state
-    bl      add_round_key       // last addroundkey on 3rd quarter state
+    invoke  add_round_key       // last addroundkey on 3rd quarter state
     strd    r4, r5, [sp, #64]
     strd    r6, r7, [sp, #72]
     strd    r8, r9, [sp, #80]
     strd    r10, r11, [sp, #88]
     add.w   r12, sp, #96        // r12 points to 4th quarter state
-    bl      add_round_key       // last addroundkey on 4th quarter state
+    invoke  add_round_key       // last addroundkey on 4th quarter state
     strd    r4, r5, [sp, #96]
     strd    r6, r7, [sp, #104]
     strd    r8, r9, [sp, #112]
@@ -687,85 +738,72 @@ aes256_encrypt:
     push {r0-r12,r14}
     sub.w   sp, sp, #188
     str.w   r1, [sp, #180]      // store pointer to rkey on the stack
+.ifndef AES_UNROLL
     mov     r1, #0              // init loop counter
     str.w   r1, [sp, #184]      // store loop counter on the stack
+.endif
     bl      packing_0           // 1st packing layer
     sub.w   sp, sp, #32
     bl      packing_1           // 2nd packing layer
     sub.w   sp, sp, #64
     bl      packing_2           // 3rd packing layer
     sub.w   sp, sp, #128
+.ifdef AES_UNROLL
+    .rept 13
+    aes_round
+    .endr
+.else
 loop_aes256_core:
-    mov     r12, sp             // r12 points to 1st quarter state
-    bl      add_round_key       // addroundkey on 1st quarter state
-    bl      sbox                // sbox on 1st quarter state
-    stm     sp, {r1,r3,r6,r9}
-    strd    r4, r0, [sp, #16]
-    strd    r2, r11, [sp, #24]
-    add.w   r12, sp, #32        // r12 points to 2nd quarter state
-    bl      add_round_key       // addroundkey on 2nd quarter state
-    bl      sbox                // sbox on 2nd quarter state
-    bl      shiftrows_1         // shiftrows on 2nd quarter state
-    add.w   r12, sp, #64        // r12 points to 3rd quarter state
-    bl      add_round_key       // addroundkey on 3rd quarter state
-    bl      sbox                // sbox on 3rd quarter state
-    bl      shiftrows_2         // shiftrows on 3rd quarter state
-    add.w   r12, sp, #96        // r12 points to 4th quarter state
-    bl      add_round_key       // addroundkey on 4th quarter state
-    bl      sbox                // sbox on 4th quarter state
-    bl      shiftrows_3         // shiftrows on 4t quarter state
-    strd    r1, r3, [sp, #96]
-    strd    r6, r9, [sp, #104]
-    strd    r0, r2, [sp, #116]
-    bl      mixcolumns          // mixcolumns on the entire state
+    aes_round
     ldr.w   r1, [sp, #184]      // load loop counter
     add.w   r1, r1, #1          // increment loop counter
     str.w   r1, [sp, #184]      // store loop counter on the stack
     cmp     r1, #12
     ble     loop_aes256_core    // loop until r1 <= 8
+.endif
     // Last round
     mov     r12, sp             // r12 points to 1st quarter state
-    bl      add_round_key       // addroundkey on 1st quarter state
-    bl      sbox                // sbox on 1st quarter state
+    invoke  add_round_key       // addroundkey on 1st quarter state
+    invoke  sbox                // sbox on 1st quarter state
     stm     sp, {r1,r3,r6,r9}
     strd    r4, r0, [sp, #16]
     strd    r2, r11, [sp, #24]
     add.w   r12, sp, #32        // r12 points to 2nd quarter state
-    bl      add_round_key       // addroundkey on 2nd quarter state
-    bl      sbox                // sbox on 2nd quarter state
-    bl      shiftrows_1         // shiftrows on 2nd quarter state
+    invoke  add_round_key       // addroundkey on 2nd quarter state
+    invoke  sbox                // sbox on 2nd quarter state
+    invoke  shiftrows_1         // shiftrows on 2nd quarter state
     add.w   r12, sp, #64        // r12 points to 3rd quarter state
-    bl      add_round_key       // addroundkey on 3rd quarter state
-    bl      sbox                // sbox on 3rd quarter state
-    bl      shiftrows_2         // shiftrows on 3rd quarter state
+    invoke  add_round_key       // addroundkey on 3rd quarter state
+    invoke  sbox                // sbox on 3rd quarter state
+    invoke  shiftrows_2         // shiftrows on 3rd quarter state
     add.w   r12, sp, #96        // r12 points to 4th quarter state
-    bl      add_round_key       // addroundkey on 4th quarter state
-    bl      sbox                // sbox on 4th quarter state
-    bl      shiftrows_3         // shiftrows on 4t quarter state
+    invoke  add_round_key       // addroundkey on 4th quarter state
+    invoke  sbox                // sbox on 4th quarter state
+    invoke  shiftrows_3         // shiftrows on 4t quarter state
     strd    r1, r3, [sp, #96]
     strd    r6, r9, [sp, #104]
     strd    r4, r0, [sp, #112]
     strd    r2, r11, [sp, #120]
     mov     r12, sp             // r12 points to 1st quarter state     
-    bl      add_round_key       // last addroundkey on 1st quarter state
+    invoke  add_round_key       // last addroundkey on 1st quarter state
     strd    r4, r5, [sp]
     strd    r6, r7, [sp, #8]
     strd    r8, r9, [sp, #16]
     strd    r10, r11, [sp, #24]
     add.w   r12, sp, #32        // r12 points to 2nd quarter state
-    bl      add_round_key       // last addroundkey on 2nd quarter state
+    invoke  add_round_key       // last addroundkey on 2nd quarter state
     strd    r4, r5, [sp, #32]
     strd    r6, r7, [sp, #40]
     strd    r8, r9, [sp, #48]
     strd    r10, r11, [sp, #56]
     add.w   r12, sp, #64        // r12 points to 3rd quarter state
-    bl      add_round_key       // last addroundkey on 3rd quarter state
+    invoke  add_round_key       // last addroundkey on 3rd quarter state
     strd    r4, r5, [sp, #64]
     strd    r6, r7, [sp, #72]
     strd    r8, r9, [sp, #80]
     strd    r10, r11, [sp, #88]
     add.w   r12, sp, #96        // r12 points to 4th quarter state
-    bl      add_round_key       // last addroundkey on 4th quarter state
+    invoke  add_round_key       // last addroundkey on 4th quarter state
     strd    r4, r5, [sp, #96]
     strd    r6, r7, [sp, #104]
     strd    r8, r9, [sp, #112]
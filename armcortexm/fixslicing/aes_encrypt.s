@@ -4,6 +4,10 @@
 * Fully-fixsliced implementation runs faster than the semi-fixsliced variant
 * at the cost of a larger code size.
 *
+* If AES_UNROLL is defined at build time (e.g. --defsym AES_UNROLL=1), the
+* subroutines are expanded in place instead of being called, which saves the
+* branches and the link register spills at the cost of a larger code size.
+*
 * See the paper at https://eprint.iacr.org/2020/1123.pdf for more details.
 *
 * @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
@@ -89,6 +93,28 @@
     eor     r4, r14, r0, ror #16        // r4 <- S'0
 .endm
 
+/******************************************************************************
+* The subroutines below are defined as macros (suffixed by '_body'), from which
+* 'subroutine' generates the code called by 'invoke'. If AES_UNROLL is defined,
+* 'invoke' expands them in place instead.
+******************************************************************************/
+.macro subroutine name
+.ifndef AES_UNROLL
+.align 2
+\name:
+    \name\()_body
+    bx      lr
+.endif
+.endm
+
+.macro invoke name
+.ifdef AES_UNROLL
+    \name\()_body
+.else
+    bl      \name
+.endif
+.endm
+
 /******************************************************************************
 * Packs two 128-bit input blocs stored in r4-r7 and r8-r11, respectively, into
 * the 256-bit internal state where the bits are packed as follows:
@@ -101,8 +127,7 @@
 * r10 = b_30 b_62 b_94 b_126 || ... || b_6 b_38 b_70 b_102
 * r11 = b_31 b_63 b_95 b_127 || ... || b_7 b_39 b_71 b_103
 ******************************************************************************/
-.align 2
-packing:
+.macro packing_body
     movw    r3, #0x0f0f
     movt    r3, #0x0f0f             // r3 <- 0x0f0f0f0f (mask for SWAPMOVE)
     eor     r2, r3, r3, lsl #2      // r2 <- 0x33333333 (mask for SWAPMOVE)
@@ -119,13 +144,13 @@ packing:
     swpmv   r10, r6, r7, r0, r3, #4, r12
     swpmv   r11, r7, r11, r9, r3, #4, r12
     swpmv   r9, r5, r2, r5, r3, #4, r12
-    bx      lr
+.endm
+subroutine packing
 
 /******************************************************************************
 * Unpacks the 256-bit internal state in two 128-bit blocs.
 ******************************************************************************/
-.align 2
-unpacking:
+.macro unpacking_body
     movw    r3, #0x0f0f
     movt    r3, #0x0f0f                 // r3 <- 0x0f0f0f0f (mask for SWAPMOVE)
     swpmv   r2, r5, r9, r5, r3, #4, r12
@@ -142,14 +167,14 @@ unpacking:
     swpmv   r9, r5,r9, r5, r1, #1, r12
     swpmv   r10, r6, r10, r6, r1, #1, r12
     swpmv   r11, r7, r11, r7, r1, #1, r12
-    bx      lr
+.endm
+subroutine unpacking
 
 /******************************************************************************
 * Subroutine that computes the AddRoundKey and the S-box.
 * Credits to https://github.com/Ko-/aes-armcortexm for the S-box implementation
 ******************************************************************************/
-.align 2
-ark_sbox:
+.macro ark_sbox_body
     // add round key
     ldr.w   r1, [sp, #48]
     ldmia   r1!, {r0,r2,r3,r12}
@@ -163,7 +188,9 @@ ark_sbox:
     eor     r10, r3
     eor     r11, r12
     str.w   r1, [sp, #48]
+.ifndef AES_UNROLL
     str     r14, [sp, #52]
+.endif
     // sbox: credits to https://github.com/Ko-/aes-armcortexm
     eor     r1, r7, r9              //Exec y14 = U3 ^ U5; into r1
     eor     r3, r4, r10             //Exec y13 = U0 ^ U6; into r3
@@ -309,33 +336,41 @@ ark_sbox:
     eor     r14, r11, r12           //Exec tc18 = tc13 ^ tc14; into r14
     eor     r2, r2, r14             //Exec S6 = tc10 ^ tc18 ^ 1; into r2
     eor     r11, r8, r14            //Exec S7 = z12 ^ tc18 ^ 1; into r11
+.ifndef AES_UNROLL
     ldr     r14, [sp, #52]          // restore link register
+.endif
     eor     r8, r12, r7             //Exec S4 = tc14 ^ S3; into r8
-    bx      lr
     // [('r0', 'S5'), ('r1', 'S0'), ('r2', 'S6'), ('r3', 'S1'),
     // ('r6', 'S2'),('r7', 'S3'), ('r8', 'S4'), ('r11', 'S7')]
+.endm
+subroutine ark_sbox
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
 * For fully-fixsliced implementations, it is used for rounds i s.t. (i%4) == 0.
 * For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 0.
 ******************************************************************************/
-.align 2
-mixcolumns_0:
+.macro mixcolumns_0_body
+.ifndef AES_UNROLL
     str     r14, [sp, #52]          // store link register
+.endif
     movw    r12, #0x0303
     movt    r12, #0x0303
     mc_0_2  r12, 6, 2, 26, 18
+.ifndef AES_UNROLL
     ldr     r14, [sp, #52]          // restore link register
-    bx      lr
+.endif
+.endm
+subroutine mixcolumns_0
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
 * For fully-fixsliced implementations only, for round i s.t. (i%4) == 1.
 ******************************************************************************/
-.align 2
-mixcolumns_1:
+.macro mixcolumns_1_body
+.ifndef AES_UNROLL
     str     r14, [sp, #52]          // store link register
+.endif
     movw    r14, #0x0f0f
     movt    r14, #0x0f0f            // r14<- 0x0f0f0f0f (mask for BYTE_ROR_4)
     and     r5, r14, r1, lsr #4     // r5 <- (S0 >> 4) & 0x0f0f0f0f
@@ -385,26 +420,33 @@ mixcolumns_1:
     and     r5, r14, r3, lsr #4     // r5 <- (S1 >> 4) & 0x0f0f0f0f
     and     r0, r14, r3             // r0 <- S1 & 0x0f0f0f0f
     orr     r0, r5, r0, lsl #4      // r0 <- BYTE_ROR_4(S1)
+.ifndef AES_UNROLL
     ldr     r14, [sp, #52]          // restore link register
+.endif
     eor     r2, r2, r0, ror #8      // r2 <- r2 ^ (BYTE_ROR_4(S1) >>> 8)
     eor     r0, r3, r0, ror #8      // r0 <- S1 ^ (BYTE_ROR_4(S1) >>> 8)
     eor     r5, r2, r0, ror #16     // r5 <- r2 <- (r0 >>> 16)
     eor     r1, r0, r1              // r1 <- r0 ^ BYTE_ROR_4(S0) >>> 8
     eor     r4, r1, r4, ror #16     // r4 <- r4 ^ (r0 >>> 16)
-    bx      lr
+.endm
+subroutine mixcolumns_1
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
 * For fully-fixsliced implementations only, for rounds i s.t. (i%4) == 2.
 ******************************************************************************/
-.align 2
-mixcolumns_2:
+.macro mixcolumns_2_body
+.ifndef AES_UNROLL
     str     r14, [sp, #52]          // store link register
+.endif
     movw    r12, #0x3f3f
     movt    r12, #0x3f3f
     mc_0_2  r12, 2, 6, 30, 22
+.ifndef AES_UNROLL
     ldr     r14, [sp, #52]          // restore link register
-    bx      lr
+.endif
+.endm
+subroutine mixcolumns_2
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
@@ -412,8 +454,7 @@ mixcolumns_2:
 * For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 1.
 * Based on Käsper-Schwabe, similar to https://github.com/Ko-/aes-armcortexm.
 ******************************************************************************/
-.align 2
-mixcolumns_3:
+.macro mixcolumns_3_body
     eor     r12, r11, r11, ror #8   // r12<- S7 ^ (S7 >>> 8)
     eor     r4, r1, r1, ror #8      // r4 <- S0 ^ (S0 >>> 8)
     eor     r11, r4, r11, ror #8    // r11<- S0 ^ (S0 >>> 8) ^ (S7 >>> 8)
@@ -441,13 +482,13 @@ mixcolumns_3:
     eor     r5, r5, r12, ror #16    // r5 <- r5 ^ (S1 >>> 16) ^ (S1 >>> 24)
     eor     r4, r12, r4, ror #16    // r4 <- S1 ^ (S1 >>> 8) ^ (r4 >>> 16)
     eor     r4, r4, r1, ror #8      // r4 <- r4 ^ (S0 >>> 8)
-    bx      lr
+.endm
+subroutine mixcolumns_3
 
 /******************************************************************************
 * Applies the ShiftRows transformation twice (i.e. SR^2) on the internal state.
 ******************************************************************************/
-.align 2
-double_shiftrows:
+.macro double_shiftrows_body
     movw    r10, #0x0f00
     movt    r10, #0x0f00            // r10<- 0x0f000f00 (mask)
     swpmv   r0, r0, r0, r0, r10, #4, r12
@@ -458,7 +499,8 @@ double_shiftrows:
     swpmv   r7, r7, r7, r7, r10, #4, r12
     swpmv   r8, r8, r8, r8, r10, #4, r12
     swpmv   r11, r11, r11, r11, r10, #4, r12
-    bx      lr
+.endm
+subroutine double_shiftrows
 
 /******************************************************************************
 * Fully-fixsliced implementation of AES-128.
@@ -486,27 +528,27 @@ aes128_encrypt_ffs:
     ldr     r11,[r3, #12]
     ldr.w   r1, [sp, #112]          // load 'rkey' argument from the stack
     str.w   r1, [sp, #48]           // store it there for 'add_round_key'
-    bl      packing                 // pack the 2 input blocks
-    bl      ark_sbox                // ark + sbox (round 0)
-    bl      mixcolumns_0            // mixcolumns (round 0)
-    bl      ark_sbox                // ark + sbox (round 1)
-    bl      mixcolumns_1            // mixcolumns (round 1)
-    bl      ark_sbox                // ark + sbox (round 2)
-    bl      mixcolumns_2            // mixcolumns (round 2)
-    bl      ark_sbox                // ark + sbox (round 3)
-    bl      mixcolumns_3            // mixcolumns (round 3)
-    bl      ark_sbox                // ark + sbox (round 4)
-    bl      mixcolumns_0            // mixcolumns (round 4)
-    bl      ark_sbox                // ark + sbox (round 5)
-    bl      mixcolumns_1            // mixcolumns (round 5)
-    bl      ark_sbox                // ark + sbox (round 6)
-    bl      mixcolumns_2            // mixcolumns (round 6)
-    bl      ark_sbox                // ark + sbox (round 7)
-    bl      mixcolumns_3            // mixcolumns (round 7)
-    bl      ark_sbox                // ark + sbox (round 8)
-    bl      mixcolumns_0            // mixcolumns (round 8)
-    bl      ark_sbox                // ark + sbox (round 9)
-    bl      double_shiftrows        // to resynchronize with the classical rep
+    invoke  packing                 // pack the 2 input blocks
+    invoke  ark_sbox                // ark + sbox (round 0)
+    invoke  mixcolumns_0            // mixcolumns (round 0)
+    invoke  ark_sbox                // ark + sbox (round 1)
+    invoke  mixcolumns_1            // mixcolumns (round 1)
+    invoke  ark_sbox                // ark + sbox (round 2)
+    invoke  mixcolumns_2            // mixcolumns (round 2)
+    invoke  ark_sbox                // ark + sbox (round 3)
+    invoke  mixcolumns_3            // mixcolumns (round 3)
+    invoke  ark_sbox                // ark + sbox (round 4)
+    invoke  mixcolumns_0            // mixcolumns (round 4)
+    invoke  ark_sbox                // ark + sbox (round 5)
+    invoke  mixcolumns_1            // mixcolumns (round 5)
+    invoke  ark_sbox                // ark + sbox (round 6)
+    invoke  mixcolumns_2            // mixcolumns (round 6)
+    invoke  ark_sbox                // ark + sbox (round 7)
+    invoke  mixcolumns_3            // mixcolumns (round 7)
+    invoke  ark_sbox                // ark + sbox (round 8)
+    invoke  mixcolumns_0            // mixcolumns (round 8)
+    invoke  ark_sbox                // ark + sbox (round 9)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
     ldr     r14, [sp, #48]          // ---------------------------------------
     ldmia   r14!, {r4,r5,r10,r12}   // 
     eor     r4, r1                  // 
@@ -518,7 +560,7 @@ aes128_encrypt_ffs:
     eor     r9, r0, r3              // 
     eor     r10, r2                 // 
     eor     r11, r12                // ---------------------------------------
-    bl      unpacking               // unpack the internal state
+    invoke  unpacking               // unpack the internal state
     ldrd    r0, r1, [sp, #56]       // restore the addr to store the ciphertext
     add.w   sp, #64                 // restore the stack pointer
     str.w   r4, [r0]                // store the ciphertext
@@ -558,35 +600,35 @@ aes256_encrypt_ffs:
     ldr     r11,[r3, #12]
     ldr.w   r1, [sp, #112]          // load 'rkey' argument from the stack
     str.w   r1, [sp, #48]           // store it there for 'add_round_key'
-    bl      packing                 // pack the 2 input blocks
-    bl      ark_sbox                // ark + sbox (round 0)
-    bl      mixcolumns_0            // mixcolumns (round 0)
-    bl      ark_sbox                // ark + sbox (round 1)
-    bl      mixcolumns_1            // mixcolumns (round 1)
-    bl      ark_sbox                // ark + sbox (round 2)
-    bl      mixcolumns_2            // mixcolumns (round 2)
-    bl      ark_sbox                // ark + sbox (round 3)
-    bl      mixcolumns_3            // mixcolumns (round 3)
-    bl      ark_sbox                // ark + sbox (round 4)
-    bl      mixcolumns_0            // mixcolumns (round 4)
-    bl      ark_sbox                // ark + sbox (round 5)
-    bl      mixcolumns_1            // mixcolumns (round 5)
-    bl      ark_sbox                // ark + sbox (round 6)
-    bl      mixcolumns_2            // mixcolumns (round 6)
-    bl      ark_sbox                // ark + sbox (round 7)
-    bl      mixcolumns_3            // mixcolumns (round 7)
-    bl      ark_sbox                // ark + sbox (round 8)
-    bl      mixcolumns_0            // mixcolumns (round 8)
-    bl      ark_sbox                // ark + sbox (round 9)
-    bl      mixcolumns_1            // mixcolumns (round 9)
-    bl      ark_sbox                // ark + sbox (round 10)
-    bl      mixcolumns_2            // mixcolumns (round 10)
-    bl      ark_sbox                // ark + sbox (round 11)
-    bl      mixcolumns_3            // mixcolumns (round 11)
-    bl      ark_sbox                // ark + sbox (round 12)
-    bl      mixcolumns_0            // mixcolumns (round 12)
-    bl      ark_sbox                // ark + sbox (round 13)
-    bl      double_shiftrows        // to resynchronize with the classical rep
+    invoke  packing                 // pack the 2 input blocks
+    invoke  ark_sbox                // ark + sbox (round 0)
+    invoke  mixcolumns_0            // mixcolumns (round 0)
+    invoke  ark_sbox                // ark + sbox (round 1)
+    invoke  mixcolumns_1            // mixcolumns (round 1)
+    invoke  ark_sbox                // ark + sbox (round 2)
+    invoke  mixcolumns_2            // mixcolumns (round 2)
+    invoke  ark_sbox                // ark + sbox (round 3)
+    invoke  mixcolumns_3            // mixcolumns (round 3)
+    invoke  ark_sbox                // ark + sbox (round 4)
+    invoke  mixcolumns_0            // mixcolumns (round 4)
+    invoke  ark_sbox                // ark + sbox (round 5)
+    invoke  mixcolumns_1            // mixcolumns (round 5)
+    invoke  ark_sbox                // ark + sbox (round 6)
+    invoke  mixcolumns_2            // mixcolumns (round 6)
+    invoke  ark_sbox                // ark + sbox (round 7)
+    invoke  mixcolumns_3            // mixcolumns (round 7)
+    invoke  ark_sbox                // ark + sbox (round 8)
+    invoke  mixcolumns_0            // mixcolumns (round 8)
+    invoke  ark_sbox                // ark + sbox (round 9)
+    invoke  mixcolumns_1            // mixcolumns (round 9)
+    invoke  ark_sbox                // ark + sbox (round 10)
+    invoke  mixcolumns_2            // mixcolumns (round 10)
+    invoke  ark_sbox                // ark + sbox (round 11)
+    invoke  mixcolumns_3            // mixcolumns (round 11)
+    invoke  ark_sbox                // ark + sbox (round 12)
+    invoke  mixcolumns_0            // mixcolumns (round 12)
+    invoke  ark_sbox                // ark + sbox (round 13)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
     ldr     r14, [sp, #48]          // ---------------------------------------
     ldmia   r14!, {r4,r5,r10,r12}   // 
     eor     r4, r1                  // 
@@ -598,7 +640,7 @@ aes256_encrypt_ffs:
     eor     r9, r0, r3              // 
     eor     r10, r2                 // 
     eor     r11, r12                // ---------------------------------------
-    bl      unpacking               // unpack the internal state
+    invoke  unpacking               // unpack the internal state
     ldrd    r0, r1, [sp, #56]       // restore the addr to store the ciphertext
     add.w   sp, #64                 // restore the stack pointer
     str.w   r4, [r0]                // store the ciphertext
@@ -638,31 +680,31 @@ aes128_encrypt_sfs:
     ldr     r11,[r3, #12]
     ldr.w   r1, [sp, #112]          // load 'rkey' argument from the stack
     str.w   r1, [sp, #48]           // store it there for 'add_round_key'
-    bl      packing                 // pack the 2 input blocks
-    bl      ark_sbox                // ark + sbox (round 0)
-    bl      mixcolumns_0            // mixcolumns (round 0)
-    bl      ark_sbox                // ark + sbox (round 1)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 1)
-    bl      ark_sbox                // ark + sbox (round 2)
-    bl      mixcolumns_0            // mixcolumns (round 2)
-    bl      ark_sbox                // ark + sbox (round 3)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 3)
-    bl      ark_sbox                // ark + sbox (round 4)
-    bl      mixcolumns_0            // mixcolumns (round 4)
-    bl      ark_sbox                // ark + sbox (round 5)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 5)
-    bl      ark_sbox                // ark + sbox (round 6)
-    bl      mixcolumns_0            // mixcolumns (round 6)
-    bl      ark_sbox                // ark + sbox (round 7)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 7)
-    bl      ark_sbox                // ark + sbox (round 8)
-    bl      mixcolumns_0            // mixcolumns (round 8)
-    bl      ark_sbox                // ark + sbox (round 9)
-    bl      double_shiftrows        // to resynchronize with the classical rep
+    invoke  packing                 // pack the 2 input blocks
+    invoke  ark_sbox                // ark + sbox (round 0)
+    invoke  mixcolumns_0            // mixcolumns (round 0)
+    invoke  ark_sbox                // ark + sbox (round 1)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 1)
+    invoke  ark_sbox                // ark + sbox (round 2)
+    invoke  mixcolumns_0            // mixcolumns (round 2)
+    invoke  ark_sbox                // ark + sbox (round 3)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 3)
+    invoke  ark_sbox                // ark + sbox (round 4)
+    invoke  mixcolumns_0            // mixcolumns (round 4)
+    invoke  ark_sbox                // ark + sbox (round 5)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 5)
+    invoke  ark_sbox                // ark + sbox (round 6)
+    invoke  mixcolumns_0            // mixcolumns (round 6)
+    invoke  ark_sbox                // ark + sbox (round 7)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 7)
+    invoke  ark_sbox                // ark + sbox (round 8)
+    invoke  mixcolumns_0            // mixcolumns (round 8)
+    invoke  ark_sbox                // ark + sbox (round 9)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
     ldr     r14, [sp, #48]          // ---------------------------------------
     ldmia   r14!, {r4,r5,r10,r12}   // 
     eor     r4, r1                  // 
@@ -674,7 +716,7 @@ aes128_encrypt_sfs:
     eor     r9, r0, r3              // 
     eor     r10, r2                 // 
     eor     r11, r12                // ---------------------------------------
-    bl      unpacking               // unpack the internal state
+    invoke  unpacking               // unpack the internal state
     ldrd    r0, r1, [sp, #56]       // restore the addr to store the ciphertext
     add.w   sp, #64                 // restore the stack pointer
     str.w   r4, [r0]                // store the ciphertext
@@ -714,41 +756,41 @@ aes256_encrypt_sfs:
     ldr     r11,[r3, #12]
     ldr.w   r1, [sp, #112]          // load 'rkey' argument from the stack
     str.w   r1, [sp, #48]           // store it there for 'add_round_key'
-    bl      packing                 // pack the 2 input blocks
-    bl      ark_sbox                // ark + sbox (round 0)
-    bl      mixcolumns_0            // mixcolumns (round 0)
-    bl      ark_sbox                // ark + sbox (round 1)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 1)
-    bl      ark_sbox                // ark + sbox (round 2)
-    bl      mixcolumns_0            // mixcolumns (round 2)
-    bl      ark_sbox                // ark + sbox (round 3)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 3)
-    bl      ark_sbox                // ark + sbox (round 4)
-    bl      mixcolumns_0            // mixcolumns (round 4)
-    bl      ark_sbox                // ark + sbox (round 5)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 5)
-    bl      ark_sbox                // ark + sbox (round 6)
-    bl      mixcolumns_0            // mixcolumns (round 6)
-    bl      ark_sbox                // ark + sbox (round 7)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 7)
-    bl      ark_sbox                // ark + sbox (round 8)
-    bl      mixcolumns_0            // mixcolumns (round 8)
-    bl      ark_sbox                // ark + sbox (round 9)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 9)
-    bl      ark_sbox                // ark + sbox (round 10)
-    bl      mixcolumns_0            // mixcolumns (round 10)
-    bl      ark_sbox                // ark + sbox (round 11)
-    bl      double_shiftrows        // to resynchronize with the classical rep
-    bl      mixcolumns_3            // mixcolumns (round 11)
-    bl      ark_sbox                // ark + sbox (round 12)
-    bl      mixcolumns_0            // mixcolumns (round 12)
-    bl      ark_sbox                // ark + sbox (round 13)
-    bl      double_shiftrows        // to resynchronize with the classical rep
+    invoke  packing                 // pack the 2 input blocks
+    invoke  ark_sbox                // ark + sbox (round 0)
+    invoke  mixcolumns_0            // mixcolumns (round 0)
+    invoke  ark_sbox                // ark + sbox (round 1)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 1)
+    invoke  ark_sbox                // ark + sbox (round 2)
+    invoke  mixcolumns_0            // mixcolumns (round 2)
+    invoke  ark_sbox                // ark + sbox (round 3)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 3)
+    invoke  ark_sbox                // ark + sbox (round 4)
+    invoke  mixcolumns_0            // mixcolumns (round 4)
+    invoke  ark_sbox                // ark + sbox (round 5)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 5)
+    invoke  ark_sbox                // ark + sbox (round 6)
+    invoke  mixcolumns_0            // mixcolumns (round 6)
+    invoke  ark_sbox                // ark + sbox (round 7)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 7)
+    invoke  ark_sbox                // ark + sbox (round 8)
+    invoke  mixcolumns_0            // mixcolumns (round 8)
+    invoke  ark_sbox                // ark + sbox (round 9)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 9)
+    invoke  ark_sbox                // ark + sbox (round 10)
+    invoke  mixcolumns_0            // mixcolumns (round 10)
+    invoke  ark_sbox                // ark + sbox (round 11)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
+    invoke  mixcolumns_3            // mixcolumns (round 11)
+    invoke  ark_sbox                // ark + sbox (round 12)
+    invoke  mixcolumns_0            // mixcolumns (round 12)
+    invoke  ark_sbox                // ark + sbox (round 13)
+    invoke  double_shiftrows        // to resynchronize with the classical rep
     ldr     r14, [sp, #48]          // ---------------------------------------
     ldmia   r14!, {r4,r5,r10,r12}   // 
     eor     r4, r1                  // 
@@ -760,7 +802,7 @@ aes256_encrypt_sfs:
     eor     r9, r0, r3              // 
     eor     r10, r2                 // 
     eor     r11, r12                // ---------------------------------------
-    bl      unpacking               // unpack the internal state
+    invoke  unpacking               // unpack the internal state
     ldrd    r0, r1, [sp, #56]       // restore the addr to store the ciphertext
     add.w   sp, #64                 // restore the stack pointer
     str.w   r4, [r0]                // store the ciphertext
@@ -425,6 +425,10 @@ aes256_keyschedule_ffs_lut:
     ldr     r5, [r1, #4]
     ldr     r6, [r1, #8]
     ldr     r7, [r1, #12]
+    ldr     r8, [r1, #16]
+    ldr     r9, [r1, #20]
+    ldr     r10, [r1, #24]
+    ldr     r11, [r1, #28]
     adr     r3, AES_Sbox_compact        // load the sbox LUT address in r3
     movw    r2, #0x01                   // 1st const
     bl      aes256_keyschedule_rfunc_0  // 1st round
@@ -658,6 +662,10 @@ aes256_keyschedule_sfs_lut:
     ldr     r5, [r1, #4]
     ldr     r6, [r1, #8]
     ldr     r7, [r1, #12]
+    ldr     r8, [r1, #16]
+    ldr     r9, [r1, #20]
+    ldr     r10, [r1, #24]
+    ldr     r11, [r1, #28]
     adr     r3, AES_Sbox_compact        // load the sbox LUT address in r3
     movw    r2, #0x01                   // 1st const
     bl      aes256_keyschedule_rfunc_0  // 1st round
@@ -0,0 +1,32 @@
+#ifndef AES_MASKING_H_
+#define AES_MASKING_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* 1st-order masked fixsliced encryption functions */
+void aes128_encrypt_ffs(unsigned char ctext0[16], unsigned char ctext1[16],
+				const unsigned char ptext0[16], const unsigned char ptext1[16],
+				const uint32_t rkeys[121]);
+void aes128_encrypt_sfs(unsigned char ctext0[16], unsigned char ctext1[16],
+				const unsigned char ptext0[16], const unsigned char ptext1[16],
+				const uint32_t rkeys[121]);
+
+/* 1st-order masked fixsliced key schedule functions */
+void aes128_keyschedule_ffs(uint32_t rkeys[121], const unsigned char key0[16],
+				const unsigned char key1[16]);
+void aes128_keyschedule_sfs(uint32_t rkeys[121], const unsigned char key0[16],
+				const unsigned char key1[16]);
+
+/* 1st-order masked barrel-shiftrows encryption function (8 blocks) */
+void aes128_encrypt_bsr(unsigned char ctext[128], const unsigned char ptext[128],
+				const uint32_t rkeys[385]);
+
+/* 1st-order masked barrel-shiftrows key schedule function */
+void aes128_keyschedule_bsr(uint32_t rkeys[385], const unsigned char key[16]);
+
+/* Randomness source used to generate the masks */
+typedef void (*masking_rng_t)(uint32_t* out, size_t nwords);
+void masking_set_rng(masking_rng_t rng);
+
+#endif 	// AES_MASKING_H_
@@ -0,0 +1,523 @@
+/******************************************************************************
+* 1st-order masked fixsliced implementation of AES-128 (encryption-only) in C.
+* Reference counterpart of 'armcortexm/1storder_masking' that can be built and
+* benchmarked on any platform.
+*
+* The masking scheme is the one described in "Masking AES with 2 random bits"
+* available at https://eprint.iacr.org/2018/1007.
+* See supplementary material at https://github.com/LaurenDM/TwoRandomBits
+*
+* All bytes within the internal state are masked in the following way:
+* m1 || m0^m1 || m0^m1 || m0 || m0 || m1 || m0 || m1 where m0, m1 are random
+* bits (one pair per block). Because each round key is masked using the same
+* masking scheme with different random bits, the masks are updated at every
+* AddRoundKey operation.
+*
+* Note that a C compiler is free to reorder the operations of the masked
+* S-box, so that this implementation should be seen as a functional reference
+* rather than as a side-channel protected implementation.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+
+/******************************************************************************
+* Packs two 128-bit input blocs in0, in1 into the 256-bit internal state out 
+* where the bits are packed as follows:
+* out[0] = b_24 b_56 b_88 b_120 || ... || b_0 b_32 b_64 b_96
+* out[1] = b_25 b_57 b_89 b_121 || ... || b_1 b_33 b_65 b_97
+* out[2] = b_26 b_58 b_90 b_122 || ... || b_2 b_34 b_66 b_98
+* out[3] = b_27 b_59 b_91 b_123 || ... || b_3 b_35 b_67 b_99
+* out[4] = b_28 b_60 b_92 b_124 || ... || b_4 b_36 b_68 b_100
+* out[5] = b_29 b_61 b_93 b_125 || ... || b_5 b_37 b_69 b_101
+* out[6] = b_30 b_62 b_94 b_126 || ... || b_6 b_38 b_70 b_102
+* out[7] = b_31 b_63 b_95 b_127 || ... || b_7 b_39 b_71 b_103
+******************************************************************************/
+inline void packing(uint32_t* out, const unsigned char* in0,
+		const unsigned char* in1) {
+	uint32_t tmp;
+	PROFILE_BEGIN();
+	out[0] = LE_LOAD_32(in0);
+	out[1] = LE_LOAD_32(in1);
+	out[2] = LE_LOAD_32(in0 + 4);
+	out[3] = LE_LOAD_32(in1 + 4);
+	out[4] = LE_LOAD_32(in0 + 8);
+	out[5] = LE_LOAD_32(in1 + 8);
+	out[6] = LE_LOAD_32(in0 + 12);
+	out[7] = LE_LOAD_32(in1 + 12);
+	SWAPMOVE(out[1], out[0], 0x55555555, 1);
+	SWAPMOVE(out[3], out[2], 0x55555555, 1);
+	SWAPMOVE(out[5], out[4], 0x55555555, 1);
+	SWAPMOVE(out[7], out[6], 0x55555555, 1);
+	SWAPMOVE(out[2], out[0], 0x33333333, 2);
+	SWAPMOVE(out[3], out[1], 0x33333333, 2);
+	SWAPMOVE(out[6], out[4], 0x33333333, 2);
+	SWAPMOVE(out[7], out[5], 0x33333333, 2);
+	SWAPMOVE(out[4], out[0], 0x0f0f0f0f, 4);
+	SWAPMOVE(out[5], out[1], 0x0f0f0f0f, 4);
+	SWAPMOVE(out[6], out[2], 0x0f0f0f0f, 4);
+	SWAPMOVE(out[7], out[3], 0x0f0f0f0f, 4);
+	PROFILE_END(PROFILE_PACKING);
+}
+
+/******************************************************************************
+* Unpacks the 256-bit internal state in two 128-bit blocs out0, out1.
+******************************************************************************/
+static inline void unpacking(unsigned char* out0, unsigned char* out1, uint32_t* in) {
+	uint32_t tmp;
+	PROFILE_BEGIN();
+	SWAPMOVE(in[4], in[0], 0x0f0f0f0f, 4);
+	SWAPMOVE(in[5], in[1], 0x0f0f0f0f, 4);
+	SWAPMOVE(in[6], in[2], 0x0f0f0f0f, 4);
+	SWAPMOVE(in[7], in[3], 0x0f0f0f0f, 4);
+	SWAPMOVE(in[2], in[0], 0x33333333, 2);
+	SWAPMOVE(in[3], in[1], 0x33333333, 2);
+	SWAPMOVE(in[6], in[4], 0x33333333, 2);
+	SWAPMOVE(in[7], in[5], 0x33333333, 2);
+	SWAPMOVE(in[1], in[0], 0x55555555, 1);
+	SWAPMOVE(in[3], in[2], 0x55555555, 1);
+	SWAPMOVE(in[5], in[4], 0x55555555, 1);
+	SWAPMOVE(in[7], in[6], 0x55555555, 1);
+	LE_STORE_32(out0, in[0]);
+	LE_STORE_32(out0 + 4, in[2]);
+	LE_STORE_32(out0 + 8, in[4]);
+	LE_STORE_32(out0 + 12, in[6]);
+	LE_STORE_32(out1, in[1]);
+	LE_STORE_32(out1 + 4, in[3]);
+	LE_STORE_32(out1 + 8, in[5]);
+	LE_STORE_32(out1 + 12, in[7]);
+	PROFILE_END(PROFILE_UNPACKING);
+}
+
+/******************************************************************************
+* Applies the masks m0, m1, m0^m1 on the internal state according to the
+* masking scheme (also used for unmasking).
+******************************************************************************/
+inline void mask_state(uint32_t* state, const uint32_t* masks) {
+	state[0] ^= masks[1];
+	state[1] ^= masks[0];
+	state[2] ^= masks[1];
+	state[3] ^= masks[0];
+	state[4] ^= masks[0];
+	state[5] ^= masks[2];
+	state[6] ^= masks[2];
+	state[7] ^= masks[1];
+}
+
+/******************************************************************************
+* XOR the round key to the internal state. Each round key is stored as the 3
+* masks km0, km1, km0^km1 followed by the 8 masked words, so that the masks of
+* the internal state are updated accordingly.
+******************************************************************************/
+static inline void ark(uint32_t* state, uint32_t* masks, const uint32_t* rkey) {
+	PROFILE_BEGIN();
+	UNROLL_WORDS
+	for(int i = 0; i < 3; i++)
+		masks[i] ^= rkey[i];
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++)
+		state[i] ^= rkey[i+3];
+	PROFILE_END(PROFILE_ARK);
+}
+
+/******************************************************************************
+* Masked AND gadget: returns x & y masked with mx, where x, y are masked with
+* mx, my (mx != my). Relies on the variable m01 = m0 | m1.
+******************************************************************************/
+#define MASKED_AND(x, mx, y, my)									\
+	((((x) & (y)) ^ (((x) & (my)) ^ (my))) ^ (((mx) & (y)) ^ m01))
+
+/******************************************************************************
+* 1st-order masked implementation of the S-box in a bitsliced manner.
+* Credits to https://github.com/LaurenDM/TwoRandomBits.
+* Based on the Boyar-Peralta circuit where the internal values are masked with
+* m0, m1 or m0^m1 so that each AND gate can be computed from a single pair of
+* random bits. Note that the 4 NOT are moved to the key schedule, as in the
+* unmasked implementation.
+******************************************************************************/
+inline void sbox(uint32_t* state, const uint32_t* masks) {
+	PROFILE_BEGIN();
+	uint32_t m0 = masks[0], m1 = masks[1], m2 = masks[2];
+	uint32_t m01 = m0 | m1;
+	uint32_t y14, y13, hy13, y9, hy9, y8, t0, y1, hy1, y4, hy4, y12, y2, y5,
+		y3, hy3, t1, y15, hy15, y20, y6, hy6, y10, hy10, y11, hy11, y7, y17,
+		y19, y16, y21, y18, t2, t3, t4, t5, t6, t7, t8, t9, t10, t11, t12,
+		t13, t14, t15, t16, t17, t18, t19, t20, t21, t22, t23, ht23, t24,
+		ht24, t25, t26, t27, t28, t29, t30, t31, t32, t33, ht33, t34, t35,
+		t36, t37, t38, t39, t40, t41, t42, t43, t44, t45, z0, z1, z2, z3, z4,
+		z5, z6, z7, z8, z9, z10, z11, z12, z13, z14, z15, z16, z17, tc1, tc2,
+		tc3, tc4, tc5, tc6, tc7, tc8, tc9, tc10, tc11, tc12, tc13, tc14, S3,
+		tc16, tc17, tc18, S7, tc20, tc21, S4, S1, tc26, S2, S5;
+	y14			= state[3] ^ state[5];
+	y13			= state[0] ^ state[6];
+	hy13		= y13 ^ m1;
+	y9			= state[0] ^ state[3];
+	hy9			= y9 ^ m1;
+	y8			= state[0] ^ state[5];
+	t0			= state[1] ^ state[2];
+	y1			= t0 ^ state[7];
+	hy1			= y1 ^ m1;
+	y4			= hy1 ^ state[3];
+	hy4			= y4 ^ m0;
+	y12			= y13 ^ y14;
+	y2			= y1 ^ state[0];
+	y5			= y1 ^ state[6];
+	y3			= y5 ^ y8;
+	hy3			= y3 ^ m1;
+	t1			= state[4] ^ y12;
+	y15			= t1 ^ state[5];
+	hy15		= y15 ^ m1;
+	y20			= t1 ^ state[1];
+	y6			= y15 ^ state[7];
+	hy6			= y6 ^ m0;
+	y10			= y15 ^ t0;
+	hy10		= y10 ^ m0;
+	y11			= y20 ^ hy9;
+	hy11		= y11 ^ m0;
+	y7			= state[7] ^ hy11;
+	y17			= y10 ^ hy11;
+	y19			= y10 ^ y8;
+	y16			= t0 ^ y11;
+	y21			= hy13 ^ y16;
+	y18			= state[0] ^ y16;
+	t2			= MASKED_AND(y12, m2, y15, m0);
+	t3			= MASKED_AND(hy3, m0, y6, m2);
+	t4			= t3 ^ t2;
+	t5			= MASKED_AND(state[7], m1, hy4, m2);
+	t6			= t5 ^ t2;
+	t7			= MASKED_AND(hy13, m2, y16, m0);
+	t8			= MASKED_AND(y1, m0, y5, m1);
+	t9			= t8 ^ t7;
+	t10			= MASKED_AND(y7, m0, y2, m2);
+	t11			= t10 ^ t7;
+	t12			= MASKED_AND(y11, m1, y9, m2);
+	t13			= MASKED_AND(y17, m0, y14, m1);
+	t14			= t13 ^ t12;
+	t15			= MASKED_AND(y8, m0, y10, m1);
+	t16			= t15 ^ t12;
+	t17			= t4 ^ y20;
+	t18			= t6 ^ t16;
+	t19			= t9 ^ t14;
+	t20			= t11 ^ t16;
+	t21			= t17 ^ t14;
+	t22			= t18 ^ y19;
+	t23			= t19 ^ y21;
+	ht23		= t23 ^ m0;
+	t24			= t20 ^ y18;
+	ht24		= t24 ^ m0;
+	t25			= t21 ^ t22;
+	t26			= MASKED_AND(t23, m2, t21, m1);
+	t27			= t24 ^ t26;
+	t28			= MASKED_AND(t25, m2, t27, m0);
+	t29			= t28 ^ t22;
+	t30			= t23 ^ t24;
+	t31			= t22 ^ t26;
+	t32			= MASKED_AND(t30, m0, t31, m1);
+	t33			= t32 ^ t24;
+	ht33		= t33 ^ m0;
+	t34			= ht23 ^ t33;
+	t35			= t27 ^ t33;
+	t36			= MASKED_AND(t35, m1, ht24, m2);
+	t37			= t36 ^ t34;
+	t38			= t27 ^ t36;
+	t39			= MASKED_AND(t29, m1, t38, m2);
+	t40			= t25 ^ t39;
+	t41			= t40 ^ t37;
+	t42			= t29 ^ t33;
+	t43			= t29 ^ t40;
+	t44			= ht33 ^ t37;
+	t45			= t42 ^ t41;
+	z0			= MASKED_AND(t44, m0, hy15, m2);
+	z1			= MASKED_AND(hy6, m1, t37, m2);
+	z2			= MASKED_AND(t33, m2, state[7], m1);
+	z3			= MASKED_AND(y16, m0, t43, m2);
+	z4			= MASKED_AND(hy1, m2, t40, m0);
+	z5			= MASKED_AND(t29, m1, y7, m0);
+	z6			= MASKED_AND(y11, m1, t42, m0);
+	z7			= MASKED_AND(y17, m0, t45, m2);
+	z8			= MASKED_AND(hy10, m2, t41, m1);
+	z9			= MASKED_AND(t44, m0, y12, m2);
+	z10			= MASKED_AND(t37, m2, hy3, m0);
+	z11			= MASKED_AND(t33, m2, y4, m1);
+	z12			= MASKED_AND(t43, m2, y13, m0);
+	z13			= MASKED_AND(y5, m1, t40, m0);
+	z14			= MASKED_AND(t29, m1, y2, m2);
+	z15			= MASKED_AND(y9, m2, t42, m0);
+	z16			= MASKED_AND(y14, m1, t45, m2);
+	z17			= MASKED_AND(t41, m1, y8, m0);
+	tc1			= z15 ^ z16;
+	tc2			= z10 ^ tc1;
+	tc3			= z9 ^ tc2;
+	tc4			= z0 ^ z2;
+	tc5			= z1 ^ z0;
+	tc6			= z3 ^ z4;
+	tc7			= z12 ^ tc4;
+	tc8			= z7 ^ tc6;
+	tc9			= z8 ^ tc7;
+	tc10		= tc8 ^ tc9;
+	tc11		= tc6 ^ tc5;
+	tc12		= z3 ^ z5;
+	tc13		= z13 ^ tc1;
+	tc14		= tc4 ^ tc12;
+	S3			= tc3 ^ tc11;
+	tc16		= z6 ^ tc8;
+	tc17		= z14 ^ tc10;
+	tc18		= tc13 ^ tc14;
+	S7			= z12 ^ tc18;
+	tc20		= z15 ^ tc16;
+	tc21		= tc2 ^ z11;
+	state[0]	= tc3 ^ tc16;
+	state[6]	= tc10 ^ tc18;
+	S4			= tc14 ^ S3;
+	S1			= S3 ^ tc16;
+	tc26		= tc17 ^ tc20;
+	S2			= tc26 ^ z17;
+	S5			= tc21 ^ tc17;
+	state[2]	= S2 ^ m0;
+	state[4]	= S4 ^ m1;
+	state[1]	= S1 ^ m1;
+	state[3]	= S3 ^ m2;
+	state[5]	= S5 ^ m0;
+	state[7]	= S7 ^ m2;
+	PROFILE_END(PROFILE_SBOX);
+}
+
+/******************************************************************************
+* Applies the ShiftRows transformation twice (i.e. SR^2) on the internal state.
+******************************************************************************/
+static inline void double_shiftrows(uint32_t* state) {
+    uint32_t tmp;
+	PROFILE_BEGIN();
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++)
+        SWAPMOVE(state[i], state[i], 0x0f000f00, 4);
+	PROFILE_END(PROFILE_SHIFTROWS);
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations, it is used for rounds i s.t. (i%4) == 0.
+* For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 0.
+******************************************************************************/
+static inline void mixcolumns_0(uint32_t* state) {
+	uint32_t t0, t1, t2, t3, t4;
+	PROFILE_BEGIN();
+	t3 = ROR(BYTE_ROR_6(state[0]),8);
+	t0 = state[0] ^ t3;
+	t1 = ROR(BYTE_ROR_6(state[7]),8);
+	t2 = state[7] ^ t1;
+	state[7] = ROR(BYTE_ROR_4(t2),16) ^ t1 ^ t0;
+	t1 = ROR(BYTE_ROR_6(state[6]),8);
+	t4 = t1 ^ state[6];
+	state[6] = t2 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_6(state[5]),8);
+	t2 = t1 ^ state[5];
+	state[5] = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	t1 = ROR(BYTE_ROR_6(state[4]),8);
+	t4 = t1 ^ state[4];
+	state[4] = t2 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_6(state[3]),8);
+	t2 = t1 ^ state[3];
+	state[3] = t4 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	t1 = ROR(BYTE_ROR_6(state[2]),8);
+	t4 = t1 ^ state[2];
+	state[2] = t2 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_6(state[1]),8);
+	t2 = t1 ^ state[1];
+	state[1] = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	state[0] = t2 ^ t3 ^ ROR(BYTE_ROR_4(t0),16);
+	PROFILE_END(PROFILE_MIXCOLUMNS);
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations only, for round i s.t. (i%4) == 1.
+******************************************************************************/
+static inline void mixcolumns_1(uint32_t* state) {
+	uint32_t t0, t1, t2;
+	PROFILE_BEGIN();
+	t0 = state[0] ^ ROR(BYTE_ROR_4(state[0]),8);
+	t1 = state[7] ^ ROR(BYTE_ROR_4(state[7]),8);
+	t2 = state[6];
+	state[6] = t1 ^ t0;
+	state[7] ^= state[6] ^ ROR(t1,16);
+	t1 =  ROR(BYTE_ROR_4(t2),8);
+	state[6] ^= t1;
+	t1 ^= t2;
+	state[6] ^= ROR(t1,16);
+	t2 = state[5];
+	state[5] = t1;
+	t1 =  ROR(BYTE_ROR_4(t2),8);
+	state[5] ^= t1;
+	t1 ^= t2;
+	state[5] ^= ROR(t1,16);
+	t2 = state[4];
+	state[4] = t1 ^ t0;
+	t1 =  ROR(BYTE_ROR_4(t2),8);
+	state[4] ^= t1;
+	t1 ^= t2;
+	state[4] ^= ROR(t1,16);
+	t2 = state[3];
+	state[3] = t1 ^ t0;
+	t1 =  ROR(BYTE_ROR_4(t2),8);
+	state[3] ^= t1;
+	t1 ^= t2;
+	state[3] ^= ROR(t1,16);
+	t2 = state[2];
+	state[2] = t1;
+	t1 = ROR(BYTE_ROR_4(t2),8);
+	state[2] ^= t1;
+	t1 ^= t2;
+	state[2] ^= ROR(t1,16);
+	t2 = state[1];
+	state[1] = t1;
+	t1 = ROR(BYTE_ROR_4(t2),8);
+	state[1] ^= t1;
+	t1 ^= t2;
+	state[1] ^= ROR(t1,16);
+	t2 = state[0];
+	state[0] = t1;
+	t1 = ROR(BYTE_ROR_4(t2),8);
+	state[0] ^= t1;
+	t1 ^= t2;
+	state[0] ^= ROR(t1,16);
+	PROFILE_END(PROFILE_MIXCOLUMNS);
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations only, for rounds i s.t. (i%4) == 2.
+******************************************************************************/
+static inline void mixcolumns_2(uint32_t* state) {
+	uint32_t t0, t1, t2, t3, t4;
+	PROFILE_BEGIN();
+	t3 = ROR(BYTE_ROR_2(state[0]),8);
+	t0 = state[0] ^ t3;
+	t1 = ROR(BYTE_ROR_2(state[7]),8);
+	t2 = state[7] ^ t1;
+	state[7] = ROR(BYTE_ROR_4(t2),16) ^ t1 ^ t0;
+	t1 = ROR(BYTE_ROR_2(state[6]),8);
+	t4 = t1 ^ state[6];
+	state[6] = t2 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_2(state[5]),8);
+	t2 = t1 ^ state[5];
+	state[5] = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	t1 = ROR(BYTE_ROR_2(state[4]),8);
+	t4 = t1 ^ state[4];
+	state[4] = t2 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_2(state[3]),8);
+	t2 = t1 ^ state[3];
+	state[3] = t4 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	t1 = ROR(BYTE_ROR_2(state[2]),8);
+	t4 = t1 ^ state[2];
+	state[2] = t2 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_2(state[1]),8);
+	t2 = t1 ^ state[1];
+	state[1] = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	state[0] = t2 ^ t3 ^ ROR(BYTE_ROR_4(t0),16);
+	PROFILE_END(PROFILE_MIXCOLUMNS);
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations, it is used for rounds i s.t. (i%4) == 3.
+* For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 1.
+* Based on Käsper-Schwabe, similar to https://github.com/Ko-/aes-armcortexm.
+******************************************************************************/
+static inline void mixcolumns_3(uint32_t* state) {
+	uint32_t t0, t1, t2;
+	PROFILE_BEGIN();
+	t0 = state[7] ^ ROR(state[7],8);
+	t2 = state[0] ^ ROR(state[0],8);
+	state[7] = t2 ^ ROR(state[7], 8) ^ ROR(t0, 16);
+	t1 = state[6] ^ ROR(state[6],8);
+	state[6] = t0 ^ t2 ^ ROR(state[6], 8) ^ ROR(t1,16);
+	t0 = state[5] ^ ROR(state[5],8);
+	state[5] = t1 ^ ROR(state[5],8) ^ ROR(t0,16);
+	t1 = state[4] ^ ROR(state[4],8);
+	state[4] = t0 ^ t2 ^ ROR(state[4],8) ^ ROR(t1,16);
+	t0 = state[3] ^ ROR(state[3],8);
+	state[3] = t1 ^ t2 ^ ROR(state[3],8) ^ ROR(t0,16);
+	t1 = state[2] ^ ROR(state[2],8);
+	state[2] = t0 ^ ROR(state[2],8) ^ ROR(t1,16);
+	t0 = state[1] ^ ROR(state[1],8);
+	state[1] = t1 ^ ROR(state[1],8) ^ ROR(t0,16);
+	state[0] = t0 ^ ROR(state[0],8) ^ ROR(t2,16);
+	PROFILE_END(PROFILE_MIXCOLUMNS);
+}
+
+/******************************************************************************
+* 1st-order masked fully-fixsliced AES-128 encryption.
+* Two 128-bit blocks ptext0, ptext1 are encrypted into ctext0, ctext1 without
+* any operating mode. The masked round keys are assumed to be pre-computed.
+* 4 random bits are consumed per call.
+******************************************************************************/
+void aes128_encrypt_ffs(unsigned char* ctext0, unsigned char* ctext1,
+					const unsigned char* ptext0, const unsigned char* ptext1,
+					const uint32_t* rkeys_ffs) {
+	uint32_t state[8]; 					// 256-bit internal state
+	uint32_t masks[3]; 					// m0, m1, m0^m1
+	uint32_t r = random_nibble();
+	packing(state, ptext0, ptext1);		// packs into bitsliced representation
+	EXPAND_MASKS(masks, r);
+	mask_state(state, masks); 			// masking
+	UNROLL_ROUNDS
+	for(int i = 0; i < 88; i += 44) { 	// loop over quadruple rounds
+		ark(state, masks, rkeys_ffs + i);
+		sbox(state, masks);
+		mixcolumns_0(state);
+		ark(state, masks, rkeys_ffs + i + 11);
+		sbox(state, masks);
+		mixcolumns_1(state);
+		ark(state, masks, rkeys_ffs + i + 22);
+		sbox(state, masks);
+		mixcolumns_2(state);
+		ark(state, masks, rkeys_ffs + i + 33);
+		sbox(state, masks);
+		mixcolumns_3(state);
+	}
+	ark(state, masks, rkeys_ffs + 88);
+	sbox(state, masks);
+	mixcolumns_0(state);
+	ark(state, masks, rkeys_ffs + 99);
+	sbox(state, masks);
+	double_shiftrows(state); 			// resynchronization
+	ark(state, masks, rkeys_ffs + 110);
+	mask_state(state, masks); 			// unmasking
+	unpacking(ctext0, ctext1, state);	// unpacks the state to the output
+}
+
+/******************************************************************************
+* 1st-order masked semi-fixsliced AES-128 encryption.
+* Two 128-bit blocks ptext0, ptext1 are encrypted into ctext0, ctext1 without
+* any operating mode. The masked round keys are assumed to be pre-computed.
+* 4 random bits are consumed per call.
+******************************************************************************/
+void aes128_encrypt_sfs(unsigned char* ctext0, unsigned char* ctext1,
+					const unsigned char* ptext0, const unsigned char* ptext1,
+					const uint32_t* rkeys_sfs) {
+	uint32_t state[8]; 					// 256-bit internal state
+	uint32_t masks[3]; 					// m0, m1, m0^m1
+	uint32_t r = random_nibble();
+	packing(state, ptext0, ptext1); 	// packs into bitsliced representation
+	EXPAND_MASKS(masks, r);
+	mask_state(state, masks); 			// masking
+	UNROLL_ROUNDS
+	for(int i = 0; i < 5; i++) { 		// loop over double rounds
+		ark(state, masks, rkeys_sfs + i*22);
+		sbox(state, masks);
+		mixcolumns_0(state);
+		ark(state, masks, rkeys_sfs + i*22 + 11);
+		sbox(state, masks);
+		double_shiftrows(state);
+		if (i != 4) 					// No MixColumns in the last round
+			mixcolumns_3(state);
+	}
+	ark(state, masks, rkeys_sfs + 110); // last AddRoundKey
+	mask_state(state, masks); 			// unmasking
+	unpacking(ctext0, ctext1, state); 	// unpacks the state to the output
+}
@@ -0,0 +1,283 @@
+/******************************************************************************
+* 1st-order masked bitsliced implementation of AES-128 (encryption-only) in C
+* using the barrel-shiftrows representation. Reference counterpart of
+* 'aes128_encrypt_bsr' in 'armcortexm/1storder_masking'.
+*
+* The masking scheme is the same as for the fixsliced implementations (see
+* 'aes_encrypt.c'): each byte of the internal state is masked as follows
+* m1 || m0^m1 || m0^m1 || m0 || m0 || m1 || m0 || m1 where m0, m1 are random
+* bits (one pair per block). Since 8 blocks are encrypted in parallel, the
+* randomness generation and the mask updates are amortized over 4 times more
+* blocks than with the fixsliced representations. As ShiftRows and MixColumns
+* are linear and all bytes of a given slice share the same mask, they leave
+* the masks unchanged.
+*
+* Note that a C compiler is free to reorder the masked operations, so that this
+* implementation should be seen as a functional reference rather than as a
+* side-channel protected implementation.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+
+/******************************************************************************
+* Packing routine to rearrange the 8 16-byte blocs (128 bytes in total) into 
+* the barrel-shiftrows bitsliced representation:
+* out[0] = b_0 b_32 b_64 b_96
+* ...
+* out[31] = b_31 b_63 b_95 b_127
+******************************************************************************/
+static inline void packing_bsr(uint32_t* out, const unsigned char* in) {
+	uint32_t tmp;
+	PROFILE_BEGIN();
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) {
+		out[i] 		= LE_LOAD_32(in + i*16);
+		out[i+8] 	= LE_LOAD_32(in + i*16 + 4);
+		out[i+16] 	= LE_LOAD_32(in + i*16 + 8);
+		out[i+24] 	= LE_LOAD_32(in + i*16 + 12);
+		SWAPMOVE(out[i], out[i+8], 0x00ff00ff, 8);
+		SWAPMOVE(out[i+16], out[i+24], 0x00ff00ff, 8);
+	}
+	UNROLL_WORDS
+	for(int i = 0; i < 16; i++)
+		SWAPMOVE(out[i], out[i+16], 0x0000ffff, 16);
+	UNROLL_WORDS
+	for(int i = 0; i < 32; i+=8) {
+		SWAPMOVE(out[i+1], out[i], 	0x55555555, 1);
+		SWAPMOVE(out[i+3], out[i+2],0x55555555, 1);
+		SWAPMOVE(out[i+5], out[i+4],0x55555555, 1);
+		SWAPMOVE(out[i+7], out[i+6],0x55555555, 1);
+		SWAPMOVE(out[i+2], out[i], 	0x33333333, 2);
+		SWAPMOVE(out[i+3], out[i+1],0x33333333, 2);
+		SWAPMOVE(out[i+6], out[i+4],0x33333333, 2);
+		SWAPMOVE(out[i+7], out[i+5],0x33333333, 2);
+		SWAPMOVE(out[i+4], out[i], 	0x0f0f0f0f, 4);
+		SWAPMOVE(out[i+5], out[i+1],0x0f0f0f0f, 4);
+		SWAPMOVE(out[i+6], out[i+2],0x0f0f0f0f, 4);
+		SWAPMOVE(out[i+7], out[i+3],0x0f0f0f0f, 4);
+	}
+	PROFILE_END(PROFILE_PACKING);
+}
+
+/******************************************************************************
+* Unpacking routine to store the internal state in a 128-byte array.
+******************************************************************************/
+static inline void unpacking_bsr(unsigned char* out, uint32_t* in) {
+	uint32_t tmp;
+	PROFILE_BEGIN();
+	UNROLL_WORDS
+	for(int i = 0; i < 32; i+=8) {
+		SWAPMOVE(in[i+1], in[i],	0x55555555, 1);
+		SWAPMOVE(in[i+3], in[i+2],	0x55555555, 1);
+		SWAPMOVE(in[i+5], in[i+4],	0x55555555, 1);
+		SWAPMOVE(in[i+7], in[i+6],	0x55555555, 1);
+		SWAPMOVE(in[i+2], in[i], 	0x33333333, 2);
+		SWAPMOVE(in[i+3], in[i+1],	0x33333333, 2);
+		SWAPMOVE(in[i+6], in[i+4],	0x33333333, 2);
+		SWAPMOVE(in[i+7], in[i+5],	0x33333333, 2);
+		SWAPMOVE(in[i+4], in[i], 	0x0f0f0f0f, 4);
+		SWAPMOVE(in[i+5], in[i+1],	0x0f0f0f0f, 4);
+		SWAPMOVE(in[i+6], in[i+2],	0x0f0f0f0f, 4);
+		SWAPMOVE(in[i+7], in[i+3],	0x0f0f0f0f, 4);
+	}
+	UNROLL_WORDS
+	for(int i = 0; i < 16; i++)
+		SWAPMOVE(in[i], in[i+16], 	0x0000ffff, 16);
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) {
+		SWAPMOVE(in[i], in[i+8], 	0x00ff00ff, 8);
+		SWAPMOVE(in[i+16], in[i+24],0x00ff00ff, 8);
+		LE_STORE_32(out+i*16, 	in[i]);
+		LE_STORE_32(out+i*16+4, in[i+8]);
+		LE_STORE_32(out+i*16+8, in[i+16]);
+		LE_STORE_32(out+i*16+12,in[i+24]);
+	}
+	PROFILE_END(PROFILE_UNPACKING);
+}
+
+/******************************************************************************
+* ShiftRows on the entire 1024-bit internal state.
+******************************************************************************/
+static inline void shiftrows(uint32_t* state) {
+	PROFILE_BEGIN();
+	UNROLL_WORDS
+	for(int i = 8; i < 16; i++) 		// shifts the 2nd row
+		state[i] = ROR(state[i],8); 	// shifts the 2nd row
+	UNROLL_WORDS
+	for(int i = 16; i < 24; i++) 		// shifts the 3rd row
+		state[i] = ROR(state[i],16); 	// shifts the 3rd row
+	UNROLL_WORDS
+	for(int i = 24; i < 32; i++) 		// shifts the 4th row
+		state[i] = ROR(state[i],24); 	// shifts the 4th row
+	PROFILE_END(PROFILE_SHIFTROWS);
+}
+
+/******************************************************************************
+* MixColumns on the entire 1024-bit internal state.
+******************************************************************************/
+static inline void mixcolumns(uint32_t* state) {
+	uint32_t tmp2_0, tmp2_1, tmp2_2, tmp2_3;
+	uint32_t tmp, tmp_bis, tmp0_0, tmp0_1, tmp0_2, tmp0_3;
+	uint32_t tmp1_0, tmp1_1, tmp1_2, tmp1_3;
+	PROFILE_BEGIN();
+	tmp2_0 = state[0] ^ state[8];
+	tmp2_1 = state[8] ^ state[16];
+	tmp2_2 = state[16] ^ state[24];
+	tmp2_3 = state[24] ^ state[0];
+	tmp0_0 = state[7] ^ state[15];
+	tmp0_1 = state[15] ^ state[23];
+	tmp0_2 = state[23] ^ state[31];
+	tmp0_3 = state[31]^ state[7];
+	tmp = state[7];
+	state[7] = tmp2_0 ^ tmp0_2 ^ state[15];
+	state[15] = tmp2_1 ^ tmp0_2 ^ tmp;
+	tmp = state[23];
+	state[23] = tmp2_2 ^ tmp0_0 ^ state[31];
+	state[31] = tmp2_3 ^ tmp0_0 ^ tmp;
+	tmp1_0 = state[6] ^ state[14];
+	tmp1_1 = state[14] ^ state[22];
+	tmp1_2 = state[22] ^ state[30];
+	tmp1_3 = state[30] ^ state[6]; 
+	tmp = state[6];
+	state[6] = tmp0_0 ^ tmp2_0 ^ state[14] ^ tmp1_2;
+	tmp_bis = state[14];
+	state[14] =  tmp0_1 ^ tmp2_1 ^ tmp1_2 ^ tmp;
+	tmp = state[22];
+	state[22] = tmp0_2 ^ tmp2_2 ^ tmp1_3 ^ tmp_bis;
+	state[30] =  tmp0_3 ^ tmp2_3 ^ tmp1_0 ^ tmp;
+	tmp0_0 = state[5] ^ state[13];
+	tmp0_1 = state[13] ^ state[21];
+	tmp0_2 = state[21] ^ state[29];
+	tmp0_3 = state[29]^ state[5];
+	tmp = state[5];
+	state[5] = tmp1_0 ^ tmp0_1 ^ state[29];
+	tmp_bis = state[13];
+	state[13] = tmp1_1 ^ tmp0_2 ^ tmp;
+	tmp = state[21];
+	state[21] =  tmp1_2 ^ tmp0_3 ^ tmp_bis;
+	state[29] = tmp1_3 ^ tmp0_0 ^ tmp;
+	tmp1_0 = state[4] ^ state[12];
+	tmp1_1 = state[12] ^ state[20];
+	tmp1_2 = state[20] ^ state[28];
+	tmp1_3 = state[28] ^ state[4];
+	tmp = state[4];
+	state[4] = tmp0_0 ^ tmp2_0 ^ tmp1_1 ^ state[28];	
+	tmp_bis = state[12];
+	state[12] = tmp0_1 ^ tmp2_1 ^ tmp1_2 ^ tmp;
+	tmp = state[20];
+	state[20] = tmp0_2 ^ tmp2_2 ^ tmp1_3 ^ tmp_bis;
+	state[28] = tmp0_3 ^ tmp2_3 ^ tmp1_0 ^ tmp;
+	tmp0_0 = state[3] ^ state[11];
+	tmp0_1 = state[11] ^ state[19];
+	tmp0_2 = state[19] ^ state[27];
+	tmp0_3 = state[27]^ state[3];
+	tmp = state[3];
+	state[3] = tmp1_0 ^ tmp2_0 ^ tmp0_1 ^ state[27];
+	tmp_bis = state[11];
+	state[11] = tmp1_1 ^ tmp2_1 ^ tmp0_2 ^ tmp;
+	tmp = state[19];
+	state[19] = tmp1_2 ^ tmp2_2 ^ tmp0_3 ^ tmp_bis;
+	state[27] =  tmp1_3 ^ tmp2_3 ^ tmp0_0 ^ tmp;
+	tmp1_0 = state[2] ^ state[10];
+	tmp1_1 = state[10] ^ state[18];
+	tmp1_2 = state[18] ^ state[26];
+	tmp1_3 = state[26] ^ state[2];
+	tmp = state[2];
+	state[2] = tmp0_0 ^ tmp1_1 ^ state[26];
+	tmp_bis = state[10];
+	state[10] = tmp0_1 ^ tmp1_2 ^ tmp;
+	tmp = state[18];
+	state[18] = tmp0_2 ^ tmp1_3 ^ tmp_bis;
+	state[26] = tmp0_3 ^ tmp1_0 ^ tmp;
+	tmp0_0 = state[1] ^ state[9];
+	tmp0_1 = state[9] ^ state[17];
+	tmp0_2 = state[17] ^ state[25];
+	tmp0_3 = state[25]^ state[1];
+	tmp = state[1];
+	state[1] = tmp1_0 ^ tmp0_1 ^ state[25];
+	tmp_bis = state[9];
+	state[9] = tmp1_1 ^ tmp0_2 ^ tmp;
+	tmp = state[17];
+	state[17] = tmp1_2 ^ tmp0_3 ^ tmp_bis;
+	state[25] =  tmp1_3 ^ tmp0_0 ^ tmp;
+	tmp = state[0];
+	state[0] = tmp0_0 ^ tmp2_1 ^ state[24];
+	tmp_bis = state[8];
+	state[8] = tmp0_1 ^ tmp2_2 ^ tmp;
+	tmp = state[16];
+	state[16] = tmp0_2 ^ tmp2_3 ^ tmp_bis;
+	state[24] = tmp0_3 ^ tmp2_0 ^ tmp;
+	PROFILE_END(PROFILE_MIXCOLUMNS);
+}
+
+/******************************************************************************
+* XOR the round key to the entire 1024-bit internal state. Each round key is
+* stored as the 3 masks km0, km1, km0^km1 followed by the 32 masked words, so
+* that the masks of the internal state are updated accordingly.
+******************************************************************************/
+static inline void ark(uint32_t* state, uint32_t* masks, const uint32_t* rkey) {
+	PROFILE_BEGIN();
+	UNROLL_WORDS
+	for(int i = 0; i < 3; i++)
+		masks[i] ^= rkey[i];
+	UNROLL_WORDS
+	for(int i = 0; i < 32; i++)
+		state[i] ^= rkey[i+3];
+	PROFILE_END(PROFILE_ARK);
+}
+
+/******************************************************************************
+* Applies the masks m0, m1, m0^m1 on the entire 1024-bit internal state (also
+* used for unmasking).
+******************************************************************************/
+static inline void mask_state_bsr(uint32_t* state, const uint32_t* masks) {
+	mask_state(state, masks);
+	mask_state(state + 8, masks);
+	mask_state(state + 16, masks);
+	mask_state(state + 24, masks);
+}
+
+/******************************************************************************
+* 1st-order masked S-box on the entire 1024-bit internal state, i.e. the
+* masked S-box from 'aes_encrypt.c' applied on each quarter state.
+******************************************************************************/
+static inline void sbox_bsr(uint32_t* state, const uint32_t* masks) {
+	sbox(state, masks); 				// S-box on the 1st quarter state
+	sbox(state + 8, masks); 			// S-box on the 2nd quarter state
+	sbox(state + 16, masks); 			// S-box on the 3rd quarter state
+	sbox(state + 24, masks); 			// S-box on the 4th quarter state
+}
+
+/******************************************************************************
+* 1st-order masked AES-128 encryption of 8 128-bit blocks of data in parallel
+* with the barrel-shiftrows representation, without any operating mode.
+* The masked round keys are assumed to be pre-computed.
+* 16 random bits are consumed per call.
+******************************************************************************/
+void aes128_encrypt_bsr(unsigned char ctext[128], const unsigned char ptext[128],
+				const uint32_t rkeys[385]) {
+	uint32_t state[32]; 				// 1024-bit state (8 blocks in //)
+	uint32_t masks[3]; 					// m0, m1, m0^m1
+	uint32_t r = random_halfword();
+	packing_bsr(state, ptext); 			// From bytes to the barrel-shiftrows
+	EXPAND_MASKS_BSR(masks, r);
+	mask_state_bsr(state, masks); 		// masking
+	UNROLL_ROUNDS
+	for(int i = 0; i < 9; i++) {
+		ark(state, masks, rkeys + i*35); // AddRoundKey on the entire state
+		sbox_bsr(state, masks); 		// S-box on the entire state
+		shiftrows(state); 				// ShiftRows on the entire state
+		mixcolumns(state); 				// MixColumns on the entire state
+	}
+	ark(state, masks, rkeys + 315); 	// AddRoundKey on the entire state
+	sbox_bsr(state, masks); 			// S-box on the entire state
+	shiftrows(state); 					// No MixColumns in the last round
+	ark(state, masks, rkeys + 350); 	// last AddRoundKey
+	mask_state_bsr(state, masks); 		// unmasking
+	unpacking_bsr(ctext, state); 		// From barrel-shiftrows to bytes
+}
@@ -0,0 +1,160 @@
+/******************************************************************************
+* 1st-order masked bitsliced implementation of the AES-128 key schedule in C
+* to match the fixsliced representations.
+*
+* The masking scheme is the one described in "Masking AES with 2 random bits"
+* available at https://eprint.iacr.org/2018/1007.
+* All bytes within a round key are masked in the following way:
+* m1 || m0^m1 || m0^m1 || m0 || m0 || m1 || m0 || m1 where m0, m1 are random
+* bits. For each round key, m0 and m1 are picked randomly.
+* Note that because the function prototype allows to pass 2 different keys as
+* input parameters, 4 random bits are used instead of 2 to ensure that
+* different round keys are masked with different masks.
+*
+* Each round key is stored on 11 words: the masks km0, km1, km0^km1 followed
+* by the 8 masked words, which is the format expected by the encryption.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy
+#include "aes.h"
+#include "internal-aes.h"
+
+static const unsigned char rconst[10] = {
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+/* Index of the mask (m0, m1 or m0^m1) applied on each slice */
+static const int mask_idx[8] = {1, 0, 1, 0, 0, 2, 2, 1};
+
+/******************************************************************************
+* Applies ShiftRows^(-1) on a round key to match the fixsliced representation.
+******************************************************************************/
+static inline void inv_shiftrows_1(uint32_t* rkey) {
+	uint32_t tmp;
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) {
+		SWAPMOVE(rkey[i], rkey[i], 0x0c0f0300, 4);
+		SWAPMOVE(rkey[i], rkey[i], 0x33003300, 2);
+	}
+}
+
+/******************************************************************************
+* Applies ShiftRows^(-2) on a round key to match the fixsliced representation.
+******************************************************************************/
+static inline void inv_shiftrows_2(uint32_t* rkey) {
+	uint32_t tmp;
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++)
+		SWAPMOVE(rkey[i], rkey[i], 0x0f000f00, 4);
+}
+
+/******************************************************************************
+* Applies ShiftRows^(-3) on a round key to match the fixsliced representation.
+******************************************************************************/
+static inline void inv_shiftrows_3(uint32_t* rkey) {
+	uint32_t tmp;
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) {
+		SWAPMOVE(rkey[i], rkey[i], 0x030f0c00, 4);
+		SWAPMOVE(rkey[i], rkey[i], 0x33003300, 2);
+	}
+}
+
+/******************************************************************************
+* XOR the columns after the S-box during the key schedule round function.
+* The S-box output is expected to be masked with the new masks while the
+* previous round key is masked with the old ones, so that the 1st and 3rd
+* columns end up being masked with both. Those columns are then remasked so
+* that the whole round key is masked with the new masks only.
+******************************************************************************/
+static inline void xor_columns(uint32_t* rkey, const uint32_t* prev) {
+	rkey[4] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	rkey[5] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	rkey[9] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	rkey[10] ^= 0xffffffff; 		// NOT that are omitted in S-box
+	UNROLL_WORDS
+	for(int i = 3; i < 11; i++) {
+		rkey[i] = (prev[i] ^ ROR(rkey[i], 2))  & 0xc0c0c0c0;
+		rkey[i] |= ((prev[i] ^ rkey[i] >> 2) & 0x30303030);
+		rkey[i] |= ((prev[i] ^ rkey[i] >> 2) & 0x0c0c0c0c);
+		rkey[i] |= ((prev[i] ^ rkey[i] >> 2) & 0x03030303);
+		rkey[i] ^= prev[mask_idx[i-3]] & 0xcccccccc; 	// remask
+	}
+}
+
+/******************************************************************************
+* Computes the masked round key 'rkey' from the previous one 'prev' with fresh
+* masks.
+******************************************************************************/
+static void keyschedule_round(uint32_t* rkey, const uint32_t* prev,
+				unsigned char rcon) {
+	uint32_t diff[3];
+	uint32_t r = random_nibble();
+	EXPAND_MASKS(rkey, r); 			// new masks
+	memcpy(rkey+3, prev+3, 32);
+	sbox(rkey+3, prev); 			// masked with the old masks
+	UNROLL_WORDS
+	for(int i = 0; i < 3; i++)
+		diff[i] = prev[i] ^ rkey[i];
+	mask_state(rkey+3, diff); 		// masked with the new masks
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) 		// rconst
+		if ((rcon >> i) & 1)
+			rkey[10-i] ^= 0x00000300;
+	xor_columns(rkey, prev); 		// Rotword and XOR between the columns
+}
+
+/******************************************************************************
+* Masked AES-128 key schedule. 'period' refers to the number of rounds after
+* which the fixsliced representation is resynchronized (i.e. 4 and 2 for the
+* fully and semi-fixsliced representations, respectively).
+******************************************************************************/
+static void keyschedule(uint32_t* rkeys, const unsigned char* key0,
+				const unsigned char* key1, int period) {
+	uint32_t r = random_nibble();
+	packing(rkeys+3, key0, key1); 	// packs the keys into the bitsliced state
+	EXPAND_MASKS(rkeys, r);
+	mask_state(rkeys+3, rkeys); 	// masks the key
+	UNROLL_ROUNDS
+	for(int i = 1; i < 11; i++) {
+		keyschedule_round(rkeys + i*11, rkeys + (i-1)*11, rconst[i-1]);
+		switch ((i-1) % period) { 	// to match fixslicing
+			case 1: inv_shiftrows_1(rkeys + (i-1)*11 + 3); break;
+			case 2: inv_shiftrows_2(rkeys + (i-1)*11 + 3); break;
+			case 3: inv_shiftrows_3(rkeys + (i-1)*11 + 3); break;
+		}
+	}
+	UNROLL_ROUNDS
+	for(int i = 1; i < 11; i++) {
+		rkeys[i*11 + 4] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+		rkeys[i*11 + 5] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+		rkeys[i*11 + 9] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+		rkeys[i*11 + 10] ^= 0xffffffff; // NOT to speed up SBox calculations
+	}
+}
+
+/******************************************************************************
+* Masked AES-128 key schedule to match the fully-fixsliced (ffs)
+* representation. Note that it is possible to pass two different keys as input
+* parameters if one wants to encrypt 2 blocks with two different keys.
+* 44 random bits are consumed per call.
+******************************************************************************/
+void aes128_keyschedule_ffs(uint32_t* rkeys, const unsigned char* key0,
+						const unsigned char* key1) {
+	keyschedule(rkeys, key0, key1, 4);
+}
+
+/******************************************************************************
+* Masked AES-128 key schedule to match the semi-fixsliced (sfs)
+* representation. Note that it is possible to pass two different keys as input
+* parameters if one wants to encrypt 2 blocks with two different keys.
+* 44 random bits are consumed per call.
+******************************************************************************/
+void aes128_keyschedule_sfs(uint32_t* rkeys, const unsigned char* key0,
+						const unsigned char* key1) {
+	keyschedule(rkeys, key0, key1, 2);
+}
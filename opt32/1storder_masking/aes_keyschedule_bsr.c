@@ -0,0 +1,145 @@
+/******************************************************************************
+* 1st-order masked bitsliced implementation of the AES-128 key schedule in C
+* to match the barrel-shiftrows representation.
+*
+* The masking scheme is the one described in "Masking AES with 2 random bits"
+* available at https://eprint.iacr.org/2018/1007.
+* All bytes within a round key are masked in the following way:
+* m1 || m0^m1 || m0^m1 || m0 || m0 || m1 || m0 || m1 where m0, m1 are random
+* bits. For each round key, m0 and m1 are picked randomly for each of the 8
+* blocks, so that 16 random bits are used per round key.
+*
+* Each round key is stored on 35 words: the masks km0, km1, km0^km1 followed
+* by the 32 masked words, which is the format expected by the encryption.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+
+static const unsigned char rconst[10] = {
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+/* Index of the mask (m0, m1 or m0^m1) applied on each slice */
+static const int mask_idx[8] = {1, 0, 1, 0, 0, 2, 2, 1};
+
+/******************************************************************************
+* Packing routine used to rearrange the key to match the barrel-shiftrows.
+* Since the 8 blocks are encrypted with the same key, each bit is replicated
+* over the 8 bits of the corresponding byte (see 'aes_keyschedule_lut.c' in
+* 'opt32/barrel_shiftrows').
+******************************************************************************/
+static void packing_rkey(uint32_t* rkey_bsr, const unsigned char* rkey) {
+	uint32_t tmp, tmp0, tmp1, tmp2, tmp3;
+	tmp0 = LE_LOAD_32(rkey);
+	tmp1 = LE_LOAD_32(rkey + 4);
+	tmp2 = LE_LOAD_32(rkey + 8);
+	tmp3 = LE_LOAD_32(rkey + 12);
+	SWAPMOVE(tmp0, tmp1, 0x00ff00ff, 8);
+	SWAPMOVE(tmp2, tmp3, 0x00ff00ff, 8);
+	SWAPMOVE(tmp0, tmp2, 0x0000ffff, 16);
+	SWAPMOVE(tmp1, tmp3, 0x0000ffff, 16);
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) {
+		rkey_bsr[i] 	= (tmp0 & (0x80808080 >> i)) << i;
+		rkey_bsr[i] 	|= (rkey_bsr[i] >> 1);
+		rkey_bsr[i] 	|= (rkey_bsr[i] >> 2);
+		rkey_bsr[i] 	|= (rkey_bsr[i] >> 4);
+		rkey_bsr[i+8] 	= (tmp1 & (0x80808080 >> i)) << i;
+		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 1);
+		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 2);
+		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 4);
+		rkey_bsr[i+16] 	= (tmp2 & (0x80808080 >> i)) << i;
+		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 1);
+		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 2);
+		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 4);
+		rkey_bsr[i+24] 	= (tmp3 & (0x80808080 >> i)) << i;
+		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 1);
+		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 2);
+		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 4);
+	}
+}
+
+/******************************************************************************
+* XOR the columns after the S-box during the key schedule round function.
+* 'sub' holds the output of SubWord (masked with the new masks) where the byte
+* i of each slice corresponds to the row i. RotWord is applied by taking the
+* byte (i+1)%4 for the row i.
+* The previous round key being masked with the old masks, the 1st and 3rd
+* columns end up being masked with both. Those columns are then remasked so
+* that the whole round key is masked with the new masks only.
+******************************************************************************/
+static void xor_columns(uint32_t* rkey, const uint32_t* prev,
+				const uint32_t* sub) {
+	uint32_t w;
+	UNROLL_WORDS
+	for(int i = 0; i < 32; i++) {
+		w = prev[i+3] ^ (ROR(sub[i%8], ((i/8 + 1) % 4) * 8) & 0xff);
+		w ^= (w & 0x000000ff) << 8;
+		w ^= (w & 0x0000ff00) << 8;
+		w ^= (w & 0x00ff0000) << 8;
+		rkey[i+3] = w ^ (prev[mask_idx[i%8]] & 0x00ff00ff); 	// remask
+	}
+}
+
+/******************************************************************************
+* Computes the masked round key 'rkey' from the previous one 'prev' with fresh
+* masks.
+******************************************************************************/
+static void keyschedule_round(uint32_t* rkey, const uint32_t* prev,
+				unsigned char rcon) {
+	uint32_t sub[8], diff[3];
+	uint32_t r = random_halfword();
+	EXPAND_MASKS_BSR(rkey, r); 		// new masks
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) { 	// gathers the last column into 'sub'
+		sub[i] = prev[i+3] >> 24;
+		sub[i] |= (prev[i+11] >> 16) & 0x0000ff00;
+		sub[i] |= (prev[i+19] >> 8) & 0x00ff0000;
+		sub[i] |= prev[i+27] & 0xff000000;
+	}
+	sbox(sub, prev); 				// masked with the old masks
+	UNROLL_WORDS
+	for(int i = 0; i < 3; i++)
+		diff[i] = prev[i] ^ rkey[i];
+	mask_state(sub, diff); 			// masked with the new masks
+	sub[1] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	sub[2] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	sub[6] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	sub[7] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) 		// rconst on the byte moved to the 1st row
+		if ((rcon >> i) & 1)
+			sub[7-i] ^= 0x0000ff00;
+	xor_columns(rkey, prev, sub); 	// RotWord and XOR between the columns
+}
+
+/******************************************************************************
+* Masked AES-128 key schedule to match the barrel-shiftrows representation.
+* 176 random bits are consumed per call.
+******************************************************************************/
+void aes128_keyschedule_bsr(uint32_t rkeys[385], const unsigned char key[16]) {
+	uint32_t r = random_halfword();
+	packing_rkey(rkeys+3, key); 	// packs the key into the bitsliced state
+	EXPAND_MASKS_BSR(rkeys, r);
+	UNROLL_WORDS
+	for(int i = 0; i < 32; i+=8)
+		mask_state(rkeys+3+i, rkeys);	// masks the key
+	UNROLL_ROUNDS
+	for(int i = 1; i < 11; i++)
+		keyschedule_round(rkeys + i*35, rkeys + (i-1)*35, rconst[i-1]);
+	UNROLL_ROUNDS
+	for(int i = 1; i < 11; i++) {
+		UNROLL_WORDS
+		for(int j = 3; j < 35; j+=8) {
+			rkeys[i*35+j+1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+			rkeys[i*35+j+2] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+			rkeys[i*35+j+6] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+			rkeys[i*35+j+7] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+		}
+	}
+}
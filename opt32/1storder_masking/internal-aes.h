@@ -0,0 +1,98 @@
+#ifndef INTERNAL_AES_H_
+#define INTERNAL_AES_H_
+
+#include <stdint.h>
+#include "../common/le-io.h"
+#if defined(AES_PROFILE)
+#include "../profile/profile.h" 	// per-phase cycle counts
+#else 							// hooks expand to nothing (no timer needed)
+#define PROFILE_BEGIN()
+#define PROFILE_END(phase)
+#endif
+
+/******************************************************************************
+* Loop unrolling level, selected at build time with -DAES_UNROLL=<level>:
+* 0: the compiler decides (default, most compact code)
+* 1: partial unrolling, loops over the state words are fully unrolled while
+*    loops over the rounds are unrolled twice
+* 2: full unrolling of all loops
+******************************************************************************/
+#ifndef AES_UNROLL
+#define AES_UNROLL 		0
+#endif
+
+#define AES_PRAGMA(x) 	_Pragma(#x)
+#if defined(__clang__)
+#define AES_UNROLL_N(n) AES_PRAGMA(unroll n)
+#else
+#define AES_UNROLL_N(n) AES_PRAGMA(GCC unroll n)
+#endif
+
+#if AES_UNROLL >= 2
+#define UNROLL_ROUNDS 	AES_UNROLL_N(16)
+#define UNROLL_WORDS 	AES_UNROLL_N(32)
+#elif AES_UNROLL == 1
+#define UNROLL_ROUNDS 	AES_UNROLL_N(2)
+#define UNROLL_WORDS 	AES_UNROLL_N(32)
+#else
+#define UNROLL_ROUNDS
+#define UNROLL_WORDS
+#endif
+
+/* Number of 32-bit random words fetched at once from the RNG callback */
+#ifndef MASK_POOL_WORDS
+#define MASK_POOL_WORDS 	64
+#endif
+
+#define ROR(x,y) 		(((x) >> (y)) | ((x) << (32 - (y))))
+
+#define BYTE_ROR_6(x) 										\
+	((((x) >> 6) & 0x03030303)	| (((x) & 0x3f3f3f3f) << 2))
+
+#define BYTE_ROR_4(x) 										\
+	((((x) >> 4) & 0x0f0f0f0f)	| (((x) & 0x0f0f0f0f) << 4))
+
+#define BYTE_ROR_2(x) 										\
+	((((x) >> 2) & 0x3f3f3f3f)	| (((x) & 0x03030303) << 6))
+
+#define SWAPMOVE(a, b, mask, n)	({							\
+	tmp = (b ^ (a >> n)) & mask;							\
+	b ^= tmp;												\
+	a ^= (tmp << n);										\
+})
+
+/******************************************************************************
+* Expands 4 random bits into the masks m0, m1, m0^m1. Since the two blocks are
+* interleaved bit by bit in the fixsliced representation, each block gets its
+* own pair of random bits (i.e. 'ab' -> 'abab...ab').
+******************************************************************************/
+#define EXPAND_MASKS(m, r)	({								\
+	(m)[0] = ((r) & 0x3) * 0x55555555;						\
+	(m)[1] = (((r) >> 2) & 0x3) * 0x55555555;				\
+	(m)[2] = (m)[0] ^ (m)[1];								\
+})
+
+/******************************************************************************
+* Expands 16 random bits into the masks m0, m1, m0^m1 for the barrel-shiftrows
+* representation. Since each byte of the internal state holds the same bit of
+* the 8 blocks, each block gets its own pair of random bits by replicating the
+* two random bytes over the word (i.e. 'ab' -> 'abababab' for each block).
+******************************************************************************/
+#define EXPAND_MASKS_BSR(m, r)	({							\
+	(m)[0] = ((r) & 0xff) * 0x01010101;						\
+	(m)[1] = (((r) >> 8) & 0xff) * 0x01010101;				\
+	(m)[2] = (m)[0] ^ (m)[1];								\
+})
+
+void packing(uint32_t* out, const unsigned char* in0,
+		const unsigned char* in1);
+
+void mask_state(uint32_t* state, const uint32_t* masks);
+
+void sbox(uint32_t* state, const uint32_t* masks);
+
+uint32_t random_nibble(void);
+
+uint32_t random_halfword(void);
+
+#endif 	// INTERNAL_AES_H_
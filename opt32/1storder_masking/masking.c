@@ -0,0 +1,89 @@
+/******************************************************************************
+* Randomness management for the 1st-order masked implementations.
+*
+* Instead of querying the RNG for each call (as done in the ARM Cortex-M
+* assembly implementations that busy-poll the STM32 RNG peripheral), random
+* words are fetched by batches of MASK_POOL_WORDS through a user-defined
+* callback and then consumed 4 bits at a time, which is the amount of
+* randomness required per fixsliced encryption (or per round key). The
+* barrel-shiftrows implementation consumes 16 bits at a time instead.
+*
+* The RNG callback defaults to getrandom() on Linux and has to be set through
+* 'masking_set_rng' on other platforms, the program being aborted if masks are
+* requested without any RNG. Note that the pool is not thread-safe.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+#include <stdlib.h> 	// for abort
+
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/random.h>
+
+static void os_rng(uint32_t* out, size_t nwords) {
+	unsigned char* p = (unsigned char*)out;
+	size_t len = nwords * sizeof(uint32_t);
+	ssize_t ret;
+	while (len) {
+		ret = getrandom(p, len, 0);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			abort(); 	// never run with predictable masks
+		}
+		p += ret;
+		len -= ret;
+	}
+}
+static masking_rng_t rng_callback = os_rng;
+#else
+static masking_rng_t rng_callback = NULL;
+#endif
+
+static uint32_t pool[MASK_POOL_WORDS];
+static unsigned int pool_nibbles = 0; 	// number of unused nibbles in the pool
+
+/******************************************************************************
+* Sets the RNG callback and discards the random words fetched so far.
+******************************************************************************/
+void masking_set_rng(masking_rng_t rng) {
+	rng_callback = rng;
+	for(int i = 0; i < MASK_POOL_WORDS; i++)
+		pool[i] = 0;
+	pool_nibbles = 0;
+}
+
+/******************************************************************************
+* Returns 4 fresh random bits, refilling the pool whenever it is exhausted.
+* Consumed bits are erased from the pool.
+******************************************************************************/
+uint32_t random_nibble(void) {
+	uint32_t r;
+	unsigned int idx;
+	if (!pool_nibbles) {
+		if (!rng_callback)
+			abort(); 	// no RNG set through 'masking_set_rng'
+		rng_callback(pool, MASK_POOL_WORDS);
+		pool_nibbles = MASK_POOL_WORDS * 8;
+	}
+	idx = --pool_nibbles;
+	r = pool[idx / 8] & 0xf;
+	pool[idx / 8] >>= 4;
+	return r;
+}
+
+/******************************************************************************
+* Returns 16 fresh random bits (i.e. 4 nibbles from the pool).
+******************************************************************************/
+uint32_t random_halfword(void) {
+	uint32_t r = random_nibble();
+	r |= random_nibble() << 4;
+	r |= random_nibble() << 8;
+	r |= random_nibble() << 12;
+	return r;
+}
@@ -1,5 +1,5 @@
-#ifndef AES_H_
-#define AES_H_
+#ifndef AES_BARREL_SHIFTROWS_H_
+#define AES_BARREL_SHIFTROWS_H_
 
 #include <stdint.h>
 
@@ -9,9 +9,13 @@ void aes128_encrypt(unsigned char ctext[128], const unsigned char ptext[128],
 void aes256_encrypt(unsigned char ctext[128], const unsigned char ptext[128],
 				const uint32_t rkeys[480]);
 
+/* Key schedule functions (fully bitsliced) */
+void aes128_keyschedule(uint32_t rkeys[352], const unsigned char key[16]);
+void aes256_keyschedule(uint32_t rkeys[480], const unsigned char key[32]);
+
 /* Key schedule functions (LUT-based) */
 void aes128_keyschedule_lut(uint32_t rkeys[352], const unsigned char key[16]);
 void aes256_keyschedule_lut(uint32_t rkeys[480], const unsigned char key[32]);
 
 
-#endif 	// AES_H_
\ No newline at end of file
+#endif 	// AES_BARREL_SHIFTROWS_H_
\ No newline at end of file
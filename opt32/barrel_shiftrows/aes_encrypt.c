@@ -11,6 +11,7 @@
 ******************************************************************************/
 #include "aes.h"
 #include "internal-aes.h"
+#include "../common/sbox.h"
 
 /******************************************************************************
 * Packing routine to rearrange the 8 16-byte blocs (128 bytes in total) into 
@@ -19,8 +20,10 @@
 * ...
 * out[31] = b_31 b_63 b_95 b_127
 ******************************************************************************/
-static void packing(uint32_t* out, const unsigned char* in) {
+static inline void packing(uint32_t* out, const unsigned char* in) {
 	uint32_t tmp;
+	PROFILE_BEGIN();
+	UNROLL_WORDS
 	for(int i = 0; i < 8; i++) {
 		out[i] 		= LE_LOAD_32(in + i*16);
 		out[i+8] 	= LE_LOAD_32(in + i*16 + 4);
@@ -29,8 +32,10 @@ static void packing(uint32_t* out, const unsigned char* in) {
 		SWAPMOVE(out[i], out[i+8], 0x00ff00ff, 8);
 		SWAPMOVE(out[i+16], out[i+24], 0x00ff00ff, 8);
 	}
+	UNROLL_WORDS
 	for(int i = 0; i < 16; i++)
 		SWAPMOVE(out[i], out[i+16], 0x0000ffff, 16);
+	UNROLL_WORDS
 	for(int i = 0; i < 32; i+=8) {
 		SWAPMOVE(out[i+1], out[i], 	0x55555555, 1);
 		SWAPMOVE(out[i+3], out[i+2],0x55555555, 1);
@@ -45,13 +50,16 @@ static void packing(uint32_t* out, const unsigned char* in) {
 		SWAPMOVE(out[i+6], out[i+2],0x0f0f0f0f, 4);
 		SWAPMOVE(out[i+7], out[i+3],0x0f0f0f0f, 4);
 	}
+	PROFILE_END(PROFILE_PACKING);
 }
 
 /******************************************************************************
 * Unpacking routine to store the internal state in a 128-byte array.
 ******************************************************************************/
-static void unpacking(unsigned char* out, uint32_t* in) {
+static inline void unpacking(unsigned char* out, uint32_t* in) {
 	uint32_t tmp;
+	PROFILE_BEGIN();
+	UNROLL_WORDS
 	for(int i = 0; i < 32; i+=8) {
 		SWAPMOVE(in[i+1], in[i],	0x55555555, 1);
 		SWAPMOVE(in[i+3], in[i+2],	0x55555555, 1);
@@ -66,8 +74,10 @@ static void unpacking(unsigned char* out, uint32_t* in) {
 		SWAPMOVE(in[i+6], in[i+2],	0x0f0f0f0f, 4);
 		SWAPMOVE(in[i+7], in[i+3],	0x0f0f0f0f, 4);
 	}
+	UNROLL_WORDS
 	for(int i = 0; i < 16; i++)
 		SWAPMOVE(in[i], in[i+16], 	0x0000ffff, 16);
+	UNROLL_WORDS
 	for(int i = 0; i < 8; i++) {
 		SWAPMOVE(in[i], in[i+8], 	0x00ff00ff, 8);
 		SWAPMOVE(in[i+16], in[i+24],0x00ff00ff, 8);
@@ -76,157 +86,48 @@ static void unpacking(unsigned char* out, uint32_t* in) {
 		LE_STORE_32(out+i*16+8, in[i+16]);
 		LE_STORE_32(out+i*16+12,in[i+24]);
 	}
+	PROFILE_END(PROFILE_UNPACKING);
 }
 
 /******************************************************************************
-* Bitsliced implementation of the AES Sbox based on Boyar, Peralta and Calik.
-* See http://www.cs.yale.edu/homes/peralta/CircuitStuff/SLP_AES_113.txt
+* Bitsliced implementation of the AES Sbox, the circuit being selected at
+* build time (see 'common/sbox.h').
 * Note that the 4 NOT (^= 0xffffffff) are moved to the key schedule.
 * Updates only a quarter of the state (i.e. 256 bits) => need to be applied 4
 * times per round when considering the barrel-shiftrows representation.
 ******************************************************************************/
-static void sbox(uint32_t* state) {
-	uint32_t t0, t1, t2, t3, t4, t5,
-		t6, t7, t8, t9, t10, t11, t12,
-		t13, t14, t15, t16, t17;
-	t0			= state[3] ^ state[5];
-	t1			= state[0] ^ state[6];
-	t2			= t1 ^ t0;
-	t3			= state[4] ^ t2;
-	t4			= t3 ^ state[5];
-	t5			= t2 & t4;
-	t6			= t4 ^ state[7];
-	t7			= t3 ^ state[1];
-	t8			= state[0] ^ state[3]; 
-	t9			= t7 ^ t8;
-	t10			= t8 & t9;
-	t11			= state[7] ^ t9; 
-	t12			= state[0] ^ state[5];
-	t13			= state[1] ^ state[2];
-	t14			= t4 ^ t13;
-	t15			= t14 ^ t9;
-	t16			= t0 & t15;
-	t17			= t16 ^ t10;
-	state[1]	= t14 ^ t12; 
-	state[2]	= t12 & t14;
-	state[2] 	^= t10;
-	state[4]	= t13 ^ t9;
-	state[5]	= t1 ^ state[4];
-	t3			= t1 & state[4];
-	t10			= state[0] ^ state[4];
-	t13 		^= state[7];
-	state[3] 	^= t13; 
-	t16			= state[3] & state[7];
-	t16 		^= t5;
-	t16 		^= state[2];
-	state[1] 	^= t16;
-	state[0] 	^= t13;
-	t16			= state[0] & t11;
-	t16 		^= t3;
-	state[2] 	^= t16;
-	state[2] 	^= t10;
-	state[6] 	^= t13;
-	t10			= state[6] & t13;
-	t3 			^= t10;
-	t3 			^= t17;
-	state[5] 	^= t3;
-	t3			= state[6] ^ t12;
-	t10			= t3 & t6;
-	t5 			^= t10;
-	t5 			^= t7;
-	t5 			^= t17;
-	t7			= t5 & state[5];
-	t10			= state[2] ^ t7;
-	t7 			^= state[1];
-	t5 			^= state[1];
-	t16			= t5 & t10;
-	state[1] 	^= t16;
-	t17			= state[1] & state[0];
-	t11			= state[1] & t11;
-	t16			= state[5] ^ state[2];
-	t7 			&= t16;
-	t7 			^= state[2];
-	t16			= t10 ^ t7;
-	state[2] 	&= t16;
-	t10 		^= state[2];
-	t10 		&= state[1];
-	t5 			^= t10;
-	t10			= state[1] ^ t5;
-	state[4] 	&= t10; 
-	t11 		^= state[4];
-	t1 			&= t10;
-	state[6] 	&= t5; 
-	t10			= t5 & t13;
-	state[4] 	^= t10;
-	state[5] 	^= t7;
-	state[2] 	^= state[5];
-	state[5]	= t5 ^ state[2];
-	t5			= state[5] & t14;
-	t10			= state[5] & t12;
-	t12			= t7 ^ state[2];
-	t4 			&= t12;
-	t2 			&= t12;
-	t3 			&= state[2]; 
-	state[2] 	&= t6;
-	state[2] 	^= t4;
-	t13			= state[4] ^ state[2];
-	state[3] 	&= t7;
-	state[1] 	^= t7;
-	state[5] 	^= state[1];
-	t6			= state[5] & t15;
-	state[4] 	^= t6; 
-	t0 			&= state[5];
-	state[5]	= state[1] & t9; 
-	state[5] 	^= state[4];
-	state[1] 	&= t8;
-	t6			= state[1] ^ state[5];
-	t0 			^= state[1];
-	state[1]	= t3 ^ t0;
-	t15			= state[1] ^ state[3];
-	t2 			^= state[1];
-	state[0]	= t2 ^ state[5];
-	state[3]	= t2 ^ t13;
-	state[1]	= state[3] ^ state[5];
-	//state[1] 	^= 0xffffffff;
-	t0 			^= state[6];
-	state[5]	= t7 & state[7];
-	t14			= t4 ^ state[5];
-	state[6]	= t1 ^ t14;
-	state[6] 	^= t5; 
-	state[6] 	^= state[4];
-	state[2]	= t17 ^ state[6];
-	state[5]	= t15 ^ state[2];
-	state[2] 	^= t6;
-	state[2] 	^= t10;
-	//state[2] 	^= 0xffffffff;
-	t14 		^= t11;
-	t0 			^= t14;
-	state[6] 	^= t0;
-	//state[6] 	^= 0xffffffff;
-	state[7]	= t1 ^ t0;
-	//state[7] 	^= 0xffffffff;
-	state[4]	= t14 ^ state[3]; 
+static inline void sbox(uint32_t* state) {
+	PROFILE_BEGIN();
+	SBOX(state[0], state[1], state[2], state[3],
+		state[4], state[5], state[6], state[7]);
+	PROFILE_END(PROFILE_SBOX);
 }
 
 /******************************************************************************
 * ShiftRows on the entire 1024-bit internal state.
 ******************************************************************************/
-static void shiftrows(uint32_t* state) {
+static inline void shiftrows(uint32_t* state) {
+	PROFILE_BEGIN();
+	UNROLL_WORDS
 	for(int i = 8; i < 16; i++) 		// shifts the 2nd row
 		state[i] = ROR(state[i],8); 	// shifts the 2nd row
+	UNROLL_WORDS
 	for(int i = 16; i < 24; i++) 		// shifts the 3rd row
 		state[i] = ROR(state[i],16); 	// shifts the 3rd row
+	UNROLL_WORDS
 	for(int i = 24; i < 32; i++) 		// shifts the 4th row
 		state[i] = ROR(state[i],24); 	// shifts the 4th row
+	PROFILE_END(PROFILE_SHIFTROWS);
 }
 
 /******************************************************************************
 * MixColumns on the entire 1024-bit internal state.
 ******************************************************************************/
-static void mixcolumns(uint32_t* state) {
+static inline void mixcolumns(uint32_t* state) {
 	uint32_t tmp2_0, tmp2_1, tmp2_2, tmp2_3;
 	uint32_t tmp, tmp_bis, tmp0_0, tmp0_1, tmp0_2, tmp0_3;
 	uint32_t tmp1_0, tmp1_1, tmp1_2, tmp1_3;
+	PROFILE_BEGIN();
 	tmp2_0 = state[0] ^ state[8];
 	tmp2_1 = state[8] ^ state[16];
 	tmp2_2 = state[16] ^ state[24];
@@ -314,14 +215,18 @@ static void mixcolumns(uint32_t* state) {
 	tmp = state[16];
 	state[16] = tmp0_2 ^ tmp2_3 ^ tmp_bis;
 	state[24] = tmp0_3 ^ tmp2_0 ^ tmp;
+	PROFILE_END(PROFILE_MIXCOLUMNS);
 }
 
 /******************************************************************************
 * AddRoundKey on the entire 1024-bit internal state.
 ******************************************************************************/
-static void ark(uint32_t* state, const uint32_t* rkey) {
+static inline void ark(uint32_t* state, const uint32_t* rkey) {
+	PROFILE_BEGIN();
+	UNROLL_WORDS
 	for(int i = 0; i < 32; i++)
 		state[i] ^= rkey[i];
+	PROFILE_END(PROFILE_ARK);
 }
 
 /******************************************************************************
@@ -333,6 +238,7 @@ void aes128_encrypt(unsigned char* out, const unsigned char* in,
 				const uint32_t* rkeys) {
 	uint32_t state[32]; 				// 1024-bit state (8 blocks in //)
 	packing(state, in); 				// From bytes to the barrel-shiftrows
+	UNROLL_ROUNDS
 	for(int i = 0; i < 10; i++) {
 		ark(state, rkeys+i*32); 		// AddRoundKey on the entire state
 		sbox(state); 					// S-box on the 1st quarter state
@@ -356,6 +262,7 @@ void aes256_encrypt(unsigned char* out, const unsigned char* in,
 				const uint32_t* rkeys) {
 	uint32_t state[32]; 				// 1024-bit state (8 blocks in //)
 	packing(state, in); 				// From bytes to the barrel-shiftrows
+	UNROLL_ROUNDS
 	for(int i = 0; i < 14; i++) {
 		ark(state, rkeys+i*32); 		// AddRoundKey on the entire state
 		sbox(state); 					// S-box on the 1st quarter state
@@ -0,0 +1,115 @@
+/******************************************************************************
+* C language implementations of the AES-128 and AES-256 key schedules to match
+* the barrel-shiftrows representation. Note that those implementations are
+* fully bitsliced and do not rely on any Look-Up Table (LUT), so that they can
+* be run on secret keys (e.g. the per-nonce keys of AES-GCM-SIV or the key of
+* the CTR_DRBG) without any key-dependent memory access.
+*
+* The key is packed once, then each round key is computed from the previous
+* one(s) in the bitsliced domain: the last column is gathered into 8 words
+* (one per slice, the byte i holding the row i), goes through the bitsliced
+* S-box and is XORed into the columns.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+#include "../common/sbox.h"
+
+static const unsigned char rconst[10] = {
+	0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
+};
+
+/******************************************************************************
+* Applies SubWord on the last column of the round key 'rkey' and adds the round
+* constant 'rcon' on the byte that RotWord moves to the 1st row (0 for the
+* AES-256 steps without RotWord). The output is written in 'sub'.
+******************************************************************************/
+static inline void subword(uint32_t* sub, const uint32_t* rkey, unsigned char rcon) {
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) { 	// gathers the last column into 'sub'
+		sub[i] = rkey[i] >> 24;
+		sub[i] |= (rkey[i+8] >> 16) & 0x0000ff00;
+		sub[i] |= (rkey[i+16] >> 8) & 0x00ff0000;
+		sub[i] |= rkey[i+24] & 0xff000000;
+	}
+	SBOX(sub[0], sub[1], sub[2], sub[3], sub[4], sub[5], sub[6], sub[7]);
+	sub[1] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	sub[2] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	sub[6] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	sub[7] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) 		// rconst on the byte moved to the 1st row
+		if ((rcon >> i) & 1)
+			sub[7-i] ^= 0x0000ff00;
+}
+
+/******************************************************************************
+* XOR the columns after the S-box during the key schedule round function.
+* 'sub' holds the output of SubWord where the byte i of each slice corresponds
+* to the row i. If 'rot' is set, RotWord is applied by taking the byte
+* (i+1)%4 for the row i.
+******************************************************************************/
+static inline void xor_columns(uint32_t* rkey, const uint32_t* prev,
+				const uint32_t* sub, int rot) {
+	uint32_t w;
+	UNROLL_WORDS
+	for(int i = 0; i < 32; i++) {
+		w = prev[i] ^ (ROR(sub[i%8], ((i/8 + rot) % 4) * 8) & 0xff);
+		w ^= (w & 0x000000ff) << 8;
+		w ^= (w & 0x0000ff00) << 8;
+		w ^= (w & 0x00ff0000) << 8;
+		rkey[i] = w;
+	}
+}
+
+/******************************************************************************
+* Adds the NOTs omitted in the S-box to all round keys but the 1st one.
+******************************************************************************/
+static inline void add_nots(uint32_t* rkeys, int nrkeys) {
+	UNROLL_ROUNDS
+	for(int i = 1; i < nrkeys; i++) {
+		UNROLL_WORDS
+		for(int j = 0; j < 32; j+=8) {
+			rkeys[i*32+j+1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+			rkeys[i*32+j+2] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+			rkeys[i*32+j+6] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+			rkeys[i*32+j+7] ^= 0xffffffff; 	// NOT to speed up SBox calculations
+		}
+	}
+}
+
+/******************************************************************************
+* Bitsliced AES-128 key schedule to match the barrel-shiftrows representation.
+******************************************************************************/
+void aes128_keyschedule(uint32_t rkeys[352], const unsigned char key[16]) {
+	uint32_t sub[8];
+	packing_rkey(rkeys, key); 		// packs the key into the bitsliced state
+	UNROLL_ROUNDS
+	for(int i = 1; i < 11; i++) {
+		subword(sub, rkeys + (i-1)*32, rconst[i-1]);
+		xor_columns(rkeys + i*32, rkeys + (i-1)*32, sub, 1);
+	}
+	add_nots(rkeys, 11);
+}
+
+/******************************************************************************
+* Bitsliced AES-256 key schedule to match the barrel-shiftrows representation.
+******************************************************************************/
+void aes256_keyschedule(uint32_t rkeys[480], const unsigned char key[32]) {
+	uint32_t sub[8];
+	packing_rkey(rkeys, key); 		// packs the key into the bitsliced state
+	packing_rkey(rkeys + 32, key + 16);
+	UNROLL_ROUNDS
+	for(int i = 2; i < 15; i++) {
+		if (i & 1) 					// SubWord only
+			subword(sub, rkeys + (i-1)*32, 0);
+		else 						// RotWord, SubWord and round constant
+			subword(sub, rkeys + (i-1)*32, rconst[i/2-1]);
+		xor_columns(rkeys + i*32, rkeys + (i-2)*32, sub, !(i & 1));
+	}
+	add_nots(rkeys, 15);
+}
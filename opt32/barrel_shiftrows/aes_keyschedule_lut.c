@@ -58,43 +58,6 @@ static unsigned char rcon[11] = {
 	0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1b, 0x36
 };
 
-/******************************************************************************
-* Packing routine used to rearrange the rkeys to match the barrel-shiftrows.
-* It is about twice more efficient than the 'packing' func. This optimization
-* is possible because the 8 16-byte blocs to pack are all equal.
-* However, if one wants to encrypt 8 blocs in parallel with different keys, the
-* 'packing' function is necessary.
-******************************************************************************/
-static void packing_rkey(uint32_t* rkey_bsr, const unsigned char* rkey) {
-	uint32_t tmp, tmp0, tmp1, tmp2, tmp3;
-	tmp0 = LE_LOAD_32(rkey);
-	tmp1 = LE_LOAD_32(rkey + 4);
-	tmp2 = LE_LOAD_32(rkey + 8);
-	tmp3 = LE_LOAD_32(rkey + 12);
-	SWAPMOVE(tmp0, tmp1, 0x00ff00ff, 8);
-	SWAPMOVE(tmp2, tmp3, 0x00ff00ff, 8);
-	SWAPMOVE(tmp0, tmp2, 0x0000ffff, 16);
-	SWAPMOVE(tmp1, tmp3, 0x0000ffff, 16);
-	for(int i = 0; i < 8; i++) {
-		rkey_bsr[i] 	= (tmp0 & (0x80808080 >> i)) << i;
-		rkey_bsr[i] 	|= (rkey_bsr[i] >> 1);
-		rkey_bsr[i] 	|= (rkey_bsr[i] >> 2);
-		rkey_bsr[i] 	|= (rkey_bsr[i] >> 4);
-		rkey_bsr[i+8] 	= (tmp1 & (0x80808080 >> i)) << i;
-		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 1);
-		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 2);
-		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 4);
-		rkey_bsr[i+16] 	= (tmp2 & (0x80808080 >> i)) << i;
-		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 1);
-		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 2);
-		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 4);
-		rkey_bsr[i+24] 	= (tmp3 & (0x80808080 >> i)) << i;
-		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 1);
-		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 2);
-		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 4);
-	}
-}
-
 void aes128_keyschedule_lut(uint32_t* rkeys_bsr, const unsigned char* key) {
 	uint32_t rkeys[44];
 	// key schedule in the classical representation
@@ -102,6 +65,7 @@ void aes128_keyschedule_lut(uint32_t* rkeys_bsr, const unsigned char* key) {
 	rkeys[1] = LE_LOAD_32(key + 4);
 	rkeys[2] = LE_LOAD_32(key + 8);
 	rkeys[3] = LE_LOAD_32(key + 12);
+	UNROLL_ROUNDS
 	for(int i = 4; i < 44; i+=4) {
 		rkeys[i] = rkeys[i-4] ^ rcon[i/4];
 		rkeys[i] ^= (sbox_lut[rkeys[i-1] & 0xff] << 24);
@@ -114,8 +78,10 @@ void aes128_keyschedule_lut(uint32_t* rkeys_bsr, const unsigned char* key) {
 	}
 	// packing all round keys to match the fully-fixsliced representation
 	packing_rkey(rkeys_bsr, (unsigned char*)rkeys);
+	UNROLL_ROUNDS
 	for(int i = 1; i < 11; i++) {
 		packing_rkey(rkeys_bsr + i*32, (unsigned char*)(rkeys + i*4));
+		UNROLL_WORDS
 		for(int j = 0; j < 32; j+=8) {
 			rkeys_bsr[i*32+j+1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
 			rkeys_bsr[i*32+j+2] ^= 0xffffffff; 	// NOT to speed up SBox calculations
@@ -137,6 +103,7 @@ void aes256_keyschedule_lut(uint32_t* rkeys_bsr, const unsigned char* key) {
 	rkeys[6] = LE_LOAD_32(key + 24);
 	rkeys[7] = LE_LOAD_32(key + 28);
 	// loop over double rounds for the round function
+	UNROLL_ROUNDS
 	for(int i = 8; i < 56; i+=8) {
 		rkeys[i] = rkeys[i-8] ^ rcon[i/8];
 		rkeys[i] ^= (sbox_lut[rkeys[i-1] & 0xff] << 24);
@@ -166,8 +133,10 @@ void aes256_keyschedule_lut(uint32_t* rkeys_bsr, const unsigned char* key) {
 	rkeys[59] = rkeys[58] ^ rkeys[51];
 	// packing all round keys to match the fully-fixsliced representation
 	packing_rkey(rkeys_bsr, (unsigned char*)rkeys);
+	UNROLL_ROUNDS
 	for(int i = 1; i < 15; i++) {
 		packing_rkey(rkeys_bsr + i*32, (unsigned char*)(rkeys + i*4));
+		UNROLL_WORDS
 		for(int j = 0; j < 32; j+=8) {
 			rkeys_bsr[i*32+j+1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
 			rkeys_bsr[i*32+j+2] ^= 0xffffffff; 	// NOT to speed up SBox calculations
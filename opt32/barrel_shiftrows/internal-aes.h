@@ -2,6 +2,42 @@
 #define INTERNAL_AES_H_
 
 #include <stdint.h>
+#include "../common/le-io.h"
+#if defined(AES_PROFILE)
+#include "../profile/profile.h" 	// per-phase cycle counts
+#else 							// hooks expand to nothing (no timer needed)
+#define PROFILE_BEGIN()
+#define PROFILE_END(phase)
+#endif
+
+/******************************************************************************
+* Loop unrolling level, selected at build time with -DAES_UNROLL=<level>:
+* 0: the compiler decides (default, most compact code)
+* 1: partial unrolling, loops over the state words are fully unrolled while
+*    loops over the rounds are unrolled twice
+* 2: full unrolling of all loops
+******************************************************************************/
+#ifndef AES_UNROLL
+#define AES_UNROLL 		0
+#endif
+
+#define AES_PRAGMA(x) 	_Pragma(#x)
+#if defined(__clang__)
+#define AES_UNROLL_N(n) AES_PRAGMA(unroll n)
+#else
+#define AES_UNROLL_N(n) AES_PRAGMA(GCC unroll n)
+#endif
+
+#if AES_UNROLL >= 2
+#define UNROLL_ROUNDS 	AES_UNROLL_N(16)
+#define UNROLL_WORDS 	AES_UNROLL_N(32)
+#elif AES_UNROLL == 1
+#define UNROLL_ROUNDS 	AES_UNROLL_N(2)
+#define UNROLL_WORDS 	AES_UNROLL_N(32)
+#else
+#define UNROLL_ROUNDS
+#define UNROLL_WORDS
+#endif
 
 #define ROR(x,y) 		(((x) >> (y)) | ((x) << (32 - (y))))
 
@@ -11,16 +47,43 @@
 	a ^= (tmp << n);										\
 })
 
-#define LE_LOAD_32(x) 										\
-    ((((uint32_t)((x)[3])) << 24) | 						\
-     (((uint32_t)((x)[2])) << 16) | 						\
-     (((uint32_t)((x)[1])) << 8) | 							\
-      ((uint32_t)((x)[0])))
-
-#define LE_STORE_32(x, y)									\
-	(x)[0] = (y) & 0xff; 									\
-	(x)[1] = ((y) >> 8) & 0xff; 							\
-	(x)[2] = ((y) >> 16) & 0xff; 							\
-	(x)[3] = (y) >> 24;
+/******************************************************************************
+* Packing routine used to rearrange the rkeys to match the barrel-shiftrows.
+* It is about twice more efficient than the 'packing' func. This optimization
+* is possible because the 8 16-byte blocs to pack are all equal.
+* However, if one wants to encrypt 8 blocs in parallel with different keys, the
+* 'packing' function is necessary.
+* Shared by the LUT-based and the bitsliced key schedules.
+******************************************************************************/
+static inline void packing_rkey(uint32_t* rkey_bsr, const unsigned char* rkey) {
+	uint32_t tmp, tmp0, tmp1, tmp2, tmp3;
+	tmp0 = LE_LOAD_32(rkey);
+	tmp1 = LE_LOAD_32(rkey + 4);
+	tmp2 = LE_LOAD_32(rkey + 8);
+	tmp3 = LE_LOAD_32(rkey + 12);
+	SWAPMOVE(tmp0, tmp1, 0x00ff00ff, 8);
+	SWAPMOVE(tmp2, tmp3, 0x00ff00ff, 8);
+	SWAPMOVE(tmp0, tmp2, 0x0000ffff, 16);
+	SWAPMOVE(tmp1, tmp3, 0x0000ffff, 16);
+	UNROLL_WORDS
+	for(int i = 0; i < 8; i++) {
+		rkey_bsr[i] 	= (tmp0 & (0x80808080 >> i)) << i;
+		rkey_bsr[i] 	|= (rkey_bsr[i] >> 1);
+		rkey_bsr[i] 	|= (rkey_bsr[i] >> 2);
+		rkey_bsr[i] 	|= (rkey_bsr[i] >> 4);
+		rkey_bsr[i+8] 	= (tmp1 & (0x80808080 >> i)) << i;
+		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 1);
+		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 2);
+		rkey_bsr[i+8] 	|= (rkey_bsr[i+8] >> 4);
+		rkey_bsr[i+16] 	= (tmp2 & (0x80808080 >> i)) << i;
+		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 1);
+		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 2);
+		rkey_bsr[i+16] 	|= (rkey_bsr[i+16] >> 4);
+		rkey_bsr[i+24] 	= (tmp3 & (0x80808080 >> i)) << i;
+		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 1);
+		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 2);
+		rkey_bsr[i+24] 	|= (rkey_bsr[i+24] >> 4);
+	}
+}
 
 #endif 	// INTERNAL_AES_H_
\ No newline at end of file
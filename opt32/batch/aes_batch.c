@@ -0,0 +1,205 @@
+/******************************************************************************
+* Coalescing of many small encryption requests into full batches of the
+* barrel-shiftrows AES implementations.
+*
+* Encrypting a 16 to 64-byte request with a single call to 'aes128_encrypt'
+* wastes up to 7 of the 8 blocks processed in parallel. Instead, requests that
+* share the same key are submitted to a queue and their blocks are gathered
+* into batches of 8 blocks, a request possibly spanning two batches. The
+* submission queue is the intrusive lock-free MPSC queue from D. Vyukov:
+* producers only perform an atomic exchange, while the consumer dequeues
+* without any atomic read-modify-write operation.
+*
+* To bound the latency, a partial batch is processed as soon as the oldest
+* pending request has waited for 'max_latency' nanoseconds. Note that this
+* deadline is only checked when the consumer polls the queue.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy, memset
+#include <time.h>
+#include "aes_batch.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#define BATCH_YIELD() 	sched_yield()
+#else
+#define BATCH_YIELD()
+#endif
+
+static uint64_t now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/******************************************************************************
+* Initializes an empty queue for the round keys 'rkeys' of the barrel-shiftrows
+* encryption function 'encrypt' (e.g. 'aes128_encrypt'). 'rkeys' must remain
+* valid as long as the queue is in use.
+******************************************************************************/
+void aes_batch_init(aes_batch_queue* q, aes_batch_encrypt_t encrypt,
+				const uint32_t* rkeys, uint64_t max_latency) {
+	atomic_init(&q->stub.next, NULL);
+	atomic_init(&q->head, &q->stub);
+	q->tail = &q->stub;
+	q->pending = NULL;
+	q->pending_last = NULL;
+	q->pending_blocks = 0;
+	q->encrypt = encrypt;
+	q->rkeys = rkeys;
+	q->max_latency = max_latency;
+}
+
+static void enqueue(aes_batch_queue* q, aes_batch_req* req) {
+	aes_batch_req* prev;
+	atomic_store_explicit(&req->next, NULL, memory_order_relaxed);
+	prev = atomic_exchange_explicit(&q->head, req, memory_order_acq_rel);
+	atomic_store_explicit(&prev->next, req, memory_order_release);
+}
+
+/******************************************************************************
+* Returns the oldest submitted request, or NULL if there is none or if the
+* oldest one is still being enqueued by a producer.
+******************************************************************************/
+static aes_batch_req* dequeue(aes_batch_queue* q) {
+	aes_batch_req* tail = q->tail;
+	aes_batch_req* next = atomic_load_explicit(&tail->next,
+							memory_order_acquire);
+	if (tail == &q->stub) {
+		if (!next)
+			return NULL;
+		q->tail = next;
+		tail = next;
+		next = atomic_load_explicit(&tail->next, memory_order_acquire);
+	}
+	if (next) {
+		q->tail = next;
+		return tail;
+	}
+	if (tail != atomic_load_explicit(&q->head, memory_order_acquire))
+		return NULL;
+	enqueue(q, &q->stub); 				// so that 'tail' gets a successor
+	next = atomic_load_explicit(&tail->next, memory_order_acquire);
+	if (next) {
+		q->tail = next;
+		return tail;
+	}
+	return NULL;
+}
+
+/******************************************************************************
+* Submits a request. Can be called from any thread.
+* Returns 0 on success, -1 if the length is not a non-zero multiple of 16.
+******************************************************************************/
+int aes_batch_submit(aes_batch_queue* q, aes_batch_req* req) {
+	if (!req->len || (req->len & 15))
+		return -1;
+	req->issued = 0;
+	req->completed = 0;
+	req->submitted = now();
+	atomic_store_explicit(&req->done, 0, memory_order_relaxed);
+	enqueue(q, req);
+	return 0;
+}
+
+/* Returns 1 if a request without callback has been processed, 0 otherwise */
+int aes_batch_done(aes_batch_req* req) {
+	return atomic_load_explicit(&req->done, memory_order_acquire);
+}
+
+/******************************************************************************
+* Waits until a request without callback has been processed. Another thread
+* is expected to poll the queue in the meantime.
+******************************************************************************/
+void aes_batch_wait(aes_batch_req* req) {
+	while (!aes_batch_done(req))
+		BATCH_YIELD();
+}
+
+/******************************************************************************
+* Moves the submitted requests to the list of pending requests.
+******************************************************************************/
+static void collect(aes_batch_queue* q) {
+	aes_batch_req* req;
+	while ((req = dequeue(q))) {
+		req->pending_next = NULL;
+		if (q->pending_last)
+			q->pending_last->pending_next = req;
+		else
+			q->pending = req;
+		q->pending_last = req;
+		q->pending_blocks += req->len / 16;
+	}
+}
+
+/******************************************************************************
+* Encrypts the next (up to) 8 pending blocks in a single call and completes
+* the requests that are fully processed. Returns the number of completed
+* requests.
+******************************************************************************/
+static size_t process_batch(aes_batch_queue* q) {
+	_Alignas(4) unsigned char buf[16*AES_BATCH_BLOCKS];
+	aes_batch_req* owner[AES_BATCH_BLOCKS];
+	size_t idx[AES_BATCH_BLOCKS], n = 0, ncompleted = 0;
+	aes_batch_req* req = q->pending;
+	while (n < AES_BATCH_BLOCKS && req) { 	// gathers the blocks
+		if (req->issued == req->len / 16) {
+			req = req->pending_next;
+			continue;
+		}
+		memcpy(buf + 16*n, req->in + 16*req->issued, 16);
+		owner[n] = req;
+		idx[n++] = req->issued++;
+	}
+	q->pending_blocks -= n;
+	memset(buf + 16*n, 0x00, 16*(AES_BATCH_BLOCKS - n)); 	// unused lanes
+	q->encrypt(buf, buf, q->rkeys);
+	for(size_t i = 0; i < n; i++) { 		// scatters the blocks
+		memcpy(owner[i]->out + 16*idx[i], buf + 16*i, 16);
+		owner[i]->completed++;
+	}
+	while ((req = q->pending) && req->completed == req->len / 16) {
+		q->pending = req->pending_next;
+		if (!q->pending)
+			q->pending_last = NULL;
+		if (req->callback) 		// 'req' must not be accessed afterwards
+			req->callback(req, req->arg);
+		else
+			atomic_store_explicit(&req->done, 1, memory_order_release);
+		ncompleted++;
+	}
+	return ncompleted;
+}
+
+/******************************************************************************
+* Processes all the full batches that can be formed from the submitted
+* requests, as well as a partial batch if the oldest pending request has
+* exceeded its latency budget. Must only be called by a single thread at a
+* time. Returns the number of completed requests.
+******************************************************************************/
+size_t aes_batch_poll(aes_batch_queue* q) {
+	size_t ncompleted = 0;
+	collect(q);
+	while (q->pending_blocks >= AES_BATCH_BLOCKS)
+		ncompleted += process_batch(q);
+	if (q->pending_blocks && now() - q->pending->submitted >= q->max_latency)
+		ncompleted += process_batch(q);
+	return ncompleted;
+}
+
+/******************************************************************************
+* Processes all the submitted requests regardless of their deadline. Must only
+* be called by a single thread at a time. Returns the number of completed
+* requests.
+******************************************************************************/
+size_t aes_batch_flush(aes_batch_queue* q) {
+	size_t ncompleted = 0;
+	collect(q);
+	while (q->pending_blocks)
+		ncompleted += process_batch(q);
+	return ncompleted;
+}
@@ -0,0 +1,72 @@
+#ifndef AES_BATCH_H_
+#define AES_BATCH_H_
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Number of blocks processed per call to the barrel-shiftrows core */
+#define AES_BATCH_BLOCKS 	8
+
+/* Signature shared by the barrel-shiftrows encryption functions (8 blocks) */
+typedef void (*aes_batch_encrypt_t)(unsigned char*, const unsigned char*,
+				const uint32_t*);
+
+typedef struct aes_batch_req aes_batch_req;
+
+/* Completion callback, run by the thread that processed the request */
+typedef void (*aes_batch_cb)(aes_batch_req* req, void* arg);
+
+/******************************************************************************
+* Encryption request: 'len' bytes (a non-zero multiple of 16) from 'in' are
+* encrypted block by block into 'out' ('in' and 'out' may be equal).
+* If 'callback' is set, it is called once the request is processed and the
+* request belongs to the callback from then on. Otherwise the submitter can
+* poll the completion with 'aes_batch_done' or 'aes_batch_wait'.
+* The remaining fields are private.
+******************************************************************************/
+struct aes_batch_req {
+	unsigned char* out;
+	const unsigned char* in;
+	size_t len;
+	aes_batch_cb callback;
+	void* arg;
+	_Atomic(aes_batch_req*) next; 		// link in the submission queue
+	aes_batch_req* pending_next; 		// link in the list of pending requests
+	size_t issued, completed; 			// number of blocks
+	uint64_t submitted; 				// submission time, in nanoseconds
+	atomic_int done;
+};
+
+/******************************************************************************
+* Coalescer of the requests encrypted under the same key: any number of
+* threads submit requests through a lock-free MPSC queue while a single
+* consumer gathers their blocks into full batches of 8 blocks. A partial
+* batch is only processed once the oldest pending request has waited for
+* more than 'max_latency' nanoseconds, or when flushing.
+******************************************************************************/
+typedef struct {
+	_Atomic(aes_batch_req*) head; 		// last submitted request
+	aes_batch_req* tail; 				// next request to dequeue (consumer)
+	aes_batch_req stub;
+	aes_batch_req* pending; 			// dequeued, not completed yet (FIFO)
+	aes_batch_req* pending_last;
+	size_t pending_blocks; 				// blocks not issued yet
+	aes_batch_encrypt_t encrypt;
+	const uint32_t* rkeys;
+	uint64_t max_latency;
+} aes_batch_queue;
+
+void aes_batch_init(aes_batch_queue* q, aes_batch_encrypt_t encrypt,
+				const uint32_t* rkeys, uint64_t max_latency);
+
+/* Producers (any thread) */
+int aes_batch_submit(aes_batch_queue* q, aes_batch_req* req);
+int aes_batch_done(aes_batch_req* req);
+void aes_batch_wait(aes_batch_req* req);
+
+/* Consumer (a single thread at a time) */
+size_t aes_batch_poll(aes_batch_queue* q);
+size_t aes_batch_flush(aes_batch_queue* q);
+
+#endif 	// AES_BATCH_H_
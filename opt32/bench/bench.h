@@ -0,0 +1,43 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define BENCH_NRUNS 	256
+
+/******************************************************************************
+* Cycle counter: TSC on x86, nanoseconds from the monotonic clock otherwise.
+******************************************************************************/
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_UNIT		"cycles"
+static inline uint64_t bench_cycles(void) {
+	return __rdtsc();
+}
+#else
+#include <time.h>
+#define BENCH_UNIT		"ns"
+static inline uint64_t bench_cycles(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+#endif
+
+/******************************************************************************
+* Runs 'stmt' BENCH_NRUNS times and stores the minimum elapsed time in 'res'.
+******************************************************************************/
+#define BENCH(res, stmt)	({									\
+	uint64_t _t;												\
+	res = UINT64_MAX;											\
+	for(int _i = 0; _i < BENCH_NRUNS; _i++) {					\
+		_t = bench_cycles();									\
+		stmt;													\
+		_t = bench_cycles() - _t;								\
+		if (_t < res)											\
+			res = _t;											\
+	}															\
+})
+
+#endif 	// BENCH_H_
@@ -0,0 +1,157 @@
+/******************************************************************************
+* Cost of the fixsliced and barrel-shiftrows AES cores for a given loop
+* unrolling level (see 'AES_UNROLL' in the 'internal-aes.h' files), together
+* with a known-answer test from FIPS-197 so that all variants can be checked
+* against each other. The '_reg' functions refer to the register-resident
+* variants of the fixsliced cores ('fixslicing/aes_encrypt_reg.c').
+*
+* Build (from the 'opt32' directory) with 'make', which produces one binary per
+* unrolling level ('make check' runs them all), or by hand:
+*	gcc -O3 -DAES_UNROLL=0 -o bench_aes_unroll0 bench/bench_aes.c \
+*		fixslicing/aes_encrypt.c fixslicing/aes_encrypt_reg.c \
+*		fixslicing/aes_keyschedule.c fixslicing/aes_keyschedule_lut.c \
+*		barrel_shiftrows/aes_encrypt.c barrel_shiftrows/aes_keyschedule_lut.c
+*	gcc -O3 -DAES_UNROLL=1 -o bench_aes_unroll1 bench/bench_aes.c \
+*		fixslicing/aes_encrypt.c fixslicing/aes_encrypt_reg.c \
+*		fixslicing/aes_keyschedule.c fixslicing/aes_keyschedule_lut.c \
+*		barrel_shiftrows/aes_encrypt.c barrel_shiftrows/aes_keyschedule_lut.c
+*	gcc -O3 -DAES_UNROLL=2 -o bench_aes_unroll2 bench/bench_aes.c \
+*		fixslicing/aes_encrypt.c fixslicing/aes_encrypt_reg.c \
+*		fixslicing/aes_keyschedule.c fixslicing/aes_keyschedule_lut.c \
+*		barrel_shiftrows/aes_encrypt.c barrel_shiftrows/aes_keyschedule_lut.c
+* Code size can be compared with 'size -t' on the resulting object files.
+* Likewise, the S-box circuit can be selected with -DAES_SBOX=<circuit> (see
+* 'common/sbox.h') to find out which one is the fastest on a given core.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h>
+#include "../fixslicing/aes.h"
+#include "../barrel_shiftrows/aes.h"
+#include "bench.h"
+
+#ifndef AES_UNROLL
+#define AES_UNROLL 		0
+#endif
+#ifndef AES_SBOX
+#define AES_SBOX 		0
+#endif
+
+/* FIPS-197, appendix C.1 and C.3 */
+static const unsigned char key[32] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+static const unsigned char ptext[16] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+	0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const unsigned char ctext128[16] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+	0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+static const unsigned char ctext256[16] = {
+	0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+	0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+static int failures;
+
+static void check(const char* name, const unsigned char* out,
+				const unsigned char* expected, int nblocks) {
+	for(int i = 0; i < nblocks; i++) {
+		if (memcmp(out + 16*i, expected, 16)) {
+			printf("  %s: KAT FAILED\n", name);
+			failures++;
+			return;
+		}
+	}
+}
+
+/******************************************************************************
+* Prints the elapsed time, and the cost per byte if 'nblocks' were processed.
+******************************************************************************/
+static void report(const char* name, uint64_t t, int nblocks) {
+	printf("  %-26s %8llu %s", name, (unsigned long long)t, BENCH_UNIT);
+	if (nblocks)
+		printf(" (%.2f %s per byte)", (double)t / (16*nblocks), BENCH_UNIT);
+	printf("\n");
+}
+
+static void bench_fixslicing(void) {
+	unsigned char out[32];
+	uint32_t rkeys[120];
+	uint64_t t;
+	printf("fixslicing\n");
+	BENCH(t, aes128_keyschedule_ffs(rkeys, key, key));
+	report("aes128_keyschedule_ffs", t, 0);
+	BENCH(t, aes128_keyschedule_ffs_lut(rkeys, key));
+	report("aes128_keyschedule_ffs_lut", t, 0);
+	BENCH(t, aes128_encrypt_ffs(out, out+16, ptext, ptext, rkeys));
+	report("aes128_encrypt_ffs", t, 2);
+	check("aes128_encrypt_ffs", out, ctext128, 2);
+	BENCH(t, aes128_encrypt_ffs_reg(out, out+16, ptext, ptext, rkeys));
+	report("aes128_encrypt_ffs_reg", t, 2);
+	check("aes128_encrypt_ffs_reg", out, ctext128, 2);
+	BENCH(t, aes128_keyschedule_sfs(rkeys, key, key));
+	report("aes128_keyschedule_sfs", t, 0);
+	BENCH(t, aes128_keyschedule_sfs_lut(rkeys, key));
+	report("aes128_keyschedule_sfs_lut", t, 0);
+	BENCH(t, aes128_encrypt_sfs(out, out+16, ptext, ptext, rkeys));
+	report("aes128_encrypt_sfs", t, 2);
+	check("aes128_encrypt_sfs", out, ctext128, 2);
+	BENCH(t, aes128_encrypt_sfs_reg(out, out+16, ptext, ptext, rkeys));
+	report("aes128_encrypt_sfs_reg", t, 2);
+	check("aes128_encrypt_sfs_reg", out, ctext128, 2);
+	BENCH(t, aes256_keyschedule_ffs(rkeys, key, key));
+	report("aes256_keyschedule_ffs", t, 0);
+	BENCH(t, aes256_keyschedule_ffs_lut(rkeys, key));
+	report("aes256_keyschedule_ffs_lut", t, 0);
+	BENCH(t, aes256_encrypt_ffs(out, out+16, ptext, ptext, rkeys));
+	report("aes256_encrypt_ffs", t, 2);
+	check("aes256_encrypt_ffs", out, ctext256, 2);
+	BENCH(t, aes256_encrypt_ffs_reg(out, out+16, ptext, ptext, rkeys));
+	report("aes256_encrypt_ffs_reg", t, 2);
+	check("aes256_encrypt_ffs_reg", out, ctext256, 2);
+	BENCH(t, aes256_keyschedule_sfs(rkeys, key, key));
+	report("aes256_keyschedule_sfs", t, 0);
+	BENCH(t, aes256_keyschedule_sfs_lut(rkeys, key));
+	report("aes256_keyschedule_sfs_lut", t, 0);
+	BENCH(t, aes256_encrypt_sfs(out, out+16, ptext, ptext, rkeys));
+	report("aes256_encrypt_sfs", t, 2);
+	check("aes256_encrypt_sfs", out, ctext256, 2);
+	BENCH(t, aes256_encrypt_sfs_reg(out, out+16, ptext, ptext, rkeys));
+	report("aes256_encrypt_sfs_reg", t, 2);
+	check("aes256_encrypt_sfs_reg", out, ctext256, 2);
+}
+
+static void bench_barrel_shiftrows(void) {
+	unsigned char in[128], out[128];
+	uint32_t rkeys[480];
+	uint64_t t;
+	printf("barrel_shiftrows\n");
+	for(int i = 0; i < 8; i++)
+		memcpy(in + 16*i, ptext, 16);
+	BENCH(t, aes128_keyschedule_lut(rkeys, key));
+	report("aes128_keyschedule_lut", t, 0);
+	BENCH(t, aes128_encrypt(out, in, rkeys));
+	report("aes128_encrypt", t, 8);
+	check("aes128_encrypt", out, ctext128, 8);
+	BENCH(t, aes256_keyschedule_lut(rkeys, key));
+	report("aes256_keyschedule_lut", t, 0);
+	BENCH(t, aes256_encrypt(out, in, rkeys));
+	report("aes256_encrypt", t, 8);
+	check("aes256_encrypt", out, ctext256, 8);
+}
+
+int main(void) {
+	printf("AES_UNROLL=%d AES_SBOX=%d\n", AES_UNROLL, AES_SBOX);
+	bench_fixslicing();
+	bench_barrel_shiftrows();
+	return failures != 0;
+}
@@ -0,0 +1,112 @@
+/******************************************************************************
+* Throughput of small (16 to 64-byte) encryption requests issued by several
+* threads, either encrypted with one barrel-shiftrows call each or coalesced
+* into full batches through the submission queue of 'batch/aes_batch.c'.
+* The outputs of both approaches are compared.
+*
+* Build (from the 'opt32' directory):
+*	gcc -O3 -pthread -o bench_batch bench/bench_batch.c batch/aes_batch.c \
+*		barrel_shiftrows/aes_encrypt.c barrel_shiftrows/aes_keyschedule_lut.c
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "../barrel_shiftrows/aes.h"
+#include "../batch/aes_batch.h"
+
+#define NTHREADS 		4
+#define NREQS 			4096 		// per thread
+#define MAX_LATENCY 	20000 		// nanoseconds
+
+static uint32_t rkeys[352];
+static aes_batch_queue queue;
+static atomic_int nproducers;
+static unsigned char in[NTHREADS][NREQS][64];
+static unsigned char out[NTHREADS][NREQS][64];
+static unsigned char ref[NTHREADS][NREQS][64];
+
+static size_t req_len(int t, int i) {
+	return 16 * (1 + (t + i) % 4);
+}
+
+static uint64_t now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void* producer(void* arg) {
+	int t = (int)(intptr_t)arg;
+	static aes_batch_req reqs[NTHREADS][NREQS];
+	for(int i = 0; i < NREQS; i++) {
+		aes_batch_req* req = &reqs[t][i];
+		req->in = in[t][i];
+		req->out = out[t][i];
+		req->len = req_len(t, i);
+		req->callback = NULL;
+		aes_batch_submit(&queue, req);
+	}
+	for(int i = 0; i < NREQS; i++)
+		aes_batch_wait(&reqs[t][i]);
+	atomic_fetch_sub(&nproducers, 1);
+	return NULL;
+}
+
+static void* consumer(void* arg) {
+	(void)arg;
+	while (atomic_load(&nproducers))
+		aes_batch_poll(&queue);
+	aes_batch_flush(&queue);
+	return NULL;
+}
+
+int main(void) {
+	unsigned char key[16] = {0}, buf[128];
+	pthread_t threads[NTHREADS], worker;
+	uint64_t t;
+	for(int i = 0; i < NTHREADS; i++)
+		for(int j = 0; j < NREQS; j++)
+			for(int k = 0; k < 64; k++)
+				in[i][j][k] = i ^ (j * 7) ^ (k * 13);
+	aes128_keyschedule_lut(rkeys, key);
+	// baseline: one 8-block call per request
+	t = now();
+	for(int i = 0; i < NTHREADS; i++) {
+		for(int j = 0; j < NREQS; j++) {
+			memcpy(buf, in[i][j], req_len(i, j));
+			aes128_encrypt(buf, buf, rkeys);
+			memcpy(ref[i][j], buf, req_len(i, j));
+		}
+	}
+	t = now() - t;
+	printf("1 call per request:   %8.1f ns per request\n",
+		(double)t / (NTHREADS*NREQS));
+	// coalesced requests
+	aes_batch_init(&queue, aes128_encrypt, rkeys, MAX_LATENCY);
+	atomic_init(&nproducers, NTHREADS);
+	t = now();
+	pthread_create(&worker, NULL, consumer, NULL);
+	for(int i = 0; i < NTHREADS; i++)
+		pthread_create(&threads[i], NULL, producer, (void*)(intptr_t)i);
+	for(int i = 0; i < NTHREADS; i++)
+		pthread_join(threads[i], NULL);
+	pthread_join(worker, NULL);
+	t = now() - t;
+	printf("coalesced requests:   %8.1f ns per request (%d threads)\n",
+		(double)t / (NTHREADS*NREQS), NTHREADS);
+	for(int i = 0; i < NTHREADS; i++) {
+		for(int j = 0; j < NREQS; j++) {
+			if (memcmp(out[i][j], ref[i][j], req_len(i, j))) {
+				printf("mismatch (thread %d, request %d)\n", i, j);
+				return 1;
+			}
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,274 @@
+/******************************************************************************
+* Throughput of AES-128-CCM (fully-fixsliced), which computes the CBC-MAC and
+* the keystream within the same core call (see 'modes/aes_ccm.c'), against a
+* straightforward instantiation that spends one call on the CBC-MAC and one
+* call on the keystream for each payload block.
+*
+* Both instantiations are first checked against the examples of RFC 3610 and
+* NIST SP 800-38C (including CCM-8 and the 2^16-byte additional data of the
+* 4th example of SP 800-38C), and the decryption is checked to reject
+* modified tags and ciphertexts.
+*
+* Build (from the 'opt32' directory):
+*	gcc -O3 -o bench_ccm bench/bench_ccm.c modes/aes_ccm.c \
+*		fixslicing/aes_encrypt.c fixslicing/aes_keyschedule.c
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h>
+#include "../fixslicing/aes.h"
+#include "../modes/modes.h"
+#include "bench.h"
+
+typedef void (*fs_encrypt_t)(unsigned char*, unsigned char*,
+				const unsigned char*, const unsigned char*, const uint32_t*);
+
+static const size_t sizes[] = {16, 64, 256, 1024, 8192};
+
+static unsigned char seq[96]; 			// 0x00, 0x01, ..., 0x5f
+static unsigned char ad64k[65536]; 		// 256 times 0x00, 0x01, ..., 0xff
+
+/* RFC 3610, packet vector #1 (CCM-8) */
+static const unsigned char rfc_key[16] = {
+	0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+	0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf
+};
+static const unsigned char rfc_nonce[13] = {
+	0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0,
+	0xa1, 0xa2, 0xa3, 0xa4, 0xa5
+};
+static const unsigned char rfc_ctext[23] = {
+	0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2,
+	0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+	0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84
+};
+static const unsigned char rfc_tag[8] = {
+	0x17, 0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0
+};
+
+/* NIST SP 800-38C, appendix C (K = 40..4f, N = 10..., A = 00..., P = 20...) */
+static const unsigned char ex1_ctext[4] = {0x71, 0x62, 0x01, 0x5b};
+static const unsigned char ex1_tag[4] = {0x4d, 0xac, 0x25, 0x5d};
+static const unsigned char ex2_ctext[16] = {
+	0xd2, 0xa1, 0xf0, 0xe0, 0x51, 0xea, 0x5f, 0x62,
+	0x08, 0x1a, 0x77, 0x92, 0x07, 0x3d, 0x59, 0x3d
+};
+static const unsigned char ex2_tag[6] = {0x1f, 0xc6, 0x4f, 0xbf, 0xac, 0xcd};
+static const unsigned char ex3_ctext[24] = {
+	0xe3, 0xb2, 0x01, 0xa9, 0xf5, 0xb7, 0x1a, 0x7a,
+	0x9b, 0x1c, 0xea, 0xec, 0xcd, 0x97, 0xe7, 0x0b,
+	0x61, 0x76, 0xaa, 0xd9, 0xa4, 0x42, 0x8a, 0xa5
+};
+static const unsigned char ex3_tag[8] = {
+	0x48, 0x43, 0x92, 0xfb, 0xc1, 0xb0, 0x99, 0x51
+};
+static const unsigned char ex4_ctext[32] = {
+	0x69, 0x91, 0x5d, 0xad, 0x1e, 0x84, 0xc6, 0x37,
+	0x6a, 0x68, 0xc2, 0x96, 0x7e, 0x4d, 0xab, 0x61,
+	0x5a, 0xe0, 0xfd, 0x1f, 0xae, 0xc4, 0x4c, 0xc4,
+	0x84, 0x82, 0x85, 0x29, 0x46, 0x3c, 0xcf, 0x72
+};
+static const unsigned char ex4_tag[14] = {
+	0xb4, 0xac, 0x6b, 0xec, 0x93, 0xe8, 0x59, 0x8e,
+	0x7f, 0x0d, 0xad, 0xbc, 0xea, 0x5b
+};
+
+/* AES-256 (K = 40..5f) with the inputs of the 3rd example of SP 800-38C and a
+ * 16-byte tag, and in CCM-8 with the lengths of the RFC 3610 vector. Neither
+ * document covers AES-256: the expected outputs were computed with OpenSSL. */
+static const unsigned char ex3_256_ctext[24] = {
+	0x04, 0xf8, 0x83, 0xae, 0xb3, 0xbd, 0x07, 0x30,
+	0xea, 0xf5, 0x0b, 0xb6, 0xde, 0x4f, 0xa2, 0x21,
+	0x20, 0x34, 0xe4, 0xe4, 0x1b, 0x0e, 0x75, 0xe5
+};
+static const unsigned char ex3_256_tag[16] = {
+	0x9b, 0xba, 0x3f, 0x3a, 0x10, 0x7f, 0x32, 0x39,
+	0xbd, 0x63, 0x90, 0x29, 0x23, 0xf8, 0x03, 0x71
+};
+static const unsigned char ccm8_256_ctext[23] = {
+	0x40, 0x52, 0x7d, 0xbf, 0x45, 0x71, 0x97, 0xdc,
+	0xf6, 0xb4, 0x7b, 0x20, 0xe9, 0x74, 0xd1, 0x74,
+	0x1c, 0x6a, 0xd6, 0x94, 0x8f, 0x9f, 0x0e
+};
+static const unsigned char ccm8_256_tag[8] = {
+	0xc8, 0x53, 0x94, 0x5c, 0xd4, 0x7d, 0x69, 0xed
+};
+
+typedef struct {
+	const char* name;
+	size_t key_len;
+	const unsigned char *key, *nonce, *ad, *ptext, *ctext, *tag;
+	size_t nonce_len, ad_len, len, tag_len;
+} ccm_kat;
+
+static const ccm_kat kats[] = {
+	{"rfc3610 #1", 16, rfc_key, rfc_nonce, seq, seq + 8, rfc_ctext, rfc_tag,
+		13, 8, 23, 8},
+	{"sp800-38c #1", 16, seq + 0x40, seq + 0x10, seq, seq + 0x20, ex1_ctext,
+		ex1_tag, 7, 8, 4, 4},
+	{"sp800-38c #2", 16, seq + 0x40, seq + 0x10, seq, seq + 0x20, ex2_ctext,
+		ex2_tag, 8, 16, 16, 6},
+	{"sp800-38c #3", 16, seq + 0x40, seq + 0x10, seq, seq + 0x20, ex3_ctext,
+		ex3_tag, 12, 20, 24, 8},
+	{"sp800-38c #4", 16, seq + 0x40, seq + 0x10, ad64k, seq + 0x20, ex4_ctext,
+		ex4_tag, 13, sizeof(ad64k), 32, 14},
+	{"aes256 #3", 32, seq + 0x40, seq + 0x10, seq, seq + 0x20, ex3_256_ctext,
+		ex3_256_tag, 12, 20, 24, 16},
+	{"aes256 ccm8", 32, seq + 0x40, seq + 0x10, seq, seq + 0x20,
+		ccm8_256_ctext, ccm8_256_tag, 13, 8, 23, 8},
+};
+
+static int failures;
+
+static void fail(const char* name, const char* what) {
+	printf("  %s: %s FAILED\n", name, what);
+	failures++;
+}
+
+/******************************************************************************
+* Encrypts the block 'x' in place, the 2nd lane of the core being unused.
+******************************************************************************/
+static void encrypt_1lane(unsigned char* x, fs_encrypt_t encrypt,
+				const uint32_t* rkeys) {
+	encrypt(x, x, x, x, rkeys);
+}
+
+/******************************************************************************
+* Straightforward AES-CCM encryption: each block of the CBC-MAC and each
+* keystream block is computed by a separate core call, i.e. 2 calls per
+* payload block.
+******************************************************************************/
+static void ccm_encrypt_2calls(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t len, const unsigned char* ad,
+				size_t ad_len, const unsigned char* nonce, size_t nonce_len,
+				size_t tag_len, fs_encrypt_t encrypt, const uint32_t* rkeys) {
+	unsigned char mac[16] = {0}, ctr[16] = {0}, ks[16];
+	size_t q = 15 - nonce_len, pos, blen, n;
+	mac[0] = ((ad_len != 0) << 6) | (((tag_len - 2)/2) << 3) | (q - 1);
+	memcpy(mac + 1, nonce, nonce_len);
+	for(size_t i = 0, l = len; i < q; i++, l >>= 8)
+		mac[15 - i] = l & 0xff;
+	encrypt_1lane(mac, encrypt, rkeys); 		// B0
+	if (ad_len) {
+		if (ad_len < 0xff00) {
+			mac[0] ^= ad_len >> 8;
+			mac[1] ^= ad_len & 0xff;
+			pos = 2;
+		} else { 							// 32-bit lengths only here
+			mac[0] ^= 0xff;
+			mac[1] ^= 0xfe;
+			for(int i = 0; i < 4; i++)
+				mac[2 + i] ^= (uint32_t)ad_len >> (24 - 8*i);
+			pos = 6;
+		}
+		for(size_t i = 0; i < ad_len; i += n) {
+			n = ad_len - i < 16 - pos ? ad_len - i : 16 - pos;
+			for(size_t j = 0; j < n; j++)
+				mac[pos + j] ^= ad[i + j];
+			encrypt_1lane(mac, encrypt, rkeys);
+			pos = 0;
+		}
+	}
+	ctr[0] = q - 1;
+	memcpy(ctr + 1, nonce, nonce_len);
+	for(size_t i = 0; i < len; i += blen) {
+		blen = len - i < 16 ? len - i : 16;
+		for(int j = 15; j > 0 && ++ctr[j] == 0; j--);
+		memcpy(ks, ctr, 16);
+		encrypt_1lane(ks, encrypt, rkeys); 	// keystream block
+		for(size_t j = 0; j < blen; j++) {
+			mac[j] ^= ptext[i + j];
+			ctext[i + j] = ptext[i + j] ^ ks[j];
+		}
+		encrypt_1lane(mac, encrypt, rkeys); 	// CBC-MAC block
+	}
+	memset(ctr + 16 - q, 0x00, q); 			// A0
+	encrypt_1lane(ctr, encrypt, rkeys);
+	for(size_t i = 0; i < tag_len; i++)
+		tag[i] = mac[i] ^ ctr[i];
+}
+
+/******************************************************************************
+* Checks both instantiations against a known-answer vector, and checks that
+* the decryption returns the plaintext and rejects modified tags and
+* ciphertexts (zeroizing the output).
+******************************************************************************/
+static void check_kat(const ccm_kat* v) {
+	unsigned char out[32], tag[16], bad[32];
+	uint32_t rkeys[120];
+	int aes256 = v->key_len == 32, ret;
+	if (aes256)
+		aes256_keyschedule_ffs(rkeys, v->key, v->key);
+	else
+		aes128_keyschedule_ffs(rkeys, v->key, v->key);
+	ccm_encrypt_2calls(out, tag, v->ptext, v->len, v->ad, v->ad_len, v->nonce,
+				v->nonce_len, v->tag_len,
+				aes256 ? aes256_encrypt_ffs : aes128_encrypt_ffs, rkeys);
+	if (memcmp(out, v->ctext, v->len) || memcmp(tag, v->tag, v->tag_len))
+		fail(v->name, "2-call KAT");
+	ret = (aes256 ? aes256_ccm_encrypt : aes128_ccm_encrypt)(out, tag, v->ptext,
+				v->len, v->ad, v->ad_len, v->nonce, v->nonce_len, v->tag_len,
+				rkeys);
+	if (ret || memcmp(out, v->ctext, v->len) || memcmp(tag, v->tag, v->tag_len))
+		fail(v->name, "encryption KAT");
+	if (v->tag_len == 8) {
+		ret = (aes256 ? aes256_ccm8_encrypt : aes128_ccm8_encrypt)(out, tag,
+				v->ptext, v->len, v->ad, v->ad_len, v->nonce, v->nonce_len,
+				rkeys);
+		if (ret || memcmp(out, v->ctext, v->len) || memcmp(tag, v->tag, 8))
+			fail(v->name, "CCM-8 KAT");
+	}
+	ret = (aes256 ? aes256_ccm_decrypt : aes128_ccm_decrypt)(out, v->ctext,
+				v->len, v->tag, v->ad, v->ad_len, v->nonce, v->nonce_len,
+				v->tag_len, rkeys);
+	if (ret || memcmp(out, v->ptext, v->len))
+		fail(v->name, "decryption KAT");
+	memcpy(tag, v->tag, v->tag_len);
+	tag[v->tag_len - 1] ^= 0x01;
+	ret = (aes256 ? aes256_ccm_decrypt : aes128_ccm_decrypt)(out, v->ctext,
+				v->len, tag, v->ad, v->ad_len, v->nonce, v->nonce_len,
+				v->tag_len, rkeys);
+	memset(bad, 0x00, v->len);
+	if (ret != -1 || memcmp(out, bad, v->len))
+		fail(v->name, "modified tag rejection");
+	memcpy(bad, v->ctext, v->len);
+	bad[0] ^= 0x80;
+	ret = (aes256 ? aes256_ccm_decrypt : aes128_ccm_decrypt)(out, bad, v->len,
+				v->tag, v->ad, v->ad_len, v->nonce, v->nonce_len, v->tag_len,
+				rkeys);
+	if (ret != -1)
+		fail(v->name, "modified ciphertext rejection");
+}
+
+int main(void) {
+	static unsigned char ptext[8192], ctext[8192];
+	unsigned char key[16] = {0}, nonce[13] = {0}, ad[16] = {0}, tag[16];
+	uint32_t rkeys[88];
+	uint64_t t0, t1;
+	for(size_t i = 0; i < sizeof(seq); i++)
+		seq[i] = i;
+	for(size_t i = 0; i < sizeof(ad64k); i++)
+		ad64k[i] = i & 0xff;
+	printf("Known-answer and tag rejection tests\n");
+	for(size_t i = 0; i < sizeof(kats)/sizeof(kats[0]); i++)
+		check_kat(&kats[i]);
+	printf("  %s\n", failures ? "FAILED" : "OK");
+	aes128_keyschedule_ffs(rkeys, key, key);
+	printf("\nAES-128-CCM (13-byte nonce, 16-byte AD, 16-byte tag), "
+				"%s per byte\n", BENCH_UNIT);
+	printf("%8s %14s %14s %8s\n", "bytes", "2 calls/block", "1 call/block",
+				"ratio");
+	for(size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+		size_t len = sizes[i];
+		BENCH(t0, ccm_encrypt_2calls(ctext, tag, ptext, len, ad, 16, nonce, 13,
+				16, aes128_encrypt_ffs, rkeys));
+		BENCH(t1, aes128_ccm_encrypt(ctext, tag, ptext, len, ad, 16, nonce, 13,
+				16, rkeys));
+		printf("%8zu %14.1f %14.1f %8.2f\n", len, (double)t0 / len,
+				(double)t1 / len, (double)t1 / t0);
+	}
+	return failures != 0;
+}
@@ -0,0 +1,87 @@
+/******************************************************************************
+* Latency of AES-128-CTR bursts (barrel-shiftrows) when the keystream is
+* computed on demand against when it has been precomputed into the ring of
+* the stream during idle time (see 'modes/aes_ctr.c'). The output is checked
+* against the keystream computed directly from the core.
+*
+* Build (from the 'opt32' directory):
+*	gcc -O3 -o bench_ctr bench/bench_ctr.c modes/aes_ctr.c \
+*		barrel_shiftrows/aes_encrypt.c barrel_shiftrows/aes_keyschedule_lut.c
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h>
+#include "../barrel_shiftrows/aes.h"
+#include "../modes/modes.h"
+#include "bench.h"
+
+static const size_t bursts[] = {16, 64, 256, 1024};
+
+/******************************************************************************
+* Checks 1024 bytes of keystream, processed in bursts of various lengths,
+* against the counter blocks encrypted directly. Returns 0 if they match.
+******************************************************************************/
+static int check(const uint32_t* rkeys, const unsigned char* iv) {
+	static aes_ctr_stream st;
+	unsigned char ctr[128], ref[1024], buf[1024] = {0};
+	memcpy(ctr, iv, 16);
+	for(int i = 0; i < 64; i++) {
+		if (i % 8)
+			memcpy(ctr + 16*(i % 8), ctr + 16*(i % 8 - 1), 16);
+		else if (i)
+			memcpy(ctr, ctr + 112, 16);
+		if (i) 							// 128-bit big-endian increment
+			for(int j = 15; j >= 0 && ++ctr[16*(i % 8) + j] == 0; j--);
+		if (i % 8 == 7)
+			aes128_encrypt(ref + 16*(i-7), ctr, rkeys);
+	}
+	aes128_ctr_init(&st, iv, rkeys);
+	for(size_t pos = 0, i = 0; pos < 1024; i++) {
+		size_t len = 1 + (i * 37) % 100;
+		len = len < 1024 - pos ? len : 1024 - pos;
+		if (i % 3 == 0)
+			aes_ctr_refill(&st);
+		aes_ctr_crypt(&st, buf + pos, buf + pos, len);
+		pos += len;
+	}
+	return memcmp(buf, ref, 1024);
+}
+
+int main(void) {
+	static aes_ctr_stream st;
+	unsigned char key[16] = {0}, buf[1024] = {0};
+	unsigned char iv[16] = {0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+		0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xff, 0xf0};
+	uint32_t rkeys[352];
+	uint64_t t_cold, t_warm, t;
+	aes128_keyschedule_lut(rkeys, key);
+	if (check(rkeys, iv)) {
+		printf("CTR keystream mismatch\n");
+		return 1;
+	}
+	aes128_ctr_init(&st, iv, rkeys);
+	printf("%8s %14s %14s  (%s per burst)\n", "bytes", "on demand",
+		"precomputed", BENCH_UNIT);
+	for(size_t i = 0; i < sizeof(bursts)/sizeof(bursts[0]); i++) {
+		t_cold = t_warm = UINT64_MAX;
+		for(int j = 0; j < BENCH_NRUNS; j++) {
+			aes_ctr_wipe(&st); 			// empty ring
+			aes128_ctr_init(&st, iv, rkeys);
+			t = bench_cycles();
+			aes_ctr_crypt(&st, buf, buf, bursts[i]);
+			t = bench_cycles() - t;
+			t_cold = t < t_cold ? t : t_cold;
+			aes_ctr_refill(&st); 		// idle time
+			t = bench_cycles();
+			aes_ctr_crypt(&st, buf, buf, bursts[i]);
+			t = bench_cycles() - t;
+			t_warm = t < t_warm ? t : t_warm;
+		}
+		printf("%8zu %14llu %14llu\n", bursts[i], (unsigned long long)t_cold,
+			(unsigned long long)t_warm);
+	}
+	return 0;
+}
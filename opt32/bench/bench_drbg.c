@@ -0,0 +1,217 @@
+/******************************************************************************
+* Known-answer tests and throughput of the AES-256 CTR_DRBG (no derivation
+* function, see 'drbg/ctr_drbg.c').
+*
+* The tests follow the CAVP procedure: instantiate, reseed (with additional
+* input), generate twice (with additional input) and compare the output of
+* the 2nd generate call. If a CAVP response file (e.g. 'CTR_DRBG.rsp' from
+* the 'drbgvectors_pr_false' or 'drbgvectors_no_reseed' directory) is given
+* on the command line, all its '[AES-256 no df]' cases are run. Otherwise,
+* built-in vectors in the same format are used, whose expected outputs were
+* computed with the CTR-DRBG of OpenSSL.
+*
+* The throughput of 'ctr_drbg_random' is then compared with the one of the
+* getrandom system call (on Linux) for various request sizes.
+*
+* Build (from the 'opt32' directory):
+*	gcc -O3 -o bench_drbg bench/bench_drbg.c drbg/ctr_drbg.c \
+*		barrel_shiftrows/aes_encrypt.c barrel_shiftrows/aes_keyschedule.c
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "../drbg/ctr_drbg.h"
+#include "bench.h"
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+static const size_t sizes[] = {16, 64, 256, 1024, 4096, 65536};
+
+/* Hex strings, NULL (or empty) standing for an empty input. A NULL reseed
+ * entropy input means that the instance is not reseeded. */
+typedef struct {
+	const char *entropy, *pers, *entropy_reseed, *add_reseed, *add1, *add2;
+	const char *returned;
+} drbg_kat;
+
+static const drbg_kat kats[] = {
+	{"016735383809c91fff5499c5325925bef667da0e41a5e3f2ca64c8687336c7b8"
+		"47c525f815a8c7e258f6214391d49c71",
+	NULL,
+	"415afb7a76788b03ccda8384f4f995c2a1d4390d0b490c4ee12612b1793d395b"
+		"bb7078eb9b8880c3901a9e18eb76e2e8",
+	NULL, NULL, NULL,
+	"23809efa4a2e017e7b1244a4c14fa73d89d17ca0aaa2a0f46a52c6cf46df7d49"
+		"665c5c73dce7b2578600693f96a86b95ab76257b980a9a544afffc8887a1fa0e"},
+	{"acfcd566a1b89ce24c555b5e4fb1d8267257edf53a8808dcfed279ccc068a44a"
+		"b9f95e28f51dab40eadb6a061a7d1296",
+	"4799ff871c537ebb0d15f38d98f8b73a3e6aedb64f5fa8e74ca9a4b39e27cf2e"
+		"83fcf0b5c65c3fe1ea5aa1de0309019a",
+	"a2bfafa1901f7d96130579785527d9769ea76f93fd49477e92b4c17ba4c72fbe"
+		"f273f71a1fd8eebf394ee6b1e59c3434",
+	"cbff3ae4801e4ac54e38a9ca82e4af8ffe28856910e385e37c069f4c70b837d9"
+		"e1aa1fab710d7fef9ef1f7ab5cef6e84",
+	"8dd5732793b01dc6cb971d0957ba2fbe92c6c61fa314aa454b9747d07f2ea0e8"
+		"71ae5a4a716fc8cf5ce8348c72ddf3cd",
+	"2331cb8bacd7e4bd5348f89eda4fc0740ffd93f7636cae2cea8633e31797fc41"
+		"00937edf739b1785fbb2741542bad23c",
+	"ae1b94b338d5c892f9d5203269a17373f4b130ef8e2b1715c09f7dcfbfadcd79"
+		"aac1bcc0502e5fe81472ff93071cb2368b6cdeda5a0184ec2598937192c5a0b8"},
+};
+
+static int failures, ntests;
+
+/******************************************************************************
+* Decodes at most 'max' bytes from the hex string 's' into 'out'. Returns the
+* number of bytes, or -1 if the string is not valid or too long.
+******************************************************************************/
+static int unhex(unsigned char* out, size_t max, const char* s) {
+	size_t n = 0;
+	unsigned int b;
+	if (!s)
+		return 0;
+	for(; s[0] && s[1]; s += 2, n++) {
+		if (n == max || sscanf(s, "%2x", &b) != 1)
+			return -1;
+		out[n] = b;
+	}
+	return s[0] ? -1 : (int)n;
+}
+
+/******************************************************************************
+* Runs a test case and returns 0 if the 2nd generate call returns the expected
+* bits, -1 otherwise.
+******************************************************************************/
+static int run_kat(const drbg_kat* v) {
+	static ctr_drbg_state st;
+	unsigned char entropy[CTR_DRBG_SEEDLEN], pers[CTR_DRBG_SEEDLEN];
+	unsigned char add[CTR_DRBG_SEEDLEN], expected[256], out[256];
+	int pers_len, add_len, len, ret = 0;
+	len = unhex(expected, sizeof(expected), v->returned);
+	pers_len = unhex(pers, CTR_DRBG_SEEDLEN, v->pers);
+	if (len <= 0 || pers_len < 0 ||
+			unhex(entropy, CTR_DRBG_SEEDLEN, v->entropy) != CTR_DRBG_SEEDLEN)
+		return -1;
+	ret |= ctr_drbg_instantiate(&st, entropy, pers, pers_len);
+	if (v->entropy_reseed) {
+		add_len = unhex(add, CTR_DRBG_SEEDLEN, v->add_reseed);
+		if (add_len < 0 || unhex(entropy, CTR_DRBG_SEEDLEN,
+				v->entropy_reseed) != CTR_DRBG_SEEDLEN)
+			return -1;
+		ret |= ctr_drbg_reseed(&st, entropy, add, add_len);
+	}
+	add_len = unhex(add, CTR_DRBG_SEEDLEN, v->add1);
+	ret |= add_len < 0 ? -1 : ctr_drbg_generate(&st, out, len, add, add_len);
+	add_len = unhex(add, CTR_DRBG_SEEDLEN, v->add2);
+	ret |= add_len < 0 ? -1 : ctr_drbg_generate(&st, out, len, add, add_len);
+	ctr_drbg_uninstantiate(&st);
+	return (ret || memcmp(out, expected, len)) ? -1 : 0;
+}
+
+static void check(const drbg_kat* v, const char* name) {
+	ntests++;
+	if (run_kat(v)) {
+		printf("  %s: KAT FAILED\n", name);
+		failures++;
+	}
+}
+
+/******************************************************************************
+* Runs the '[AES-256 no df]' cases without prediction resistance of a CAVP
+* response file. Returns -1 if the file cannot be opened.
+******************************************************************************/
+static int run_rsp(const char* path) {
+	char line[512], name[64], *val, *end;
+	char fields[7][256];
+	int active = 0, nadd = 0;
+	drbg_kat v;
+	FILE* f = fopen(path, "r");
+	if (!f)
+		return -1;
+	while (fgets(line, sizeof(line), f)) {
+		line[strcspn(line, "\r\n")] = '\0';
+		if (line[0] == '[') {
+			if (strstr(line, " df]")) 		// algorithm section
+				active = !strcmp(line, "[AES-256 no df]");
+			else if (!strcmp(line, "[PredictionResistance = True]"))
+				active = 0;
+			continue;
+		}
+		if (!active || !(val = strstr(line, " = ")))
+			continue;
+		*val = '\0';
+		val += 3;
+		for(end = val + strlen(val); end > val && end[-1] == ' '; *--end = 0);
+		if (!strcmp(line, "COUNT")) {
+			memset(fields, 0x00, sizeof(fields));
+			snprintf(name, sizeof(name), "COUNT %s", val);
+			nadd = 0;
+		} else if (!strcmp(line, "EntropyInput")) {
+			snprintf(fields[0], 256, "%s", val);
+		} else if (!strcmp(line, "PersonalizationString")) {
+			snprintf(fields[1], 256, "%s", val);
+		} else if (!strcmp(line, "EntropyInputReseed")) {
+			snprintf(fields[2], 256, "%s", val);
+		} else if (!strcmp(line, "AdditionalInputReseed")) {
+			snprintf(fields[3], 256, "%s", val);
+		} else if (!strcmp(line, "AdditionalInput") && nadd < 2) {
+			snprintf(fields[4 + nadd++], 256, "%s", val);
+		} else if (!strcmp(line, "ReturnedBits")) {
+			snprintf(fields[6], 256, "%s", val);
+			v.entropy = fields[0];
+			v.pers = fields[1];
+			v.entropy_reseed = fields[2][0] ? fields[2] : NULL;
+			v.add_reseed = fields[3];
+			v.add1 = fields[4];
+			v.add2 = fields[5];
+			v.returned = fields[6];
+			check(&v, name);
+		}
+	}
+	fclose(f);
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	static unsigned char buf[65536];
+	static ctr_drbg_state st;
+	unsigned char entropy[CTR_DRBG_SEEDLEN] = {0};
+	uint64_t t0, t1;
+	if (argc > 1) {
+		printf("CAVP vectors from %s\n", argv[1]);
+		if (run_rsp(argv[1])) {
+			printf("  cannot open %s\n", argv[1]);
+			return 1;
+		}
+	} else {
+		printf("Built-in vectors\n");
+		for(size_t i = 0; i < sizeof(kats)/sizeof(kats[0]); i++)
+			check(&kats[i], "built-in");
+	}
+	printf("  %d/%d passed\n", ntests - failures, ntests);
+	ctr_drbg_instantiate(&st, entropy, NULL, 0);
+	printf("\nAES-256 CTR_DRBG, bytes per %s\n",
+				strcmp(BENCH_UNIT, "cycles") ? BENCH_UNIT : "cycle");
+	printf("%8s %14s %14s %14s\n", "bytes", "generate", "random",
+				"getrandom");
+	for(size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+		size_t len = sizes[i];
+		printf("%8zu", len);
+		BENCH(t0, ctr_drbg_generate(&st, buf, len, NULL, 0));
+		BENCH(t1, ctr_drbg_random(buf, len));
+		printf(" %14.3f %14.3f", (double)len / t0, (double)len / t1);
+#if defined(__linux__)
+		BENCH(t1, getrandom(buf, len, 0));
+		printf(" %14.3f\n", (double)len / t1);
+#else
+		printf(" %14s\n", "-");
+#endif
+	}
+	ctr_drbg_uninstantiate(&st);
+	return failures != 0;
+}
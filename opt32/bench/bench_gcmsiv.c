@@ -0,0 +1,387 @@
+/******************************************************************************
+* Throughput of AES-128-GCM-SIV (fully-fixsliced and barrel-shiftrows) against
+* plain AES-128-GCM built on top of the same cores and the same GHASH.
+*
+* Both AES-GCM-SIV instantiations are first checked against test vectors of
+* RFC 8452 (appendix C, including the counter wrap tests) for AES-128 and
+* AES-256, along with a decryption round trip and the rejection of modified
+* tags and ciphertexts. The AES-GCM baselines are checked against the test
+* cases 1 to 4 of the GCM specification.
+*
+* Build (from the 'opt32' directory):
+*	gcc -O3 -o bench_gcmsiv bench/bench_gcmsiv.c modes/aes_gcmsiv.c \
+*		modes/aes_gcmsiv_ffs.c modes/aes_gcmsiv_bsr.c gf128/gf128.c \
+*		gf128/gf128_ctmul.c fixslicing/aes_encrypt.c \
+*		fixslicing/aes_keyschedule.c barrel_shiftrows/aes_encrypt.c \
+*		barrel_shiftrows/aes_keyschedule.c
+* Adding -DMODES_METRICS and 'modes/metrics.c' also reports the lane
+* utilization of the AES-GCM-SIV instantiations for various message lengths.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h>
+#include "../fixslicing/aes.h"
+#include "../barrel_shiftrows/aes.h"
+#include "../gf128/gf128.h"
+#include "../modes/modes.h"
+#include "bench.h"
+
+static const size_t sizes[] = {64, 256, 1024, 8192};
+
+/* Hex strings, the result being the ciphertext followed by the tag */
+typedef struct {
+	const char *key, *nonce, *ad, *ptext, *result;
+} gcmsiv_kat;
+
+/* RFC 8452, appendix C.1 (AES-128), C.2 (AES-256) and C.3 (counter wrap) */
+static const gcmsiv_kat siv_kats[] = {
+	{"01000000000000000000000000000000", "030000000000000000000000", "", "",
+	"dc20e2d83f25705bb49e439eca56de25"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "",
+	"0100000000000000",
+	"b5d839330ac7b786578782fff6013b815b287c22493a364c"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "",
+	"010000000000000000000000",
+	"7323ea61d05932260047d942a4978db357391a0bc4fdec8b0d106639"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "",
+	"01000000000000000000000000000000",
+	"743f7c8077ab25f8624e2e948579cf77303aaf90f6fe21199c6068577437a0c4"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "",
+	"01000000000000000000000000000000" "02000000000000000000000000000000",
+	"84e07e62ba83a6585417245d7ec413a9fe427d6315c09b57ce45f2e3936a9445"
+		"1a8e45dcd4578c667cd86847bf6155ff"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "",
+	"01000000000000000000000000000000" "02000000000000000000000000000000"
+		"03000000000000000000000000000000",
+	"3fd24ce1f5a67b75bf2351f181a475c7b800a5b4d3dcf70106b1eea82fa1d64d"
+		"f42bf7226122fa92e17a40eeaac1201b5e6e311dbf395d35b0fe39c2714388f8"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "",
+	"01000000000000000000000000000000" "02000000000000000000000000000000"
+		"03000000000000000000000000000000" "04000000000000000000000000000000",
+	"2433668f1058190f6d43e360f4f35cd8e475127cfca7028ea8ab5c20f7ab2af0"
+		"2516a2bdcbc08d521be37ff28c152bba36697f25b4cd169c6590d1dd39566d3f"
+		"8a263dd317aa88d56bdf3936dba75bb8"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "01",
+	"0200000000000000",
+	"1e6daba35669f4273b0a1a2560969cdf790d99759abd1508"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "01",
+	"020000000000000000000000",
+	"296c7889fd99f41917f4462008299c5102745aaa3a0c469fad9e075a"},
+	{"01000000000000000000000000000000", "030000000000000000000000", "01",
+	"02000000000000000000000000000000",
+	"e2b0c5da79a901c1745f700525cb335b8f8936ec039e4e4bb97ebd8c4457441f"},
+	{"e66021d5eb8e4f4066d4adb9c33560e4", "f46e44bb3da0015c94f70887", "", "",
+	"a4194b79071b01a87d65f706e3949578"},
+	{"36864200e0eaf5284d884a0e77d31646", "bae8e37fc83441b16034566b",
+	"46bb91c3c5", "7a806c",
+	"af60eb711bd85bc1e4d3e0a462e074eea428a8"},
+	{"01000000000000000000000000000000" "00000000000000000000000000000000",
+	"030000000000000000000000", "", "",
+	"07f5f4169bbf55a8400cd47ea6fd400f"},
+	{"01000000000000000000000000000000" "00000000000000000000000000000000",
+	"030000000000000000000000", "", "0100000000000000",
+	"c2ef328e5c71c83b843122130f7364b761e0b97427e3df28"},
+	{"01000000000000000000000000000000" "00000000000000000000000000000000",
+	"030000000000000000000000", "", "010000000000000000000000",
+	"9aab2aeb3faa0a34aea8e2b18ca50da9ae6559e48fd10f6e5c9ca17e"},
+	{"01000000000000000000000000000000" "00000000000000000000000000000000",
+	"030000000000000000000000", "", "01000000000000000000000000000000",
+	"85a01b63025ba19b7fd3ddfc033b3e76c9eac6fa700942702e90862383c6c366"},
+	{"00000000000000000000000000000000" "00000000000000000000000000000000",
+	"000000000000000000000000", "",
+	"000000000000000000000000000000004db923dc793ee6497c76dcc03a98e108",
+	"f3f80f2cf0cb2dd9c5984fcda908456cc537703b5ba70324a6793a7bf218d3ea"
+		"ffffffff000000000000000000000000"},
+	{"00000000000000000000000000000000" "00000000000000000000000000000000",
+	"000000000000000000000000", "",
+	"eb3640277c7ffd1303c7a542d02d3e4c0000000000000000",
+	"18ce4f0b8cb4d0cac65fea8f79257b20888e53e72299e56d"
+		"ffffffff000000000000000000000000"},
+};
+
+/* GCM specification, test cases 1 to 4 (AES-128, 96-bit IV) */
+static const gcmsiv_kat gcm_kats[] = {
+	{"00000000000000000000000000000000", "000000000000000000000000", "", "",
+	"58e2fccefa7e3061367f1d57a4e7455a"},
+	{"00000000000000000000000000000000", "000000000000000000000000", "",
+	"00000000000000000000000000000000",
+	"0388dace60b6a392f328c2b971b2fe78ab6e47d42cec13bdf53a67b21257bddf"},
+	{"feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888", "",
+	"d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+		"1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+	"42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+		"21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091473f5985"
+		"4d5c2af327cd64a62cf35abd2ba6fab4"},
+	{"feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+	"feedfacedeadbeeffeedfacedeadbeefabaddad2",
+	"d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72"
+		"1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39",
+	"42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e"
+		"21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091"
+		"5bc94fbc3221a5db94fae95ae7121a47"},
+};
+
+static int failures;
+
+static void fail(const char* name, int idx, const char* what) {
+	printf("  %s #%d: %s FAILED\n", name, idx, what);
+	failures++;
+}
+
+/******************************************************************************
+* Decodes the hex string 's' into 'out' and returns the number of bytes.
+******************************************************************************/
+static size_t unhex(unsigned char* out, const char* s) {
+	size_t n = 0;
+	unsigned int b;
+	for(; s[0] && s[1]; s += 2, n++) {
+		sscanf(s, "%2x", &b);
+		out[n] = b;
+	}
+	return n;
+}
+
+/******************************************************************************
+* Increments the 32-bit big-endian counter in the last 4 bytes of the block.
+******************************************************************************/
+static void inc32(unsigned char* ctr) {
+	for(int i = 15; i > 11 && ++ctr[i] == 0; i--);
+}
+
+/******************************************************************************
+* Computes GHASH over the padded AD, ciphertext and length block and XORs the
+* result with the encrypted pre-counter block to get the tag.
+******************************************************************************/
+static void gcm_tag(unsigned char* tag, const unsigned char* h,
+				const unsigned char* ek_j0, const unsigned char* ad,
+				size_t ad_len, const unsigned char* ctext, size_t len) {
+	unsigned char length_block[16];
+	gf128_key key;
+	ghash_init(&key, h);
+	memset(tag, 0x00, 16);
+	for(int i = 0; i < 8; i++) {
+		length_block[7 - i] = ((uint64_t)ad_len << 3) >> (8*i);
+		length_block[15 - i] = ((uint64_t)len << 3) >> (8*i);
+	}
+	ghash_update(tag, &key, ad, ad_len);
+	ghash_update(tag, &key, ctext, len);
+	ghash_update(tag, &key, length_block, 16);
+	for(int i = 0; i < 16; i++)
+		tag[i] ^= ek_j0[i];
+}
+
+/******************************************************************************
+* AES-128-GCM encryption (96-bit nonce) with the fully-fixsliced core: H and
+* E(J0) are computed within the same call, then 2 counter blocks per call.
+******************************************************************************/
+static void gcm_encrypt_ffs(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t len, const unsigned char* ad,
+				size_t ad_len, const unsigned char* nonce, const uint32_t* rkeys) {
+	unsigned char h[16] = {0}, j0[16] = {0}, ek_j0[16], ctr[32], ks[32];
+	size_t blen;
+	memcpy(j0, nonce, 12);
+	j0[15] = 1;
+	aes128_encrypt_ffs(h, ek_j0, h, j0, rkeys);
+	memcpy(ctr, j0, 16);
+	inc32(ctr);
+	for(size_t i = 0; i < len; i += blen) {
+		memcpy(ctr + 16, ctr, 16);
+		inc32(ctr + 16);
+		aes128_encrypt_ffs(ks, ks + 16, ctr, ctr + 16, rkeys);
+		blen = len - i < 32 ? len - i : 32;
+		for(size_t j = 0; j < blen; j++)
+			ctext[i + j] = ptext[i + j] ^ ks[j];
+		memcpy(ctr, ctr + 16, 16);
+		inc32(ctr);
+	}
+	gcm_tag(tag, h, ek_j0, ad, ad_len, ctext, len);
+}
+
+/******************************************************************************
+* AES-128-GCM encryption (96-bit nonce) with the barrel-shiftrows core: H and
+* E(J0) are computed within the same call, then 8 counter blocks per call.
+******************************************************************************/
+static void gcm_encrypt_bsr(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t len, const unsigned char* ad,
+				size_t ad_len, const unsigned char* nonce, const uint32_t* rkeys) {
+	unsigned char blocks[128] = {0}, ctr[128], ks[128];
+	size_t blen;
+	memcpy(blocks + 16, nonce, 12);
+	blocks[31] = 1;
+	memcpy(ctr, blocks + 16, 16);
+	inc32(ctr);
+	for(int i = 1; i < 8; i++) {
+		memcpy(ctr + i*16, ctr + (i-1)*16, 16);
+		inc32(ctr + i*16);
+	}
+	aes128_encrypt(blocks, blocks, rkeys); 	// H and E(J0)
+	for(size_t i = 0; i < len; i += blen) {
+		aes128_encrypt(ks, ctr, rkeys);
+		blen = len - i < 128 ? len - i : 128;
+		for(size_t j = 0; j < blen; j++)
+			ctext[i + j] = ptext[i + j] ^ ks[j];
+		for(int j = 0; j < 8; j++)
+			for(int k = 0; k < 8; k++)
+				inc32(ctr + j*16);
+	}
+	gcm_tag(tag, blocks, blocks + 16, ad, ad_len, ctext, len);
+}
+
+typedef int (*siv_encrypt_t)(unsigned char*, unsigned char*,
+				const unsigned char*, size_t, const unsigned char*, size_t,
+				const unsigned char*, const uint32_t*);
+typedef int (*siv_decrypt_t)(unsigned char*, const unsigned char*, size_t,
+				const unsigned char*, const unsigned char*, size_t,
+				const unsigned char*, const uint32_t*);
+
+/******************************************************************************
+* Checks an AES-GCM-SIV instantiation against a known-answer vector, and checks
+* that the decryption returns the plaintext and rejects modified tags and
+* ciphertexts (zeroizing the output).
+******************************************************************************/
+static void check_siv(const gcmsiv_kat* v, int idx, const char* name,
+				siv_encrypt_t encrypt, siv_decrypt_t decrypt,
+				const uint32_t* rkeys) {
+	unsigned char nonce[12], ad[16], ptext[64], result[80];
+	unsigned char out[64], tag[16], zeros[64] = {0};
+	size_t ad_len, len;
+	unhex(nonce, v->nonce);
+	ad_len = unhex(ad, v->ad);
+	len = unhex(ptext, v->ptext);
+	unhex(result, v->result);
+	if (encrypt(out, tag, ptext, len, ad, ad_len, nonce, rkeys) ||
+			memcmp(out, result, len) || memcmp(tag, result + len, 16))
+		fail(name, idx, "encryption KAT");
+	if (decrypt(out, result, len, result + len, ad, ad_len, nonce, rkeys) ||
+			memcmp(out, ptext, len))
+		fail(name, idx, "decryption");
+	memcpy(tag, result + len, 16);
+	tag[15] ^= 0x01;
+	memset(out, 0xff, len);
+	if (decrypt(out, result, len, tag, ad, ad_len, nonce, rkeys) != -1 ||
+			memcmp(out, zeros, len))
+		fail(name, idx, "modified tag rejection");
+	if (len) {
+		result[0] ^= 0x80;
+		if (decrypt(out, result, len, result + len, ad, ad_len, nonce,
+				rkeys) != -1)
+			fail(name, idx, "modified ciphertext rejection");
+	}
+}
+
+/******************************************************************************
+* Checks the AES-GCM baseline ('gcm_encrypt_ffs' or 'gcm_encrypt_bsr') against
+* a known-answer vector.
+******************************************************************************/
+static void check_gcm(const gcmsiv_kat* v, int idx, const char* name,
+				void (*encrypt)(unsigned char*, unsigned char*,
+					const unsigned char*, size_t, const unsigned char*, size_t,
+					const unsigned char*, const uint32_t*),
+				const uint32_t* rkeys) {
+	unsigned char nonce[12], ad[32], ptext[128] = {0}, result[144], tag[16];
+	unsigned char out[128];
+	size_t ad_len, len;
+	unhex(nonce, v->nonce);
+	ad_len = unhex(ad, v->ad);
+	len = unhex(ptext, v->ptext);
+	unhex(result, v->result);
+	encrypt(out, tag, ptext, len, ad, ad_len, nonce, rkeys);
+	if (memcmp(out, result, len) || memcmp(tag, result + len, 16))
+		fail(name, idx, "KAT");
+}
+
+static void check_kats(void) {
+	unsigned char key[32];
+	uint32_t rkeys_ffs[120], rkeys_bsr[480];
+	for(int i = 0; i < (int)(sizeof(siv_kats)/sizeof(siv_kats[0])); i++) {
+		if (unhex(key, siv_kats[i].key) == 16) {
+			aes128_keyschedule_ffs(rkeys_ffs, key, key);
+			aes128_keyschedule(rkeys_bsr, key);
+			check_siv(&siv_kats[i], i, "aes128-gcmsiv-ffs",
+				aes128_gcmsiv_encrypt_ffs, aes128_gcmsiv_decrypt_ffs, rkeys_ffs);
+			check_siv(&siv_kats[i], i, "aes128-gcmsiv-bsr",
+				aes128_gcmsiv_encrypt_bsr, aes128_gcmsiv_decrypt_bsr, rkeys_bsr);
+		} else {
+			aes256_keyschedule_ffs(rkeys_ffs, key, key);
+			aes256_keyschedule(rkeys_bsr, key);
+			check_siv(&siv_kats[i], i, "aes256-gcmsiv-ffs",
+				aes256_gcmsiv_encrypt_ffs, aes256_gcmsiv_decrypt_ffs, rkeys_ffs);
+			check_siv(&siv_kats[i], i, "aes256-gcmsiv-bsr",
+				aes256_gcmsiv_encrypt_bsr, aes256_gcmsiv_decrypt_bsr, rkeys_bsr);
+		}
+	}
+	for(int i = 0; i < (int)(sizeof(gcm_kats)/sizeof(gcm_kats[0])); i++) {
+		unhex(key, gcm_kats[i].key);
+		aes128_keyschedule_ffs(rkeys_ffs, key, key);
+		aes128_keyschedule(rkeys_bsr, key);
+		check_gcm(&gcm_kats[i], i + 1, "gcm-ffs", gcm_encrypt_ffs, rkeys_ffs);
+		check_gcm(&gcm_kats[i], i + 1, "gcm-bsr", gcm_encrypt_bsr, rkeys_bsr);
+	}
+}
+
+#if defined(MODES_METRICS)
+static const size_t metrics_sizes[] = {0, 16, 17, 64, 100, 1024};
+
+/******************************************************************************
+* Runs 'stmt' once and prints the counters recorded by the modes.
+******************************************************************************/
+#define METRICS(name, len, stmt)	do {								\
+	modes_metrics _m;											\
+	modes_metrics_reset();										\
+	stmt;														\
+	modes_metrics_snapshot(&_m);								\
+	printf("%8zu %-12s %6llu %6llu %5.1f%% %8llu\n", len, name,	\
+		(unsigned long long)(_m.fs_batches + _m.bsr_batches),	\
+		(unsigned long long)_m.wasted_lanes,					\
+		100.0 * _m.blocks / (_m.blocks + _m.wasted_lanes),		\
+		(unsigned long long)(_m.keyschedules ?					\
+			_m.bytes / _m.keyschedules : 0));					\
+} while (0)
+#endif
+
+int main(void) {
+	static unsigned char ptext[8192], ctext[8192];
+	unsigned char key[16] = {0}, nonce[12] = {0}, ad[16] = {0}, tag[16];
+	uint32_t rkeys_ffs[88], rkeys_bsr[352];
+	uint64_t t;
+	printf("Known-answer and tag rejection tests\n");
+	check_kats();
+	printf("  %s\n", failures ? "FAILED" : "OK");
+	aes128_keyschedule_ffs(rkeys_ffs, key, key);
+	aes128_keyschedule(rkeys_bsr, key);
+	printf("\nAES-128 (16-byte AD), %s per byte\n", BENCH_UNIT);
+	printf("%8s %14s %14s %14s %14s\n", "bytes", "gcm-ffs", "gcmsiv-ffs",
+				"gcm-bsr", "gcmsiv-bsr");
+	for(size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+		size_t len = sizes[i];
+		printf("%8zu", len);
+		BENCH(t, gcm_encrypt_ffs(ctext, tag, ptext, len, ad, 16, nonce,
+				rkeys_ffs));
+		printf(" %14.1f", (double)t / len);
+		BENCH(t, aes128_gcmsiv_encrypt_ffs(ctext, tag, ptext, len, ad, 16,
+				nonce, rkeys_ffs));
+		printf(" %14.1f", (double)t / len);
+		BENCH(t, gcm_encrypt_bsr(ctext, tag, ptext, len, ad, 16, nonce,
+				rkeys_bsr));
+		printf(" %14.1f", (double)t / len);
+		BENCH(t, aes128_gcmsiv_encrypt_bsr(ctext, tag, ptext, len, ad, 16,
+				nonce, rkeys_bsr));
+		printf(" %14.1f\n", (double)t / len);
+	}
+#if defined(MODES_METRICS)
+	printf("\nLane utilization (16-byte AD)\n");
+	printf("%8s %-12s %6s %6s %6s %8s\n", "bytes", "mode", "batch",
+				"wasted", "used", "bytes/ks");
+	for(size_t i = 0; i < sizeof(metrics_sizes)/sizeof(metrics_sizes[0]); i++) {
+		size_t len = metrics_sizes[i];
+		METRICS("gcmsiv-ffs", len, aes128_gcmsiv_encrypt_ffs(ctext, tag,
+				ptext, len, ad, 16, nonce, rkeys_ffs));
+		METRICS("gcmsiv-bsr", len, aes128_gcmsiv_encrypt_bsr(ctext, tag,
+				ptext, len, ad, 16, nonce, rkeys_bsr));
+	}
+#endif
+	return failures != 0;
+}
@@ -0,0 +1,157 @@
+/******************************************************************************
+* Microbenchmark of the POLYVAL/GHASH carry-less multiplication backends.
+* Known-answer tests from RFC 8452 (Appendices A and C.1) and from the GCM
+* specification (test cases 2 and 4) are run first, followed by a comparison
+* of one-shot and block-by-block updates so that the aggregated reduction is
+* checked on inputs of up to 300 bytes. The program returns a non-zero status
+* if any check fails, whatever the backend.
+* The backend is selected at build time (from the 'opt32' directory):
+*	gcc -O3 -o bench_gf128 bench/bench_gf128.c gf128/gf128.c gf128/gf128_ctmul.c
+*	gcc -O3 -o bench_gf128 bench/bench_gf128.c gf128/gf128.c gf128/gf128_ctmul64.c
+*	gcc -O3 -mpclmul -o bench_gf128 bench/bench_gf128.c gf128/gf128.c \
+*		gf128/gf128_clmul.c
+*	gcc -O3 -mpclmul -mvpclmulqdq -mavx2 -o bench_gf128 bench/bench_gf128.c \
+*		gf128/gf128.c gf128/gf128_clmul.c
+*	gcc -O3 -march=armv8-a+crypto -o bench_gf128 bench/bench_gf128.c \
+*		gf128/gf128.c gf128/gf128_pmull.c
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h>
+#include "../gf128/gf128.h"
+#include "bench.h"
+
+static const size_t sizes[] = {16, 64, 128, 1024, 8192};
+
+/* Hex strings: hash key, input blocks and expected result */
+typedef struct {
+	const char *h, *in, *result;
+	int ghash; 							// 0 for POLYVAL, 1 for GHASH
+} gf128_kat;
+
+static const gf128_kat kats[] = {
+	/* RFC 8452, Appendix A */
+	{"25629347589242761d31f826ba4b757b",
+	"4f4f95668c83dfb6401762bb2d01a262d1a24ddd2721d006bbe45f20d3c9f362",
+	"f7a3b47b846119fae5b7866cf5e5b77e", 0},
+	{"25629347589242761d31f826ba4b757b",
+	"4f4f95668c83dfb6401762bb2d01a262d1a24ddd2721d006bbe45f20d3c9f362",
+	"bd9b3997046731fb96251b91f9c99d7a", 1},
+	/* RFC 8452, Appendix C.1 (64-byte plaintext, no AAD) */
+	{"d9b360279694941ac5dbc6987ada7377",
+	"01000000000000000000000000000000" "02000000000000000000000000000000"
+		"03000000000000000000000000000000" "04000000000000000000000000000000"
+		"00000000000000000002000000000000",
+	"1e39b6d3344d348f6044f89935d1cf78", 0},
+	/* GCM specification, test case 2 */
+	{"66e94bd4ef8a2c3b884cfa59ca342b2e",
+	"0388dace60b6a392f328c2b971b2fe78" "00000000000000000000000000000080",
+	"f38cbb1ad69223dcc3457ae5b6b0f885", 1},
+	/* GCM specification, test case 4 */
+	{"b83b533708bf535d0aa6e52980d53b78",
+	"feedfacedeadbeeffeedfacedeadbeef" "abaddad2000000000000000000000000"
+		"42831ec2217774244b7221b784d0d49c" "e3aa212f2c02a4e035c17e2329aca12e"
+		"21d514b25466931c7d8f6a5aac84aa05" "1ba30b396a0aac973d58e09100000000"
+		"00000000000000a000000000000001e0",
+	"698e57f70e6ecc7fd9463b7260a9ae5f", 1},
+};
+
+static int failures;
+
+/******************************************************************************
+* Decodes the hex string 's' into 'out' and returns the number of bytes.
+******************************************************************************/
+static size_t unhex(unsigned char* out, const char* s) {
+	size_t n = 0;
+	unsigned int b;
+	for(; s[0] && s[1]; s += 2, n++) {
+		sscanf(s, "%2x", &b);
+		out[n] = b;
+	}
+	return n;
+}
+
+/******************************************************************************
+* Absorbs 'len' bytes with a single call if 'step' is 0, 'step' bytes per call
+* otherwise (the last call possibly processing fewer bytes).
+******************************************************************************/
+static void hash(unsigned char* acc, const unsigned char* h, int ghash,
+				const unsigned char* in, size_t len, size_t step) {
+	gf128_key key;
+	size_t n;
+	if (ghash)
+		ghash_init(&key, h);
+	else
+		polyval_init(&key, h);
+	memset(acc, 0x00, 16);
+	do {
+		n = (step && step < len) ? step : len;
+		if (ghash)
+			ghash_update(acc, &key, in, n);
+		else
+			polyval_update(acc, &key, in, n);
+		in += n;
+		len -= n;
+	} while (len);
+}
+
+static void check_kats(void) {
+	static const size_t lens[] = {1, 15, 16, 17, 63, 64, 65, 127, 128, 129,
+		143, 144, 255, 256, 300};
+	unsigned char h[16], in[300], result[16], acc[16], ref[16];
+	size_t len;
+	for(size_t i = 0; i < sizeof(kats)/sizeof(kats[0]); i++) {
+		unhex(h, kats[i].h);
+		len = unhex(in, kats[i].in);
+		unhex(result, kats[i].result);
+		hash(acc, h, kats[i].ghash, in, len, 0);
+		if (memcmp(acc, result, 16)) {
+			printf("  %s KAT #%zu FAILED\n",
+				kats[i].ghash ? "ghash" : "polyval", i);
+			failures++;
+		}
+	}
+	for(int i = 0; i < 300; i++)
+		in[i] = 0x9d * i + 0x5b;
+	for(int ghash = 0; ghash < 2; ghash++) {
+		for(size_t i = 0; i < sizeof(lens)/sizeof(lens[0]); i++) {
+			hash(acc, h, ghash, in, lens[i], 0);
+			hash(ref, h, ghash, in, lens[i], 16);
+			if (memcmp(acc, ref, 16)) {
+				printf("  %s on %zu bytes: aggregated reduction FAILED\n",
+					ghash ? "ghash" : "polyval", lens[i]);
+				failures++;
+			}
+		}
+	}
+}
+
+int main(void) {
+	static unsigned char in[8192];
+	unsigned char h[16], acc[16] = {0};
+	gf128_key key;
+	uint64_t t;
+	for(int i = 0; i < 16; i++)
+		h[i] = 0x25 * (i + 1);
+	printf("backend: %s\n", gf128_impl);
+	check_kats();
+	printf("known-answer tests: %s\n", failures ? "FAILED" : "passed");
+	BENCH(t, polyval_init(&key, h));
+	printf("key powers (H^1..H^%d): %llu %s\n", GF128_NPOWERS,
+				(unsigned long long)t, BENCH_UNIT);
+	printf("%8s %14s %14s  (%s per byte)\n", "bytes", "polyval", "ghash",
+				BENCH_UNIT);
+	for(size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++) {
+		printf("%8zu", sizes[i]);
+		polyval_init(&key, h);
+		BENCH(t, polyval_update(acc, &key, in, sizes[i]));
+		printf(" %14.2f", (double)t / sizes[i]);
+		ghash_init(&key, h);
+		BENCH(t, ghash_update(acc, &key, in, sizes[i]));
+		printf(" %14.2f\n", (double)t / sizes[i]);
+	}
+	return failures != 0;
+}
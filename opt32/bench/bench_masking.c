@@ -0,0 +1,162 @@
+/******************************************************************************
+* Cost of the 1st-order masked fixsliced and barrel-shiftrows AES-128,
+* including the cost of the randomness generation, for different RNG
+* callbacks. The number of random bits consumed per block is reported as
+* well, and the FIPS-197 known-answer test is run with each RNG. The number of random words fetched per RNG call can be set at build
+* time (from the 'opt32' directory):
+*	gcc -O3 -o bench_masking bench/bench_masking.c \
+*		1storder_masking/aes_encrypt.c 1storder_masking/aes_keyschedule.c \
+*		1storder_masking/aes_encrypt_bsr.c \
+*		1storder_masking/aes_keyschedule_bsr.c 1storder_masking/masking.c
+*	gcc -O3 -DMASK_POOL_WORDS=1 -o bench_masking bench/bench_masking.c \
+*		1storder_masking/aes_encrypt.c 1storder_masking/aes_keyschedule.c \
+*		1storder_masking/aes_encrypt_bsr.c \
+*		1storder_masking/aes_keyschedule_bsr.c 1storder_masking/masking.c
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "../1storder_masking/aes.h"
+#include <string.h>
+#include "../1storder_masking/internal-aes.h"
+#include "bench.h"
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+
+/* FIPS-197, appendix C.1 */
+static const unsigned char fips_key[16] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+static const unsigned char fips_ptext[16] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+	0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const unsigned char fips_ctext[16] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+	0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+
+static uint64_t rng_calls;
+static int failures;
+
+/******************************************************************************
+* Fast (non-cryptographic) RNG used to measure the masked core alone.
+******************************************************************************/
+static void xorshift_rng(uint32_t* out, size_t nwords) {
+	static uint32_t x = 0x2545f491;
+	rng_calls++;
+	for(size_t i = 0; i < nwords; i++) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		out[i] = x;
+	}
+}
+
+#if defined(__linux__)
+static void os_rng(uint32_t* out, size_t nwords) {
+	rng_calls++;
+	if (getrandom(out, nwords * sizeof(uint32_t), 0) < 0)
+		perror("getrandom");
+}
+#endif
+
+/******************************************************************************
+* Runs 'stmt' once from an empty pool and stores the number of random bits it
+* consumed in 'res', i.e. the bits fetched from the RNG minus the ones that
+* are left in the pool (drained nibble by nibble until the next RNG call).
+******************************************************************************/
+#define RANDOM_BITS(res, rng, stmt)	do {							\
+	uint64_t _calls;											\
+	masking_set_rng(rng);										\
+	rng_calls = 0;												\
+	stmt;														\
+	_calls = rng_calls;											\
+	res = _calls * MASK_POOL_WORDS * 32;						\
+	while (_calls) {											\
+		random_nibble();										\
+		if (rng_calls != _calls)								\
+			break;												\
+		res -= 4;												\
+	}															\
+	masking_set_rng(rng);										\
+} while (0)
+
+static void check(const char* name, const unsigned char* out, int nblocks) {
+	for(int i = 0; i < nblocks; i++) {
+		if (memcmp(out + 16*i, fips_ctext, 16)) {
+			printf("  %s: KAT FAILED\n", name);
+			failures++;
+			return;
+		}
+	}
+}
+
+/******************************************************************************
+* Runs the FIPS-197 known-answer test on all masked encryption functions, the
+* masks being drawn from the current RNG.
+******************************************************************************/
+static void run_kats(void) {
+	unsigned char in[128], out[128];
+	uint32_t rkeys[385];
+	for(int i = 0; i < 8; i++)
+		memcpy(in + 16*i, fips_ptext, 16);
+	aes128_keyschedule_ffs(rkeys, fips_key, fips_key);
+	aes128_encrypt_ffs(out, out + 16, in, in + 16, rkeys);
+	check("aes128_encrypt_ffs", out, 2);
+	aes128_keyschedule_sfs(rkeys, fips_key, fips_key);
+	aes128_encrypt_sfs(out, out + 16, in, in + 16, rkeys);
+	check("aes128_encrypt_sfs", out, 2);
+	aes128_keyschedule_bsr(rkeys, fips_key);
+	aes128_encrypt_bsr(out, in, rkeys);
+	check("aes128_encrypt_bsr", out, 8);
+}
+
+static void run(const char* name, masking_rng_t rng) {
+	unsigned char key[16] = {0}, ptext[128] = {0}, ctext[128];
+	uint32_t rkeys[385], pool[MASK_POOL_WORDS];
+	uint64_t t, bits;
+	masking_set_rng(rng);
+	printf("%s RNG (%d words per call)\n", name, MASK_POOL_WORDS);
+	run_kats();
+	BENCH(t, rng(pool, MASK_POOL_WORDS));
+	printf("  RNG call:         %8llu %s (%.2f %s per byte of AES)\n",
+		(unsigned long long)t, BENCH_UNIT,
+		(double)t / (MASK_POOL_WORDS * 8 * 32), BENCH_UNIT);
+	BENCH(t, aes128_keyschedule_ffs(rkeys, key, key));
+	printf("  keyschedule_ffs:  %8llu %s\n", (unsigned long long)t, BENCH_UNIT);
+	BENCH(t, aes128_keyschedule_sfs(rkeys, key, key));
+	printf("  keyschedule_sfs:  %8llu %s\n", (unsigned long long)t, BENCH_UNIT);
+	BENCH(t, aes128_keyschedule_bsr(rkeys, key));
+	printf("  keyschedule_bsr:  %8llu %s\n", (unsigned long long)t, BENCH_UNIT);
+	aes128_keyschedule_ffs(rkeys, key, key);
+	BENCH(t, aes128_encrypt_ffs(ctext, ctext, ptext, ptext, rkeys));
+	RANDOM_BITS(bits, rng, aes128_encrypt_ffs(ctext, ctext, ptext, ptext,
+		rkeys));
+	printf("  encrypt_ffs:      %8.2f %s per byte, %.1f random bits/block\n",
+		(double)t / 32, BENCH_UNIT, (double)bits / 2);
+	aes128_keyschedule_sfs(rkeys, key, key);
+	BENCH(t, aes128_encrypt_sfs(ctext, ctext, ptext, ptext, rkeys));
+	RANDOM_BITS(bits, rng, aes128_encrypt_sfs(ctext, ctext, ptext, ptext,
+		rkeys));
+	printf("  encrypt_sfs:      %8.2f %s per byte, %.1f random bits/block\n",
+		(double)t / 32, BENCH_UNIT, (double)bits / 2);
+	aes128_keyschedule_bsr(rkeys, key);
+	BENCH(t, aes128_encrypt_bsr(ctext, ptext, rkeys));
+	RANDOM_BITS(bits, rng, aes128_encrypt_bsr(ctext, ptext, rkeys));
+	printf("  encrypt_bsr:      %8.2f %s per byte, %.1f random bits/block\n",
+		(double)t / 128, BENCH_UNIT, (double)bits / 8);
+}
+
+int main(void) {
+	run("xorshift", xorshift_rng);
+#if defined(__linux__)
+	run("getrandom", os_rng);
+#endif
+	return failures != 0;
+}
@@ -0,0 +1,68 @@
+/******************************************************************************
+* Breakdown of the cost of the fixsliced and barrel-shiftrows AES into their
+* phases (packing, S-box, ShiftRows, MixColumns, AddRoundKey, unpacking), as
+* recorded by the profiling build (see 'profile/profile.h').
+*
+* Build (from the 'opt32' directory):
+*	gcc -O3 -DAES_PROFILE -o bench_profile bench/bench_profile.c \
+*		profile/profile.c fixslicing/aes_encrypt.c fixslicing/aes_keyschedule.c \
+*		barrel_shiftrows/aes_encrypt.c barrel_shiftrows/aes_keyschedule_lut.c
+* Adding -DAES_BYTE_ACCESS shows the cost of packing/unpacking with byte-by-byte
+* loads and stores instead of native word accesses (see 'common/le-io.h').
+* Note that the register-resident variants ('aes_encrypt_reg.c') are not
+* instrumented since their phases are merged by the compiler.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "../fixslicing/aes.h"
+#include "../barrel_shiftrows/aes.h"
+#include "../profile/profile.h"
+
+#if !defined(AES_PROFILE)
+#error "bench_profile requires all sources to be built with -DAES_PROFILE"
+#endif
+
+#define PROFILE_NRUNS 	4096
+
+/******************************************************************************
+* Profiles PROFILE_NRUNS runs of 'stmt' and prints the breakdown.
+******************************************************************************/
+#define PROFILE(name, nblocks, stmt)	({							\
+	profile_stats _stats;										\
+	stmt; 														\
+	profile_reset();											\
+	for(int _i = 0; _i < PROFILE_NRUNS; _i++) {					\
+		stmt;													\
+	}															\
+	profile_get(&_stats);										\
+	profile_report(stdout, name, &_stats, PROFILE_NRUNS, nblocks);	\
+})
+
+int main(void) {
+	unsigned char key[32] = {0}, buf[128] = {0};
+	uint32_t rkeys[480];
+	printf("counter overhead: %llu %s per call (subtracted)\n",
+		(unsigned long long)profile_overhead(), PROFILE_UNIT);
+	aes128_keyschedule_ffs(rkeys, key, key);
+	PROFILE("aes128_encrypt_ffs", 2,
+		aes128_encrypt_ffs(buf, buf+16, buf, buf+16, rkeys));
+	aes128_keyschedule_sfs(rkeys, key, key);
+	PROFILE("aes128_encrypt_sfs", 2,
+		aes128_encrypt_sfs(buf, buf+16, buf, buf+16, rkeys));
+	aes256_keyschedule_ffs(rkeys, key, key);
+	PROFILE("aes256_encrypt_ffs", 2,
+		aes256_encrypt_ffs(buf, buf+16, buf, buf+16, rkeys));
+	aes256_keyschedule_sfs(rkeys, key, key);
+	PROFILE("aes256_encrypt_sfs", 2,
+		aes256_encrypt_sfs(buf, buf+16, buf, buf+16, rkeys));
+	aes128_keyschedule_lut(rkeys, key);
+	PROFILE("aes128_encrypt (barrel-shiftrows)", 8,
+		aes128_encrypt(buf, buf, rkeys));
+	aes256_keyschedule_lut(rkeys, key);
+	PROFILE("aes256_encrypt (barrel-shiftrows)", 8,
+		aes256_encrypt(buf, buf, rkeys));
+	return 0;
+}
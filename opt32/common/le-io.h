@@ -0,0 +1,60 @@
+#ifndef LE_IO_H_
+#define LE_IO_H_
+
+#include <stdint.h>
+#include <string.h> 	// for memcpy
+
+/******************************************************************************
+* Little-endian 32-bit loads and stores of the opt32 AES cores (fixsliced,
+* barrel-shiftrows and masked). On little-endian hosts they compile to native
+* word accesses and on big-endian hosts to native accesses followed by a byte
+* swap, memcpy letting the compiler use unaligned accesses wherever they are
+* allowed. Building with -DAES_ALIGNED_IO allows word accesses on
+* strict-alignment cores too, in which case the input/output buffers passed to
+* the encryption functions must be 4-byte aligned (the modes and the DRBG
+* take care of their own buffers).
+* -DAES_BYTE_ACCESS falls back to byte-by-byte accesses.
+******************************************************************************/
+#if defined(AES_ALIGNED_IO) && defined(__GNUC__)
+#define AES_IO_PTR(x) 		__builtin_assume_aligned((x), 4)
+#else
+#define AES_IO_PTR(x) 		(x)
+#endif
+
+#if !defined(AES_BYTE_ACCESS) && defined(__BYTE_ORDER__) && \
+	(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define LE_SWAP_32(x) 		(x)
+#elif !defined(AES_BYTE_ACCESS) && defined(__BYTE_ORDER__) && \
+	(__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define LE_SWAP_32(x) 		__builtin_bswap32(x)
+#endif
+
+#if defined(LE_SWAP_32)
+static inline uint32_t le_load_32(const unsigned char* x) {
+	uint32_t y;
+	memcpy(&y, AES_IO_PTR(x), 4);
+	return LE_SWAP_32(y);
+}
+
+static inline void le_store_32(unsigned char* x, uint32_t y) {
+	y = LE_SWAP_32(y);
+	memcpy(AES_IO_PTR(x), &y, 4);
+}
+
+#define LE_LOAD_32(x) 		le_load_32(x)
+#define LE_STORE_32(x, y) 	le_store_32((x), (y))
+#else
+#define LE_LOAD_32(x) 										\
+    ((((uint32_t)((x)[3])) << 24) | 						\
+     (((uint32_t)((x)[2])) << 16) | 						\
+     (((uint32_t)((x)[1])) << 8) | 							\
+      ((uint32_t)((x)[0])))
+
+#define LE_STORE_32(x, y)									\
+	(x)[0] = (y) & 0xff; 									\
+	(x)[1] = ((y) >> 8) & 0xff; 							\
+	(x)[2] = ((y) >> 16) & 0xff; 							\
+	(x)[3] = (y) >> 24;
+#endif
+
+#endif 	// LE_IO_H_
@@ -0,0 +1,521 @@
+/******************************************************************************
+* Bitsliced circuits for the AES S-box, selected at build time with
+* -DAES_SBOX=<circuit>:
+* 0: Boyar, Peralta and Calik, 113 gates (32 AND), depth 27 (default).
+*    See http://www.cs.yale.edu/homes/peralta/CircuitStuff/SLP_AES_113.txt
+* 1: Boyar and Peralta (https://eprint.iacr.org/2009/191), whose top and
+*    bottom linear layers are recomputed as balanced XOR trees over the
+*    inputs and the AND outputs, respectively: 130 gates (32 AND), depth 23.
+* 2: same as 1 where all the linear combinations between two AND layers are
+*    recomputed as balanced XOR trees: 164 gates (32 AND), depth 18.
+* The minimal gate count suits in-order cores (e.g. SiFive E31) while lower
+* depths expose more instruction-level parallelism to superscalar cores, at
+* the cost of more instructions and a higher register pressure.
+*
+* The circuits take the 8 words x0, ..., x7 (x0 being the most significant
+* bit of each byte) and overwrite them with the S-box output. Note that the
+* 4 NOT on x1, x2, x6 and x7 are omitted for all circuits since they are
+* moved to the key schedule. The circuits only use XOR and AND, so that the
+* words can be SIMD vectors supporting these operators (e.g. NEON, see
+* 'aarch64/fixslicing') by defining SBOX_WORD to the vector type.
+*
+* This header is shared by the C implementations in 'opt32/fixslicing',
+* 'opt32/barrel_shiftrows' and 'aarch64/fixslicing'. The assembly and masked
+* implementations only come with the default circuit.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#ifndef SBOX_H_
+#define SBOX_H_
+
+#include <stdint.h>
+
+#define AES_SBOX_BPC113 		0
+#define AES_SBOX_BALANCED 		1
+#define AES_SBOX_LOW_DEPTH 		2
+
+#ifndef AES_SBOX
+#define AES_SBOX 		AES_SBOX_BPC113
+#endif
+
+#ifndef SBOX_WORD
+#define SBOX_WORD 		uint32_t
+#endif
+
+#define SBOX_BPC113(x0, x1, x2, x3, x4, x5, x6, x7) do {			\
+	SBOX_WORD t0, t1, t2, t3, t4, t5, t6, t7, t8, t9, t10,		\
+		t11, t12, t13, t14, t15, t16, t17;						\
+	t0 = x3 ^ x5;												\
+	t1 = x0 ^ x6;												\
+	t2 = t1 ^ t0;												\
+	t3 = x4 ^ t2;												\
+	t4 = t3 ^ x5;												\
+	t5 = t2 & t4;												\
+	t6 = t4 ^ x7;												\
+	t7 = t3 ^ x1;												\
+	t8 = x0 ^ x3;												\
+	t9 = t7 ^ t8;												\
+	t10 = t8 & t9;												\
+	t11 = x7 ^ t9;												\
+	t12 = x0 ^ x5;												\
+	t13 = x1 ^ x2;												\
+	t14 = t4 ^ t13;												\
+	t15 = t14 ^ t9;												\
+	t16 = t0 & t15;												\
+	t17 = t16 ^ t10;											\
+	x1 = t14 ^ t12;												\
+	x2 = t12 & t14;												\
+	x2 ^= t10;													\
+	x4 = t13 ^ t9;												\
+	x5 = t1 ^ x4;												\
+	t3 = t1 & x4;												\
+	t10 = x0 ^ x4;												\
+	t13 ^= x7;													\
+	x3 ^= t13;													\
+	t16 = x3 & x7;												\
+	t16 ^= t5;													\
+	t16 ^= x2;													\
+	x1 ^= t16;													\
+	x0 ^= t13;													\
+	t16 = x0 & t11;												\
+	t16 ^= t3;													\
+	x2 ^= t16;													\
+	x2 ^= t10;													\
+	x6 ^= t13;													\
+	t10 = x6 & t13;												\
+	t3 ^= t10;													\
+	t3 ^= t17;													\
+	x5 ^= t3;													\
+	t3 = x6 ^ t12;												\
+	t10 = t3 & t6;												\
+	t5 ^= t10;													\
+	t5 ^= t7;													\
+	t5 ^= t17;													\
+	t7 = t5 & x5;												\
+	t10 = x2 ^ t7;												\
+	t7 ^= x1;													\
+	t5 ^= x1;													\
+	t16 = t5 & t10;												\
+	x1 ^= t16;													\
+	t17 = x1 & x0;												\
+	t11 = x1 & t11;												\
+	t16 = x5 ^ x2;												\
+	t7 &= t16;													\
+	t7 ^= x2;													\
+	t16 = t10 ^ t7;												\
+	x2 &= t16;													\
+	t10 ^= x2;													\
+	t10 &= x1;													\
+	t5 ^= t10;													\
+	t10 = x1 ^ t5;												\
+	x4 &= t10;													\
+	t11 ^= x4;													\
+	t1 &= t10;													\
+	x6 &= t5;													\
+	t10 = t5 & t13;												\
+	x4 ^= t10;													\
+	x5 ^= t7;													\
+	x2 ^= x5;													\
+	x5 = t5 ^ x2;												\
+	t5 = x5 & t14;												\
+	t10 = x5 & t12;												\
+	t12 = t7 ^ x2;												\
+	t4 &= t12;													\
+	t2 &= t12;													\
+	t3 &= x2;													\
+	x2 &= t6;													\
+	x2 ^= t4;													\
+	t13 = x4 ^ x2;												\
+	x3 &= t7;													\
+	x1 ^= t7;													\
+	x5 ^= x1;													\
+	t6 = x5 & t15;												\
+	x4 ^= t6;													\
+	t0 &= x5;													\
+	x5 = x1 & t9;												\
+	x5 ^= x4;													\
+	x1 &= t8;													\
+	t6 = x1 ^ x5;												\
+	t0 ^= x1;													\
+	x1 = t3 ^ t0;												\
+	t15 = x1 ^ x3;												\
+	t2 ^= x1;													\
+	x0 = t2 ^ x5;												\
+	x3 = t2 ^ t13;												\
+	x1 = x3 ^ x5;												\
+	t0 ^= x6;													\
+	x5 = t7 & x7;												\
+	t14 = t4 ^ x5;												\
+	x6 = t1 ^ t14;												\
+	x6 ^= t5;													\
+	x6 ^= x4;													\
+	x2 = t17 ^ x6;												\
+	x5 = t15 ^ x2;												\
+	x2 ^= t6;													\
+	x2 ^= t10;													\
+	t14 ^= t11;													\
+	t0 ^= t14;													\
+	x6 ^= t0;													\
+	x7 = t1 ^ t0;												\
+	x4 = t14 ^ x3;												\
+} while (0)
+
+#define SBOX_BP_BALANCED(x0, x1, x2, x3, x4, x5, x6, x7) do {		\
+	SBOX_WORD l1, l2, l3, l4, l5, l6, l7, l8, l9, l10,			\
+		l11, l12, l13, l14, l15, l16, l17, l18, l19, l20,		\
+		l21, l22, l23, l24, l25, l26, l27, l28, l29, l30,		\
+		l31, l32, l33, l34, l35, l36, l37, l38, l39, l40,		\
+		l41, l42, l43, l44, l45, l46, l47, l48, l49, l50,		\
+		l51, l52, l53, l54, l55, l56, l57, l58, l59, l60,		\
+		l61, l62, l63, l64, l65, l66, l67, l68, t2, t3,			\
+		t4, t5, t6, t7, t8, t9, t10, t11, t12, t13, t14,		\
+		t15, t16, t17, t18, t19, t20, t21, t22, t23, t24,		\
+		t25, t26, t27, t28, t29, t30, t31, t32, t33, t34,		\
+		t35, t36, t37, t38, t39, t40, t41, t42, t43, t44,		\
+		t45, z0, z1, z2, z3, z4, z5, z6, z7, z8, z9, z10,		\
+		z11, z12, z13, z14, z15, z16, z17;						\
+	l1 = x3 ^ x5;												\
+	l2 = x0 ^ x6;												\
+	l3 = x0 ^ x3;												\
+	l4 = x0 ^ x5;												\
+	l5 = x1 ^ x2;												\
+	l6 = l5 ^ x7;												\
+	l7 = x3 ^ x7;												\
+	l8 = l5 ^ l7;												\
+	l9 = x5 ^ x6;												\
+	l10 = l3 ^ l9;												\
+	l11 = x0 ^ x7;												\
+	l12 = l5 ^ l11;												\
+	l13 = x6 ^ x7;												\
+	l14 = l5 ^ l13;												\
+	l15 = l14 ^ l4;												\
+	l16 = x4 ^ x6;												\
+	l17 = l3 ^ l16;												\
+	l18 = x1 ^ x5;												\
+	l19 = l17 ^ l18;											\
+	l20 = l17 ^ x7;												\
+	l21 = l17 ^ l5;												\
+	l22 = l18 ^ l16;											\
+	l23 = l22 ^ x7;												\
+	l24 = x2 ^ x5;												\
+	l25 = l3 ^ l24;												\
+	l26 = l5 ^ l1;												\
+	l27 = l26 ^ l16;											\
+	l28 = l24 ^ l16;											\
+	l29 = x2 ^ x4;												\
+	l30 = l4 ^ l29;												\
+	l31 = l30 ^ x6;												\
+	t2 = l10 & l17;												\
+	t3 = l15 & l20;												\
+	t4 = t3 ^ t2;												\
+	t5 = l8 & x7;												\
+	t6 = t5 ^ t2;												\
+	t7 = l2 & l28;												\
+	t8 = l14 & l6;												\
+	t9 = t8 ^ t7;												\
+	t10 = l12 & l23;											\
+	t11 = t10 ^ t7;												\
+	t12 = l3 & l22;												\
+	t13 = l1 & l25;												\
+	t14 = t13 ^ t12;											\
+	t15 = l4 & l21;												\
+	t16 = t15 ^ t12;											\
+	t17 = t4 ^ t14;												\
+	t18 = t6 ^ t16;												\
+	t19 = t9 ^ t14;												\
+	t20 = t11 ^ t16;											\
+	t21 = t17 ^ l19;											\
+	t22 = t18 ^ l27;											\
+	t23 = t19 ^ l30;											\
+	t24 = t20 ^ l31;											\
+	t25 = t21 ^ t22;											\
+	t26 = t21 & t23;											\
+	t27 = t24 ^ t26;											\
+	t28 = t25 & t27;											\
+	t29 = t28 ^ t22;											\
+	t30 = t23 ^ t24;											\
+	t31 = t22 ^ t26;											\
+	t32 = t31 & t30;											\
+	t33 = t32 ^ t24;											\
+	t34 = t23 ^ t33;											\
+	t35 = t27 ^ t33;											\
+	t36 = t24 & t35;											\
+	t37 = t36 ^ t34;											\
+	t38 = t27 ^ t36;											\
+	t39 = t29 & t38;											\
+	t40 = t25 ^ t39;											\
+	t41 = t40 ^ t37;											\
+	t42 = t29 ^ t33;											\
+	t43 = t29 ^ t40;											\
+	t44 = t33 ^ t37;											\
+	t45 = t42 ^ t41;											\
+	z0 = t44 & l17;												\
+	z1 = t37 & l20;												\
+	z2 = t33 & x7;												\
+	z3 = t43 & l28;												\
+	z4 = t40 & l6;												\
+	z5 = t29 & l23;												\
+	z6 = t42 & l22;												\
+	z7 = t45 & l25;												\
+	z8 = t41 & l21;												\
+	z9 = t44 & l10;												\
+	z10 = t37 & l15;											\
+	z11 = t33 & l8;												\
+	z12 = t43 & l2;												\
+	z13 = t40 & l14;											\
+	z14 = t29 & l12;											\
+	z15 = t42 & l3;												\
+	z16 = t45 & l1;												\
+	z17 = t41 & l4;												\
+	l32 = z3 ^ z4;												\
+	l33 = z6 ^ z7;												\
+	l34 = z9 ^ z10;												\
+	l35 = z15 ^ z16;											\
+	l36 = l32 ^ l33;											\
+	l37 = l34 ^ l35;											\
+	l38 = l36 ^ l37;											\
+	x0 = l38;													\
+	l39 = z0 ^ z1;												\
+	l40 = l33 ^ l39;											\
+	l41 = l37 ^ l40;											\
+	x1 = l41;													\
+	l42 = z0 ^ z2;												\
+	l43 = z6 ^ z8;												\
+	l44 = z12 ^ z14;											\
+	l45 = z15 ^ z17;											\
+	l46 = l42 ^ l43;											\
+	l47 = l44 ^ l45;											\
+	l48 = l46 ^ l47;											\
+	x2 = l48;													\
+	l49 = l39 ^ l32;											\
+	l50 = l37 ^ l49;											\
+	x3 = l50;													\
+	l51 = z1 ^ z2;												\
+	l52 = z4 ^ z5;												\
+	l53 = l51 ^ l52;											\
+	l54 = l37 ^ l53;											\
+	x4 = l54;													\
+	l55 = z7 ^ z8;												\
+	l56 = z10 ^ z11;											\
+	l57 = l42 ^ l32;											\
+	l58 = l44 ^ l35;											\
+	l59 = l55 ^ l56;											\
+	l60 = l57 ^ l58;											\
+	l61 = l60 ^ l59;											\
+	x5 = l61;													\
+	l62 = z12 ^ z13;											\
+	l63 = l52 ^ l55;											\
+	l64 = l35 ^ l62;											\
+	l65 = l63 ^ l64;											\
+	x6 = l65;													\
+	l66 = z3 ^ z5;												\
+	l67 = l42 ^ l66;											\
+	l68 = l64 ^ l67;											\
+	x7 = l68;													\
+} while (0)
+
+#define SBOX_LOW_DEPTH(x0, x1, x2, x3, x4, x5, x6, x7) do {		\
+	SBOX_WORD l1, l2, l3, l4, l5, l6, l7, l8, l9, l10,			\
+		l11, l12, l13, l14, l15, l16, l17, l18, l19, l20,		\
+		l21, l22, l23, l24, l25, l26, l27, l28, l29, l30,		\
+		l31, l32, l33, l34, l35, l36, l37, l38, l39, l40,		\
+		l41, l42, l43, l44, l45, l46, l47, l48, l49, l50,		\
+		l51, l52, l53, l54, l55, l56, l57, l58, l59, l60,		\
+		l61, l62, l63, l64, l65, l66, l67, l68, l69, l70,		\
+		l71, l72, l73, l74, l75, l76, l77, l78, l79, l80,		\
+		l81, l82, l83, l84, l85, l86, l87, l88, l89, l90,		\
+		l91, l92, l93, l94, l95, l96, l97, l98, l99,			\
+		l100, l101, l102, l103, l104, l105, l106, l107,			\
+		l108, l109, l110, l111, l112, l113, l114, l115,			\
+		l116, l117, l118, l119, l120, l121, l122, l123,			\
+		l124, l125, l126, l127, l128, l129, l130, l131,			\
+		l132, t2, t3, t5, t7, t8, t10, t12, t13, t15,			\
+		t26, t28, t32, t36, t39, z0, z1, z2, z3, z4, z5,		\
+		z6, z7, z8, z9, z10, z11, z12, z13, z14, z15,			\
+		z16, z17;												\
+	l1 = x0 ^ x3;												\
+	l2 = x5 ^ x6;												\
+	l3 = l1 ^ l2;												\
+	l4 = x4 ^ x6;												\
+	l5 = l1 ^ l4;												\
+	t2 = l3 & l5;												\
+	l6 = x0 ^ x1;												\
+	l7 = x2 ^ x7;												\
+	l8 = l2 ^ l6;												\
+	l9 = l7 ^ l8;												\
+	l10 = x7 ^ l5;												\
+	t3 = l9 & l10;												\
+	l11 = x1 ^ x3;												\
+	l12 = l7 ^ l11;												\
+	t5 = l12 & x7;												\
+	l13 = x0 ^ x6;												\
+	l14 = x2 ^ x4;												\
+	l15 = l2 ^ l14;												\
+	t7 = l13 & l15;												\
+	l16 = x1 ^ x6;												\
+	l17 = l7 ^ l16;												\
+	l18 = x1 ^ l7;												\
+	t8 = l17 & l18;												\
+	l19 = l6 ^ l7;												\
+	l20 = x1 ^ x4;												\
+	l21 = x7 ^ l2;												\
+	l22 = l20 ^ l21;											\
+	t10 = l19 & l22;											\
+	l23 = l2 ^ l20;												\
+	t12 = l1 & l23;												\
+	l24 = x3 ^ x5;												\
+	l25 = x2 ^ x5;												\
+	l26 = l1 ^ l25;												\
+	t13 = l24 & l26;											\
+	l27 = x0 ^ x5;												\
+	l28 = x1 ^ x2;												\
+	l29 = l28 ^ l5;												\
+	t15 = l27 & l29;											\
+	l30 = l20 ^ l3;												\
+	l31 = t12 ^ t13;											\
+	l32 = t2 ^ l30;												\
+	l33 = t3 ^ l31;												\
+	l34 = l32 ^ l33;											\
+	l35 = l14 ^ l27;											\
+	l36 = l35 ^ t7;												\
+	l37 = t8 ^ l31;												\
+	l38 = l36 ^ l37;											\
+	t26 = l34 & l38;											\
+	l39 = x0 ^ x2;												\
+	l40 = l39 ^ t13;											\
+	l41 = t5 ^ t15;												\
+	l42 = t3 ^ l40;												\
+	l43 = l41 ^ l42;											\
+	l44 = x6 ^ t12;												\
+	l45 = l36 ^ t10;											\
+	l46 = t15 ^ l44;											\
+	l47 = l45 ^ l46;											\
+	l48 = l47 ^ t26;											\
+	t28 = l43 & l48;											\
+	l49 = l11 ^ l15;											\
+	l50 = t12 ^ t2;												\
+	l51 = l49 ^ l50;											\
+	l52 = l41 ^ l51;											\
+	l53 = l52 ^ t26;											\
+	l54 = x6 ^ t13;												\
+	l55 = t8 ^ t10;												\
+	l56 = t15 ^ l54;											\
+	l57 = l55 ^ l56;											\
+	t32 = l53 & l57;											\
+	l58 = t26 ^ t32;											\
+	t36 = l47 & l58;											\
+	l59 = l52 ^ t28;											\
+	l60 = l48 ^ t36;											\
+	t39 = l59 & l60;											\
+	l61 = l38 ^ t36;											\
+	z0 = l61 & l5;												\
+	l62 = l57 ^ t32;											\
+	l63 = l62 ^ t36;											\
+	z1 = l63 & l10;												\
+	l64 = l47 ^ t32;											\
+	z2 = l64 & x7;												\
+	l65 = l34 ^ t28;											\
+	l66 = l65 ^ t39;											\
+	z3 = l66 & l15;												\
+	l67 = l43 ^ t39;											\
+	z4 = l67 & l18;												\
+	z5 = l59 & l22;												\
+	l68 = x1 ^ l1;												\
+	l69 = l68 ^ t2;												\
+	l70 = t5 ^ t7;												\
+	l71 = t10 ^ l69;											\
+	l72 = l70 ^ l71;											\
+	l73 = l72 ^ t28;											\
+	l74 = t32 ^ l73;											\
+	z6 = l74 & l23;												\
+	l75 = x2 ^ x6;												\
+	l76 = l11 ^ l75;											\
+	l77 = l76 ^ t2;												\
+	l78 = t7 ^ t8;												\
+	l79 = t3 ^ l77;												\
+	l80 = l78 ^ l79;											\
+	l81 = l80 ^ t28;											\
+	l82 = l81 ^ t36;											\
+	l83 = l82 ^ t39;											\
+	z7 = l83 & l26;												\
+	l84 = x2 ^ l13;												\
+	l85 = l84 ^ t5;												\
+	l86 = t3 ^ l85;												\
+	l87 = l55 ^ l86;											\
+	l88 = l87 ^ t32;											\
+	l89 = l88 ^ t36;											\
+	l90 = l89 ^ t39;											\
+	z8 = l90 & l29;												\
+	z9 = l61 & l3;												\
+	z10 = l63 & l9;												\
+	z11 = l64 & l12;											\
+	z12 = l66 & l13;											\
+	z13 = l67 & l17;											\
+	z14 = l59 & l19;											\
+	z15 = l74 & l1;												\
+	z16 = l83 & l24;											\
+	z17 = l90 & l27;											\
+	l91 = z15 ^ z6;												\
+	l92 = z10 ^ z9;												\
+	l93 = l91 ^ l92;											\
+	l94 = z16 ^ z3;												\
+	l95 = z4 ^ z7;												\
+	l96 = l93 ^ l94;											\
+	l97 = l95 ^ l96;											\
+	x0 = l97;													\
+	l98 = z0 ^ z1;												\
+	l99 = l98 ^ l93;											\
+	l100 = z16 ^ z7;											\
+	l101 = l99 ^ l100;											\
+	x1 = l101;													\
+	l102 = z14 ^ z2;											\
+	l103 = l102 ^ l91;											\
+	l104 = z0 ^ l103;											\
+	l105 = z12 ^ z17;											\
+	l106 = z8 ^ l104;											\
+	l107 = l105 ^ l106;											\
+	x2 = l107;													\
+	l108 = z15 ^ l92;											\
+	l109 = l98 ^ z4;											\
+	l110 = l108 ^ l94;											\
+	l111 = l109 ^ l110;											\
+	x3 = l111;													\
+	l112 = z2 ^ z5;												\
+	l113 = l112 ^ z1;											\
+	l114 = l113 ^ l108;											\
+	l115 = z16 ^ z4;											\
+	l116 = l114 ^ l115;											\
+	x4 = l116;													\
+	l117 = z11 ^ l102;											\
+	l118 = z15 ^ z0;											\
+	l119 = z10 ^ l117;											\
+	l120 = l118 ^ l119;											\
+	l121 = z12 ^ z8;											\
+	l122 = l120 ^ l94;											\
+	l123 = l95 ^ l121;											\
+	l124 = l122 ^ l123;											\
+	x5 = l124;													\
+	l125 = z5 ^ z15;											\
+	l126 = l125 ^ z13;											\
+	l127 = z16 ^ l126;											\
+	l128 = l123 ^ l127;											\
+	x6 = l128;													\
+	l129 = z2 ^ z0;												\
+	l130 = l129 ^ z12;											\
+	l131 = z3 ^ l130;											\
+	l132 = l127 ^ l131;											\
+	x7 = l132;													\
+} while (0)
+
+#if AES_SBOX == AES_SBOX_LOW_DEPTH
+#define SBOX 			SBOX_LOW_DEPTH
+#elif AES_SBOX == AES_SBOX_BALANCED
+#define SBOX 			SBOX_BP_BALANCED
+#else
+#define SBOX 			SBOX_BPC113
+#endif
+
+#endif 	// SBOX_H_
@@ -0,0 +1,312 @@
+/******************************************************************************
+* AES-256 CTR_DRBG (NIST SP 800-90A) on top of the barrel-shiftrows AES-256
+* implementation, so that 128 bytes of output are produced per cipher call.
+*
+* The DRBG is instantiated without derivation function, which means that the
+* entropy input is expected to be full-entropy (e.g. provided by the OS) and
+* that the personalization string and additional input are limited to 48
+* bytes. No prediction resistance is provided.
+*
+* The 3 blocks required by the CTR_DRBG_Update function at the end of each
+* generate call are computed within the same 8-block call as the last output
+* blocks whenever possible, and full 128-byte batches are directly written to
+* the output buffer. The round keys of Key are computed with the fully
+* bitsliced key schedule, so that the secret Key never indexes a table.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy, memset
+#include "../barrel_shiftrows/aes.h"
+#include "ctr_drbg.h"
+
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/random.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h> 	// for getpid
+#define DRBG_PID() 		((long)getpid())
+#else
+#define DRBG_PID() 		0L 		// no fork on this platform
+#endif
+
+#define CTR_DRBG_BUFLEN 	1024 		// per-thread buffer for small requests
+
+/* With AES_ALIGNED_IO, the core only writes to 4-byte aligned buffers */
+#if defined(AES_ALIGNED_IO)
+#define DRBG_DIRECT_OUT(p) 	(((uintptr_t)(p) & 3) == 0)
+#else
+#define DRBG_DIRECT_OUT(p) 	1
+#endif
+
+/******************************************************************************
+* Sets a buffer to zero in a way that is not optimized out by the compiler.
+******************************************************************************/
+static void zeroize(void* buf, size_t len) {
+	volatile unsigned char* p = (volatile unsigned char*)buf;
+	while (len--)
+		*p++ = 0x00;
+}
+
+/******************************************************************************
+* V = (V + 1) mod 2^128.
+******************************************************************************/
+static void inc_v(unsigned char* v) {
+	for(int i = 15; i >= 0 && ++v[i] == 0; i--);
+}
+
+/******************************************************************************
+* Outputs 'len' bytes of keystream into 'out' and then performs the
+* CTR_DRBG_Update with 'provided_data' (seedlen bytes, NULL standing for the
+* all-zero string). The 3 blocks of the update are processed along with the
+* last output blocks whenever they fit into the same 8-block call. Full
+* 128-byte batches are written to 'out' directly unless the core requires an
+* aligned output buffer that 'out' does not provide.
+******************************************************************************/
+static void drbg_crypt(ctr_drbg_state* st, unsigned char* out, size_t len,
+				const unsigned char* provided_data) {
+	_Alignas(4) unsigned char ctr[128], ks[128];
+	unsigned char temp[CTR_DRBG_SEEDLEN];
+	size_t out_blocks = (len + 15) / 16;
+	size_t nblocks = out_blocks + 3; 	// output blocks + update blocks
+	size_t b, n, blen;
+	memset(ctr, 0x00, 128);
+	for(size_t idx = 0; idx < nblocks; idx += n) {
+		n = nblocks - idx < 8 ? nblocks - idx : 8;
+		for(size_t i = 0; i < n; i++) {
+			inc_v(st->v);
+			memcpy(ctr + i*16, st->v, 16);
+		}
+		if ((idx + 8) * 16 <= len && DRBG_DIRECT_OUT(out)) { 	// no copy needed
+			aes256_encrypt(out + idx*16, ctr, st->rkeys);
+			continue;
+		}
+		aes256_encrypt(ks, ctr, st->rkeys);
+		for(size_t i = 0; i < n; i++) {
+			b = idx + i;
+			if (b < out_blocks) {
+				blen = len - b*16 < 16 ? len - b*16 : 16;
+				memcpy(out + b*16, ks + i*16, blen);
+			} else {
+				memcpy(temp + (b - out_blocks)*16, ks + i*16, 16);
+			}
+		}
+	}
+	if (provided_data) {
+		for(int i = 0; i < CTR_DRBG_SEEDLEN; i++)
+			temp[i] ^= provided_data[i];
+	}
+	aes256_keyschedule(st->rkeys, temp);
+	memcpy(st->v, temp + 32, 16);
+	zeroize(ks, sizeof(ks));
+	zeroize(temp, sizeof(temp));
+}
+
+/******************************************************************************
+* Instantiates the DRBG from 48 bytes of full-entropy input and an optional
+* personalization string of at most 48 bytes.
+* Returns 0 on success, -1 if the personalization string is too long.
+******************************************************************************/
+int ctr_drbg_instantiate(ctr_drbg_state* st,
+				const unsigned char entropy[CTR_DRBG_SEEDLEN],
+				const unsigned char* pers, size_t pers_len) {
+	unsigned char seed[CTR_DRBG_SEEDLEN], key[32];
+	if (pers_len > CTR_DRBG_SEEDLEN)
+		return -1;
+	memcpy(seed, entropy, CTR_DRBG_SEEDLEN);
+	for(size_t i = 0; i < pers_len; i++)
+		seed[i] ^= pers[i];
+	memset(key, 0x00, 32);
+	memset(st->v, 0x00, 16);
+	aes256_keyschedule(st->rkeys, key);
+	drbg_crypt(st, NULL, 0, seed);
+	st->reseed_counter = 1;
+	zeroize(seed, sizeof(seed));
+	return 0;
+}
+
+/******************************************************************************
+* Reseeds the DRBG from 48 bytes of full-entropy input and an optional
+* additional input of at most 48 bytes.
+* Returns 0 on success, -1 if the additional input is too long.
+******************************************************************************/
+int ctr_drbg_reseed(ctr_drbg_state* st,
+				const unsigned char entropy[CTR_DRBG_SEEDLEN],
+				const unsigned char* add, size_t add_len) {
+	unsigned char seed[CTR_DRBG_SEEDLEN];
+	if (add_len > CTR_DRBG_SEEDLEN)
+		return -1;
+	memcpy(seed, entropy, CTR_DRBG_SEEDLEN);
+	for(size_t i = 0; i < add_len; i++)
+		seed[i] ^= add[i];
+	drbg_crypt(st, NULL, 0, seed);
+	st->reseed_counter = 1;
+	zeroize(seed, sizeof(seed));
+	return 0;
+}
+
+/******************************************************************************
+* Generates 'len' random bytes into 'out' with an optional additional input of
+* at most 48 bytes. Requests larger than CTR_DRBG_MAX_REQUEST are split into
+* several generate calls (the additional input only applies to the 1st one).
+* The reseed interval is checked for all of them beforehand, so that either
+* the whole request is served or nothing is written to 'out'.
+* Returns 0 on success, -1 if the additional input is too long, or
+* CTR_DRBG_RESEED_REQUIRED if the DRBG has to be reseeded first.
+******************************************************************************/
+int ctr_drbg_generate(ctr_drbg_state* st, unsigned char* out, size_t len,
+				const unsigned char* add, size_t add_len) {
+	unsigned char padded[CTR_DRBG_SEEDLEN];
+	size_t chunk;
+	uint64_t ncalls = len ? (len - 1) / CTR_DRBG_MAX_REQUEST + 1 : 1;
+	if (add_len > CTR_DRBG_SEEDLEN)
+		return -1;
+	if (st->reseed_counter > CTR_DRBG_RESEED_INTERVAL - (ncalls - 1))
+		return CTR_DRBG_RESEED_REQUIRED;
+	do {
+		chunk = len < CTR_DRBG_MAX_REQUEST ? len : CTR_DRBG_MAX_REQUEST;
+		if (add_len) {
+			memset(padded, 0x00, CTR_DRBG_SEEDLEN);
+			memcpy(padded, add, add_len);
+			drbg_crypt(st, NULL, 0, padded);
+		}
+		drbg_crypt(st, out, chunk, add_len ? padded : NULL);
+		st->reseed_counter++;
+		out += chunk;
+		len -= chunk;
+		add_len = 0;
+	} while (len);
+	zeroize(padded, sizeof(padded));
+	return 0;
+}
+
+/******************************************************************************
+* Erases the internal state of the DRBG.
+******************************************************************************/
+void ctr_drbg_uninstantiate(ctr_drbg_state* st) {
+	zeroize(st, sizeof(ctr_drbg_state));
+}
+
+/******************************************************************************
+* Default entropy source: getrandom() on Linux, none otherwise.
+******************************************************************************/
+#if defined(__linux__)
+static int os_entropy(unsigned char* buf, size_t len) {
+	ssize_t ret;
+	while (len) {
+		ret = getrandom(buf, len, 0);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		buf += ret;
+		len -= ret;
+	}
+	return 0;
+}
+static ctr_drbg_entropy_t entropy_source = os_entropy;
+#else
+static ctr_drbg_entropy_t entropy_source = NULL;
+#endif
+
+/******************************************************************************
+* Per-thread DRBG instance. Small requests are served from a buffer filled by
+* CTR_DRBG_BUFLEN-byte generate calls (the bytes are erased once served), so
+* that the cost of the update and key schedule is amortized over many calls.
+* The process ID at (re)seed time is recorded, so that a forked child, which
+* inherits a copy of the instance, discards it instead of returning the same
+* bytes as its parent.
+******************************************************************************/
+static _Thread_local struct {
+	ctr_drbg_state st;
+	unsigned char buf[CTR_DRBG_BUFLEN];
+	size_t avail;
+	long pid;
+	int seeded;
+} tls;
+
+/******************************************************************************
+* Sets the entropy source used to (re)seed the per-thread instances. It is
+* expected to be called once before any call to 'ctr_drbg_random'.
+******************************************************************************/
+void ctr_drbg_set_entropy_source(ctr_drbg_entropy_t entropy) {
+	entropy_source = entropy;
+}
+
+/******************************************************************************
+* (Re)seeds the DRBG instance of the calling thread. The address of the
+* thread-local storage and the process ID are used as personalization string
+* (or as additional input when reseeding).
+******************************************************************************/
+static int tls_seed(void) {
+	unsigned char entropy[CTR_DRBG_SEEDLEN];
+	struct { void* addr; long pid; } pers;
+	int ret;
+	memset(&pers, 0x00, sizeof(pers));
+	pers.addr = &tls;
+	pers.pid = DRBG_PID();
+	if (!entropy_source || entropy_source(entropy, CTR_DRBG_SEEDLEN))
+		return -1;
+	if (tls.seeded)
+		ret = ctr_drbg_reseed(&tls.st, entropy, (unsigned char*)&pers,
+				sizeof(pers));
+	else
+		ret = ctr_drbg_instantiate(&tls.st, entropy, (unsigned char*)&pers,
+				sizeof(pers));
+	zeroize(entropy, sizeof(entropy));
+	tls.pid = pers.pid;
+	tls.seeded = !ret;
+	return ret;
+}
+
+static int tls_generate(unsigned char* out, size_t len) {
+	int ret = ctr_drbg_generate(&tls.st, out, len, NULL, 0);
+	if (ret == CTR_DRBG_RESEED_REQUIRED) {
+		if (tls_seed())
+			return -1;
+		ret = ctr_drbg_generate(&tls.st, out, len, NULL, 0);
+	}
+	return ret;
+}
+
+/******************************************************************************
+* Fills 'out' with 'len' random bytes using the DRBG instance of the calling
+* thread, which is instantiated on first use. Large requests bypass the
+* buffer and are directly generated into 'out'. In a forked child, the
+* buffered bytes inherited from the parent are erased and the instance is
+* reseeded before use.
+* Returns 0 on success, -1 if the entropy source failed.
+******************************************************************************/
+int ctr_drbg_random(unsigned char* out, size_t len) {
+	size_t n;
+	if (tls.seeded && tls.pid != DRBG_PID()) { 	// forked since last (re)seed
+		zeroize(tls.buf, CTR_DRBG_BUFLEN);
+		tls.avail = 0;
+		if (tls_seed()) {
+			tls.seeded = 0; 	// do not reuse the parent's state
+			return -1;
+		}
+	}
+	if (!tls.seeded && tls_seed())
+		return -1;
+	if (len >= CTR_DRBG_BUFLEN) 		// large-request fast path
+		return tls_generate(out, len);
+	while (len) {
+		if (!tls.avail) {
+			if (tls_generate(tls.buf, CTR_DRBG_BUFLEN))
+				return -1;
+			tls.avail = CTR_DRBG_BUFLEN;
+		}
+		n = len < tls.avail ? len : tls.avail;
+		memcpy(out, tls.buf + CTR_DRBG_BUFLEN - tls.avail, n);
+		zeroize(tls.buf + CTR_DRBG_BUFLEN - tls.avail, n);
+		tls.avail -= n;
+		out += n;
+		len -= n;
+	}
+	return 0;
+}
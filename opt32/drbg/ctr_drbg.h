@@ -0,0 +1,35 @@
+#ifndef CTR_DRBG_H_
+#define CTR_DRBG_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define CTR_DRBG_SEEDLEN 			48 		// keylen + outlen for AES-256
+#define CTR_DRBG_MAX_REQUEST 		65536 	// 2^19 bits per generate call
+#define CTR_DRBG_RESEED_INTERVAL 	((uint64_t)1 << 48)
+#define CTR_DRBG_RESEED_REQUIRED 	1
+
+/* State of an AES-256 CTR_DRBG instance (no derivation function) */
+typedef struct {
+	uint32_t rkeys[480]; 				// barrel-shiftrows round keys of Key
+	unsigned char v[16];
+	uint64_t reseed_counter;
+} ctr_drbg_state;
+
+/* NIST SP 800-90A CTR_DRBG functions */
+int ctr_drbg_instantiate(ctr_drbg_state* st,
+				const unsigned char entropy[CTR_DRBG_SEEDLEN],
+				const unsigned char* pers, size_t pers_len);
+int ctr_drbg_reseed(ctr_drbg_state* st,
+				const unsigned char entropy[CTR_DRBG_SEEDLEN],
+				const unsigned char* add, size_t add_len);
+int ctr_drbg_generate(ctr_drbg_state* st, unsigned char* out, size_t len,
+				const unsigned char* add, size_t add_len);
+void ctr_drbg_uninstantiate(ctr_drbg_state* st);
+
+/* Per-thread instances seeded from an entropy source */
+typedef int (*ctr_drbg_entropy_t)(unsigned char* buf, size_t len);
+void ctr_drbg_set_entropy_source(ctr_drbg_entropy_t entropy);
+int ctr_drbg_random(unsigned char* out, size_t len);
+
+#endif 	// CTR_DRBG_H_
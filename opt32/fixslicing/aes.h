@@ -1,5 +1,5 @@
-#ifndef AES_H_
-#define AES_H_
+#ifndef AES_FIXSLICING_H_
+#define AES_FIXSLICING_H_
 
 #include <stdint.h>
 
@@ -19,6 +19,20 @@ void aes256_encrypt_sfs(unsigned char ctext0[16], unsigned char ctext1[16],
 				const unsigned char ptext0[16], const unsigned char ptext1[16],
 				const uint32_t rkeys[120]);
 
+/* Encryption functions with the internal state kept in registers */
+void aes128_encrypt_ffs_reg(unsigned char ctext0[16], unsigned char ctext1[16],
+				const unsigned char ptext0[16], const unsigned char ptext1[16],
+				const uint32_t rkeys[88]);
+void aes256_encrypt_ffs_reg(unsigned char ctext0[16], unsigned char ctext1[16],
+				const unsigned char ptext0[16], const unsigned char ptext1[16],
+				const uint32_t rkeys[120]);
+void aes128_encrypt_sfs_reg(unsigned char ctext0[16], unsigned char ctext1[16],
+				const unsigned char ptext0[16], const unsigned char ptext1[16],
+				const uint32_t rkeys[88]);
+void aes256_encrypt_sfs_reg(unsigned char ctext0[16], unsigned char ctext1[16],
+				const unsigned char ptext0[16], const unsigned char ptext1[16],
+				const uint32_t rkeys[120]);
+
 /* Fully-fixsliced key schedule functions */
 void aes128_keyschedule_ffs(uint32_t rkeys[88], const unsigned char key0[16],
 				const unsigned char key1[16]);
@@ -39,4 +53,4 @@ void aes256_keyschedule_ffs_lut(uint32_t rkeys[120], const unsigned char key[32]
 void aes128_keyschedule_sfs_lut(uint32_t rkeys[88], const unsigned char key[16]);
 void aes256_keyschedule_sfs_lut(uint32_t rkeys[120], const unsigned char key[32]);
 
-#endif 	// AES_H_
+#endif 	// AES_FIXSLICING_H_
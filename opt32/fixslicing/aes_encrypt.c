@@ -12,6 +12,7 @@
 ******************************************************************************/
 #include "aes.h"
 #include "internal-aes.h"
+#include "../common/sbox.h"
 
 /******************************************************************************
 * Packs two 128-bit input blocs in0, in1 into the 256-bit internal state out 
@@ -25,9 +26,10 @@
 * out[6] = b_30 b_62 b_94 b_126 || ... || b_6 b_38 b_70 b_102
 * out[7] = b_31 b_63 b_95 b_127 || ... || b_7 b_39 b_71 b_103
 ******************************************************************************/
-void packing(uint32_t* out, const unsigned char* in0,
+inline void packing(uint32_t* out, const unsigned char* in0,
 		const unsigned char* in1) {
 	uint32_t tmp;
+	PROFILE_BEGIN();
 	out[0] = LE_LOAD_32(in0);
 	out[1] = LE_LOAD_32(in1);
 	out[2] = LE_LOAD_32(in0 + 4);
@@ -48,13 +50,15 @@ void packing(uint32_t* out, const unsigned char* in0,
 	SWAPMOVE(out[5], out[1], 0x0f0f0f0f, 4);
 	SWAPMOVE(out[6], out[2], 0x0f0f0f0f, 4);
 	SWAPMOVE(out[7], out[3], 0x0f0f0f0f, 4);
+	PROFILE_END(PROFILE_PACKING);
 }
 
 /******************************************************************************
 * Unpacks the 256-bit internal state in two 128-bit blocs out0, out1.
 ******************************************************************************/
-static void unpacking(unsigned char* out0, unsigned char* out1, uint32_t* in) {
+static inline void unpacking(unsigned char* out0, unsigned char* out1, uint32_t* in) {
 	uint32_t tmp;
+	PROFILE_BEGIN();
 	SWAPMOVE(in[4], in[0], 0x0f0f0f0f, 4);
 	SWAPMOVE(in[5], in[1], 0x0f0f0f0f, 4);
 	SWAPMOVE(in[6], in[2], 0x0f0f0f0f, 4);
@@ -75,152 +79,43 @@ static void unpacking(unsigned char* out0, unsigned char* out1, uint32_t* in) {
 	LE_STORE_32(out1 + 4, in[3]);
 	LE_STORE_32(out1 + 8, in[5]);
 	LE_STORE_32(out1 + 12, in[7]);
+	PROFILE_END(PROFILE_UNPACKING);
 }
 
 /******************************************************************************
 * XOR the round key to the internal state. The round keys are expected to be 
 * pre-computed and to be packed in the fixsliced representation.
 ******************************************************************************/
-static void ark(uint32_t* state, const uint32_t* rkey) {
+static inline void ark(uint32_t* state, const uint32_t* rkey) {
+	PROFILE_BEGIN();
+	UNROLL_WORDS
 	for(int i = 0; i < 8; i++)
 		state[i] ^= rkey[i];
+	PROFILE_END(PROFILE_ARK);
 }
 
 /******************************************************************************
-* Bitsliced implementation of the AES Sbox based on Boyar, Peralta and Calik.
-* See http://www.cs.yale.edu/homes/peralta/CircuitStuff/SLP_AES_113.txt
+* Bitsliced implementation of the AES Sbox, the circuit being selected at
+* build time (see 'common/sbox.h').
 * Note that the 4 NOT (^= 0xffffffff) are moved to the key schedule.
 ******************************************************************************/
-void sbox(uint32_t* state) {
-	uint32_t t0, t1, t2, t3, t4, t5,
-		t6, t7, t8, t9, t10, t11, t12,
-		t13, t14, t15, t16, t17;
-	t0			= state[3] ^ state[5];
-	t1			= state[0] ^ state[6];
-	t2			= t1 ^ t0;
-	t3			= state[4] ^ t2;
-	t4			= t3 ^ state[5];
-	t5			= t2 & t4;
-	t6			= t4 ^ state[7];
-	t7			= t3 ^ state[1];
-	t8			= state[0] ^ state[3]; 
-	t9			= t7 ^ t8;
-	t10			= t8 & t9;
-	t11			= state[7] ^ t9; 
-	t12			= state[0] ^ state[5];
-	t13			= state[1] ^ state[2];
-	t14			= t4 ^ t13;
-	t15			= t14 ^ t9;
-	t16			= t0 & t15;
-	t17			= t16 ^ t10;
-	state[1]	= t14 ^ t12; 
-	state[2]	= t12 & t14;
-	state[2] 	^= t10;
-	state[4]	= t13 ^ t9;
-	state[5]	= t1 ^ state[4];
-	t3			= t1 & state[4];
-	t10			= state[0] ^ state[4];
-	t13 		^= state[7];
-	state[3] 	^= t13; 
-	t16			= state[3] & state[7];
-	t16 		^= t5;
-	t16 		^= state[2];
-	state[1] 	^= t16;
-	state[0] 	^= t13;
-	t16			= state[0] & t11;
-	t16 		^= t3;
-	state[2] 	^= t16;
-	state[2] 	^= t10;
-	state[6] 	^= t13;
-	t10			= state[6] & t13;
-	t3 			^= t10;
-	t3 			^= t17;
-	state[5] 	^= t3;
-	t3			= state[6] ^ t12;
-	t10			= t3 & t6;
-	t5 			^= t10;
-	t5 			^= t7;
-	t5 			^= t17;
-	t7			= t5 & state[5];
-	t10			= state[2] ^ t7;
-	t7 			^= state[1];
-	t5 			^= state[1];
-	t16			= t5 & t10;
-	state[1] 	^= t16;
-	t17			= state[1] & state[0];
-	t11			= state[1] & t11;
-	t16			= state[5] ^ state[2];
-	t7 			&= t16;
-	t7 			^= state[2];
-	t16			= t10 ^ t7;
-	state[2] 	&= t16;
-	t10 		^= state[2];
-	t10 		&= state[1];
-	t5 			^= t10;
-	t10			= state[1] ^ t5;
-	state[4] 	&= t10; 
-	t11 		^= state[4];
-	t1 			&= t10;
-	state[6] 	&= t5; 
-	t10			= t5 & t13;
-	state[4] 	^= t10;
-	state[5] 	^= t7;
-	state[2] 	^= state[5];
-	state[5]	= t5 ^ state[2];
-	t5			= state[5] & t14;
-	t10			= state[5] & t12;
-	t12			= t7 ^ state[2];
-	t4 			&= t12;
-	t2 			&= t12;
-	t3 			&= state[2]; 
-	state[2] 	&= t6;
-	state[2] 	^= t4;
-	t13			= state[4] ^ state[2];
-	state[3] 	&= t7;
-	state[1] 	^= t7;
-	state[5] 	^= state[1];
-	t6			= state[5] & t15;
-	state[4] 	^= t6; 
-	t0 			&= state[5];
-	state[5]	= state[1] & t9; 
-	state[5] 	^= state[4];
-	state[1] 	&= t8;
-	t6			= state[1] ^ state[5];
-	t0 			^= state[1];
-	state[1]	= t3 ^ t0;
-	t15			= state[1] ^ state[3];
-	t2 			^= state[1];
-	state[0]	= t2 ^ state[5];
-	state[3]	= t2 ^ t13;
-	state[1]	= state[3] ^ state[5];
-	//state[1] 	^= 0xffffffff;
-	t0 			^= state[6];
-	state[5]	= t7 & state[7];
-	t14			= t4 ^ state[5];
-	state[6]	= t1 ^ t14;
-	state[6] 	^= t5; 
-	state[6] 	^= state[4];
-	state[2]	= t17 ^ state[6];
-	state[5]	= t15 ^ state[2];
-	state[2] 	^= t6;
-	state[2] 	^= t10;
-	//state[2] 	^= 0xffffffff;
-	t14 		^= t11;
-	t0 			^= t14;
-	state[6] 	^= t0;
-	//state[6] 	^= 0xffffffff;
-	state[7]	= t1 ^ t0;
-	//state[7] 	^= 0xffffffff;
-	state[4]	= t14 ^ state[3]; 
+inline void sbox(uint32_t* state) {
+	PROFILE_BEGIN();
+	SBOX(state[0], state[1], state[2], state[3],
+		state[4], state[5], state[6], state[7]);
+	PROFILE_END(PROFILE_SBOX);
 }
 
 /******************************************************************************
 * Applies the ShiftRows transformation twice (i.e. SR^2) on the internal state.
 ******************************************************************************/
-static void double_shiftrows(uint32_t* state) {
+static inline void double_shiftrows(uint32_t* state) {
     uint32_t tmp;
+	PROFILE_BEGIN();
+	UNROLL_WORDS
 	for(int i = 0; i < 8; i++)
         SWAPMOVE(state[i], state[i], 0x0f000f00, 4);
+	PROFILE_END(PROFILE_SHIFTROWS);
 }
 
 /******************************************************************************
@@ -228,8 +123,9 @@ static void double_shiftrows(uint32_t* state) {
 * For fully-fixsliced implementations, it is used for rounds i s.t. (i%4) == 0.
 * For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 0.
 ******************************************************************************/
-static void mixcolumns_0(uint32_t* state) {
+static inline void mixcolumns_0(uint32_t* state) {
 	uint32_t t0, t1, t2, t3, t4;
+	PROFILE_BEGIN();
 	t3 = ROR(BYTE_ROR_6(state[0]),8);
 	t0 = state[0] ^ t3;
 	t1 = ROR(BYTE_ROR_6(state[7]),8);
@@ -254,14 +150,16 @@ static void mixcolumns_0(uint32_t* state) {
 	t2 = t1 ^ state[1];
 	state[1] = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
 	state[0] = t2 ^ t3 ^ ROR(BYTE_ROR_4(t0),16);
+	PROFILE_END(PROFILE_MIXCOLUMNS);
 }
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
 * For fully-fixsliced implementations only, for round i s.t. (i%4) == 1.
 ******************************************************************************/
-static void mixcolumns_1(uint32_t* state) {
+static inline void mixcolumns_1(uint32_t* state) {
 	uint32_t t0, t1, t2;
+	PROFILE_BEGIN();
 	t0 = state[0] ^ ROR(BYTE_ROR_4(state[0]),8);
 	t1 = state[7] ^ ROR(BYTE_ROR_4(state[7]),8);
 	t2 = state[6];
@@ -307,14 +205,16 @@ static void mixcolumns_1(uint32_t* state) {
 	state[0] ^= t1;
 	t1 ^= t2;
 	state[0] ^= ROR(t1,16);
+	PROFILE_END(PROFILE_MIXCOLUMNS);
 }
 
 /******************************************************************************
 * Computation of the MixColumns transformation in the fixsliced representation.
 * For fully-fixsliced implementations only, for rounds i s.t. (i%4) == 2.
 ******************************************************************************/
-static void mixcolumns_2(uint32_t* state) {
+static inline void mixcolumns_2(uint32_t* state) {
 	uint32_t t0, t1, t2, t3, t4;
+	PROFILE_BEGIN();
 	t3 = ROR(BYTE_ROR_2(state[0]),8);
 	t0 = state[0] ^ t3;
 	t1 = ROR(BYTE_ROR_2(state[7]),8);
@@ -339,6 +239,7 @@ static void mixcolumns_2(uint32_t* state) {
 	t2 = t1 ^ state[1];
 	state[1] = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
 	state[0] = t2 ^ t3 ^ ROR(BYTE_ROR_4(t0),16);
+	PROFILE_END(PROFILE_MIXCOLUMNS);
 }
 
 /******************************************************************************
@@ -347,8 +248,9 @@ static void mixcolumns_2(uint32_t* state) {
 * For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 1.
 * Based on Käsper-Schwabe, similar to https://github.com/Ko-/aes-armcortexm.
 ******************************************************************************/
-static void mixcolumns_3(uint32_t* state) {
+static inline void mixcolumns_3(uint32_t* state) {
 	uint32_t t0, t1, t2;
+	PROFILE_BEGIN();
 	t0 = state[7] ^ ROR(state[7],8);
 	t2 = state[0] ^ ROR(state[0],8);
 	state[7] = t2 ^ ROR(state[7], 8) ^ ROR(t0, 16);
@@ -365,6 +267,7 @@ static void mixcolumns_3(uint32_t* state) {
 	t0 = state[1] ^ ROR(state[1],8);
 	state[1] = t1 ^ ROR(state[1],8) ^ ROR(t0,16);
 	state[0] = t0 ^ ROR(state[0],8) ^ ROR(t2,16);
+	PROFILE_END(PROFILE_MIXCOLUMNS);
 }
 
 /******************************************************************************
@@ -427,6 +330,7 @@ void aes256_encrypt_ffs(unsigned char* ctext0, unsigned char * ctext1,
 					const uint32_t* rkeys_ffs) {
 	uint32_t state[8]; 					// 256-bit internal state
 	packing(state, ptext0, ptext1);		// packs into bitsliced representation
+	UNROLL_ROUNDS
 	for(int i = 0; i < 96; i+=32) { 	// loop over quadruple rounds
 		ark(state, rkeys_ffs + i);
 		sbox(state);
@@ -464,6 +368,7 @@ void aes128_encrypt_sfs(unsigned char* ctext0, unsigned char* ctext1,
 					const uint32_t* rkeys_sfs) {
 	uint32_t state[8]; 					// 256-bit internal state
 	packing(state, ptext0, ptext1); 	// packs into bitsliced representation
+	UNROLL_ROUNDS
 	for(int i = 0; i < 5; i++) { 		// loop over double rounds
 		ark(state, rkeys_sfs + i*16);
 		sbox(state);
@@ -491,6 +396,7 @@ void aes256_encrypt_sfs(unsigned char* ctext0, unsigned char* ctext1,
 					const uint32_t* rkeys_sfs) {
 	uint32_t state[8]; 					// 256-bit internal state
 	packing(state, ptext0, ptext1); 	// packs into bitsliced representation
+	UNROLL_ROUNDS
 	for(int i = 0; i < 7; i++) { 		// loop over double rounds
 		ark(state, rkeys_sfs + i*16);
 		sbox(state);
@@ -0,0 +1,377 @@
+/******************************************************************************
+* Register-resident variant of the fixsliced AES-128 and AES-256 encryption.
+*
+* The round functions are the same as in 'aes_encrypt.c' but operate on the
+* 256-bit internal state passed and returned by value, and are forced inline.
+* This way the 8 state words are never accessed through a pointer between two
+* round functions, so that compilers can keep them in registers for the whole
+* encryption instead of storing/reloading them at each step, while the round
+* keys are 'restrict'-qualified so that their loads can be freely scheduled.
+* It results in a bigger code size than 'aes_encrypt.c'.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+#include "../common/sbox.h"
+
+#define INLINE 		static inline __attribute__((always_inline))
+
+/* 256-bit internal state, one word per bit of the bytes of the 2 blocks */
+typedef struct {
+	uint32_t w0, w1, w2, w3, w4, w5, w6, w7;
+} state_t;
+
+/******************************************************************************
+* Packs two 128-bit input blocs in0, in1 into the 256-bit internal state (see
+* 'packing' in 'aes_encrypt.c' for the bit ordering).
+******************************************************************************/
+INLINE state_t packing_reg(const unsigned char* in0, const unsigned char* in1) {
+	uint32_t tmp;
+	state_t s;
+	s.w0 = LE_LOAD_32(in0);
+	s.w1 = LE_LOAD_32(in1);
+	s.w2 = LE_LOAD_32(in0 + 4);
+	s.w3 = LE_LOAD_32(in1 + 4);
+	s.w4 = LE_LOAD_32(in0 + 8);
+	s.w5 = LE_LOAD_32(in1 + 8);
+	s.w6 = LE_LOAD_32(in0 + 12);
+	s.w7 = LE_LOAD_32(in1 + 12);
+	SWAPMOVE(s.w1, s.w0, 0x55555555, 1);
+	SWAPMOVE(s.w3, s.w2, 0x55555555, 1);
+	SWAPMOVE(s.w5, s.w4, 0x55555555, 1);
+	SWAPMOVE(s.w7, s.w6, 0x55555555, 1);
+	SWAPMOVE(s.w2, s.w0, 0x33333333, 2);
+	SWAPMOVE(s.w3, s.w1, 0x33333333, 2);
+	SWAPMOVE(s.w6, s.w4, 0x33333333, 2);
+	SWAPMOVE(s.w7, s.w5, 0x33333333, 2);
+	SWAPMOVE(s.w4, s.w0, 0x0f0f0f0f, 4);
+	SWAPMOVE(s.w5, s.w1, 0x0f0f0f0f, 4);
+	SWAPMOVE(s.w6, s.w2, 0x0f0f0f0f, 4);
+	SWAPMOVE(s.w7, s.w3, 0x0f0f0f0f, 4);
+	return s;
+}
+
+/******************************************************************************
+* Unpacks the 256-bit internal state in two 128-bit blocs out0, out1.
+******************************************************************************/
+INLINE void unpacking_reg(unsigned char* out0, unsigned char* out1,
+				state_t s) {
+	uint32_t tmp;
+	SWAPMOVE(s.w4, s.w0, 0x0f0f0f0f, 4);
+	SWAPMOVE(s.w5, s.w1, 0x0f0f0f0f, 4);
+	SWAPMOVE(s.w6, s.w2, 0x0f0f0f0f, 4);
+	SWAPMOVE(s.w7, s.w3, 0x0f0f0f0f, 4);
+	SWAPMOVE(s.w2, s.w0, 0x33333333, 2);
+	SWAPMOVE(s.w3, s.w1, 0x33333333, 2);
+	SWAPMOVE(s.w6, s.w4, 0x33333333, 2);
+	SWAPMOVE(s.w7, s.w5, 0x33333333, 2);
+	SWAPMOVE(s.w1, s.w0, 0x55555555, 1);
+	SWAPMOVE(s.w3, s.w2, 0x55555555, 1);
+	SWAPMOVE(s.w5, s.w4, 0x55555555, 1);
+	SWAPMOVE(s.w7, s.w6, 0x55555555, 1);
+	LE_STORE_32(out0, s.w0);
+	LE_STORE_32(out0 + 4, s.w2);
+	LE_STORE_32(out0 + 8, s.w4);
+	LE_STORE_32(out0 + 12, s.w6);
+	LE_STORE_32(out1, s.w1);
+	LE_STORE_32(out1 + 4, s.w3);
+	LE_STORE_32(out1 + 8, s.w5);
+	LE_STORE_32(out1 + 12, s.w7);
+}
+
+/******************************************************************************
+* XOR the round key to the internal state.
+******************************************************************************/
+INLINE state_t ark(state_t s, const uint32_t* restrict rkey) {
+	s.w0 ^= rkey[0];
+	s.w1 ^= rkey[1];
+	s.w2 ^= rkey[2];
+	s.w3 ^= rkey[3];
+	s.w4 ^= rkey[4];
+	s.w5 ^= rkey[5];
+	s.w6 ^= rkey[6];
+	s.w7 ^= rkey[7];
+	return s;
+}
+
+/******************************************************************************
+* Bitsliced implementation of the AES Sbox, the circuit being selected at
+* build time (see 'common/sbox.h').
+* Note that the 4 NOT (^= 0xffffffff) are moved to the key schedule.
+******************************************************************************/
+INLINE state_t sbox_reg(state_t s) {
+	SBOX(s.w0, s.w1, s.w2, s.w3, s.w4, s.w5, s.w6, s.w7);
+	return s;
+}
+
+/******************************************************************************
+* Applies the ShiftRows transformation twice (i.e. SR^2) on the internal state.
+******************************************************************************/
+INLINE state_t double_shiftrows(state_t s) {
+	uint32_t tmp;
+	SWAPMOVE(s.w0, s.w0, 0x0f000f00, 4);
+	SWAPMOVE(s.w1, s.w1, 0x0f000f00, 4);
+	SWAPMOVE(s.w2, s.w2, 0x0f000f00, 4);
+	SWAPMOVE(s.w3, s.w3, 0x0f000f00, 4);
+	SWAPMOVE(s.w4, s.w4, 0x0f000f00, 4);
+	SWAPMOVE(s.w5, s.w5, 0x0f000f00, 4);
+	SWAPMOVE(s.w6, s.w6, 0x0f000f00, 4);
+	SWAPMOVE(s.w7, s.w7, 0x0f000f00, 4);
+	return s;
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations, it is used for rounds i s.t. (i%4) == 0.
+* For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 0.
+******************************************************************************/
+INLINE state_t mixcolumns_0(state_t s) {
+	uint32_t t0, t1, t2, t3, t4;
+	t3 = ROR(BYTE_ROR_6(s.w0),8);
+	t0 = s.w0 ^ t3;
+	t1 = ROR(BYTE_ROR_6(s.w7),8);
+	t2 = s.w7 ^ t1;
+	s.w7 = ROR(BYTE_ROR_4(t2),16) ^ t1 ^ t0;
+	t1 = ROR(BYTE_ROR_6(s.w6),8);
+	t4 = t1 ^ s.w6;
+	s.w6 = t2 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_6(s.w5),8);
+	t2 = t1 ^ s.w5;
+	s.w5 = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	t1 = ROR(BYTE_ROR_6(s.w4),8);
+	t4 = t1 ^ s.w4;
+	s.w4 = t2 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_6(s.w3),8);
+	t2 = t1 ^ s.w3;
+	s.w3 = t4 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	t1 = ROR(BYTE_ROR_6(s.w2),8);
+	t4 = t1 ^ s.w2;
+	s.w2 = t2 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_6(s.w1),8);
+	t2 = t1 ^ s.w1;
+	s.w1 = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	s.w0 = t2 ^ t3 ^ ROR(BYTE_ROR_4(t0),16);
+	return s;
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations only, for round i s.t. (i%4) == 1.
+******************************************************************************/
+INLINE state_t mixcolumns_1(state_t s) {
+	uint32_t t0, t1, t2;
+	t0 = s.w0 ^ ROR(BYTE_ROR_4(s.w0),8);
+	t1 = s.w7 ^ ROR(BYTE_ROR_4(s.w7),8);
+	t2 = s.w6;
+	s.w6 = t1 ^ t0;
+	s.w7 ^= s.w6 ^ ROR(t1,16);
+	t1 =  ROR(BYTE_ROR_4(t2),8);
+	s.w6 ^= t1;
+	t1 ^= t2;
+	s.w6 ^= ROR(t1,16);
+	t2 = s.w5;
+	s.w5 = t1;
+	t1 =  ROR(BYTE_ROR_4(t2),8);
+	s.w5 ^= t1;
+	t1 ^= t2;
+	s.w5 ^= ROR(t1,16);
+	t2 = s.w4;
+	s.w4 = t1 ^ t0;
+	t1 =  ROR(BYTE_ROR_4(t2),8);
+	s.w4 ^= t1;
+	t1 ^= t2;
+	s.w4 ^= ROR(t1,16);
+	t2 = s.w3;
+	s.w3 = t1 ^ t0;
+	t1 =  ROR(BYTE_ROR_4(t2),8);
+	s.w3 ^= t1;
+	t1 ^= t2;
+	s.w3 ^= ROR(t1,16);
+	t2 = s.w2;
+	s.w2 = t1;
+	t1 = ROR(BYTE_ROR_4(t2),8);
+	s.w2 ^= t1;
+	t1 ^= t2;
+	s.w2 ^= ROR(t1,16);
+	t2 = s.w1;
+	s.w1 = t1;
+	t1 = ROR(BYTE_ROR_4(t2),8);
+	s.w1 ^= t1;
+	t1 ^= t2;
+	s.w1 ^= ROR(t1,16);
+	t2 = s.w0;
+	s.w0 = t1;
+	t1 = ROR(BYTE_ROR_4(t2),8);
+	s.w0 ^= t1;
+	t1 ^= t2;
+	s.w0 ^= ROR(t1,16);
+	return s;
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations only, for rounds i s.t. (i%4) == 2.
+******************************************************************************/
+INLINE state_t mixcolumns_2(state_t s) {
+	uint32_t t0, t1, t2, t3, t4;
+	t3 = ROR(BYTE_ROR_2(s.w0),8);
+	t0 = s.w0 ^ t3;
+	t1 = ROR(BYTE_ROR_2(s.w7),8);
+	t2 = s.w7 ^ t1;
+	s.w7 = ROR(BYTE_ROR_4(t2),16) ^ t1 ^ t0;
+	t1 = ROR(BYTE_ROR_2(s.w6),8);
+	t4 = t1 ^ s.w6;
+	s.w6 = t2 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_2(s.w5),8);
+	t2 = t1 ^ s.w5;
+	s.w5 = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	t1 = ROR(BYTE_ROR_2(s.w4),8);
+	t4 = t1 ^ s.w4;
+	s.w4 = t2 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_2(s.w3),8);
+	t2 = t1 ^ s.w3;
+	s.w3 = t4 ^ t0 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	t1 = ROR(BYTE_ROR_2(s.w2),8);
+	t4 = t1 ^ s.w2;
+	s.w2 = t2 ^ t1 ^ ROR(BYTE_ROR_4(t4),16);
+	t1 = ROR(BYTE_ROR_2(s.w1),8);
+	t2 = t1 ^ s.w1;
+	s.w1 = t4 ^ t1 ^ ROR(BYTE_ROR_4(t2),16);
+	s.w0 = t2 ^ t3 ^ ROR(BYTE_ROR_4(t0),16);
+	return s;
+}
+
+/******************************************************************************
+* Computation of the MixColumns transformation in the fixsliced representation.
+* For fully-fixsliced implementations, it is used for rounds i s.t. (i%4) == 3.
+* For semi-fixsliced implementations, it is used for rounds i s.t. (i%2) == 1.
+* Based on Käsper-Schwabe, similar to https://github.com/Ko-/aes-armcortexm.
+******************************************************************************/
+INLINE state_t mixcolumns_3(state_t s) {
+	uint32_t t0, t1, t2;
+	t0 = s.w7 ^ ROR(s.w7,8);
+	t2 = s.w0 ^ ROR(s.w0,8);
+	s.w7 = t2 ^ ROR(s.w7, 8) ^ ROR(t0, 16);
+	t1 = s.w6 ^ ROR(s.w6,8);
+	s.w6 = t0 ^ t2 ^ ROR(s.w6, 8) ^ ROR(t1,16);
+	t0 = s.w5 ^ ROR(s.w5,8);
+	s.w5 = t1 ^ ROR(s.w5,8) ^ ROR(t0,16);
+	t1 = s.w4 ^ ROR(s.w4,8);
+	s.w4 = t0 ^ t2 ^ ROR(s.w4,8) ^ ROR(t1,16);
+	t0 = s.w3 ^ ROR(s.w3,8);
+	s.w3 = t1 ^ t2 ^ ROR(s.w3,8) ^ ROR(t0,16);
+	t1 = s.w2 ^ ROR(s.w2,8);
+	s.w2 = t0 ^ ROR(s.w2,8) ^ ROR(t1,16);
+	t0 = s.w1 ^ ROR(s.w1,8);
+	s.w1 = t1 ^ ROR(s.w1,8) ^ ROR(t0,16);
+	s.w0 = t0 ^ ROR(s.w0,8) ^ ROR(t2,16);
+	return s;
+}
+/******************************************************************************
+* Fully-fixsliced AES-128 encryption with the internal state kept in
+* registers. Same interface and round keys as 'aes128_encrypt_ffs'.
+******************************************************************************/
+void aes128_encrypt_ffs_reg(unsigned char ctext0[16], unsigned char ctext1[16],
+					const unsigned char ptext0[16], const unsigned char ptext1[16],
+					const uint32_t rkeys_ffs[restrict 88]) {
+	state_t s = packing_reg(ptext0, ptext1);
+	s = ark(s, rkeys_ffs); 				// key whitening
+	s = mixcolumns_0(sbox_reg(s)); 		// 1st round
+	s = ark(s, rkeys_ffs + 8); 			// 1st round
+	s = mixcolumns_1(sbox_reg(s)); 		// 2nd round
+	s = ark(s, rkeys_ffs + 16); 		// 2nd round
+	s = mixcolumns_2(sbox_reg(s)); 		// 3rd round
+	s = ark(s, rkeys_ffs + 24); 		// 3rd round
+	s = mixcolumns_3(sbox_reg(s)); 		// 4th round
+	s = ark(s, rkeys_ffs + 32); 		// 4th round
+	s = mixcolumns_0(sbox_reg(s)); 		// 5th round
+	s = ark(s, rkeys_ffs + 40); 		// 5th round
+	s = mixcolumns_1(sbox_reg(s)); 		// 6th round
+	s = ark(s, rkeys_ffs + 48); 		// 6th round
+	s = mixcolumns_2(sbox_reg(s)); 		// 7th round
+	s = ark(s, rkeys_ffs + 56); 		// 7th round
+	s = mixcolumns_3(sbox_reg(s)); 		// 8th round
+	s = ark(s, rkeys_ffs + 64); 		// 8th round
+	s = mixcolumns_0(sbox_reg(s)); 		// 9th round
+	s = ark(s, rkeys_ffs + 72); 		// 9th round
+	s = double_shiftrows(sbox_reg(s)); 	// 10th round (resynchronization)
+	s = ark(s, rkeys_ffs + 80); 		// 10th round
+	unpacking_reg(ctext0, ctext1, s);
+}
+
+/******************************************************************************
+* Fully-fixsliced AES-256 encryption with the internal state kept in
+* registers. Same interface and round keys as 'aes256_encrypt_ffs'.
+******************************************************************************/
+void aes256_encrypt_ffs_reg(unsigned char ctext0[16], unsigned char ctext1[16],
+					const unsigned char ptext0[16], const unsigned char ptext1[16],
+					const uint32_t rkeys_ffs[restrict 120]) {
+	state_t s = packing_reg(ptext0, ptext1);
+	UNROLL_ROUNDS
+	for(int i = 0; i < 96; i+=32) { 	// loop over quadruple rounds
+		s = ark(s, rkeys_ffs + i);
+		s = mixcolumns_0(sbox_reg(s));
+		s = ark(s, rkeys_ffs + i+8);
+		s = mixcolumns_1(sbox_reg(s));
+		s = ark(s, rkeys_ffs + i+16);
+		s = mixcolumns_2(sbox_reg(s));
+		s = ark(s, rkeys_ffs + i+24);
+		s = mixcolumns_3(sbox_reg(s));
+	}
+	s = ark(s, rkeys_ffs + 96);
+	s = mixcolumns_0(sbox_reg(s));
+	s = ark(s, rkeys_ffs + 104);
+	s = double_shiftrows(sbox_reg(s)); 	// resynchronization
+	s = ark(s, rkeys_ffs + 112);
+	unpacking_reg(ctext0, ctext1, s);
+}
+
+/******************************************************************************
+* Semi-fixsliced AES-128 encryption with the internal state kept in
+* registers. Same interface and round keys as 'aes128_encrypt_sfs'.
+******************************************************************************/
+void aes128_encrypt_sfs_reg(unsigned char ctext0[16], unsigned char ctext1[16],
+					const unsigned char ptext0[16], const unsigned char ptext1[16],
+					const uint32_t rkeys_sfs[restrict 88]) {
+	state_t s = packing_reg(ptext0, ptext1);
+	UNROLL_ROUNDS
+	for(int i = 0; i < 4; i++) { 		// loop over double rounds
+		s = ark(s, rkeys_sfs + i*16);
+		s = mixcolumns_0(sbox_reg(s));
+		s = ark(s, rkeys_sfs + i*16+8);
+		s = mixcolumns_3(double_shiftrows(sbox_reg(s)));
+	}
+	s = ark(s, rkeys_sfs + 64);
+	s = mixcolumns_0(sbox_reg(s));
+	s = ark(s, rkeys_sfs + 72);
+	s = double_shiftrows(sbox_reg(s)); 	// No MixColumns in the last round
+	s = ark(s, rkeys_sfs + 80); 		// last AddRoundKey
+	unpacking_reg(ctext0, ctext1, s);
+}
+
+/******************************************************************************
+* Semi-fixsliced AES-256 encryption with the internal state kept in
+* registers. Same interface and round keys as 'aes256_encrypt_sfs'.
+******************************************************************************/
+void aes256_encrypt_sfs_reg(unsigned char ctext0[16], unsigned char ctext1[16],
+					const unsigned char ptext0[16], const unsigned char ptext1[16],
+					const uint32_t rkeys_sfs[restrict 120]) {
+	state_t s = packing_reg(ptext0, ptext1);
+	UNROLL_ROUNDS
+	for(int i = 0; i < 6; i++) { 		// loop over double rounds
+		s = ark(s, rkeys_sfs + i*16);
+		s = mixcolumns_0(sbox_reg(s));
+		s = ark(s, rkeys_sfs + i*16+8);
+		s = mixcolumns_3(double_shiftrows(sbox_reg(s)));
+	}
+	s = ark(s, rkeys_sfs + 96);
+	s = mixcolumns_0(sbox_reg(s));
+	s = ark(s, rkeys_sfs + 104);
+	s = double_shiftrows(sbox_reg(s)); 	// No MixColumns in the last round
+	s = ark(s, rkeys_sfs + 112); 		// last AddRoundKey
+	unpacking_reg(ctext0, ctext1, s);
+}
@@ -17,8 +17,9 @@
 /******************************************************************************
 * Applies ShiftRows^(-1) on a round key to match the fixsliced representation.
 ******************************************************************************/
-static void inv_shiftrows_1(uint32_t* rkey) {
+static inline void inv_shiftrows_1(uint32_t* rkey) {
 	uint32_t tmp;
+	UNROLL_WORDS
 	for(int i = 0; i < 8; i++) {
 		SWAPMOVE(rkey[i], rkey[i], 0x0c0f0300, 4);
 		SWAPMOVE(rkey[i], rkey[i], 0x33003300, 2);
@@ -27,8 +28,9 @@ static void inv_shiftrows_1(uint32_t* rkey) {
 /******************************************************************************
 * Applies ShiftRows^(-2) on a round key to match the fixsliced representation.
 ******************************************************************************/
-static void inv_shiftrows_2(uint32_t* rkey) {
+static inline void inv_shiftrows_2(uint32_t* rkey) {
 	uint32_t tmp;
+	UNROLL_WORDS
 	for(int i = 0; i < 8; i++)
 		SWAPMOVE(rkey[i], rkey[i], 0x0f000f00, 4);
 }
@@ -36,8 +38,9 @@ static void inv_shiftrows_2(uint32_t* rkey) {
 /******************************************************************************
 * Applies ShiftRows^(-3) on a round key to match the fixsliced representation.
 ******************************************************************************/
-static void inv_shiftrows_3(uint32_t* rkey) {
+static inline void inv_shiftrows_3(uint32_t* rkey) {
 	uint32_t tmp;
+	UNROLL_WORDS
 	for(int i = 0; i < 8; i++) {
 		SWAPMOVE(rkey[i], rkey[i], 0x030f0c00, 4);
 		SWAPMOVE(rkey[i], rkey[i], 0x33003300, 2);
@@ -54,11 +57,12 @@ static void inv_shiftrows_3(uint32_t* rkey) {
 * The idx_ror parameter refers to the rotation value. When a Rotword is applied
 * the value should be 2, 26 otherwise.
 ******************************************************************************/
-static void xor_columns(uint32_t* rkeys, int idx_xor, int idx_ror) {
+static inline void xor_columns(uint32_t* rkeys, int idx_xor, int idx_ror) {
 	rkeys[1] ^= 0xffffffff; 			// NOT that are omitted in S-box
 	rkeys[2] ^= 0xffffffff; 			// NOT that are omitted in S-box
 	rkeys[6] ^= 0xffffffff; 			// NOT that are omitted in S-box
 	rkeys[7] ^= 0xffffffff; 			// NOT that are omitted in S-box
+	UNROLL_WORDS
 	for(int i = 0; i < 8; i++) {
 		rkeys[i] = (rkeys[i-idx_xor] ^ ROR(rkeys[i], idx_ror))  & 0xc0c0c0c0;
 		rkeys[i] |= ((rkeys[i-idx_xor] ^ rkeys[i] >> 2) & 0x30303030);
@@ -128,6 +132,7 @@ void aes128_keyschedule_ffs(uint32_t* rkeys, const unsigned char* key0,
 	rkeys[82] ^= 0x00000300; 		// 10th rconst
 	xor_columns(rkeys+80, 8, 2); 	// Rotword and XOR between the columns
 	inv_shiftrows_1(rkeys+72);
+	UNROLL_ROUNDS
 	for(int i = 1; i < 11; i++) {
 		rkeys[i*8 + 1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
 		rkeys[i*8 + 2] ^= 0xffffffff; 	// NOT to speed up SBox calculations
@@ -201,6 +206,7 @@ void aes256_keyschedule_ffs(uint32_t* rkeys, const unsigned char* key0,
 	rkeys[113] ^= 0x00000300; 			// 7th rconst
 	xor_columns(rkeys+112, 16, 2); 		// Rotword and XOR between the columns
 	inv_shiftrows_1(rkeys+104);			// to match fixslicing
+	UNROLL_ROUNDS
 	for(int i = 1; i < 15; i++) {
 		rkeys[i*8 + 1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
 		rkeys[i*8 + 2] ^= 0xffffffff; 	// NOT to speed up SBox calculations
@@ -268,6 +274,7 @@ void aes128_keyschedule_sfs(uint32_t* rkeys, const unsigned char* key0,
 	rkeys[82] ^= 0x00000300; 		// 10th rconst
 	xor_columns(rkeys+80, 8, 2); 	// Rotword and XOR between the columns
 	inv_shiftrows_1(rkeys+72); 		// to match fixslicing
+	UNROLL_ROUNDS
 	for(int i = 1; i < 11; i++) {
 		rkeys[i*8 + 1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
 		rkeys[i*8 + 2] ^= 0xffffffff; 	// NOT to speed up SBox calculations
@@ -338,6 +345,7 @@ void aes256_keyschedule_sfs(uint32_t* rkeys, const unsigned char* key0,
 	rkeys[113] ^= 0x00000300; 			// 7th rconst
 	xor_columns(rkeys+112, 16, 2); 		// Rotword and XOR between the columns
 	inv_shiftrows_1(rkeys+104);			// to match fixslicing
+	UNROLL_ROUNDS
 	for(int i = 1; i < 15; i++) {
 		rkeys[i*8 + 1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
 		rkeys[i*8 + 2] ^= 0xffffffff; 	// NOT to speed up SBox calculations
@@ -71,6 +71,7 @@ void aes128_keyschedule_ffs_lut(uint32_t* rkeys_ffs, const unsigned char* key){
 	rkeys[1] = LE_LOAD_32(key + 4);
 	rkeys[2] = LE_LOAD_32(key + 8);
 	rkeys[3] = LE_LOAD_32(key + 12);
+	UNROLL_ROUNDS
 	for(int i = 4; i < 44; i+=4) {
 		rkeys[i] = rkeys[i-4] ^ rcon[i/4];
 		rkeys[i] ^= (sbox_lut[rkeys[i-1] & 0xff] << 24);
@@ -82,6 +83,7 @@ void aes128_keyschedule_ffs_lut(uint32_t* rkeys_ffs, const unsigned char* key){
 		rkeys[i+3] = rkeys[i+2] ^ rkeys[i-1];
 	}
 	// applying ShiftRows^(-i) to match the fully-fixsliced representation
+	UNROLL_ROUNDS
 	for(int i = 4; i < 40; i+=4) {
 		t0 = rkeys[i];
 		t1 = rkeys[i+1];
@@ -131,6 +133,7 @@ void aes128_keyschedule_ffs_lut(uint32_t* rkeys_ffs, const unsigned char* key){
 	}
 	// packing all round keys to match the fully-fixsliced representation
 	packing(rkeys_ffs, (unsigned char*)rkeys, (unsigned char*)rkeys);
+	UNROLL_ROUNDS
 	for(int i = 1; i < 11; i++) {
 		packing(rkeys_ffs + i*8, (unsigned char*)(rkeys + i*4), (unsigned char*)(rkeys + i*4));
 		rkeys_ffs[i*8 + 1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
@@ -157,6 +160,7 @@ void aes256_keyschedule_ffs_lut(uint32_t* rkeys_ffs, const unsigned char* key){
 	rkeys[5] = LE_LOAD_32(key + 20);
 	rkeys[6] = LE_LOAD_32(key + 24);
 	rkeys[7] = LE_LOAD_32(key + 28);
+	UNROLL_ROUNDS
 	for(int i = 8; i < 56; i+=8) {
 		rkeys[i] = rkeys[i-8] ^ rcon[i/8];
 		rkeys[i] ^= (sbox_lut[rkeys[i-1] & 0xff] << 24);
@@ -184,6 +188,7 @@ void aes256_keyschedule_ffs_lut(uint32_t* rkeys_ffs, const unsigned char* key){
 	rkeys[58] = rkeys[57] ^ rkeys[50];
 	rkeys[59] = rkeys[58] ^ rkeys[51];
 	// applying ShiftRows^(-i) to match the fully-fixsliced representation
+	UNROLL_ROUNDS
 	for(int i = 4; i < 56; i+=4) {
 		t0 = rkeys[i];
 		t1 = rkeys[i+1];
@@ -233,6 +238,7 @@ void aes256_keyschedule_ffs_lut(uint32_t* rkeys_ffs, const unsigned char* key){
 	}
 	// packing all round keys to match the fully-fixsliced representation
 	packing(rkeys_ffs, (unsigned char*)rkeys, (unsigned char*)rkeys);
+	UNROLL_ROUNDS
 	for(int i = 1; i < 15; i++) {
 		packing(rkeys_ffs + i*8, (unsigned char*)(rkeys + i*4), (unsigned char*)(rkeys + i*4));
 		rkeys_ffs[i*8 + 1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
@@ -255,6 +261,7 @@ void aes128_keyschedule_sfs_lut(uint32_t* rkeys_sfs, const unsigned char* key){
 	rkeys[1] = LE_LOAD_32(key + 4);
 	rkeys[2] = LE_LOAD_32(key + 8);
 	rkeys[3] = LE_LOAD_32(key + 12);
+	UNROLL_ROUNDS
 	for(int i = 4; i < 44; i+=4) {
 		rkeys[i] = rkeys[i-4] ^ rcon[i/4];
 		rkeys[i] ^= (sbox_lut[rkeys[i-1] & 0xff] << 24);
@@ -266,6 +273,7 @@ void aes128_keyschedule_sfs_lut(uint32_t* rkeys_sfs, const unsigned char* key){
 		rkeys[i+3] = rkeys[i+2] ^ rkeys[i-1];
 	}
 	// applying ShiftRows^(-1) to match the semi-fixsliced representation
+	UNROLL_ROUNDS
 	for(int i = 4; i < 40; i+=8) {
 		t0 = rkeys[i];
 		t1 = rkeys[i+1];
@@ -289,6 +297,7 @@ void aes128_keyschedule_sfs_lut(uint32_t* rkeys_sfs, const unsigned char* key){
 	}
 	// packing all round keys to match the semi-fixsliced representation
 	packing(rkeys_sfs, (unsigned char*)rkeys, (unsigned char*)rkeys);
+	UNROLL_ROUNDS
 	for(int i = 1; i < 11; i++) {
 		packing(rkeys_sfs + i*8, (unsigned char*)(rkeys + i*4), (unsigned char*)(rkeys + i*4));
 		rkeys_sfs[i*8 + 1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
@@ -315,6 +324,7 @@ void aes256_keyschedule_sfs_lut(uint32_t* rkeys_sfs, const unsigned char* key){
 	rkeys[5] = LE_LOAD_32(key + 20);
 	rkeys[6] = LE_LOAD_32(key + 24);
 	rkeys[7] = LE_LOAD_32(key + 28);
+	UNROLL_ROUNDS
 	for(int i = 8; i < 56; i+=8) {
 		rkeys[i] = rkeys[i-8] ^ rcon[i/8];
 		rkeys[i] ^= (sbox_lut[rkeys[i-1] & 0xff] << 24);
@@ -342,6 +352,7 @@ void aes256_keyschedule_sfs_lut(uint32_t* rkeys_sfs, const unsigned char* key){
 	rkeys[58] = rkeys[57] ^ rkeys[50];
 	rkeys[59] = rkeys[58] ^ rkeys[51];
 	// applying ShiftRows^(-1) to match the semi-fixsliced representation
+	UNROLL_ROUNDS
 	for(int i = 4; i < 56; i+=8) {
 		t0 = rkeys[i];
 		t1 = rkeys[i+1];
@@ -365,6 +376,7 @@ void aes256_keyschedule_sfs_lut(uint32_t* rkeys_sfs, const unsigned char* key){
 	}
 	// packing all round keys to match the semi-fixsliced representation
 	packing(rkeys_sfs, (unsigned char*)rkeys, (unsigned char*)rkeys);
+	UNROLL_ROUNDS
 	for(int i = 1; i < 15; i++) {
 		packing(rkeys_sfs + i*8, (unsigned char*)(rkeys + i*4), (unsigned char*)(rkeys + i*4));
 		rkeys_sfs[i*8 + 1] ^= 0xffffffff; 	// NOT to speed up SBox calculations
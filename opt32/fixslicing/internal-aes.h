@@ -2,6 +2,42 @@
 #define INTERNAL_AES_H_
 
 #include <stdint.h>
+#include "../common/le-io.h"
+#if defined(AES_PROFILE)
+#include "../profile/profile.h" 	// per-phase cycle counts
+#else 							// hooks expand to nothing (no timer needed)
+#define PROFILE_BEGIN()
+#define PROFILE_END(phase)
+#endif
+
+/******************************************************************************
+* Loop unrolling level, selected at build time with -DAES_UNROLL=<level>:
+* 0: the compiler decides (default, most compact code)
+* 1: partial unrolling, loops over the state words are fully unrolled while
+*    loops over the rounds are unrolled twice
+* 2: full unrolling of all loops
+******************************************************************************/
+#ifndef AES_UNROLL
+#define AES_UNROLL 		0
+#endif
+
+#define AES_PRAGMA(x) 	_Pragma(#x)
+#if defined(__clang__)
+#define AES_UNROLL_N(n) AES_PRAGMA(unroll n)
+#else
+#define AES_UNROLL_N(n) AES_PRAGMA(GCC unroll n)
+#endif
+
+#if AES_UNROLL >= 2
+#define UNROLL_ROUNDS 	AES_UNROLL_N(16)
+#define UNROLL_WORDS 	AES_UNROLL_N(32)
+#elif AES_UNROLL == 1
+#define UNROLL_ROUNDS 	AES_UNROLL_N(2)
+#define UNROLL_WORDS 	AES_UNROLL_N(32)
+#else
+#define UNROLL_ROUNDS
+#define UNROLL_WORDS
+#endif
 
 #define ROR(x,y) 		(((x) >> (y)) | ((x) << (32 - (y))))
 
@@ -20,18 +56,6 @@
 	a ^= (tmp << n);										\
 })
 
-#define LE_LOAD_32(x) 										\
-    ((((uint32_t)((x)[3])) << 24) | 						\
-     (((uint32_t)((x)[2])) << 16) | 						\
-     (((uint32_t)((x)[1])) << 8) | 							\
-      ((uint32_t)((x)[0])))
-
-#define LE_STORE_32(x, y)									\
-	(x)[0] = (y) & 0xff; 									\
-	(x)[1] = ((y) >> 8) & 0xff; 							\
-	(x)[2] = ((y) >> 16) & 0xff; 							\
-	(x)[3] = (y) >> 24;
-
 void packing(uint32_t* out, const unsigned char* in0,
 		const unsigned char* in1);
 
@@ -0,0 +1,182 @@
+/******************************************************************************
+* POLYVAL and GHASH on top of a carry-less multiplication backend.
+*
+* This file holds everything that does not depend on how the carry-less
+* multiplications are computed: precomputation of the powers of the hash key,
+* Montgomery reduction and aggregated reduction. The backend is selected at
+* build time by linking exactly one of the following files:
+*	- gf128_ctmul.c 	portable C, 32x32->64 multiplications with holes
+*	- gf128_ctmul64.c 	portable C, 64x64->64 multiplications with holes
+*	- gf128_clmul.c 	x86 PCLMULQDQ (and VPCLMULQDQ/AVX2 if available)
+*	- gf128_pmull.c 	AArch64 PMULL (ARMv8 Crypto Extension)
+*
+* POLYVAL is computed natively (i.e. in the little-endian representation)
+* while GHASH is computed through POLYVAL using the relation given in
+* RFC 8452, Appendix A.
+*
+* Aggregated reduction: since the reduction is linear, 8 (or 4) blocks are
+* multiplied by H^8, ..., H^1 and the unreduced products are summed before a
+* single reduction, instead of one reduction per block.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "gf128.h"
+#include "internal-gf128.h"
+
+/******************************************************************************
+* Montgomery reduction of the 256-bit product z, i.e. r = z * x^(-128) modulo
+* x^128 + x^127 + x^126 + x^121 + 1. It is computed 64 bits at a time since
+* P^(-1) = 1 mod x^64.
+******************************************************************************/
+static void gf128_reduce(uint64_t* r, const uint64_t* z) {
+	uint64_t z1, z2, z3, m;
+	z1 = z[1];
+	z2 = z[2];
+	z3 = z[3];
+	m = z[0]; 							// 1st Montgomery reduction step
+	z1 ^= (m << 57) ^ (m << 62) ^ (m << 63);
+	z2 ^= m ^ (m >> 1) ^ (m >> 2) ^ (m >> 7);
+	m = z1; 							// 2nd Montgomery reduction step
+	z2 ^= (m << 57) ^ (m << 62) ^ (m << 63);
+	z3 ^= m ^ (m >> 1) ^ (m >> 2) ^ (m >> 7);
+	r[0] = z2;
+	r[1] = z3;
+}
+
+/******************************************************************************
+* r = x * y * x^(-128) in the POLYVAL field.
+******************************************************************************/
+static void gf128_mul(uint64_t* r, const uint64_t* x, const uint64_t* y) {
+	uint64_t z[4] = {0};
+	gf128_mul_acc(z, x, y);
+	gf128_reduce(r, z);
+}
+
+/******************************************************************************
+* Loads a 16-byte block as a field element, either in the POLYVAL (little-
+* endian) or in the GHASH (byte-reversed) representation.
+******************************************************************************/
+static void gf128_load(uint64_t* x, const unsigned char* in, int reflected) {
+	if (reflected) {
+		x[0] = BE_LOAD_64(in + 8);
+		x[1] = BE_LOAD_64(in);
+	} else {
+		x[0] = LE_LOAD_64(in);
+		x[1] = LE_LOAD_64(in + 8);
+	}
+}
+
+static void gf128_store(unsigned char* out, const uint64_t* x, int reflected) {
+	for(int i = 0; i < 16; i++) {
+		if (reflected)
+			out[15 - i] = (x[i >> 3] >> ((i & 7) * 8)) & 0xff;
+		else
+			out[i] = (x[i >> 3] >> ((i & 7) * 8)) & 0xff;
+	}
+}
+
+/******************************************************************************
+* Computes the powers H^2, ..., H^8 from H = key->h[0].
+******************************************************************************/
+static void gf128_powers(gf128_key* key) {
+	for(int i = 1; i < GF128_NPOWERS; i++)
+		gf128_mul(key->h[i], key->h[i-1], key->h[0]);
+}
+
+/******************************************************************************
+* Absorbs 'nblocks' full blocks into the accumulator s (nblocks = 4 or 8) with
+* a single reduction: s <- (s ^ X_1)*H^n ^ X_2*H^(n-1) ^ ... ^ X_n*H.
+* Blocks are loaded in reverse order so that x[i] is multiplied by H^(i+1).
+******************************************************************************/
+static void gf128_aggregate(uint64_t* s, const gf128_key* key,
+				const unsigned char* in, int nblocks, int reflected) {
+	uint64_t x[GF128_NPOWERS][2], z[4] = {0};
+	for(int i = 0; i < nblocks; i++)
+		gf128_load(x[nblocks - 1 - i], in + i*16, reflected);
+	x[nblocks - 1][0] ^= s[0];
+	x[nblocks - 1][1] ^= s[1];
+	for(int i = 0; i < nblocks; i += 4)
+		gf128_mul_acc4(z, x + i, key->h + i);
+	gf128_reduce(s, z);
+}
+
+/******************************************************************************
+* Absorbs len bytes into the accumulator s. If len is not a multiple of 16,
+* the last block is padded with zeros.
+******************************************************************************/
+static void gf128_blocks(uint64_t* s, const gf128_key* key,
+				const unsigned char* in, size_t len, int reflected) {
+	unsigned char block[16];
+	uint64_t x[2];
+	for(; len >= 128; in += 128, len -= 128)
+		gf128_aggregate(s, key, in, 8, reflected);
+	for(; len >= 64; in += 64, len -= 64)
+		gf128_aggregate(s, key, in, 4, reflected);
+	while (len) {
+		if (len < 16) { 				// zero-padding of the last block
+			for(size_t i = 0; i < 16; i++)
+				block[i] = i < len ? in[i] : 0x00;
+			gf128_load(x, block, reflected);
+			len = 16;
+		} else {
+			gf128_load(x, in, reflected);
+		}
+		s[0] ^= x[0];
+		s[1] ^= x[1];
+		gf128_mul(s, s, key->h[0]);
+		in += 16;
+		len -= 16;
+	}
+}
+
+/******************************************************************************
+* Precomputes the powers of the POLYVAL key h.
+******************************************************************************/
+void polyval_init(gf128_key* key, const unsigned char h[16]) {
+	gf128_load(key->h[0], h, 0);
+	gf128_powers(key);
+}
+
+/******************************************************************************
+* POLYVAL: for each 16-byte block X_i of 'in', acc <- (acc ^ X_i) * H * x^-128.
+* If len is not a multiple of 16, the last block is padded with zeros, which
+* matches the padding of the AD and plaintext in AES-GCM-SIV.
+******************************************************************************/
+void polyval_update(unsigned char acc[16], const gf128_key* key,
+				const unsigned char* in, size_t len) {
+	uint64_t s[2];
+	gf128_load(s, acc, 0);
+	gf128_blocks(s, key, in, len, 0);
+	gf128_store(acc, s, 0);
+}
+
+/******************************************************************************
+* Precomputes the powers of mulX_POLYVAL(ByteReverse(h)), which is the POLYVAL
+* key corresponding to the GHASH key h.
+******************************************************************************/
+void ghash_init(gf128_key* key, const unsigned char h[16]) {
+	uint64_t carry, *hk = key->h[0];
+	gf128_load(hk, h, 1);
+	carry = -(hk[1] >> 63); 			// mulX_POLYVAL in constant time
+	hk[1] = (hk[1] << 1) | (hk[0] >> 63);
+	hk[0] = (hk[0] << 1);
+	hk[0] ^= carry & 0x0000000000000001;
+	hk[1] ^= carry & 0xc200000000000000;
+	gf128_powers(key);
+}
+
+/******************************************************************************
+* GHASH: for each 16-byte block X_i of 'in', acc <- (acc ^ X_i) * H.
+* Computed as ByteReverse(POLYVAL(mulX_POLYVAL(ByteReverse(H)), ...)), see
+* RFC 8452, Appendix A. The last block is padded with zeros if necessary.
+******************************************************************************/
+void ghash_update(unsigned char acc[16], const gf128_key* key,
+				const unsigned char* in, size_t len) {
+	uint64_t s[2];
+	gf128_load(s, acc, 1);
+	gf128_blocks(s, key, in, len, 1);
+	gf128_store(acc, s, 1);
+}
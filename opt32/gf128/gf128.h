@@ -0,0 +1,28 @@
+#ifndef GF128_H_
+#define GF128_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Number of precomputed powers of the hash key (aggregated reduction) */
+#define GF128_NPOWERS 	8
+
+/* Hash key along with its powers H^1, ..., H^8 (POLYVAL representation) */
+typedef struct {
+	uint64_t h[GF128_NPOWERS][2];
+} gf128_key;
+
+/* Name of the carry-less multiplication backend the library is built with */
+extern const char gf128_impl[];
+
+/* POLYVAL (RFC 8452): acc <- (acc ^ X_i) * H * x^(-128) over the input blocks */
+void polyval_init(gf128_key* key, const unsigned char h[16]);
+void polyval_update(unsigned char acc[16], const gf128_key* key,
+				const unsigned char* in, size_t len);
+
+/* GHASH (NIST SP 800-38D): acc <- (acc ^ X_i) * H over the input blocks */
+void ghash_init(gf128_key* key, const unsigned char h[16]);
+void ghash_update(unsigned char acc[16], const gf128_key* key,
+				const unsigned char* in, size_t len);
+
+#endif 	// GF128_H_
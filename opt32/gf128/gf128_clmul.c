@@ -0,0 +1,94 @@
+/******************************************************************************
+* Carry-less multiplication backend for POLYVAL/GHASH relying on the x86
+* PCLMULQDQ instruction (compile with e.g. -mpclmul).
+*
+* If VPCLMULQDQ and AVX2 are available (compile with e.g. -mvpclmulqdq
+* -mavx2), the 4-block aggregated products are computed two at a time in
+* 256-bit registers.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#if !defined(__PCLMUL__)
+#error "gf128_clmul.c requires PCLMULQDQ support (e.g. -mpclmul)"
+#endif
+
+#include <immintrin.h>
+#include "gf128.h"
+#include "internal-gf128.h"
+
+#if defined(__VPCLMULQDQ__) && defined(__AVX2__)
+const char gf128_impl[] = "vpclmul-avx2";
+#else
+const char gf128_impl[] = "pclmul";
+#endif
+
+/******************************************************************************
+* Karatsuba-free schoolbook product (4 PCLMULQDQ) accumulated in lo/mid/hi.
+******************************************************************************/
+#define CLMUL_ACC(lo, mid, hi, a, b)	({							\
+	lo = _mm_xor_si128(lo, _mm_clmulepi64_si128(a, b, 0x00));		\
+	hi = _mm_xor_si128(hi, _mm_clmulepi64_si128(a, b, 0x11));		\
+	mid = _mm_xor_si128(mid, _mm_clmulepi64_si128(a, b, 0x01));		\
+	mid = _mm_xor_si128(mid, _mm_clmulepi64_si128(a, b, 0x10));		\
+})
+
+/******************************************************************************
+* Folds the middle term into lo/hi and accumulates the result into z.
+******************************************************************************/
+static void clmul_store(uint64_t* z, __m128i lo, __m128i mid, __m128i hi) {
+	__m128i* zz = (__m128i*)z;
+	lo = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+	hi = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+	_mm_storeu_si128(zz, _mm_xor_si128(_mm_loadu_si128(zz), lo));
+	_mm_storeu_si128(zz + 1, _mm_xor_si128(_mm_loadu_si128(zz + 1), hi));
+}
+
+/******************************************************************************
+* z ^= x * y where x, y are 128-bit and z is 256-bit.
+******************************************************************************/
+void gf128_mul_acc(uint64_t* z, const uint64_t* x, const uint64_t* y) {
+	__m128i a, b, lo, mid, hi;
+	a = _mm_loadu_si128((const __m128i*)x);
+	b = _mm_loadu_si128((const __m128i*)y);
+	lo = mid = hi = _mm_setzero_si128();
+	CLMUL_ACC(lo, mid, hi, a, b);
+	clmul_store(z, lo, mid, hi);
+}
+
+/******************************************************************************
+* z ^= x[0]*y[0] ^ x[1]*y[1] ^ x[2]*y[2] ^ x[3]*y[3].
+******************************************************************************/
+void gf128_mul_acc4(uint64_t* z, const uint64_t (*x)[2],
+				const uint64_t (*y)[2]) {
+#if defined(__VPCLMULQDQ__) && defined(__AVX2__)
+	__m256i a, b, lo, mid, hi;
+	lo = mid = hi = _mm256_setzero_si256();
+	for(int i = 0; i < 4; i += 2) {
+		a = _mm256_loadu_si256((const __m256i*)x[i]);
+		b = _mm256_loadu_si256((const __m256i*)y[i]);
+		lo = _mm256_xor_si256(lo, _mm256_clmulepi64_epi128(a, b, 0x00));
+		hi = _mm256_xor_si256(hi, _mm256_clmulepi64_epi128(a, b, 0x11));
+		mid = _mm256_xor_si256(mid, _mm256_clmulepi64_epi128(a, b, 0x01));
+		mid = _mm256_xor_si256(mid, _mm256_clmulepi64_epi128(a, b, 0x10));
+	}
+	clmul_store(z,
+		_mm_xor_si128(_mm256_castsi256_si128(lo),
+					_mm256_extracti128_si256(lo, 1)),
+		_mm_xor_si128(_mm256_castsi256_si128(mid),
+					_mm256_extracti128_si256(mid, 1)),
+		_mm_xor_si128(_mm256_castsi256_si128(hi),
+					_mm256_extracti128_si256(hi, 1)));
+#else
+	__m128i a, b, lo, mid, hi;
+	lo = mid = hi = _mm_setzero_si128();
+	for(int i = 0; i < 4; i++) {
+		a = _mm_loadu_si128((const __m128i*)x[i]);
+		b = _mm_loadu_si128((const __m128i*)y[i]);
+		CLMUL_ACC(lo, mid, hi, a, b);
+	}
+	clmul_store(z, lo, mid, hi);
+#endif
+}
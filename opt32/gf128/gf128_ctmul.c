@@ -0,0 +1,85 @@
+/******************************************************************************
+* Constant-time carry-less multiplication backend for POLYVAL/GHASH relying on
+* 32x32->64 integer multiplications, suited to 32-bit platforms.
+*
+* The operands are split into 4 interleaved parts with "holes" of 3 bits
+* between the data bits, so that carries cannot spread to meaningful bits
+* (this is the approach taken in BearSSL, see
+* https://bearssl.org/constanttime.html). Therefore no table lookup nor any
+* secret-dependent branch is used.
+* Note that it assumes the 32x32->64 multiplication to be constant-time, which
+* is not the case on some cores (e.g. ARM Cortex-M3).
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "gf128.h"
+#include "internal-gf128.h"
+
+const char gf128_impl[] = "ctmul32";
+
+/******************************************************************************
+* Carry-less multiplication of two 32-bit words using integer multiplications
+* with holes.
+******************************************************************************/
+static uint64_t bmul32(uint32_t x, uint32_t y) {
+	uint32_t x0, x1, x2, x3, y0, y1, y2, y3;
+	uint64_t z0, z1, z2, z3;
+	x0 = x & 0x11111111;
+	x1 = x & 0x22222222;
+	x2 = x & 0x44444444;
+	x3 = x & 0x88888888;
+	y0 = y & 0x11111111;
+	y1 = y & 0x22222222;
+	y2 = y & 0x44444444;
+	y3 = y & 0x88888888;
+	z0 = ((uint64_t)x0 * y0) ^ ((uint64_t)x1 * y3) ^
+		 ((uint64_t)x2 * y2) ^ ((uint64_t)x3 * y1);
+	z1 = ((uint64_t)x0 * y1) ^ ((uint64_t)x1 * y0) ^
+		 ((uint64_t)x2 * y3) ^ ((uint64_t)x3 * y2);
+	z2 = ((uint64_t)x0 * y2) ^ ((uint64_t)x1 * y1) ^
+		 ((uint64_t)x2 * y0) ^ ((uint64_t)x3 * y3);
+	z3 = ((uint64_t)x0 * y3) ^ ((uint64_t)x1 * y2) ^
+		 ((uint64_t)x2 * y1) ^ ((uint64_t)x3 * y0);
+	z0 &= 0x1111111111111111;
+	z1 &= 0x2222222222222222;
+	z2 &= 0x4444444444444444;
+	z3 &= 0x8888888888888888;
+	return z0 | z1 | z2 | z3;
+}
+
+/******************************************************************************
+* Carry-less multiplication of two 64-bit words (Karatsuba).
+******************************************************************************/
+static void bmul64(uint64_t* hi, uint64_t* lo, uint64_t x, uint64_t y) {
+	uint64_t z0, z1, z2;
+	z0 = bmul32(x, y);
+	z2 = bmul32(x >> 32, y >> 32);
+	z1 = bmul32(x ^ (x >> 32), y ^ (y >> 32)) ^ z0 ^ z2;
+	*lo = z0 ^ (z1 << 32);
+	*hi = z2 ^ (z1 >> 32);
+}
+
+/******************************************************************************
+* z ^= x * y where x, y are 128-bit and z is 256-bit (Karatsuba).
+******************************************************************************/
+void gf128_mul_acc(uint64_t* z, const uint64_t* x, const uint64_t* y) {
+	uint64_t z0, z1, z2, z3, t0, t1;
+	bmul64(&z1, &z0, x[0], y[0]);
+	bmul64(&z3, &z2, x[1], y[1]);
+	bmul64(&t1, &t0, x[0] ^ x[1], y[0] ^ y[1]);
+	t0 ^= z0 ^ z2;
+	t1 ^= z1 ^ z3;
+	z[0] ^= z0;
+	z[1] ^= z1 ^ t0;
+	z[2] ^= z2 ^ t1;
+	z[3] ^= z3;
+}
+
+void gf128_mul_acc4(uint64_t* z, const uint64_t (*x)[2],
+				const uint64_t (*y)[2]) {
+	for(int i = 0; i < 4; i++)
+		gf128_mul_acc(z, x[i], y[i]);
+}
@@ -0,0 +1,85 @@
+/******************************************************************************
+* Constant-time carry-less multiplication backend for POLYVAL/GHASH relying on
+* 64x64->64 integer multiplications, suited to 64-bit platforms.
+*
+* Same "holes" approach as in 'gf128_ctmul.c' but on 64-bit words. With 4
+* interleaved parts, only the lower 64 bits of each product are guaranteed to
+* be free of carry propagation, so the upper 64 bits are obtained from the
+* product of the bit-reversed operands (as in BearSSL's ghash_ctmul64).
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "gf128.h"
+#include "internal-gf128.h"
+
+const char gf128_impl[] = "ctmul64";
+
+/******************************************************************************
+* Lower 64 bits of the carry-less product of two 64-bit words.
+******************************************************************************/
+static uint64_t bmul64_lo(uint64_t x, uint64_t y) {
+	uint64_t x0, x1, x2, x3, y0, y1, y2, y3;
+	uint64_t z0, z1, z2, z3;
+	x0 = x & 0x1111111111111111;
+	x1 = x & 0x2222222222222222;
+	x2 = x & 0x4444444444444444;
+	x3 = x & 0x8888888888888888;
+	y0 = y & 0x1111111111111111;
+	y1 = y & 0x2222222222222222;
+	y2 = y & 0x4444444444444444;
+	y3 = y & 0x8888888888888888;
+	z0 = (x0 * y0) ^ (x1 * y3) ^ (x2 * y2) ^ (x3 * y1);
+	z1 = (x0 * y1) ^ (x1 * y0) ^ (x2 * y3) ^ (x3 * y2);
+	z2 = (x0 * y2) ^ (x1 * y1) ^ (x2 * y0) ^ (x3 * y3);
+	z3 = (x0 * y3) ^ (x1 * y2) ^ (x2 * y1) ^ (x3 * y0);
+	z0 &= 0x1111111111111111;
+	z1 &= 0x2222222222222222;
+	z2 &= 0x4444444444444444;
+	z3 &= 0x8888888888888888;
+	return z0 | z1 | z2 | z3;
+}
+
+/******************************************************************************
+* Bit reversal of a 64-bit word.
+******************************************************************************/
+static uint64_t rev64(uint64_t x) {
+	x = ((x & 0x5555555555555555) << 1) | ((x >> 1) & 0x5555555555555555);
+	x = ((x & 0x3333333333333333) << 2) | ((x >> 2) & 0x3333333333333333);
+	x = ((x & 0x0f0f0f0f0f0f0f0f) << 4) | ((x >> 4) & 0x0f0f0f0f0f0f0f0f);
+	x = ((x & 0x00ff00ff00ff00ff) << 8) | ((x >> 8) & 0x00ff00ff00ff00ff);
+	x = ((x & 0x0000ffff0000ffff) << 16) | ((x >> 16) & 0x0000ffff0000ffff);
+	return (x << 32) | (x >> 32);
+}
+
+/******************************************************************************
+* Carry-less multiplication of two 64-bit words.
+******************************************************************************/
+static void bmul64(uint64_t* hi, uint64_t* lo, uint64_t x, uint64_t y) {
+	*lo = bmul64_lo(x, y);
+	*hi = rev64(bmul64_lo(rev64(x), rev64(y))) >> 1;
+}
+
+/******************************************************************************
+* z ^= x * y where x, y are 128-bit and z is 256-bit (Karatsuba).
+******************************************************************************/
+void gf128_mul_acc(uint64_t* z, const uint64_t* x, const uint64_t* y) {
+	uint64_t z0, z1, z2, z3, t0, t1;
+	bmul64(&z1, &z0, x[0], y[0]);
+	bmul64(&z3, &z2, x[1], y[1]);
+	bmul64(&t1, &t0, x[0] ^ x[1], y[0] ^ y[1]);
+	t0 ^= z0 ^ z2;
+	t1 ^= z1 ^ z3;
+	z[0] ^= z0;
+	z[1] ^= z1 ^ t0;
+	z[2] ^= z2 ^ t1;
+	z[3] ^= z3;
+}
+
+void gf128_mul_acc4(uint64_t* z, const uint64_t (*x)[2],
+				const uint64_t (*y)[2]) {
+	for(int i = 0; i < 4; i++)
+		gf128_mul_acc(z, x[i], y[i]);
+}
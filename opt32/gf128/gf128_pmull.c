@@ -0,0 +1,83 @@
+/******************************************************************************
+* Carry-less multiplication backend for POLYVAL/GHASH relying on the PMULL
+* instructions of the ARMv8 Crypto Extension (compile with e.g.
+* -march=armv8-a+crypto). Counterpart of 'gf128_clmul.c' for AArch64.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#if !defined(__ARM_FEATURE_AES) && !defined(__ARM_FEATURE_CRYPTO)
+#error "gf128_pmull.c requires PMULL support (e.g. -march=armv8-a+crypto)"
+#endif
+
+#include <arm_neon.h>
+#include "gf128.h"
+#include "internal-gf128.h"
+
+const char gf128_impl[] = "pmull";
+
+/******************************************************************************
+* 64x64->128 carry-less multiplications of the low (resp. high) halves.
+******************************************************************************/
+static inline uint64x2_t pmull_lo(uint64x2_t a, uint64x2_t b) {
+	return vreinterpretq_u64_p128(vmull_p64(
+		(poly64_t)vgetq_lane_u64(a, 0), (poly64_t)vgetq_lane_u64(b, 0)));
+}
+
+static inline uint64x2_t pmull_hi(uint64x2_t a, uint64x2_t b) {
+	return vreinterpretq_u64_p128(vmull_high_p64(
+		vreinterpretq_p64_u64(a), vreinterpretq_p64_u64(b)));
+}
+
+/******************************************************************************
+* Karatsuba-free schoolbook product (4 PMULL) accumulated in lo/mid/hi. The
+* cross terms are obtained by swapping the halves of b.
+******************************************************************************/
+#define PMULL_ACC(lo, mid, hi, a, b)	({							\
+	uint64x2_t _bs = vextq_u64(b, b, 1);							\
+	lo = veorq_u64(lo, pmull_lo(a, b));								\
+	hi = veorq_u64(hi, pmull_hi(a, b));								\
+	mid = veorq_u64(mid, pmull_lo(a, _bs));							\
+	mid = veorq_u64(mid, pmull_hi(a, _bs));							\
+})
+
+/******************************************************************************
+* Folds the middle term into lo/hi and accumulates the result into z.
+******************************************************************************/
+static void pmull_store(uint64_t* z, uint64x2_t lo, uint64x2_t mid,
+				uint64x2_t hi) {
+	uint64x2_t zero = vdupq_n_u64(0);
+	lo = veorq_u64(lo, vextq_u64(zero, mid, 1));
+	hi = veorq_u64(hi, vextq_u64(mid, zero, 1));
+	vst1q_u64(z, veorq_u64(vld1q_u64(z), lo));
+	vst1q_u64(z + 2, veorq_u64(vld1q_u64(z + 2), hi));
+}
+
+/******************************************************************************
+* z ^= x * y where x, y are 128-bit and z is 256-bit.
+******************************************************************************/
+void gf128_mul_acc(uint64_t* z, const uint64_t* x, const uint64_t* y) {
+	uint64x2_t a, b, lo, mid, hi;
+	a = vld1q_u64(x);
+	b = vld1q_u64(y);
+	lo = mid = hi = vdupq_n_u64(0);
+	PMULL_ACC(lo, mid, hi, a, b);
+	pmull_store(z, lo, mid, hi);
+}
+
+/******************************************************************************
+* z ^= x[0]*y[0] ^ x[1]*y[1] ^ x[2]*y[2] ^ x[3]*y[3].
+******************************************************************************/
+void gf128_mul_acc4(uint64_t* z, const uint64_t (*x)[2],
+				const uint64_t (*y)[2]) {
+	uint64x2_t a, b, lo, mid, hi;
+	lo = mid = hi = vdupq_n_u64(0);
+	for(int i = 0; i < 4; i++) {
+		a = vld1q_u64(x[i]);
+		b = vld1q_u64(y[i]);
+		PMULL_ACC(lo, mid, hi, a, b);
+	}
+	pmull_store(z, lo, mid, hi);
+}
@@ -0,0 +1,31 @@
+#ifndef INTERNAL_GF128_H_
+#define INTERNAL_GF128_H_
+
+#include <stdint.h>
+
+#define LE_LOAD_32(x) 										\
+    ((((uint32_t)((x)[3])) << 24) | 						\
+     (((uint32_t)((x)[2])) << 16) | 						\
+     (((uint32_t)((x)[1])) << 8) | 							\
+      ((uint32_t)((x)[0])))
+
+#define BE_LOAD_32(x) 										\
+    ((((uint32_t)((x)[0])) << 24) | 						\
+     (((uint32_t)((x)[1])) << 16) | 						\
+     (((uint32_t)((x)[2])) << 8) | 							\
+      ((uint32_t)((x)[3])))
+
+#define LE_LOAD_64(x) 										\
+	((((uint64_t)LE_LOAD_32((x) + 4)) << 32) | LE_LOAD_32(x))
+
+#define BE_LOAD_64(x) 										\
+	((((uint64_t)BE_LOAD_32(x)) << 32) | BE_LOAD_32((x) + 4))
+
+/* z ^= x * y (256-bit unreduced carry-less product), backend-specific */
+void gf128_mul_acc(uint64_t* z, const uint64_t* x, const uint64_t* y);
+
+/* z ^= x[0]*y[0] ^ x[1]*y[1] ^ x[2]*y[2] ^ x[3]*y[3], backend-specific */
+void gf128_mul_acc4(uint64_t* z, const uint64_t (*x)[2],
+				const uint64_t (*y)[2]);
+
+#endif 	// INTERNAL_GF128_H_
@@ -0,0 +1,252 @@
+/******************************************************************************
+* AES-CCM (NIST SP 800-38C, RFC 3610) authenticated encryption on top of the
+* fully-fixsliced AES implementations.
+*
+* CCM requires one CBC-MAC computation and one CTR keystream block for each
+* 16-byte block of payload. Since both computations are independent, they are
+* mapped onto the two lanes of the fixsliced core: the CBC-MAC chaining value
+* is processed in the 1st lane while the next counter block is processed in
+* the 2nd lane, so that only one core call is required per payload block.
+* The keystream is computed one block ahead so that the decryption can feed
+* the recovered plaintext into the CBC-MAC within the same core call.
+*
+* The round keys are expected to be computed with the same key for both lanes
+* (e.g. using 'aes128_keyschedule_ffs(rkeys, key, key)').
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy, memset
+#include "../fixslicing/aes.h"
+#include "modes.h"
+#include "internal-modes.h"
+
+/******************************************************************************
+* Checks the CCM parameters and initializes the first block B0 of the CBC-MAC
+* as well as the counter block A1 (or A0 if there is no payload to process).
+* Returns 0 on success, -1 if the parameters are not supported.
+******************************************************************************/
+static int ccm_init(unsigned char* b0, unsigned char* ctr, size_t len,
+				size_t ad_len, const unsigned char* nonce, size_t nonce_len,
+				size_t tag_len) {
+	size_t q = 15 - nonce_len; 			// size of the length field
+	if (nonce_len < 7 || nonce_len > 13)
+		return -1;
+	if (tag_len < 4 || tag_len > 16 || (tag_len & 1))
+		return -1;
+	if (q < sizeof(size_t) && (len >> (8*q)) != 0)
+		return -1;
+	b0[0] = ((ad_len != 0) << 6) | (((tag_len - 2)/2) << 3) | (q - 1);
+	memcpy(b0 + 1, nonce, nonce_len);
+	for(size_t i = 0; i < q; i++, len >>= 8)
+		b0[15 - i] = len & 0xff;
+	memset(ctr, 0x00, 16);
+	ctr[0] = q - 1;
+	memcpy(ctr + 1, nonce, nonce_len);
+	return 0;
+}
+
+/******************************************************************************
+* Increments the q-byte counter stored in the last bytes of the counter block.
+******************************************************************************/
+static void ccm_inc_ctr(unsigned char* ctr) {
+	for(int i = 15; i > 0 && ++ctr[i] == 0; i--);
+}
+
+/******************************************************************************
+* XORs len bytes into the CBC-MAC chaining value and encrypts it whenever a
+* full block has been absorbed. The 2nd lane of the core is not used here
+* since the additional data does not involve any keystream computation.
+******************************************************************************/
+static void ccm_absorb(unsigned char* mac, size_t* pos,
+				const unsigned char* in, size_t len, fs_encrypt_t encrypt,
+				const uint32_t* rkeys) {
+	for(size_t i = 0; i < len; i++) {
+		mac[(*pos)++] ^= in[i];
+		if (*pos == 16) {
+			encrypt(mac, mac, mac, mac, rkeys);
+			METRICS_FS_BATCH(1);
+			*pos = 0;
+		}
+	}
+}
+
+/******************************************************************************
+* Authenticates the additional data, encrypts (or decrypts if 'decrypt' is set)
+* the payload and computes the authentication tag.
+* Each core call processes the CBC-MAC on the 1st lane and the keystream on the
+* 2nd lane. The keystream block S0 used to encrypt the tag is computed along
+* with the last payload block (or along with B0 if there is no payload).
+******************************************************************************/
+static int ccm_crypt(unsigned char* out, unsigned char* tag,
+				const unsigned char* in, size_t len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				int decrypt, fs_encrypt_t encrypt, const uint32_t* rkeys) {
+	_Alignas(4) unsigned char mac[16], ks[16], ctr[16], a0[16];
+	unsigned char hdr[10];
+	size_t pos = 0, hdr_len, blen;
+	if (ccm_init(mac, ctr, len, ad_len, nonce, nonce_len, tag_len))
+		return -1;
+	METRICS_BEGIN(len + ad_len);
+	memcpy(a0, ctr, 16); 				// A0 is used to encrypt the tag
+	ccm_inc_ctr(ctr); 					// A1
+	encrypt(mac, ks, mac, len ? ctr : a0, rkeys);
+	METRICS_FS_BATCH(2);
+	if (ad_len) {
+		if (ad_len < 0xff00) { 			// 2-byte encoding of the AD length
+			hdr[0] = ad_len >> 8;
+			hdr[1] = ad_len & 0xff;
+			hdr_len = 2;
+		} else if ((uint64_t)ad_len >> 32 == 0) {
+			hdr[0] = 0xff;
+			hdr[1] = 0xfe;
+			BE_STORE_32(hdr + 2, (uint32_t)ad_len);
+			hdr_len = 6;
+		} else {
+			hdr[0] = 0xff;
+			hdr[1] = 0xff;
+			BE_STORE_32(hdr + 2, (uint32_t)((uint64_t)ad_len >> 32));
+			BE_STORE_32(hdr + 6, (uint32_t)ad_len);
+			hdr_len = 10;
+		}
+		ccm_absorb(mac, &pos, hdr, hdr_len, encrypt, rkeys);
+		ccm_absorb(mac, &pos, ad, ad_len, encrypt, rkeys);
+		if (pos) { 						// zero-padding of the last AD block
+			encrypt(mac, mac, mac, mac, rkeys);
+			METRICS_FS_BATCH(1);
+		}
+	}
+	while (len) {
+		blen = len < 16 ? len : 16;
+		if (decrypt) {
+			xor_bytes(out, in, ks, blen);
+			xor_bytes(mac, mac, out, blen);
+		} else {
+			xor_bytes(mac, mac, in, blen);
+			xor_bytes(out, in, ks, blen);
+		}
+		in += blen;
+		out += blen;
+		len -= blen;
+		ccm_inc_ctr(ctr);
+		// CBC-MAC on the 1st lane, next keystream block (or S0) on the 2nd
+		encrypt(mac, ks, mac, len ? ctr : a0, rkeys);
+		METRICS_FS_BATCH(2);
+	}
+	xor_bytes(tag, mac, ks, tag_len); 	// T = MSB_M(X) ^ MSB_M(S0)
+	METRICS_END();
+	return 0;
+}
+
+/******************************************************************************
+* AES-CCM encryption of 'ptext_len' bytes from 'ptext' into 'ctext' along with
+* the authentication of 'ad_len' bytes of additional data. The 'tag_len'-byte
+* authentication tag is written in 'tag'.
+* Valid nonce lengths range from 7 to 13 bytes and valid tag lengths are even
+* values from 4 to 16 bytes.
+* Returns 0 on success, -1 if the parameters are not supported.
+******************************************************************************/
+int aes128_ccm_encrypt(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				const uint32_t rkeys_ffs[88]) {
+	return ccm_crypt(ctext, tag, ptext, ptext_len, ad, ad_len, nonce,
+				nonce_len, tag_len, 0, aes128_encrypt_ffs, rkeys_ffs);
+}
+
+/******************************************************************************
+* AES-CCM decryption of 'ctext_len' bytes from 'ctext' into 'ptext' and
+* verification of the 'tag_len'-byte authentication tag 'tag'.
+* Returns 0 if the tag is valid, -1 otherwise (in which case 'ptext' is
+* zeroized).
+******************************************************************************/
+int aes128_ccm_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				const uint32_t rkeys_ffs[88]) {
+	unsigned char computed_tag[16];
+	if (ccm_crypt(ptext, computed_tag, ctext, ctext_len, ad, ad_len, nonce,
+				nonce_len, tag_len, 1, aes128_encrypt_ffs, rkeys_ffs))
+		return -1;
+	if (ct_memcmp(computed_tag, tag, tag_len)) {
+		memset(ptext, 0x00, ctext_len);
+		return -1;
+	}
+	return 0;
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_ccm_encrypt'.
+******************************************************************************/
+int aes256_ccm_encrypt(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				const uint32_t rkeys_ffs[120]) {
+	return ccm_crypt(ctext, tag, ptext, ptext_len, ad, ad_len, nonce,
+				nonce_len, tag_len, 0, aes256_encrypt_ffs, rkeys_ffs);
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_ccm_decrypt'.
+******************************************************************************/
+int aes256_ccm_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				const uint32_t rkeys_ffs[120]) {
+	unsigned char computed_tag[16];
+	if (ccm_crypt(ptext, computed_tag, ctext, ctext_len, ad, ad_len, nonce,
+				nonce_len, tag_len, 1, aes256_encrypt_ffs, rkeys_ffs))
+		return -1;
+	if (ct_memcmp(computed_tag, tag, tag_len)) {
+		memset(ptext, 0x00, ctext_len);
+		return -1;
+	}
+	return 0;
+}
+
+/******************************************************************************
+* AES-CCM-8 variants (i.e. with 8-byte tags) commonly used on constrained
+* devices (e.g. TLS_AES_128_CCM_8_SHA256, IEEE 802.15.4).
+******************************************************************************/
+int aes128_ccm8_encrypt(unsigned char* ctext, unsigned char tag[8],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len,
+				const uint32_t rkeys_ffs[88]) {
+	return aes128_ccm_encrypt(ctext, tag, ptext, ptext_len, ad, ad_len,
+				nonce, nonce_len, 8, rkeys_ffs);
+}
+
+int aes128_ccm8_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[8],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len,
+				const uint32_t rkeys_ffs[88]) {
+	return aes128_ccm_decrypt(ptext, ctext, ctext_len, tag, ad, ad_len,
+				nonce, nonce_len, 8, rkeys_ffs);
+}
+
+int aes256_ccm8_encrypt(unsigned char* ctext, unsigned char tag[8],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len,
+				const uint32_t rkeys_ffs[120]) {
+	return aes256_ccm_encrypt(ctext, tag, ptext, ptext_len, ad, ad_len,
+				nonce, nonce_len, 8, rkeys_ffs);
+}
+
+int aes256_ccm8_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[8],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len,
+				const uint32_t rkeys_ffs[120]) {
+	return aes256_ccm_decrypt(ptext, ctext, ctext_len, tag, ad, ad_len,
+				nonce, nonce_len, 8, rkeys_ffs);
+}
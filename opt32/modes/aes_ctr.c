@@ -0,0 +1,147 @@
+/******************************************************************************
+* AES-CTR (NIST SP 800-38A) on top of the barrel-shiftrows AES implementations
+* with keystream precomputation for latency-critical streams.
+*
+* Each stream keeps a ring buffer of keystream that is refilled by batches of
+* 8 counter blocks (128 bytes), i.e. one full barrel-shiftrows call. The
+* refill can be run by another thread (e.g. an idle worker) or by the caller
+* itself during idle cycles, so that 'aes_ctr_crypt' only XORs the data with
+* ready keystream. If the ring runs dry, 'aes_ctr_crypt' refills it itself.
+*
+* 'aes_ctr_crypt' must only be called by one thread at a time for a given
+* stream, while 'aes_ctr_refill' can be called concurrently from any thread:
+* concurrent refills are serialized by a flag and the produced/consumed
+* positions are exchanged with acquire/release semantics.
+* Note that the precomputed keystream remains in memory until it is consumed
+* or until 'aes_ctr_wipe' is called.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy, memset
+#include "../barrel_shiftrows/aes.h"
+#include "modes.h"
+#include "internal-modes.h"
+
+/* The positions wrap around at 2^N, so that the ring size has to divide it */
+#if (AES_CTR_RING_SIZE < 128) || (AES_CTR_RING_SIZE & (AES_CTR_RING_SIZE - 1))
+#error "AES_CTR_RING_SIZE must be a power of two not lower than 128"
+#endif
+
+/******************************************************************************
+* Increments the 128-bit big-endian counter block.
+******************************************************************************/
+static void ctr_inc(unsigned char* ctr) {
+	for(int i = 15; i >= 0 && ++ctr[i] == 0; i--);
+}
+
+static void ctr_init(aes_ctr_stream* st, const unsigned char* iv,
+				bsr_encrypt_t encrypt, const uint32_t* rkeys) {
+	st->encrypt = encrypt;
+	st->rkeys = rkeys;
+	memcpy(st->ctr, iv, 16);
+	atomic_init(&st->head, 0);
+	atomic_init(&st->tail, 0);
+	atomic_flag_clear(&st->refilling);
+}
+
+/******************************************************************************
+* Initializes an AES-128-CTR stream with the initial counter block 'iv' and the
+* barrel-shiftrows round keys 'rkeys' (which must remain valid as long as the
+* stream is in use). No keystream is precomputed at this point.
+******************************************************************************/
+void aes128_ctr_init(aes_ctr_stream* st, const unsigned char iv[16],
+				const uint32_t rkeys[352]) {
+	ctr_init(st, iv, aes128_encrypt, rkeys);
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_ctr_init'.
+******************************************************************************/
+void aes256_ctr_init(aes_ctr_stream* st, const unsigned char iv[16],
+				const uint32_t rkeys[480]) {
+	ctr_init(st, iv, aes256_encrypt, rkeys);
+}
+
+/******************************************************************************
+* Produces at least 'len' bytes of keystream (or less if the ring gets full),
+* 128 bytes per call to the core. Returns the number of bytes produced, which
+* is 0 if the ring is full or if another thread is already refilling it.
+******************************************************************************/
+static size_t refill(aes_ctr_stream* st, size_t len) {
+	_Alignas(4) unsigned char ctr[128];
+	size_t head, tail, produced = 0;
+	if (atomic_flag_test_and_set_explicit(&st->refilling,
+			memory_order_acquire))
+		return 0;
+	head = atomic_load_explicit(&st->head, memory_order_relaxed);
+	tail = atomic_load_explicit(&st->tail, memory_order_acquire);
+	while (produced < len && AES_CTR_RING_SIZE - (head - tail) >= 128) {
+		for(int i = 0; i < 8; i++) {
+			memcpy(ctr + 16*i, st->ctr, 16);
+			ctr_inc(st->ctr);
+		}
+		st->encrypt(st->ks + head % AES_CTR_RING_SIZE, ctr, st->rkeys);
+		METRICS_BSR_BATCH(8);
+		head += 128;
+		produced += 128;
+		atomic_store_explicit(&st->head, head, memory_order_release);
+	}
+	atomic_flag_clear_explicit(&st->refilling, memory_order_release);
+	return produced;
+}
+
+/******************************************************************************
+* Fills the free space of the ring with keystream. Meant to be called by an
+* idle worker or during idle cycles. Returns the number of bytes produced.
+******************************************************************************/
+size_t aes_ctr_refill(aes_ctr_stream* st) {
+	return refill(st, AES_CTR_RING_SIZE);
+}
+
+/******************************************************************************
+* Encrypts (or decrypts) 'len' bytes from 'in' into 'out' with the next
+* keystream bytes of the stream. The keystream of a partially used block is
+* kept for the next call, so that a stream can be processed in chunks of any
+* length.
+******************************************************************************/
+void aes_ctr_crypt(aes_ctr_stream* st, unsigned char* out,
+				const unsigned char* in, size_t len) {
+	size_t head, tail, n, pos;
+	METRICS_BEGIN(len);
+	tail = atomic_load_explicit(&st->tail, memory_order_relaxed);
+	while (len) {
+		head = atomic_load_explicit(&st->head, memory_order_acquire);
+		if (head == tail) { 			// ring is empty: only computes what we need
+			refill(st, len);
+			continue;
+		}
+		pos = tail % AES_CTR_RING_SIZE;
+		n = head - tail;
+		n = n < len ? n : len;
+		n = n < AES_CTR_RING_SIZE - pos ? n : AES_CTR_RING_SIZE - pos;
+		xor_bytes(out, in, st->ks + pos, n);
+		in += n;
+		out += n;
+		len -= n;
+		tail += n;
+		atomic_store_explicit(&st->tail, tail, memory_order_release);
+	}
+	METRICS_END();
+}
+
+/******************************************************************************
+* Erases the precomputed keystream and the counter. The stream must not be
+* used afterwards (unless initialized again).
+******************************************************************************/
+void aes_ctr_wipe(aes_ctr_stream* st) {
+	while (atomic_flag_test_and_set_explicit(&st->refilling,
+			memory_order_acquire));
+	memset(st->ks, 0x00, AES_CTR_RING_SIZE);
+	memset(st->ctr, 0x00, 16);
+	atomic_store_explicit(&st->head, 0, memory_order_relaxed);
+	atomic_store_explicit(&st->tail, 0, memory_order_relaxed);
+	atomic_flag_clear_explicit(&st->refilling, memory_order_release);
+}
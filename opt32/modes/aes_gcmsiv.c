@@ -0,0 +1,72 @@
+/******************************************************************************
+* Routines of AES-GCM-SIV (RFC 8452) that do not depend on the underlying AES
+* implementation: key derivation blocks, POLYVAL over the AD and plaintext and
+* counter increment. See 'aes_gcmsiv_ffs.c' and 'aes_gcmsiv_bsr.c' for the
+* fixsliced and barrel-shiftrows instantiations, respectively.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy, memset
+#include "../gf128/gf128.h"
+#include "internal-modes.h"
+
+/******************************************************************************
+* RFC 8452 limits both the plaintext and the AD to 2^36 bytes.
+* Returns 0 if the lengths are valid, -1 otherwise.
+******************************************************************************/
+int gcmsiv_check_lengths(size_t ptext_len, size_t ad_len) {
+	if ((uint64_t)ptext_len > ((uint64_t)1 << 36))
+		return -1;
+	if ((uint64_t)ad_len > ((uint64_t)1 << 36))
+		return -1;
+	return 0;
+}
+
+/******************************************************************************
+* Fills the 'nblocks' 16-byte blocks LE32(i) || nonce used to derive the
+* message-authentication and message-encryption keys.
+******************************************************************************/
+void gcmsiv_init_blocks(unsigned char* blocks, const unsigned char* nonce,
+				int nblocks) {
+	for(int i = 0; i < nblocks; i++) {
+		LE_STORE_32(blocks + i*16, (uint32_t)i);
+		memcpy(blocks + i*16 + 4, nonce, 12);
+	}
+}
+
+/******************************************************************************
+* Computes the block to encrypt to get the tag, i.e. the POLYVAL over the
+* padded AD, padded plaintext and length block, XORed with the nonce and with
+* the most significant bit of the last byte cleared.
+******************************************************************************/
+void gcmsiv_tag_input(unsigned char* s, const unsigned char* auth_key,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* nonce) {
+	unsigned char length_block[16];
+	gf128_key key;
+	uint64_t ad_bits = (uint64_t)ad_len << 3;
+	uint64_t ptext_bits = (uint64_t)ptext_len << 3;
+	LE_STORE_32(length_block, (uint32_t)ad_bits);
+	LE_STORE_32(length_block + 4, (uint32_t)(ad_bits >> 32));
+	LE_STORE_32(length_block + 8, (uint32_t)ptext_bits);
+	LE_STORE_32(length_block + 12, (uint32_t)(ptext_bits >> 32));
+	polyval_init(&key, auth_key);
+	memset(s, 0x00, 16);
+	polyval_update(s, &key, ad, ad_len);
+	polyval_update(s, &key, ptext, ptext_len);
+	polyval_update(s, &key, length_block, 16);
+	xor_bytes(s, s, nonce, 12);
+	s[15] &= 0x7f;
+}
+
+/******************************************************************************
+* Increments the 32-bit little-endian counter in the first 4 bytes of the
+* counter block (modulo 2^32).
+******************************************************************************/
+void gcmsiv_inc_ctr(unsigned char* ctr) {
+	for(int i = 0; i < 4 && ++ctr[i] == 0; i++);
+}
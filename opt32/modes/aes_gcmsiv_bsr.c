@@ -0,0 +1,169 @@
+/******************************************************************************
+* AES-GCM-SIV (RFC 8452) on top of the barrel-shiftrows AES implementations.
+*
+* The per-nonce key derivation (4 or 6 block encryptions) fits into a single
+* 8-block call and the CTR pass processes 8 counter blocks (128 bytes) per
+* call, which makes this instantiation more suited to long messages.
+* The message-encryption round keys are derived with the fully bitsliced key
+* schedule so that no secret-dependent table lookup is performed.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy, memset
+#include "../barrel_shiftrows/aes.h"
+#include "modes.h"
+#include "internal-modes.h"
+
+/******************************************************************************
+* Derives the message-authentication key and the round keys of the
+* message-encryption key from the nonce, using a single 8-block call.
+* 'nblocks' must be 4 for AES-128 and 6 for AES-256.
+******************************************************************************/
+static void gcmsiv_derive_keys(unsigned char* auth_key, uint32_t* rkeys_enc,
+				const unsigned char* nonce, int nblocks, bsr_encrypt_t encrypt,
+				bsr_keyschedule_t keyschedule, const uint32_t* rkeys) {
+	_Alignas(4) unsigned char blocks[128];
+	unsigned char enc_key[32];
+	memset(blocks, 0x00, 128);
+	gcmsiv_init_blocks(blocks, nonce, nblocks);
+	encrypt(blocks, blocks, rkeys);
+	METRICS_BSR_BATCH(nblocks);
+	memcpy(auth_key, blocks, 8);
+	memcpy(auth_key + 8, blocks + 16, 8);
+	for(int i = 2; i < nblocks; i++)
+		memcpy(enc_key + (i-2)*8, blocks + i*16, 8);
+	keyschedule(rkeys_enc, enc_key);
+	METRICS_KEYSCHEDULE();
+}
+
+/******************************************************************************
+* CTR pass of AES-GCM-SIV, 8 counter blocks per call. The initial counter
+* block is the tag with the most significant bit of the last byte set.
+******************************************************************************/
+static void gcmsiv_ctr(unsigned char* out, const unsigned char* in, size_t len,
+				const unsigned char* tag, bsr_encrypt_t encrypt,
+				const uint32_t* rkeys_enc) {
+	_Alignas(4) unsigned char ctr[128], ks[128];
+	size_t blen;
+	memcpy(ctr, tag, 16);
+	ctr[15] |= 0x80;
+	for(int i = 1; i < 8; i++) {
+		memcpy(ctr + i*16, ctr + (i-1)*16, 16);
+		gcmsiv_inc_ctr(ctr + i*16);
+	}
+	while (len) {
+		encrypt(ks, ctr, rkeys_enc);
+		blen = len < 128 ? len : 128;
+		METRICS_BSR_BATCH((blen + 15) / 16);
+		xor_bytes(out, in, ks, blen);
+		in += blen;
+		out += blen;
+		len -= blen;
+		for(int i = 0; i < 8; i++) { 	// adds 8 to all counters
+			for(int j = 0; j < 8; j++)
+				gcmsiv_inc_ctr(ctr + i*16);
+		}
+	}
+}
+
+static int gcmsiv_encrypt(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, int nblocks, bsr_encrypt_t encrypt,
+				bsr_keyschedule_t keyschedule, const uint32_t* rkeys) {
+	unsigned char auth_key[16];
+	_Alignas(4) unsigned char block[128];
+	uint32_t rkeys_enc[480];
+	if (gcmsiv_check_lengths(ptext_len, ad_len))
+		return -1;
+	METRICS_BEGIN(ptext_len + ad_len);
+	gcmsiv_derive_keys(auth_key, rkeys_enc, nonce, nblocks, encrypt,
+				keyschedule, rkeys);
+	memset(block, 0x00, 128);
+	gcmsiv_tag_input(block, auth_key, ad, ad_len, ptext, ptext_len, nonce);
+	encrypt(block, block, rkeys_enc);
+	METRICS_BSR_BATCH(1);
+	memcpy(tag, block, 16);
+	gcmsiv_ctr(ctext, ptext, ptext_len, tag, encrypt, rkeys_enc);
+	METRICS_END();
+	return 0;
+}
+
+static int gcmsiv_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, int nblocks, bsr_encrypt_t encrypt,
+				bsr_keyschedule_t keyschedule, const uint32_t* rkeys) {
+	unsigned char auth_key[16];
+	_Alignas(4) unsigned char block[128];
+	uint32_t rkeys_enc[480];
+	if (gcmsiv_check_lengths(ctext_len, ad_len))
+		return -1;
+	METRICS_BEGIN(ctext_len + ad_len);
+	gcmsiv_derive_keys(auth_key, rkeys_enc, nonce, nblocks, encrypt,
+				keyschedule, rkeys);
+	gcmsiv_ctr(ptext, ctext, ctext_len, tag, encrypt, rkeys_enc);
+	memset(block, 0x00, 128);
+	gcmsiv_tag_input(block, auth_key, ad, ad_len, ptext, ctext_len, nonce);
+	encrypt(block, block, rkeys_enc);
+	METRICS_BSR_BATCH(1);
+	METRICS_END();
+	if (ct_memcmp(block, tag, 16)) {
+		memset(ptext, 0x00, ctext_len);
+		return -1;
+	}
+	return 0;
+}
+
+/******************************************************************************
+* AES-128-GCM-SIV encryption of 'ptext_len' bytes from 'ptext' into 'ctext'
+* along with the authentication of 'ad_len' bytes of additional data. The
+* 16-byte tag is written in 'tag'.
+* Returns 0 on success, -1 if the input lengths exceed 2^36 bytes.
+******************************************************************************/
+int aes128_gcmsiv_encrypt_bsr(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[352]) {
+	return gcmsiv_encrypt(ctext, tag, ptext, ptext_len, ad, ad_len, nonce, 4,
+				aes128_encrypt, aes128_keyschedule, rkeys);
+}
+
+/******************************************************************************
+* AES-128-GCM-SIV decryption of 'ctext_len' bytes from 'ctext' into 'ptext'
+* and verification of the 16-byte tag 'tag'.
+* Returns 0 if the tag is valid, -1 otherwise (in which case 'ptext' is
+* zeroized).
+******************************************************************************/
+int aes128_gcmsiv_decrypt_bsr(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[352]) {
+	return gcmsiv_decrypt(ptext, ctext, ctext_len, tag, ad, ad_len, nonce, 4,
+				aes128_encrypt, aes128_keyschedule, rkeys);
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_gcmsiv_encrypt_bsr'.
+******************************************************************************/
+int aes256_gcmsiv_encrypt_bsr(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[480]) {
+	return gcmsiv_encrypt(ctext, tag, ptext, ptext_len, ad, ad_len, nonce, 6,
+				aes256_encrypt, aes256_keyschedule, rkeys);
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_gcmsiv_decrypt_bsr'.
+******************************************************************************/
+int aes256_gcmsiv_decrypt_bsr(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[480]) {
+	return gcmsiv_decrypt(ptext, ctext, ctext_len, tag, ad, ad_len, nonce, 6,
+				aes256_encrypt, aes256_keyschedule, rkeys);
+}
@@ -0,0 +1,168 @@
+/******************************************************************************
+* AES-GCM-SIV (RFC 8452) on top of the fully-fixsliced AES implementations.
+*
+* The per-nonce key derivation requires 4 (resp. 6) block encryptions for
+* AES-128 (resp. AES-256), which are batched into 2 (resp. 3) fixsliced calls.
+* The message-encryption round keys are derived with the fully bitsliced key
+* schedule so that no secret-dependent table lookup is performed. The CTR pass
+* processes 2 counter blocks per call.
+*
+* The round keys of the key-generating key are expected to be computed with
+* the same key for both lanes (e.g. 'aes128_keyschedule_ffs(rkeys, key, key)').
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy, memset
+#include "../fixslicing/aes.h"
+#include "modes.h"
+#include "internal-modes.h"
+
+/******************************************************************************
+* Derives the message-authentication key and the round keys of the
+* message-encryption key from the nonce, 2 blocks at a time.
+* 'nblocks' must be 4 for AES-128 and 6 for AES-256.
+******************************************************************************/
+static void gcmsiv_derive_keys(unsigned char* auth_key, uint32_t* rkeys_enc,
+				const unsigned char* nonce, int nblocks, fs_encrypt_t encrypt,
+				fs_keyschedule_t keyschedule, const uint32_t* rkeys) {
+	_Alignas(4) unsigned char blocks[96];
+	unsigned char enc_key[32];
+	gcmsiv_init_blocks(blocks, nonce, nblocks);
+	for(int i = 0; i < nblocks; i += 2) {
+		encrypt(blocks + i*16, blocks + i*16 + 16,
+				blocks + i*16, blocks + i*16 + 16, rkeys);
+		METRICS_FS_BATCH(2);
+	}
+	memcpy(auth_key, blocks, 8);
+	memcpy(auth_key + 8, blocks + 16, 8);
+	for(int i = 2; i < nblocks; i++)
+		memcpy(enc_key + (i-2)*8, blocks + i*16, 8);
+	keyschedule(rkeys_enc, enc_key, enc_key);
+	METRICS_KEYSCHEDULE();
+}
+
+/******************************************************************************
+* CTR pass of AES-GCM-SIV, 2 counter blocks per call. The initial counter
+* block is the tag with the most significant bit of the last byte set.
+******************************************************************************/
+static void gcmsiv_ctr(unsigned char* out, const unsigned char* in, size_t len,
+				const unsigned char* tag, fs_encrypt_t encrypt,
+				const uint32_t* rkeys_enc) {
+	_Alignas(4) unsigned char ctr0[16], ctr1[16], ks[32];
+	size_t blen;
+	memcpy(ctr0, tag, 16);
+	ctr0[15] |= 0x80;
+	while (len) {
+		memcpy(ctr1, ctr0, 16);
+		gcmsiv_inc_ctr(ctr1);
+		encrypt(ks, ks + 16, ctr0, ctr1, rkeys_enc);
+		blen = len < 32 ? len : 32;
+		METRICS_FS_BATCH((blen + 15) / 16);
+		xor_bytes(out, in, ks, blen);
+		in += blen;
+		out += blen;
+		len -= blen;
+		memcpy(ctr0, ctr1, 16);
+		gcmsiv_inc_ctr(ctr0);
+	}
+}
+
+static int gcmsiv_encrypt(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, int nblocks, fs_encrypt_t encrypt,
+				fs_keyschedule_t keyschedule, const uint32_t* rkeys) {
+	unsigned char auth_key[16];
+	_Alignas(4) unsigned char s[16];
+	uint32_t rkeys_enc[120];
+	if (gcmsiv_check_lengths(ptext_len, ad_len))
+		return -1;
+	METRICS_BEGIN(ptext_len + ad_len);
+	gcmsiv_derive_keys(auth_key, rkeys_enc, nonce, nblocks, encrypt,
+				keyschedule, rkeys);
+	gcmsiv_tag_input(s, auth_key, ad, ad_len, ptext, ptext_len, nonce);
+	encrypt(s, s, s, s, rkeys_enc);
+	memcpy(tag, s, 16); 				// the tag buffer may be unaligned
+	METRICS_FS_BATCH(1);
+	gcmsiv_ctr(ctext, ptext, ptext_len, tag, encrypt, rkeys_enc);
+	METRICS_END();
+	return 0;
+}
+
+static int gcmsiv_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, int nblocks, fs_encrypt_t encrypt,
+				fs_keyschedule_t keyschedule, const uint32_t* rkeys) {
+	unsigned char auth_key[16];
+	_Alignas(4) unsigned char s[16];
+	uint32_t rkeys_enc[120];
+	if (gcmsiv_check_lengths(ctext_len, ad_len))
+		return -1;
+	METRICS_BEGIN(ctext_len + ad_len);
+	gcmsiv_derive_keys(auth_key, rkeys_enc, nonce, nblocks, encrypt,
+				keyschedule, rkeys);
+	gcmsiv_ctr(ptext, ctext, ctext_len, tag, encrypt, rkeys_enc);
+	gcmsiv_tag_input(s, auth_key, ad, ad_len, ptext, ctext_len, nonce);
+	encrypt(s, s, s, s, rkeys_enc);
+	METRICS_FS_BATCH(1);
+	METRICS_END();
+	if (ct_memcmp(s, tag, 16)) {
+		memset(ptext, 0x00, ctext_len);
+		return -1;
+	}
+	return 0;
+}
+
+/******************************************************************************
+* AES-128-GCM-SIV encryption of 'ptext_len' bytes from 'ptext' into 'ctext'
+* along with the authentication of 'ad_len' bytes of additional data. The
+* 16-byte tag is written in 'tag'.
+* Returns 0 on success, -1 if the input lengths exceed 2^36 bytes.
+******************************************************************************/
+int aes128_gcmsiv_encrypt_ffs(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys_ffs[88]) {
+	return gcmsiv_encrypt(ctext, tag, ptext, ptext_len, ad, ad_len, nonce, 4,
+				aes128_encrypt_ffs, aes128_keyschedule_ffs, rkeys_ffs);
+}
+
+/******************************************************************************
+* AES-128-GCM-SIV decryption of 'ctext_len' bytes from 'ctext' into 'ptext'
+* and verification of the 16-byte tag 'tag'.
+* Returns 0 if the tag is valid, -1 otherwise (in which case 'ptext' is
+* zeroized).
+******************************************************************************/
+int aes128_gcmsiv_decrypt_ffs(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys_ffs[88]) {
+	return gcmsiv_decrypt(ptext, ctext, ctext_len, tag, ad, ad_len, nonce, 4,
+				aes128_encrypt_ffs, aes128_keyschedule_ffs, rkeys_ffs);
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_gcmsiv_encrypt_ffs'.
+******************************************************************************/
+int aes256_gcmsiv_encrypt_ffs(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys_ffs[120]) {
+	return gcmsiv_encrypt(ctext, tag, ptext, ptext_len, ad, ad_len, nonce, 6,
+				aes256_encrypt_ffs, aes256_keyschedule_ffs, rkeys_ffs);
+}
+
+/******************************************************************************
+* AES-256 counterpart of 'aes128_gcmsiv_decrypt_ffs'.
+******************************************************************************/
+int aes256_gcmsiv_decrypt_ffs(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys_ffs[120]) {
+	return gcmsiv_decrypt(ptext, ctext, ctext_len, tag, ad, ad_len, nonce, 6,
+				aes256_encrypt_ffs, aes256_keyschedule_ffs, rkeys_ffs);
+}
@@ -0,0 +1,123 @@
+#ifndef INTERNAL_MODES_H_
+#define INTERNAL_MODES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Signature shared by all the fixsliced encryption functions (2 blocks) */
+typedef void (*fs_encrypt_t)(unsigned char*, unsigned char*,
+				const unsigned char*, const unsigned char*, const uint32_t*);
+
+/* Signature shared by the fixsliced key schedule functions (2 keys) */
+typedef void (*fs_keyschedule_t)(uint32_t*, const unsigned char*,
+				const unsigned char*);
+
+/* Signature shared by the barrel-shiftrows encryption functions (8 blocks) */
+typedef void (*bsr_encrypt_t)(unsigned char*, const unsigned char*,
+				const uint32_t*);
+
+/* Signature shared by the barrel-shiftrows key schedule functions */
+typedef void (*bsr_keyschedule_t)(uint32_t*, const unsigned char*);
+
+/******************************************************************************
+* Hooks updating the counters returned by 'modes_metrics_snapshot'. They expand
+* to nothing unless MODES_METRICS is defined. The counters are updated with
+* relaxed atomic additions, i.e. a few cycles per core call.
+******************************************************************************/
+#if defined(MODES_METRICS)
+#include <stdatomic.h>
+#include <time.h>
+
+enum {
+	METRICS_CALLS, METRICS_BYTES, METRICS_FS_BATCHES, METRICS_BSR_BATCHES,
+	METRICS_BLOCKS, METRICS_WASTED_LANES, METRICS_KEYSCHEDULES, METRICS_NS,
+	METRICS_NCOUNTERS
+};
+
+extern _Atomic uint64_t metrics_counters[METRICS_NCOUNTERS];
+
+static inline void metrics_add(int counter, uint64_t value) {
+	atomic_fetch_add_explicit(&metrics_counters[counter], value,
+		memory_order_relaxed);
+}
+
+static inline uint64_t metrics_now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/* End of a call started at 't0' */
+static inline void metrics_end(uint64_t t0) {
+	metrics_add(METRICS_NS, metrics_now() - t0);
+	metrics_add(METRICS_CALLS, 1);
+}
+
+/* Core call where 'used' out of 'lanes' blocks are actually needed */
+static inline void metrics_batch(int counter, uint64_t used, uint64_t lanes) {
+	metrics_add(counter, 1);
+	metrics_add(METRICS_BLOCKS, used);
+	metrics_add(METRICS_WASTED_LANES, lanes - used);
+}
+
+/* Call processing 'nbytes' bytes of payload and additional data */
+#define METRICS_BEGIN(nbytes) 									\
+	uint64_t _metrics_t = metrics_now();						\
+	metrics_add(METRICS_BYTES, (nbytes))
+#define METRICS_END() 											\
+	metrics_end(_metrics_t)
+#define METRICS_FS_BATCH(used) 									\
+	metrics_batch(METRICS_FS_BATCHES, (used), 2)
+#define METRICS_BSR_BATCH(used) 								\
+	metrics_batch(METRICS_BSR_BATCHES, (used), 8)
+#define METRICS_KEYSCHEDULE() 									\
+	metrics_add(METRICS_KEYSCHEDULES, 1)
+#else
+#define METRICS_BEGIN(nbytes)
+#define METRICS_END()
+#define METRICS_FS_BATCH(used)
+#define METRICS_BSR_BATCH(used)
+#define METRICS_KEYSCHEDULE()
+#endif
+
+#define BE_STORE_32(x, y)									\
+	(x)[0] = ((y) >> 24) & 0xff; 							\
+	(x)[1] = ((y) >> 16) & 0xff; 							\
+	(x)[2] = ((y) >> 8) & 0xff; 							\
+	(x)[3] = (y) & 0xff;
+
+#define LE_STORE_32(x, y)									\
+	(x)[0] = (y) & 0xff; 									\
+	(x)[1] = ((y) >> 8) & 0xff; 							\
+	(x)[2] = ((y) >> 16) & 0xff; 							\
+	(x)[3] = (y) >> 24;
+
+static inline void xor_bytes(unsigned char* out, const unsigned char* in0,
+				const unsigned char* in1, size_t len) {
+	for(size_t i = 0; i < len; i++)
+		out[i] = in0[i] ^ in1[i];
+}
+
+/******************************************************************************
+* Compares two byte strings in constant time. Returns 0 if they are equal, -1
+* otherwise.
+******************************************************************************/
+static inline int ct_memcmp(const unsigned char* a, const unsigned char* b,
+				size_t len) {
+	unsigned char diff = 0;
+	for(size_t i = 0; i < len; i++)
+		diff |= a[i] ^ b[i];
+	return -(int)((diff + 0xff) >> 8);
+}
+
+/* AES-GCM-SIV routines which do not depend on the underlying AES core */
+int gcmsiv_check_lengths(size_t ptext_len, size_t ad_len);
+void gcmsiv_init_blocks(unsigned char* blocks, const unsigned char* nonce,
+				int nblocks);
+void gcmsiv_tag_input(unsigned char* s, const unsigned char* auth_key,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* nonce);
+void gcmsiv_inc_ctr(unsigned char* ctr);
+
+#endif 	// INTERNAL_MODES_H_
@@ -0,0 +1,47 @@
+/******************************************************************************
+* Lane utilization and throughput counters of the operating modes, updated by
+* the METRICS_* hooks (see 'internal-modes.h') when built with -DMODES_METRICS.
+*
+* Derived figures of interest:
+* - lane utilization: blocks / (blocks + wasted_lanes)
+* - blocks per batch: blocks / (fs_batches + bsr_batches)
+* - bytes per key schedule: bytes / keyschedules
+* - time per byte: ns / bytes
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#ifndef MODES_METRICS
+#define MODES_METRICS
+#endif
+#include "modes.h"
+#include "internal-modes.h"
+
+_Atomic uint64_t metrics_counters[METRICS_NCOUNTERS];
+
+/******************************************************************************
+* Copies the current value of the counters into 'metrics'. Each counter is
+* read atomically, but the snapshot as a whole is not if other threads are
+* running the modes at the same time.
+******************************************************************************/
+void modes_metrics_snapshot(modes_metrics* metrics) {
+	uint64_t c[METRICS_NCOUNTERS];
+	for(int i = 0; i < METRICS_NCOUNTERS; i++)
+		c[i] = atomic_load_explicit(&metrics_counters[i],
+			memory_order_relaxed);
+	metrics->calls = c[METRICS_CALLS];
+	metrics->bytes = c[METRICS_BYTES];
+	metrics->fs_batches = c[METRICS_FS_BATCHES];
+	metrics->bsr_batches = c[METRICS_BSR_BATCHES];
+	metrics->blocks = c[METRICS_BLOCKS];
+	metrics->wasted_lanes = c[METRICS_WASTED_LANES];
+	metrics->keyschedules = c[METRICS_KEYSCHEDULES];
+	metrics->ns = c[METRICS_NS];
+}
+
+void modes_metrics_reset(void) {
+	for(int i = 0; i < METRICS_NCOUNTERS; i++)
+		atomic_store_explicit(&metrics_counters[i], 0, memory_order_relaxed);
+}
@@ -0,0 +1,136 @@
+#ifndef MODES_H_
+#define MODES_H_
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* AES-CCM authenticated encryption (fully-fixsliced) */
+int aes128_ccm_encrypt(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				const uint32_t rkeys[88]);
+int aes128_ccm_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				const uint32_t rkeys[88]);
+int aes256_ccm_encrypt(unsigned char* ctext, unsigned char* tag,
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				const uint32_t rkeys[120]);
+int aes256_ccm_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char* tag,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len, size_t tag_len,
+				const uint32_t rkeys[120]);
+
+/* AES-CCM-8 (8-byte tag) for constrained devices (fully-fixsliced) */
+int aes128_ccm8_encrypt(unsigned char* ctext, unsigned char tag[8],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len,
+				const uint32_t rkeys[88]);
+int aes128_ccm8_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[8],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len,
+				const uint32_t rkeys[88]);
+int aes256_ccm8_encrypt(unsigned char* ctext, unsigned char tag[8],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len,
+				const uint32_t rkeys[120]);
+int aes256_ccm8_decrypt(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[8],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char* nonce, size_t nonce_len,
+				const uint32_t rkeys[120]);
+
+/* AES-GCM-SIV nonce-misuse-resistant AEAD (fully-fixsliced) */
+int aes128_gcmsiv_encrypt_ffs(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[88]);
+int aes128_gcmsiv_decrypt_ffs(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[88]);
+int aes256_gcmsiv_encrypt_ffs(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[120]);
+int aes256_gcmsiv_decrypt_ffs(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[120]);
+
+/* AES-GCM-SIV nonce-misuse-resistant AEAD (barrel-shiftrows) */
+int aes128_gcmsiv_encrypt_bsr(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[352]);
+int aes128_gcmsiv_decrypt_bsr(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[352]);
+int aes256_gcmsiv_encrypt_bsr(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[480]);
+int aes256_gcmsiv_decrypt_bsr(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[480]);
+
+/******************************************************************************
+* AES-CTR (barrel-shiftrows) with a ring buffer of precomputed keystream, so
+* that encrypting a burst only XORs it against ready keystream. The ring is
+* refilled 128 bytes at a time by 'aes_ctr_refill', either from another
+* thread or during idle cycles. See 'aes_ctr.c'.
+******************************************************************************/
+#ifndef AES_CTR_RING_SIZE
+#define AES_CTR_RING_SIZE 	1024 		// power of two, at least 128
+#endif
+
+typedef struct {
+	void (*encrypt)(unsigned char*, const unsigned char*, const uint32_t*);
+	const uint32_t* rkeys;
+	unsigned char ctr[16]; 				// next counter block to encrypt
+	_Alignas(4) unsigned char ks[AES_CTR_RING_SIZE];
+	_Atomic size_t head; 				// keystream bytes produced
+	_Atomic size_t tail; 				// keystream bytes consumed
+	atomic_flag refilling;
+} aes_ctr_stream;
+
+void aes128_ctr_init(aes_ctr_stream* st, const unsigned char iv[16],
+				const uint32_t rkeys[352]);
+void aes256_ctr_init(aes_ctr_stream* st, const unsigned char iv[16],
+				const uint32_t rkeys[480]);
+size_t aes_ctr_refill(aes_ctr_stream* st);
+void aes_ctr_crypt(aes_ctr_stream* st, unsigned char* out,
+				const unsigned char* in, size_t len);
+void aes_ctr_wipe(aes_ctr_stream* st);
+
+/******************************************************************************
+* Lane utilization and throughput of the modes above, recorded when they are
+* built with -DMODES_METRICS (see 'metrics.c'). All counters are cumulative
+* over all threads since the last reset.
+******************************************************************************/
+typedef struct {
+	uint64_t calls; 			// calls to the encryption/decryption functions
+	uint64_t bytes; 			// payload and additional data processed
+	uint64_t fs_batches; 		// calls to the 2-block fixsliced cores
+	uint64_t bsr_batches; 		// calls to the 8-block barrel-shiftrows cores
+	uint64_t blocks; 			// blocks whose output is used
+	uint64_t wasted_lanes; 		// blocks computed only to fill the batches
+	uint64_t keyschedules; 		// key schedules run within the modes
+	uint64_t ns; 				// time spent in the modes, in nanoseconds
+} modes_metrics;
+
+void modes_metrics_snapshot(modes_metrics* metrics);
+void modes_metrics_reset(void);
+
+#endif 	// MODES_H_
@@ -0,0 +1,88 @@
+/******************************************************************************
+* Per-phase cycle counts of the bitsliced implementations in 'opt32' when
+* built with -DAES_PROFILE (see 'profile.h').
+*
+* Note that the counter is read twice per call, which costs about as much as
+* the smallest phases (e.g. AddRoundKey): this overhead is measured once and
+* subtracted from the reported figures, which should thus be considered as
+* estimates rather than exact counts.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#ifndef AES_PROFILE
+#define AES_PROFILE
+#endif
+#include <string.h> 	// for memcpy, memset
+#include "profile.h"
+
+#define PROFILE_CALIBRATION_RUNS 	1024
+
+_Thread_local profile_stats profile_tls;
+
+static const char* phase_names[PROFILE_NPHASES] = {
+	"packing", "unpacking", "sbox", "shiftrows", "mixcolumns", "ark"
+};
+
+void profile_reset(void) {
+	memset(&profile_tls, 0x00, sizeof(profile_tls));
+}
+
+void profile_get(profile_stats* stats) {
+	memcpy(stats, &profile_tls, sizeof(profile_tls));
+}
+
+/******************************************************************************
+* Returns the minimum cost of an empty PROFILE_BEGIN/PROFILE_END pair, the
+* statistics of the calling thread being left unchanged.
+******************************************************************************/
+uint64_t profile_overhead(void) {
+	static _Thread_local uint64_t overhead = UINT64_MAX;
+	profile_stats saved;
+	if (overhead != UINT64_MAX)
+		return overhead;
+	profile_get(&saved);
+	for(int i = 0; i < PROFILE_CALIBRATION_RUNS; i++) {
+		profile_tls.cycles[0] = 0;
+		{
+			PROFILE_BEGIN();
+			PROFILE_END(0);
+		}
+		if (profile_tls.cycles[0] < overhead)
+			overhead = profile_tls.cycles[0];
+	}
+	memcpy(&profile_tls, &saved, sizeof(saved));
+	return overhead;
+}
+
+/******************************************************************************
+* Prints, for each phase, the number of calls and the cost per encryption of
+* 'nblocks' blocks, the cost per call and the share of the total, where
+* 'nencs' is the number of encryptions profiled in 'stats'.
+******************************************************************************/
+void profile_report(FILE* out, const char* name, const profile_stats* stats,
+				uint64_t nencs, int nblocks) {
+	uint64_t overhead = profile_overhead();
+	double cost[PROFILE_NPHASES], total = 0;
+	for(int i = 0; i < PROFILE_NPHASES; i++) {
+		uint64_t c = stats->cycles[i];
+		uint64_t o = overhead * stats->calls[i];
+		cost[i] = (c > o) ? (double)(c - o) : 0;
+		total += cost[i];
+	}
+	fprintf(out, "%s (%d blocks, %s per encryption)\n", name, nblocks,
+		PROFILE_UNIT);
+	fprintf(out, "  %-12s %8s %10s %10s %7s\n", "phase", "calls", "total",
+		"per call", "share");
+	for(int i = 0; i < PROFILE_NPHASES; i++) {
+		if (!stats->calls[i])
+			continue;
+		fprintf(out, "  %-12s %8.1f %10.1f %10.1f %6.1f%%\n", phase_names[i],
+			(double)stats->calls[i] / nencs, cost[i] / nencs,
+			cost[i] / stats->calls[i], total ? 100 * cost[i] / total : 0);
+	}
+	fprintf(out, "  %-12s %8s %10.1f (%.2f %s per byte)\n", "all", "",
+		total / nencs, total / (nencs * 16 * nblocks), PROFILE_UNIT);
+}
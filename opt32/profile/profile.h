@@ -0,0 +1,79 @@
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+/******************************************************************************
+* Phases of the bitsliced implementations whose cycles are recorded when the
+* 'opt32' implementations are built with -DAES_PROFILE.
+******************************************************************************/
+enum {
+	PROFILE_PACKING, 			// packing
+	PROFILE_UNPACKING, 			// unpacking
+	PROFILE_SBOX, 				// sbox
+	PROFILE_SHIFTROWS, 			// shiftrows, double_shiftrows
+	PROFILE_MIXCOLUMNS, 		// mixcolumns, mixcolumns_0, ..., mixcolumns_3
+	PROFILE_ARK, 				// ark
+	PROFILE_NPHASES
+};
+
+/* Cycles (or nanoseconds, see PROFILE_UNIT) and calls for each phase */
+typedef struct {
+	uint64_t cycles[PROFILE_NPHASES];
+	uint64_t calls[PROFILE_NPHASES];
+} profile_stats;
+
+/******************************************************************************
+* Cycle counter: TSC on x86, nanoseconds from the monotonic clock otherwise.
+******************************************************************************/
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILE_UNIT 	"cycles"
+static inline uint64_t profile_cycles(void) {
+	return __rdtsc();
+}
+#else
+#include <time.h>
+#define PROFILE_UNIT 	"ns"
+static inline uint64_t profile_cycles(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+#endif
+
+/******************************************************************************
+* Hooks placed at the beginning and at the end of each phase. They expand to
+* nothing unless AES_PROFILE is defined, so that the default build is left
+* untouched. The statistics are kept per thread.
+******************************************************************************/
+#if defined(AES_PROFILE)
+extern _Thread_local profile_stats profile_tls;
+
+#define PROFILE_BEGIN() 										\
+	uint64_t _profile_t = profile_cycles()
+
+#define PROFILE_END(phase)	({									\
+	profile_tls.cycles[phase] += profile_cycles() - _profile_t;	\
+	profile_tls.calls[phase]++;									\
+})
+#else
+#define PROFILE_BEGIN()
+#define PROFILE_END(phase)
+#endif
+
+/* Resets the statistics of the calling thread */
+void profile_reset(void);
+
+/* Copies the statistics of the calling thread into 'stats' */
+void profile_get(profile_stats* stats);
+
+/* Cost of an empty PROFILE_BEGIN/PROFILE_END pair, to be subtracted per call */
+uint64_t profile_overhead(void);
+
+/* Prints the cost of each phase per call and per 'nblocks'-block encryption */
+void profile_report(FILE* out, const char* name, const profile_stats* stats,
+				uint64_t nencs, int nblocks);
+
+#endif 	// PROFILE_H_
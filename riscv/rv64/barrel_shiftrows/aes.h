@@ -0,0 +1,12 @@
+#ifndef AES_H
+#define AES_H
+
+#include <stdint.h>
+
+void aes128_keyschedule_lut(uint64_t rkeys[352], const uint8_t key[16]);
+void aes256_keyschedule_lut(uint64_t rkeys[480], const uint8_t key[32]);
+
+void aes128_encrypt(uint8_t out[256], const uint8_t in[256], const uint64_t rkeys[352]);
+void aes256_encrypt(uint8_t out[256], const uint8_t in[256], const uint64_t rkeys[480]);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef AES_RVV_H_
+#define AES_RVV_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Fully-fixsliced encryption functions (any number of blocks, ECB) */
+void aes128_encrypt_rvv(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t rkeys[88]);
+void aes256_encrypt_rvv(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t rkeys[120]);
+
+/* Fully-fixsliced CTR functions (32-bit big-endian counter, updated) */
+void aes128_ctr32_rvv(unsigned char* out, const unsigned char* in,
+				size_t nblocks, const uint32_t rkeys[88], unsigned char ctr[16]);
+void aes256_ctr32_rvv(unsigned char* out, const unsigned char* in,
+				size_t nblocks, const uint32_t rkeys[120], unsigned char ctr[16]);
+
+#endif 	// AES_RVV_H_
@@ -0,0 +1,19 @@
+#ifndef AES_ZKNE_H_
+#define AES_ZKNE_H_
+
+#include <stdint.h>
+
+/* Encryption functions (one block at a time) */
+void aes128_encrypt_zkne(unsigned char ctext[16], const unsigned char ptext[16],
+				const uint32_t rkeys[44]);
+void aes192_encrypt_zkne(unsigned char ctext[16], const unsigned char ptext[16],
+				const uint32_t rkeys[52]);
+void aes256_encrypt_zkne(unsigned char ctext[16], const unsigned char ptext[16],
+				const uint32_t rkeys[60]);
+
+/* Key schedule functions */
+void aes128_keyschedule_zkne(uint32_t rkeys[44], const unsigned char key[16]);
+void aes192_keyschedule_zkne(uint32_t rkeys[52], const unsigned char key[24]);
+void aes256_keyschedule_zkne(uint32_t rkeys[60], const unsigned char key[32]);
+
+#endif 	// AES_ZKNE_H_
@@ -0,0 +1,73 @@
+###############################################################################
+# Reference AES (FIPS-197) used by asmbench.py to check the outputs of the
+# emulated implementations.
+#
+# @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
+#           alexandre.adomnicai@ntu.edu.sg
+#
+# @date     October 2026
+###############################################################################
+
+def _sbox():
+    """Computes the S-box from the inverse in GF(2^8) and the affine map."""
+    sbox = [0] * 256
+    p = q = 1
+    while True:
+        p = p ^ ((p << 1) & 0xff) ^ (0x1b if p & 0x80 else 0)     # p *= 3
+        q ^= q << 1                                             # q /= 3
+        q ^= q << 2
+        q ^= q << 4
+        q &= 0xff
+        if q & 0x80:
+            q ^= 0x09
+        x = q ^ (q << 1 | q >> 7) ^ (q << 2 | q >> 6) ^ \
+            (q << 3 | q >> 5) ^ (q << 4 | q >> 4)
+        sbox[p] = (x ^ 0x63) & 0xff
+        if p == 1:
+            break
+    sbox[0] = 0x63
+    return sbox
+
+SBOX = _sbox()
+
+def xtime(b):
+    return ((b << 1) ^ (0x1b if b & 0x80 else 0)) & 0xff
+
+def expand_key(key):
+    """Returns the round keys as a list of 4*(Nr+1) 4-byte words."""
+    nk = len(key) // 4
+    nr = nk + 6
+    w = [list(key[4 * i:4 * i + 4]) for i in range(nk)]
+    rcon = 1
+    for i in range(nk, 4 * (nr + 1)):
+        t = list(w[i - 1])
+        if i % nk == 0:
+            t = [SBOX[b] for b in t[1:] + t[:1]]
+            t[0] ^= rcon
+            rcon = xtime(rcon)
+        elif nk > 6 and i % nk == 4:
+            t = [SBOX[b] for b in t]
+        w.append([a ^ b for a, b in zip(w[i - nk], t)])
+    return w
+
+def encrypt_block(key, block):
+    w = expand_key(key)
+    nr = len(w) // 4 - 1
+    s = [b ^ k for b, k in zip(block, sum(w[0:4], []))]
+    for r in range(1, nr + 1):
+        s = [SBOX[b] for b in s]
+        s = [s[(i + 4 * (i % 4)) % 16] for i in range(16)]     # ShiftRows
+        if r != nr:
+            t = []
+            for c in range(4):
+                a = s[4 * c:4 * c + 4]
+                for i in range(4):
+                    t.append(xtime(a[i]) ^ xtime(a[(i + 1) % 4]) ^
+                             a[(i + 1) % 4] ^ a[(i + 2) % 4] ^ a[(i + 3) % 4])
+            s = t
+        s = [b ^ k for b, k in zip(s, sum(w[4 * r:4 * r + 4], []))]
+    return bytes(s)
+
+def encrypt(key, data):
+    return b''.join(encrypt_block(key, data[i:i + 16])
+                    for i in range(0, len(data), 16))
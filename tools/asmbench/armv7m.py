@@ -0,0 +1,385 @@
+###############################################################################
+# ARMv7-M emulator (the subset of Thumb-2 used by the 'armcortexm'
+# implementations, without IT blocks) along with a cycle model of the ARM
+# Cortex-M3, which the Cortex-M4 matches for these integer instructions.
+#
+# Cortex-M3 model (see the Cortex-M3 Technical Reference Manual, instruction
+# timings):
+#   - data processing, MOVW/MOVT, UBFX, CMP: 1 cycle
+#   - LDR (single): 2 cycles, but 1 cycle when following another single load
+#     since their address and data phases are pipelined
+#   - STR (single): 1 cycle thanks to the store buffer, nothing being
+#     pipelined after it
+#   - LDRD/STRD: 3 cycles, LDM/STM/PUSH/POP: 1+N cycles
+#   - taken branches, BL, BX and loads to pc: P additional cycles to refill
+#     the pipeline (P = 1 by default, i.e. zero wait-state memory)
+# With these figures, the cycles per byte of the README are matched within 1%
+# but it is meant to compare versions of the same code rather than to give
+# exact figures.
+#
+# @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
+#           alexandre.adomnicai@ntu.edu.sg
+#
+# @date     October 2026
+###############################################################################
+import re
+
+from emu import Machine, EmulationError, RETURN_ADDR
+
+REG = {'r%d' % i: i for i in range(16)}
+REG.update({'sb': 9, 'sl': 10, 'fp': 11, 'ip': 12, 'sp': 13, 'lr': 14,
+            'pc': 15})
+CALLEE_SAVED = tuple(range(4, 12)) + (13,)
+M32 = 0xffffffff
+
+CONDS = {
+    'eq': lambda n, z, c, v: z,
+    'ne': lambda n, z, c, v: not z,
+    'cs': lambda n, z, c, v: c, 'hs': lambda n, z, c, v: c,
+    'cc': lambda n, z, c, v: not c, 'lo': lambda n, z, c, v: not c,
+    'mi': lambda n, z, c, v: n,
+    'pl': lambda n, z, c, v: not n,
+    'vs': lambda n, z, c, v: v,
+    'vc': lambda n, z, c, v: not v,
+    'hi': lambda n, z, c, v: c and not z,
+    'ls': lambda n, z, c, v: not c or z,
+    'ge': lambda n, z, c, v: n == v,
+    'lt': lambda n, z, c, v: n != v,
+    'gt': lambda n, z, c, v: not z and n == v,
+    'le': lambda n, z, c, v: z or n != v,
+    'al': lambda n, z, c, v: True,
+}
+
+LOGIC = {
+    'and': lambda a, b: a & b,
+    'eor': lambda a, b: a ^ b,
+    'orr': lambda a, b: a | b,
+    'orn': lambda a, b: a | (~b & M32),
+    'bic': lambda a, b: a & (~b & M32),
+}
+ARITH = ('add', 'sub', 'rsb', 'adc', 'sbc')
+SHIFTS = ('lsl', 'lsr', 'asr', 'ror')
+DP = re.compile(r'^(and|eor|orr|orn|bic|add|sub|rsb|adc|sbc|mov|mvn|lsl|lsr|'
+                r'asr|ror|mul|cmp|cmn|tst|teq)(s?)(\.w|\.n)?$')
+MEM = re.compile(r'^(ldr|str)(b|h|sb|sh|d)?(\.w|\.n)?$')
+MULTI = re.compile(r'^(ldm|stm|push|pop)(ia|db|fd|ea)?(\.w|\.n)?$')
+BRANCH = re.compile(r'^b(eq|ne|cs|hs|cc|lo|mi|pl|vs|vc|hi|ls|ge|lt|gt|le|al)?'
+                    r'(\.w|\.n)?$')
+
+CM3_COSTS = {
+    'pipeline_refill': 1,
+}
+
+def shift_c(v, kind, n, carry):
+    """Returns the shifted value along with the carry out."""
+    v &= M32
+    if kind == 'rrx':
+        return (v >> 1) | (int(carry) << 31), bool(v & 1)
+    if n == 0:
+        return v, carry
+    if kind == 'lsl':
+        return (v << n) & M32 if n < 32 else 0, \
+            bool((v >> (32 - n)) & 1) if n <= 32 else False
+    if kind == 'lsr':
+        return v >> n if n < 32 else 0, \
+            bool((v >> (n - 1)) & 1) if n <= 32 else False
+    if kind == 'asr':
+        s = v - (1 << 32) if v >> 31 else v
+        n = min(n, 32)
+        return (s >> n) & M32, bool((s >> (n - 1)) & 1)
+    if kind == 'ror':
+        n &= 31
+        r = ((v >> n) | (v << (32 - n))) & M32 if n else v
+        return r, bool(r >> 31)
+    raise EmulationError('unsupported shift ' + kind)
+
+class Armv7mMachine(Machine):
+
+    COMMENT = '@'
+
+    def __init__(self, elf, objdump='llvm-objdump'):
+        cmd = [objdump, '-d']
+        if 'llvm' in objdump:
+            cmd.append('--triple=thumbv7m-none-eabi')
+        super().__init__(elf, cmd)
+        self.costs = dict(CM3_COSTS)
+
+    def call(self, fn, *args, maxinsns=10**7):
+        """Calls the function 'fn' following the AAPCS (arguments beyond the
+        4th on the stack) and checks that the callee-saved registers are
+        preserved."""
+        r = [0] * 16
+        sp = self.stack_top
+        stacked = args[4:]
+        sp -= 4 * len(stacked)
+        sp &= ~7
+        for i, v in enumerate(stacked):
+            self.wr(sp + 4 * i, v, 4)
+        for i, v in enumerate(args[:4]):
+            r[i] = v & M32
+        for i in range(4, 13):
+            r[i] = 0x5a5a0000 + i
+        r[13] = sp
+        r[14] = RETURN_ADDR | 1
+        saved = [r[i] for i in CALLEE_SAVED]
+        self.r = r
+        self.n = self.z = self.c = self.v = False
+        self.prev_load = False
+        self.run(self.syms[fn], maxinsns)
+        if [r[i] for i in CALLEE_SAVED] != saved:
+            raise EmulationError('%s: callee-saved registers clobbered' % fn)
+        return r[0]
+
+    # Cycle model ############################################################
+
+    def cost(self, pc, mn, ops, taken):
+        P = self.costs['pipeline_refill']
+        m = MEM.match(mn)
+        single = bool(m) and m.group(2) != 'd'
+        load = single and m.group(1) == 'ldr'
+        if load:
+            c = 1 if self.prev_load else 2
+        elif single:
+            c = 1
+        elif m:
+            c = 3
+        elif MULTI.match(mn):
+            regs = ops[-1]
+            c = 1 + len(self.reglist(regs))
+            if 'pc' in regs:
+                c += P
+        elif taken or mn in ('bl', 'blx', 'bx'):
+            c = 1 + P
+        else:
+            c = 1
+        if single and REG.get(ops[0]) == 15:
+            c += P
+        self.prev_load = load
+        return c
+
+    # Interpreter ############################################################
+
+    def reglist(self, s):
+        regs = []
+        for part in s.strip('{}').split(','):
+            part = part.strip()
+            if '-' in part:
+                a, b = part.split('-')
+                regs += list(range(REG[a.strip()], REG[b.strip()] + 1))
+            elif part:
+                regs.append(REG[part])
+        return sorted(regs)
+
+    def reg(self, name, pc):
+        i = REG[name]
+        return (pc + 4) & M32 if i == 15 else self.r[i]
+
+    def operand2(self, ops, pc):
+        """Flexible second operand: register (optionally shifted) or
+        immediate. Returns the value and the shifter carry out."""
+        o = ops[0]
+        if o.startswith('#'):
+            return int(o[1:], 0) & M32, self.c
+        v = self.reg(o, pc)
+        if len(ops) > 1:
+            kind, _, amount = ops[1].partition(' ')
+            amount = amount.strip()
+            n = int(amount[1:], 0) if amount.startswith('#') else \
+                (self.reg(amount, pc) & 0xff if amount else 0)
+            return shift_c(v, kind, n, self.c)
+        return v, self.c
+
+    def set_nz(self, v):
+        self.n = bool(v >> 31)
+        self.z = v == 0
+
+    def addc(self, a, b, carry):
+        r = a + b + int(carry)
+        res = r & M32
+        self.c = r > M32
+        self.v = bool(((a ^ res) & (b ^ res)) >> 31)
+        self.set_nz(res)
+        return res
+
+    def address(self, ops, pc):
+        """Returns (address, writeback value or None) of a memory operand."""
+        mem = ops[0]
+        wb = mem.endswith('!')
+        inner = [o.strip() for o in mem.rstrip('!').strip('[]').split(',')]
+        base = self.reg(inner[0], pc)
+        if inner[0] == 'pc':
+            base &= ~3
+        if len(inner) == 1:
+            off = 0
+        elif inner[1].startswith('#'):
+            off = int(inner[1][1:], 0)
+        else:
+            off = self.reg(inner[1], pc)
+            if len(inner) > 2:
+                kind, _, n = inner[2].partition(' ')
+                off = shift_c(off, kind, int(n.strip()[1:], 0), self.c)[0]
+        if len(ops) > 1:                    # post-indexed
+            return base, (base + int(ops[1][1:], 0)) & M32
+        addr = (base + off) & M32
+        return addr, (addr if wb else None)
+
+    def step(self, pc, mn, ops, size):
+        r = self.r
+        npc = pc + size
+        def w(i, v):
+            r[REG[ops[i]]] = v & M32
+        m = DP.match(mn)
+        if m:
+            op, s = m.group(1), m.group(2) == 's'
+            if op in ('cmp', 'cmn', 'tst', 'teq'):
+                a = self.reg(ops[0], pc)
+                b, carry = self.operand2(ops[1:], pc)
+                if op == 'cmp':
+                    self.addc(a, ~b & M32, True)
+                elif op == 'cmn':
+                    self.addc(a, b, False)
+                else:
+                    self.set_nz(a & b if op == 'tst' else a ^ b)
+                    self.c = carry
+                return npc
+            if op in ('mov', 'mvn'):
+                v, carry = self.operand2(ops[1:], pc)
+                v = v if op == 'mov' else ~v & M32
+            elif op in SHIFTS:
+                src = ops[1] if len(ops) > 2 else ops[0]
+                amount = ops[-1]
+                n = int(amount[1:], 0) if amount.startswith('#') else \
+                    self.reg(amount, pc) & 0xff
+                v, carry = shift_c(self.reg(src, pc), op, n, self.c)
+            else:
+                # two-operand form, e.g. 'eor r0, r1' or 'eor r0, r1, lsl #2'
+                if len(ops) == 2 or ops[2].split(' ')[0] in SHIFTS + ('rrx',):
+                    a_name, rest = ops[0], ops[1:]
+                else:
+                    a_name, rest = ops[1], ops[2:]
+                a = self.reg(a_name, pc)
+                b, carry = self.operand2(rest, pc)
+                if op in LOGIC:
+                    v = LOGIC[op](a, b)
+                elif op == 'mul':
+                    v = (a * b) & M32
+                elif op == 'add':
+                    v = self.addc(a, b, False) if s else (a + b) & M32
+                elif op == 'sub':
+                    v = self.addc(a, ~b & M32, True) if s else (a - b) & M32
+                elif op == 'rsb':
+                    v = self.addc(b, ~a & M32, True) if s else (b - a) & M32
+                elif op == 'adc':
+                    v = self.addc(a, b, self.c)
+                else:
+                    v = self.addc(a, ~b & M32, self.c)
+                if op in ARITH:
+                    w(0, v)
+                    return npc
+            if s:
+                self.set_nz(v)
+                self.c = carry
+            w(0, v)
+            return npc
+        m = MEM.match(mn)
+        if m:
+            load, kind = m.group(1) == 'ldr', m.group(2) or ''
+            if kind == 'd':
+                addr, wb = self.address(ops[2:], pc)
+                if load:
+                    v0, v1 = self.rd(addr, 4), self.rd(addr + 4, 4)
+                    w(0, v0)
+                    w(1, v1)
+                else:
+                    self.wr(addr, self.reg(ops[0], pc), 4)
+                    self.wr(addr + 4, self.reg(ops[1], pc), 4)
+            else:
+                addr, wb = self.address(ops[1:], pc)
+                n = {'': 4, 'b': 1, 'h': 2, 'sb': 1, 'sh': 2}[kind]
+                if load:
+                    v = self.rd(addr, n)
+                    if kind.startswith('s') and v >> (8 * n - 1):
+                        v -= 1 << (8 * n)
+                    if REG[ops[0]] == 15:
+                        npc = v & ~1
+                    else:
+                        w(0, v)
+                else:
+                    self.wr(addr, self.reg(ops[0], pc), n)
+            if wb is not None:
+                base = ops[2 if kind == 'd' else 1].strip('[!')
+                r[REG[base.split(',')[0].strip(' ]')]] = wb
+            return npc
+        m = MULTI.match(mn)
+        if m:
+            op, mode = m.group(1), m.group(2) or ''
+            if op in ('push', 'pop'):
+                base, wb, regs = 'sp', True, self.reglist(ops[0])
+                decrement = op == 'push'
+                load = op == 'pop'
+            else:
+                base, wb = ops[0].rstrip('!'), ops[0].endswith('!')
+                regs = self.reglist(ops[1])
+                decrement = mode in ('db', 'fd' if op == 'ldm' else 'ea')
+                load = op == 'ldm'
+            addr = r[REG[base]]
+            start = (addr - 4 * len(regs)) & M32 if decrement else addr
+            for i, reg in enumerate(regs):
+                a = start + 4 * i
+                if load:
+                    v = self.rd(a, 4)
+                    if reg == 15:
+                        npc = v & ~1
+                    else:
+                        r[reg] = v
+                else:
+                    self.wr(a, r[reg], 4)
+            if wb and not (load and REG[base] in regs):
+                r[REG[base]] = start if decrement else \
+                    (addr + 4 * len(regs)) & M32
+            return npc
+        m = BRANCH.match(mn)
+        if m:
+            if CONDS[m.group(1) or 'al'](self.n, self.z, self.c, self.v):
+                return int(ops[0], 16)
+            return npc
+        if mn in ('bl', 'blx') and not ops[0] in REG:
+            r[14] = npc | 1
+            return int(ops[0], 16)
+        if mn in ('bx', 'blx'):
+            target = self.reg(ops[0], pc)
+            if mn == 'blx':
+                r[14] = npc | 1
+            return target & ~1
+        if mn in ('cbz', 'cbnz'):
+            if (self.reg(ops[0], pc) == 0) == (mn == 'cbz'):
+                return int(ops[1], 16)
+            return npc
+        if mn in ('movw', 'movt'):
+            imm = int(ops[1].lstrip('#'), 0) & 0xffff
+            if mn == 'movw':
+                w(0, imm)
+            else:
+                w(0, (r[REG[ops[0]]] & 0xffff) | (imm << 16))
+            return npc
+        if mn in ('ubfx', 'sbfx'):
+            lsb, width = int(ops[2][1:], 0), int(ops[3][1:], 0)
+            v = (self.reg(ops[1], pc) >> lsb) & ((1 << width) - 1)
+            if mn == 'sbfx' and v >> (width - 1):
+                v -= 1 << width
+            w(0, v)
+            return npc
+        if mn in ('uxtb', 'uxth', 'uxtb.w', 'uxth.w'):
+            w(0, self.reg(ops[1], pc) & (0xff if 'b' in mn[3:] else 0xffff))
+            return npc
+        if mn in ('rev', 'rev.w'):
+            w(0, int.from_bytes(self.reg(ops[1], pc).to_bytes(4, 'little'),
+                                'big'))
+            return npc
+        if mn in ('adr', 'adr.w'):
+            w(0, ((pc + 4) & ~3) + int(ops[1].lstrip('#'), 0))
+            return npc
+        if mn in ('nop', 'nop.w'):
+            return npc
+        raise EmulationError('0x%x: unsupported instruction %s %s' % (
+            pc, mn, ', '.join(ops)))
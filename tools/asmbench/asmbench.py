@@ -0,0 +1,423 @@
+#!/usr/bin/env python3
+###############################################################################
+# Instruction and cycle counts of the assembly implementations in the
+# 'armcortexm' and 'riscv' directories, without the boards.
+#
+# Each target is assembled and linked into a bare image, which is run by an
+# instruction-set emulator (see 'armv7m.py' and 'rv.py'): the key schedules
+# and encryption functions are called on random keys and plaintexts, their
+# outputs are checked against a reference AES (see 'aes.py') and the executed
+# instructions are fed into a cost model of the ARM Cortex-M3 or the SiFive
+# E31, both in-order cores with deterministic timings. The cycle counts are
+# approximations meant to compare versions of the same code, e.g. to gate
+# assembly changes on a baseline:
+#   asmbench.py --save base.json            (before the change)
+#   asmbench.py --baseline base.json        (after, exits with 1 if slower)
+#
+# Toolchains:
+#   - LLVM (default): cpp, llvm-mc, ld.lld and llvm-objdump. The GNU as
+#     syntax of the Cortex-M sources is adjusted on the fly (see
+#     'llvm_compat') as llvm-mc is stricter about immediates and shifts.
+#   - GNU (--cross arm-none-eabi- or riscv64-unknown-elf-): gcc, ld, objdump.
+#
+# Usage:
+#   asmbench.py                             all targets
+#   asmbench.py riscv/fixslicing armcortexm/barrel_shiftrows
+#   asmbench.py riscv/rvv --vlen 256
+#   asmbench.py --unroll                    round functions expanded in place
+#   asmbench.py --list
+#
+# @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
+#           alexandre.adomnicai@ntu.edu.sg
+#
+# @date     October 2026
+###############################################################################
+import argparse
+import json
+import os
+import random
+import re
+import shlex
+import subprocess
+import sys
+import tempfile
+
+from emu import EmulationError
+from aes import encrypt
+from armv7m import Armv7mMachine
+from rv import RiscvMachine
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..')
+
+###############################################################################
+# Benchmarks, i.e. how to call the functions of each family of implementations
+# and check their outputs. 'rng' provides the keys and plaintexts, and 'emit'
+# records the instruction and cycle counts of the last call.
+###############################################################################
+
+def bench_fixslicing(m, rng, emit, keylens=(16, 32), variants=('ffs', 'sfs'),
+                     masked=False):
+    """Fixsliced implementations: 2 blocks per call, the round keys being
+    computed by both the LUT-based and the bitsliced key schedules."""
+    for kl in keylens:
+        for var in variants:
+            key, ptext = rng.randbytes(kl), rng.randbytes(32)
+            k, p, c = m.alloc(key), m.alloc(ptext), m.alloc(32)
+            rk = m.alloc(4 * 121)
+            # the Cortex-M bitsliced key schedules only read the first key
+            schedules = [('aes%d_keyschedule_%s' % (kl * 8, var), (k, k))]
+            if not masked:
+                schedules.insert(0, ('aes%d_keyschedule_%s_lut' %
+                                     (kl * 8, var), (k,)))
+            enc = 'aes%d_encrypt_%s' % (kl * 8, var)
+            for i, (ks, args) in enumerate(schedules):
+                m.call(ks, rk, *args)
+                emit(ks, None)
+                m.call(enc, c, c + 16, p, p + 16, rk)
+                if i == 0:
+                    emit(enc, 32)
+                check(m, enc, c, encrypt(key, ptext))
+            m.reset_heap()
+
+def bench_barrel(m, rng, emit, nblocks, args_order):
+    """Barrel-shiftrows implementations: nblocks blocks per call."""
+    for kl in (16, 32):
+        key, ptext = rng.randbytes(kl), rng.randbytes(16 * nblocks)
+        k, p = m.alloc(key), m.alloc(ptext)
+        c = m.alloc(16 * nblocks)
+        rk = m.alloc(4 * 480 * (nblocks // 8))
+        ks = 'aes%d_keyschedule_lut' % (kl * 8)
+        m.call(ks, rk, k)
+        emit(ks, None)
+        enc = 'aes%d_encrypt' % (kl * 8)
+        m.call(enc, *[{'c': c, 'p': p, 'k': rk}[a] for a in args_order])
+        emit(enc, 16 * nblocks)
+        check(m, enc, c, encrypt(key, ptext))
+        m.reset_heap()
+
+def bench_masking(m, rng, emit):
+    """Masked implementations: the fixsliced ones (2 blocks per call) followed
+    by the barrel-shiftrows one (8 blocks per call)."""
+    bench_fixslicing(m, rng, emit, keylens=(16,), masked=True)
+    key, ptext = rng.randbytes(16), rng.randbytes(128)
+    k, p, c = m.alloc(key), m.alloc(ptext), m.alloc(128)
+    rk = m.alloc(4 * 385)
+    m.call('aes128_keyschedule_bsr', rk, k)
+    emit('aes128_keyschedule_bsr', None)
+    m.call('aes128_encrypt_bsr', c, p, rk)
+    emit('aes128_encrypt_bsr', 128)
+    check(m, 'aes128_encrypt_bsr', c, encrypt(key, ptext))
+    m.reset_heap()
+
+def bench_zkne(m, rng, emit):
+    """Scalar crypto extension: 1 block per call, standard round keys."""
+    for kl in (16, 24, 32):
+        key, ptext = rng.randbytes(kl), rng.randbytes(16)
+        k, p, c, rk = m.alloc(key), m.alloc(ptext), m.alloc(16), m.alloc(240)
+        ks, enc = 'aes%d_keyschedule_zkne' % (kl * 8), \
+            'aes%d_encrypt_zkne' % (kl * 8)
+        m.call(ks, rk, k)
+        emit(ks, None)
+        m.call(enc, c, p, rk)
+        emit(enc, 16)
+        check(m, enc, c, encrypt(key, ptext))
+        m.reset_heap()
+
+def bench_rvv(m, rng, emit, nblocks=64, max_tail=33):
+    """Vector implementations: nblocks blocks per call, the fixsliced round
+    keys being computed by the RV32I LUT-based key schedule. The outputs are
+    then checked (untimed) for all the numbers of blocks up to max_tail, so
+    that the odd block handled via the stack and the partial vector lengths
+    are covered, the counter starting at a random value and right before it
+    wraps around 2^32."""
+    for kl in (16, 32):
+        key, ptext = rng.randbytes(kl), rng.randbytes(16 * nblocks)
+        iv = rng.randbytes(12) + bytes(4)
+        k, p, c = m.alloc(key), m.alloc(ptext), m.alloc(16 * nblocks)
+        rk, ctr = m.alloc(4 * 120), m.alloc(iv)
+        m.call('aes%d_keyschedule_ffs_lut' % (kl * 8), rk, k)
+        enc = 'aes%d_encrypt_rvv' % (kl * 8)
+        m.call(enc, c, p, nblocks, rk)
+        emit(enc, 16 * nblocks)
+        check(m, enc, c, encrypt(key, ptext))
+        enc = 'aes%d_ctr32_rvv' % (kl * 8)
+        m.call(enc, c, p, nblocks, rk, ctr)
+        emit(enc, 16 * nblocks)
+        check(m, enc, c, ctr32_ref(key, iv, ptext))
+        check(m, enc + ' counter', ctr, ctr32_next(iv, nblocks))
+        for n in range(max_tail + 1):
+            ptext, guard = rng.randbytes(16 * n), rng.randbytes(16)
+            p, c = m.alloc(ptext), m.alloc(16 * n + 16)
+            m.write(c + 16 * n, guard)
+            enc = 'aes%d_encrypt_rvv' % (kl * 8)
+            m.call(enc, c, p, n, rk)
+            check(m, '%s(%d blocks)' % (enc, n), c,
+                  encrypt(key, ptext) + guard)
+            enc = 'aes%d_ctr32_rvv' % (kl * 8)
+            for start in (rng.getrandbits(32), 0xfffffffe, 0xffffffff):
+                iv = rng.randbytes(12) + start.to_bytes(4, 'big')
+                m.write(ctr, iv)
+                m.call(enc, c, p, n, rk, ctr)
+                name = '%s(%d blocks from %08x)' % (enc, n, start)
+                check(m, name, c, ctr32_ref(key, iv, ptext) + guard)
+                check(m, name + ' counter', ctr, ctr32_next(iv, n))
+        m.reset_heap()
+
+def ctr32_ref(key, iv, ptext):
+    """Reference CTR encryption, only the last 32 bits being incremented."""
+    start = int.from_bytes(iv[12:], 'big')
+    ks = encrypt(key, b''.join(iv[:12] + ((start + i) % 2**32).to_bytes(4,
+                               'big') for i in range(len(ptext) // 16)))
+    return bytes(a ^ b for a, b in zip(ptext, ks))
+
+def ctr32_next(iv, nblocks):
+    """Counter block expected after processing nblocks blocks."""
+    start = int.from_bytes(iv[12:], 'big')
+    return iv[:12] + ((start + nblocks) % 2**32).to_bytes(4, 'big')
+
+def check(m, fn, addr, expected):
+    if m.read(addr, len(expected)) != expected:
+        raise EmulationError('%s: wrong output' % fn)
+
+###############################################################################
+# Targets: sources, architecture, extensions and benchmark.
+###############################################################################
+
+ARM = 'arm'
+RV32 = 'rv32'
+RV64 = 'rv64'
+
+TARGETS = {}
+
+def target(name, arch, srcs, bench, mattr='', **kwargs):
+    TARGETS[name] = dict(arch=arch, srcs=srcs, bench=bench, mattr=mattr,
+                         kwargs=kwargs)
+
+target('armcortexm/fixslicing', ARM,
+       ['armcortexm/fixslicing/aes_encrypt.s',
+        'armcortexm/fixslicing/aes_keyschedule.s',
+        'armcortexm/fixslicing/aes_keyschedule_lut.s'], bench_fixslicing)
+target('armcortexm/barrel_shiftrows', ARM,
+       ['armcortexm/barrel_shiftrows/aes_encrypt.s',
+        'armcortexm/barrel_shiftrows/aes_keyschedule_lut.s'], bench_barrel,
+       nblocks=8, args_order='ckp')
+target('armcortexm/1storder_masking', ARM,
+       ['armcortexm/1storder_masking/aes_encrypt.s',
+        'armcortexm/1storder_masking/aes_keyschedule.s'], bench_masking)
+for _ext in ('', '+zbkb', '+zbkb,+zbkx'):
+    target('riscv/fixslicing' + _ext.replace(',', ''), RV32,
+           ['riscv/fixslicing/aes_encrypt.S',
+            'riscv/fixslicing/aes_keyschedule.S',
+            'riscv/fixslicing/aes_keyschedule_lut.S'], bench_fixslicing,
+           mattr=_ext)
+for _ext in ('', '+zbkb'):
+    target('riscv/barrel_shiftrows' + _ext, RV32,
+           ['riscv/barrel_shiftrows/aes_encrypt.S',
+            'riscv/barrel_shiftrows/aes_keyschedule_lut.S'], bench_barrel,
+           mattr=_ext, nblocks=8, args_order='cpk')
+    target('riscv/rv64/barrel_shiftrows' + _ext, RV64,
+           ['riscv/rv64/barrel_shiftrows/aes_encrypt.S',
+            'riscv/rv64/barrel_shiftrows/aes_keyschedule_lut.S'], bench_barrel,
+           mattr=_ext, nblocks=16, args_order='cpk')
+for _ext in ('', ',+zbkb'):
+    target('riscv/zkne' + _ext.replace(',', ''), RV32,
+           ['riscv/zkne/aes_encrypt.S', 'riscv/zkne/aes_keyschedule.S'],
+           bench_zkne, mattr='+zkne' + _ext)
+target('riscv/rvv', RV32,
+       ['riscv/rvv/aes_encrypt.S', 'riscv/fixslicing/aes_keyschedule_lut.S'],
+       bench_rvv, mattr='+v')
+
+###############################################################################
+# Build.
+###############################################################################
+
+def llvm_compat(text):
+    """Adjusts the GNU as syntax of the Cortex-M sources for llvm-mc: no '#'
+    before the numeric arguments of macros, '#' before the shift amounts,
+    two-operand 'add.w'/'sub.w' with an immediate expanded, and no '.w' on
+    'ubfx' and on loads/stores with a negative offset."""
+    macros = set(re.findall(r'^\s*\.macro\s+(\w+)', text, re.M))
+    out = []
+    for line in text.split('\n'):
+        code, sep, comment = line.partition('//')
+        m = re.match(r'(\s*)(\w+)(\s+)(.*)$', code)
+        if m and m.group(2) in macros:
+            code = m.group(1) + m.group(2) + m.group(3) + \
+                re.sub(r'#(?=-?\d)', '', m.group(4))
+        code = re.sub(r',(\s*)(lsl|lsr|asr|ror)\s+(?!#)([\\\w]+)',
+                      r',\1\2 #\3', code)
+        code = re.sub(r'\bubfx\.w\b', 'ubfx ', code)
+        code = re.sub(r'\b(str|ldr)\.w(\s+\w+,\s*\[\w+,\s*#-)', r'\1  \2',
+                      code)
+        m = re.match(r'(\s*)(add|sub)\.w(\s+)(\w+),\s*(#.*)$', code)
+        if m:
+            code = '%s%s.w%s%s, %s, %s' % (m.group(1), m.group(2), m.group(3),
+                                         m.group(4), m.group(4), m.group(5))
+        out.append(code + sep + comment)
+    return '\n'.join(out)
+
+def march(arch, mattr):
+    exts = [e.strip('+') for e in mattr.split(',') if e]
+    return arch + 'i' + ''.join(('_' if len(e) > 1 else '') + e
+                                for e in exts)
+
+class Toolchain:
+
+    def __init__(self, args):
+        self.cross = args.cross
+        self.cpp = shlex.split(args.cpp)
+        self.ld = shlex.split(args.ld)
+        self.objdump = args.objdump
+        self.unroll = args.unroll
+
+    def run(self, cmd):
+        try:
+            subprocess.run(cmd, check=True, capture_output=True, text=True)
+        except FileNotFoundError:
+            sys.exit('%s: command not found' % cmd[0])
+        except subprocess.CalledProcessError as e:
+            sys.exit('%s\n%s' % (' '.join(cmd), e.stderr))
+
+    def build(self, t, tmp):
+        arch, objs = t['arch'], []
+        xlen = 64 if arch == RV64 else 32
+        for i, src in enumerate(t['srcs']):
+            src = os.path.join(ROOT, src)
+            obj = os.path.join(tmp, '%d.o' % i)
+            if self.cross:
+                flags = ['-mcpu=cortex-m3', '-mthumb'] if arch == ARM else \
+                    ['-march=' + march(arch, t['mattr']),
+                     '-mabi=' + ('lp64' if xlen == 64 else 'ilp32')]
+                if self.unroll:
+                    flags += ['-DAES_UNROLL', '-Wa,--defsym,AES_UNROLL=1']
+                self.run([self.cross + 'gcc', '-c'] + flags + [src, '-o', obj])
+            elif arch == ARM:
+                asm = os.path.join(tmp, '%d.s' % i)
+                with open(src) as f, open(asm, 'w') as g:
+                    g.write(llvm_compat(f.read()))
+                self.run(['llvm-mc', '-triple=thumbv7m-none-eabi',
+                          '-filetype=obj', asm, '-o', obj] +
+                         (['--defsym=AES_UNROLL=1'] if self.unroll else []))
+            else:
+                asm = os.path.join(tmp, '%d.s' % i)
+                defs = ['-D__riscv_xlen=%d' % xlen] + \
+                    ['-D__riscv_' + e.strip('+') for e in
+                     t['mattr'].split(',') if e]
+                if self.unroll:
+                    defs.append('-DAES_UNROLL')
+                self.run(self.cpp + ['-E', '-P', '-x', 'assembler-with-cpp'] +
+                         defs + [src, '-o', asm])
+                self.run(['llvm-mc', '-triple=riscv%d' % xlen,
+                          '-mattr=' + t['mattr'], '-filetype=obj', asm,
+                          '-o', obj])
+            objs.append(obj)
+        elf = os.path.join(tmp, 'image.elf')
+        if self.cross:
+            ld = [self.cross + 'ld']
+        else:
+            ld = self.ld + ['-m', 'armelf' if arch == ARM else
+                            'elf%dlriscv' % xlen]
+        if arch != ARM:
+            ld.append('--no-relax')
+        self.run(ld + ['-Ttext=0x10000', '-e', '0'] + objs + ['-o', elf])
+        return elf
+
+    def machine(self, t, elf, args):
+        objdump = self.cross + 'objdump' if self.cross else self.objdump
+        if t['arch'] == ARM:
+            m = Armv7mMachine(elf, objdump)
+            m.costs['pipeline_refill'] = args.refill
+            # STM32 RNG used by the masked implementations: always ready
+            rng = random.Random(args.seed)
+            m.mmio[0x50060804] = lambda: 1
+            m.mmio[0x50060808] = lambda: rng.getrandbits(32)
+        else:
+            m = RiscvMachine(elf, 64 if t['arch'] == RV64 else 32, args.vlen,
+                             objdump)
+        return m
+
+###############################################################################
+# Main.
+###############################################################################
+
+def main():
+    ap = argparse.ArgumentParser(
+        description='Instruction and cycle counts of the assembly '
+                    'implementations under emulation')
+    ap.add_argument('targets', nargs='*', help='targets (default: all)')
+    ap.add_argument('--list', action='store_true', help='list the targets')
+    ap.add_argument('--vlen', type=int, default=128,
+                    help='VLEN in bits for riscv/rvv (default: 128)')
+    ap.add_argument('--refill', type=int, default=1,
+                    help='Cortex-M pipeline refill cycles (default: 1)')
+    ap.add_argument('--seed', type=int, default=0,
+                    help='seed of the keys and plaintexts (default: 0)')
+    ap.add_argument('--cross', default='',
+                    help='GNU toolchain prefix (default: LLVM toolchain)')
+    ap.add_argument('--cpp', default='cc', help='C preprocessor for .S files')
+    ap.add_argument('--ld', default='ld.lld', help='LLVM linker')
+    ap.add_argument('--objdump', default='llvm-objdump')
+    ap.add_argument('--unroll', action='store_true',
+                    help='build with AES_UNROLL defined')
+    ap.add_argument('--histogram', action='store_true',
+                    help='print the executed mnemonics of each function')
+    ap.add_argument('--save', metavar='JSON', help='save the results')
+    ap.add_argument('--baseline', metavar='JSON',
+                    help='compare the cycles against saved results')
+    ap.add_argument('--tolerance', type=float, default=0.5,
+                    help='allowed slowdown vs the baseline in %% '
+                         '(default: 0.5)')
+    args = ap.parse_args()
+    if args.list:
+        print('\n'.join(TARGETS))
+        return
+    names = args.targets or list(TARGETS)
+    for name in names:
+        if name not in TARGETS:
+            sys.exit('unknown target %s (see --list)' % name)
+    tools = Toolchain(args)
+    results = {}
+    print('%-36s %-28s %8s %8s %8s' % ('target', 'function', 'insns',
+                                       'cycles', 'c/byte'))
+    for name in names:
+        t = TARGETS[name]
+        with tempfile.TemporaryDirectory() as tmp:
+            m = tools.machine(t, tools.build(t, tmp), args)
+        print('%-36s %-28s %8d bytes' % (name, '(code size)', m.code_size))
+        results[name + ':size'] = m.code_size
+        rng = random.Random(args.seed)
+        def emit(fn, nbytes):
+            cpb = '%8.1f' % (m.cycles / nbytes) if nbytes else '%8s' % '-'
+            print('%-36s %-28s %8d %8d %s' % (name, fn, m.count, m.cycles,
+                                              cpb))
+            if args.histogram:
+                print('    ' + ' '.join('%s:%d' % h for h in
+                                        m.hist.most_common()))
+            results['%s:%s' % (name, fn)] = dict(insns=m.count,
+                                                 cycles=m.cycles)
+        try:
+            t['bench'](m, rng, emit, **t['kwargs'])
+        except EmulationError as e:
+            sys.exit('%s: %s' % (name, e))
+    if args.save:
+        with open(args.save, 'w') as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+    if args.baseline:
+        with open(args.baseline) as f:
+            base = json.load(f)
+        slower = 0
+        for k in sorted(results.keys() & base.keys()):
+            if k.endswith(':size'):
+                continue
+            old, new = base[k]['cycles'], results[k]['cycles']
+            delta = 100.0 * (new - old) / old
+            if delta > args.tolerance:
+                slower += 1
+            if delta:
+                print('%-65s %8d -> %8d (%+.1f%%)%s' % (k, old, new, delta,
+                      ' SLOWER' if delta > args.tolerance else ''))
+        if slower:
+            sys.exit('%d function(s) slower than the baseline' % slower)
+
+if __name__ == '__main__':
+    main()
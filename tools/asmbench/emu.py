@@ -0,0 +1,177 @@
+###############################################################################
+# Common part of the instruction-set emulators used by asmbench.py: loading
+# of the linked ELF image (segments and symbols), flat little-endian memory
+# with memory-mapped registers, and decoding of the instructions from the
+# disassembly of objdump (so that the emulators only have to interpret the
+# canonical syntax printed for each instruction).
+#
+# @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
+#           alexandre.adomnicai@ntu.edu.sg
+#
+# @date     October 2026
+###############################################################################
+import collections
+import re
+import struct
+import subprocess
+
+RETURN_ADDR = 0xdead0       # return address of the emulated calls
+
+class EmulationError(Exception):
+    pass
+
+def split_operands(s):
+    """Splits the operands on commas which are not within brackets/braces."""
+    ops, depth, cur = [], 0, ''
+    for ch in s:
+        if ch in '[{':
+            depth += 1
+        elif ch in ']}':
+            depth -= 1
+        if ch == ',' and depth == 0:
+            ops.append(cur.strip())
+            cur = ''
+        else:
+            cur += ch
+    if cur.strip():
+        ops.append(cur.strip())
+    return ops
+
+class Machine:
+    """Flat memory starting at address 0, the code being linked at 0x10000.
+    Reads from addresses registered in 'mmio' call the associated function
+    instead, e.g. to model a random number generator."""
+
+    COMMENT = '#'           # start of the comments printed by objdump
+
+    def __init__(self, elf, objdump, memsize=1 << 20):
+        self.mem = bytearray(memsize)
+        self.mmio = {}
+        self.syms = {}
+        self.load(elf)
+        self.insns = {}
+        self.decode(subprocess.run(objdump + [elf], capture_output=True,
+                                   text=True, check=True).stdout)
+        self.brk = memsize // 2
+        self.stack_top = memsize - 0x100
+        self.count = 0
+        self.cycles = 0
+        self.hist = collections.Counter()
+
+    def load(self, elf):
+        """Copies the PT_LOAD segments and reads the symbol table."""
+        d = open(elf, 'rb').read()
+        is64 = d[4] == 2
+        if is64:
+            phoff, shoff = struct.unpack_from('<QQ', d, 0x20)
+            phentsize, phnum, shentsize, shnum = \
+                struct.unpack_from('<HHHH', d, 0x36)
+        else:
+            phoff, shoff = struct.unpack_from('<II', d, 0x1c)
+            phentsize, phnum, shentsize, shnum = \
+                struct.unpack_from('<HHHH', d, 0x2a)
+        for i in range(phnum):
+            o = phoff + i * phentsize
+            if is64:
+                t, _, off, va, _, fsz, _ = struct.unpack_from('<IIQQQQQ', d, o)
+            else:
+                t, off, va, _, fsz, _ = struct.unpack_from('<IIIIII', d, o)
+            if t == 1:
+                self.mem[va:va + fsz] = d[off:off + fsz]
+        shdrs = []
+        for i in range(shnum):
+            o = shoff + i * shentsize
+            if is64:
+                _, t, _, _, off, size, link, _, _, entsize = \
+                    struct.unpack_from('<IIQQQQIIQQ', d, o)
+            else:
+                _, t, _, _, off, size, link, _, _, entsize = \
+                    struct.unpack_from('<IIIIIIIIII', d, o)
+            shdrs.append((t, off, size, link, entsize))
+        for t, off, size, link, entsize in shdrs:
+            if t != 2:                      # SHT_SYMTAB
+                continue
+            stroff = shdrs[link][1]
+            for o in range(off, off + size, entsize):
+                if is64:
+                    name, info, _, _, value, _ = \
+                        struct.unpack_from('<IBBHQQ', d, o)
+                else:
+                    name, value, _, info, _, _ = \
+                        struct.unpack_from('<IIIBBH', d, o)
+                if info & 0xf in (0, 2) and name:  # NOTYPE or FUNC
+                    end = d.index(b'\0', stroff + name)
+                    sym = d[stroff + name:end].decode()
+                    if not sym.startswith('$'):  # mapping symbols
+                        self.syms[sym] = value & ~1
+
+    def decode(self, text):
+        rx = re.compile(r'^\s*([0-9a-f]+):\s+((?:[0-9a-f]{2,8} )+)\s*'
+                        r'([a-z][\w.]*)\s*(.*)$')
+        for line in text.splitlines():
+            m = rx.match(line)
+            if not m:
+                continue
+            addr = int(m.group(1), 16)
+            size = len(''.join(m.group(2).split())) // 2
+            ops = re.split(r'\s+<|' + re.escape(self.COMMENT), m.group(4))[0]
+            self.insns[addr] = (m.group(3), split_operands(ops), size)
+
+    @property
+    def code_size(self):
+        """Size in bytes of the disassembled code, LUTs included."""
+        return sum(insn[2] for insn in self.insns.values())
+
+    def rd(self, addr, n):
+        if addr in self.mmio:
+            return self.mmio[addr]() & ((1 << (8 * n)) - 1)
+        if addr + n > len(self.mem):
+            raise EmulationError('read out of memory at 0x%x' % addr)
+        return int.from_bytes(self.mem[addr:addr + n], 'little')
+
+    def wr(self, addr, v, n):
+        if addr + n > len(self.mem):
+            raise EmulationError('write out of memory at 0x%x' % addr)
+        self.mem[addr:addr + n] = (v & ((1 << (8 * n)) - 1)).to_bytes(
+            n, 'little')
+
+    def alloc(self, data_or_len, align=16):
+        """Allocates a buffer, initialized with 'data_or_len' if bytes."""
+        self.brk = (self.brk + align - 1) & ~(align - 1)
+        addr = self.brk
+        if isinstance(data_or_len, int):
+            self.mem[addr:addr + data_or_len] = bytes(data_or_len)
+            self.brk += data_or_len
+        else:
+            self.mem[addr:addr + len(data_or_len)] = data_or_len
+            self.brk += len(data_or_len)
+        if self.brk > self.stack_top - 0x10000:
+            raise EmulationError('out of memory')
+        return addr
+
+    def read(self, addr, n):
+        return bytes(self.mem[addr:addr + n])
+
+    def write(self, addr, data):
+        self.mem[addr:addr + len(data)] = data
+
+    def reset_heap(self):
+        self.brk = len(self.mem) // 2
+
+    def run(self, pc, maxinsns):
+        """Runs from pc until the return address is reached, accumulating the
+        number of executed instructions and the cycles of the cost model."""
+        self.count = self.cycles = 0
+        self.hist = collections.Counter()
+        while pc != RETURN_ADDR:
+            try:
+                mn, ops, size = self.insns[pc]
+            except KeyError:
+                raise EmulationError('no instruction at 0x%x' % pc)
+            self.hist[mn] += 1
+            npc = self.step(pc, mn, ops, size)
+            self.cycles += self.cost(pc, mn, ops, npc != pc + size)
+            pc = npc
+            self.count += 1
+            if self.count > maxinsns:
+                raise EmulationError('more than %d instructions' % maxinsns)
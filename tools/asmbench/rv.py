@@ -0,0 +1,414 @@
+###############################################################################
+# RISC-V emulator (RV32I/RV64I with M, Zbkb, Zbkx, Zkne and the subset of the
+# V extension used by 'riscv/rvv') along with a cycle model of the SiFive E31
+# core.
+#
+# E31 model (see the SiFive E31 Core Complex Manual, execution pipeline):
+#   - every instruction issues in 1 cycle (single-issue, in-order)
+#   - the result of a load is available 2 cycles later (3 for sub-word loads),
+#     the dependent instructions stalling in the meantime
+#   - jumps and calls are predicted (return address stack), while conditional
+#     branches are statically predicted taken if backward and not taken if
+#     forward, a misprediction costing 3 cycles
+# It is meant to compare versions of the same code rather than to give exact
+# figures, and the vector instructions are simply counted as 1 cycle.
+#
+# @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
+#           alexandre.adomnicai@ntu.edu.sg
+#
+# @date     October 2026
+###############################################################################
+import re
+
+from emu import Machine, EmulationError, RETURN_ADDR
+from aes import SBOX, xtime
+
+ABI = ['zero', 'ra', 'sp', 'gp', 'tp', 't0', 't1', 't2', 's0', 's1', 'a0',
+       'a1', 'a2', 'a3', 'a4', 'a5', 'a6', 'a7', 's2', 's3', 's4', 's5', 's6',
+       's7', 's8', 's9', 's10', 's11', 't3', 't4', 't5', 't6']
+REG = {n: i for i, n in enumerate(ABI)}
+REG['fp'] = 8
+for _i in range(32):
+    REG['x%d' % _i] = _i
+CALLEE_SAVED = (2, 8, 9) + tuple(range(18, 28))
+
+MATTR_ALL = '+m,+zbkb,+zbkx,+zkne,+v'
+
+E31_COSTS = {
+    'load_latency': 2,          # word and doubleword loads
+    'load_latency_subword': 3,  # byte and halfword loads
+    'mispredict': 3,
+}
+
+class RiscvMachine(Machine):
+
+    def __init__(self, elf, xlen=32, vlen=128, objdump='llvm-objdump'):
+        cmd = [objdump, '-d']
+        if 'llvm' in objdump:
+            cmd.append('--mattr=' + MATTR_ALL)
+        super().__init__(elf, cmd)
+        self.xlen = xlen
+        self.mask = (1 << xlen) - 1
+        self.vlen = vlen
+        self.vregs = [[0] * (vlen // 32) for _ in range(32)]
+        self.vl = 0
+        self.costs = dict(E31_COSTS)
+
+    def call(self, fn, *args, maxinsns=10**7):
+        """Calls the function 'fn' following the calling convention and
+        checks that the callee-saved registers are preserved."""
+        x = [0] * 32
+        for i, v in enumerate(args):
+            x[10 + i] = v & self.mask
+        x[1] = RETURN_ADDR
+        x[2] = self.stack_top
+        for i in CALLEE_SAVED[1:]:
+            x[i] = (0x5a5a0000 + i) & self.mask
+        saved = [x[i] for i in CALLEE_SAVED]
+        self.x = x
+        self.ready = {}             # register -> cycle its value is ready
+        self.run(self.syms[fn], maxinsns)
+        if [x[i] for i in CALLEE_SAVED] != saved:
+            raise EmulationError('%s: callee-saved registers clobbered' % fn)
+        return x[10]
+
+    # Cycle model ############################################################
+
+    def srcs(self, mn, ops):
+        """Returns the registers read by the instruction."""
+        if mn in STORES or mn in BR or mn in BRZ or mn in ('jr', 'ret') or \
+                (mn in ('jalr', 'jal') and len(ops) == 1):
+            regs = ops
+        else:
+            regs = ops[1:]
+        out = []
+        for o in regs:
+            m = re.match(r'(?:-?\w+)?\((\w+)\)$', o)
+            o = m.group(1) if m else o
+            if o in REG and REG[o]:
+                out.append(REG[o])
+        if mn == 'ret':
+            out.append(1)
+        return out
+
+    def cost(self, pc, mn, ops, taken):
+        stall = 0
+        for r in self.srcs(mn, ops):
+            stall = max(stall, self.ready.get(r, 0) - self.cycles)
+        c = 1 + stall
+        if mn in LOADS:
+            lat = self.costs['load_latency'] if LOADS[mn][0] >= 4 else \
+                self.costs['load_latency_subword']
+            self.ready[REG[ops[0]]] = self.cycles + c - 1 + lat
+        elif ops and ops[0] in REG:
+            self.ready.pop(REG[ops[0]], None)
+        if mn in BR or mn in BRZ:
+            target = int(ops[-1], 16)
+            if taken != (target < pc):      # static prediction
+                c += self.costs['mispredict']
+        return c
+
+    # Interpreter ############################################################
+
+    def sx(self, v, bits=None):
+        bits = bits or self.xlen
+        v &= (1 << bits) - 1
+        return v - (1 << bits) if v >> (bits - 1) else v
+
+    def mop(self, s):
+        m = re.match(r'(-?\w+)?\((\w+)\)', s)
+        off = int(m.group(1), 0) if m.group(1) else 0
+        return (self.x[REG[m.group(2)]] + off) & self.mask
+
+    def step(self, pc, mn, ops, size):
+        x, M = self.x, self.mask
+        r = lambda i: x[REG[ops[i]]]
+        def w(v):
+            x[REG[ops[0]]] = v & M
+            x[0] = 0
+        npc = pc + size
+        if mn in ALU:
+            w(ALU[mn](self, r(1), r(2)))
+        elif mn in ALUI:
+            w(ALUI[mn](self, r(1), int(ops[2], 0)))
+        elif mn in UNARY:
+            w(UNARY[mn](self, r(1)))
+        elif mn in LOADS:
+            n, signed = LOADS[mn]
+            v = self.rd(self.mop(ops[1]), n)
+            w(self.sx(v, 8 * n) if signed else v)
+        elif mn in STORES:
+            self.wr(self.mop(ops[1]), r(0), STORES[mn])
+        elif mn in BR:
+            if BR[mn](self.sx(r(0)), self.sx(r(1)), r(0), r(1)):
+                npc = int(ops[2], 16)
+        elif mn in BRZ:
+            if BRZ[mn](self.sx(r(0))):
+                npc = int(ops[1], 16)
+        elif mn == 'lui':
+            w(self.sx(int(ops[1], 0) << 12, 32))
+        elif mn == 'auipc':
+            w(pc + self.sx(int(ops[1], 0) << 12, 32))
+        elif mn == 'li':
+            w(int(ops[1], 0))
+        elif mn == 'mv':
+            w(r(1))
+        elif mn == 'jal':
+            if len(ops) == 1:
+                x[1] = npc
+                return int(ops[0], 16)
+            w(npc)
+            return int(ops[1], 16)
+        elif mn == 'j':
+            return int(ops[0], 16)
+        elif mn == 'ret':
+            return x[1]
+        elif mn == 'jr':
+            return r(0)
+        elif mn == 'jalr':
+            if len(ops) == 1:
+                t = r(0)
+                x[1] = npc
+                return t
+            t = self.mop(ops[1]) if '(' in ops[1] else r(1)
+            w(npc)
+            return t & ~1
+        elif mn == 'nop':
+            pass
+        elif mn.startswith('aes32') or mn.startswith('aes64'):
+            self.aes(mn, ops, w, r)
+        elif mn.startswith('v'):
+            self.vec(mn, ops)
+        else:
+            raise EmulationError('0x%x: unsupported instruction %s %s' % (
+                pc, mn, ', '.join(ops)))
+        return npc
+
+    def aes(self, mn, ops, w, r):
+        """Scalar AES instructions (Zkne)."""
+        if mn in ('aes32esi', 'aes32esmi'):
+            bs = int(ops[3], 0)
+            s = SBOX[(r(2) >> (8 * bs)) & 0xff]
+            if mn == 'aes32esi':
+                u = s
+            else:
+                u = xtime(s) | (s << 8) | (s << 16) | ((xtime(s) ^ s) << 24)
+            u = ((u << (8 * bs)) | (u >> (32 - 8 * bs))) & 0xffffffff
+            w(self.sx(r(1) ^ u, 32))
+        elif mn in ('aes64es', 'aes64esm'):
+            st = (r(2) << 64) | r(1)
+            b = [(st >> (8 * i)) & 0xff for i in range(16)]
+            sb = [SBOX[b[(i + 4 * (i % 4)) % 16]] for i in range(16)]
+            if mn == 'aes64esm':
+                out = []
+                for c in range(2):
+                    a = sb[4 * c:4 * c + 4]
+                    for i in range(4):
+                        out.append(xtime(a[i]) ^ xtime(a[(i + 1) % 4]) ^
+                                   a[(i + 1) % 4] ^ a[(i + 2) % 4] ^
+                                   a[(i + 3) % 4])
+                sb = out
+            w(sum(sb[i] << (8 * i) for i in range(8)))
+        elif mn == 'aes64ks1i':
+            rnum = int(ops[2], 0)
+            t = (r(1) >> 32) & 0xffffffff
+            rc = [1, 2, 4, 8, 16, 32, 64, 128, 0x1b, 0x36][rnum] \
+                if rnum < 10 else 0
+            if rnum != 0xa:
+                t = ((t >> 8) | (t << 24)) & 0xffffffff
+            t = sum(SBOX[(t >> (8 * i)) & 0xff] << (8 * i) for i in range(4))
+            t ^= rc
+            w(t | (t << 32))
+        elif mn == 'aes64ks2':
+            w1 = (r(1) >> 32) ^ (r(2) & 0xffffffff)
+            w2 = w1 ^ (r(2) >> 32)
+            w((w2 << 32) | w1)
+        else:
+            raise EmulationError('unsupported instruction ' + mn)
+
+    def vec(self, mn, ops):
+        """Subset of the V extension: SEW=32 and LMUL=1 only."""
+        x, V = self.x, self.vregs
+        if mn in ('vsetvli', 'vsetivli'):
+            if ops[2] != 'e32' or ops[3] != 'm1':
+                raise EmulationError('only e32, m1 is supported')
+            if mn == 'vsetivli':
+                avl = int(ops[1], 0)
+            else:
+                avl = self.mask if ops[1] == 'zero' else x[REG[ops[1]]]
+            self.vl = min(avl, self.vlen // 32)
+            x[REG[ops[0]]] = self.vl
+            x[0] = 0
+            return
+        vl, M = self.vl, 0xffffffff
+        vn = lambda s: int(s[1:])
+        def put(d, vals):
+            V[d][:vl] = [v & M for v in vals]
+            V[d][vl:] = [0xdeadbeef] * (len(V[d]) - vl)    # tail agnostic
+        m = re.match(r'v(l|s)seg(\d)e32\.v', mn)
+        if mn in ('vle32.v', 'vse32.v') or m:
+            nf = int(m.group(2)) if m else 1
+            d = vn(ops[0])
+            a = x[REG[ops[1].strip('()')]]
+            for f in range(nf):
+                if mn.startswith('vl'):
+                    put(d + f, [self.rd(a + 4 * (nf * i + f), 4)
+                                for i in range(vl)])
+                else:
+                    for i in range(vl):
+                        self.wr(a + 4 * (nf * i + f), V[d + f][i], 4)
+            return
+        d = vn(ops[0])
+        if mn == 'vid.v':
+            return put(d, range(vl))
+        if mn == 'vmv.v.x':
+            return put(d, [x[REG[ops[1]]]] * vl)
+        if mn == 'vmv.v.v':
+            return put(d, V[vn(ops[1])][:vl])
+        if mn == 'vmv.v.i':
+            return put(d, [int(ops[1], 0)] * vl)
+        op, kind = mn[1:].split('.')
+        a = V[vn(ops[1])]
+        if kind == 'vv':
+            b = V[vn(ops[2])][:vl]
+        elif kind == 'vx':
+            b = [x[REG[ops[2]]] & M] * vl
+        elif kind == 'vi':
+            b = [int(ops[2], 0) & M] * vl
+        else:
+            raise EmulationError('unsupported instruction ' + mn)
+        f = VOPS.get(op)
+        if f is None:
+            raise EmulationError('unsupported instruction ' + mn)
+        put(d, [f(a[i], b[i]) for i in range(vl)])
+
+def ror(m, a, b):
+    s = b & (m.xlen - 1)
+    a &= m.mask
+    return (a >> s) | (a << (m.xlen - s))
+
+def ror32(a, s):
+    a &= 0xffffffff
+    return ((a >> s) | (a << (32 - s))) & 0xffffffff
+
+def brev8(m, a):
+    o = 0
+    for i in range(m.xlen // 8):
+        b = (a >> (8 * i)) & 0xff
+        o |= int('{:08b}'.format(b)[::-1], 2) << (8 * i)
+    return o
+
+def rev8(m, a):
+    return int.from_bytes(a.to_bytes(m.xlen // 8, 'little'), 'big')
+
+def zip32(m, a):
+    o = 0
+    for i in range(16):
+        o |= ((a >> i) & 1) << (2 * i)
+        o |= ((a >> (i + 16)) & 1) << (2 * i + 1)
+    return o
+
+def unzip32(m, a):
+    o = 0
+    for i in range(16):
+        o |= ((a >> (2 * i)) & 1) << i
+        o |= ((a >> (2 * i + 1)) & 1) << (i + 16)
+    return o
+
+def xperm(m, a, b, w):
+    o, n = 0, (1 << w) - 1
+    for i in range(0, m.xlen, w):
+        idx = (b >> i) & n
+        if idx * w < m.xlen:
+            o |= ((a >> (idx * w)) & n) << i
+    return o
+
+def pack(m, a, b):
+    h = m.xlen // 2
+    return (a & ((1 << h) - 1)) | ((b & ((1 << h) - 1)) << h)
+
+ALU = {
+    'add': lambda m, a, b: a + b,
+    'sub': lambda m, a, b: a - b,
+    'xor': lambda m, a, b: a ^ b,
+    'or': lambda m, a, b: a | b,
+    'and': lambda m, a, b: a & b,
+    'sll': lambda m, a, b: a << (b & (m.xlen - 1)),
+    'srl': lambda m, a, b: a >> (b & (m.xlen - 1)),
+    'sra': lambda m, a, b: m.sx(a) >> (b & (m.xlen - 1)),
+    'slt': lambda m, a, b: int(m.sx(a) < m.sx(b)),
+    'sltu': lambda m, a, b: int(a < b),
+    'addw': lambda m, a, b: m.sx(a + b, 32),
+    'subw': lambda m, a, b: m.sx(a - b, 32),
+    'sllw': lambda m, a, b: m.sx(a << (b & 31), 32),
+    'srlw': lambda m, a, b: m.sx((a & 0xffffffff) >> (b & 31), 32),
+    'sraw': lambda m, a, b: m.sx(a, 32) >> (b & 31),
+    'mul': lambda m, a, b: a * b,
+    'ror': ror,
+    'rol': lambda m, a, b: ror(m, a, m.xlen - (b & (m.xlen - 1))),
+    'rorw': lambda m, a, b: m.sx(ror32(a, b & 31), 32),
+    'rolw': lambda m, a, b: m.sx(ror32(a, (32 - (b & 31)) & 31), 32),
+    'andn': lambda m, a, b: a & ~b,
+    'orn': lambda m, a, b: a | ~b,
+    'xnor': lambda m, a, b: ~(a ^ b),
+    'pack': pack,
+    'packh': lambda m, a, b: (a & 0xff) | ((b & 0xff) << 8),
+    'packw': lambda m, a, b: m.sx((a & 0xffff) | ((b & 0xffff) << 16), 32),
+    'xperm4': lambda m, a, b: xperm(m, a, b, 4),
+    'xperm8': lambda m, a, b: xperm(m, a, b, 8),
+}
+ALUI = {
+    'addi': lambda m, a, i: a + i,
+    'xori': lambda m, a, i: a ^ i,
+    'ori': lambda m, a, i: a | i,
+    'andi': lambda m, a, i: a & i,
+    'slli': lambda m, a, i: a << i,
+    'srli': lambda m, a, i: a >> i,
+    'srai': lambda m, a, i: m.sx(a) >> i,
+    'slti': lambda m, a, i: int(m.sx(a) < i),
+    'sltiu': lambda m, a, i: int(a < (i & m.mask)),
+    'addiw': lambda m, a, i: m.sx(a + i, 32),
+    'slliw': lambda m, a, i: m.sx(a << i, 32),
+    'srliw': lambda m, a, i: m.sx((a & 0xffffffff) >> i, 32),
+    'sraiw': lambda m, a, i: m.sx(a, 32) >> i,
+    'rori': lambda m, a, i: ror(m, a, i),
+    'roriw': lambda m, a, i: m.sx(ror32(a, i), 32),
+}
+UNARY = {
+    'not': lambda m, a: ~a,
+    'neg': lambda m, a: -a,
+    'seqz': lambda m, a: int(a == 0),
+    'snez': lambda m, a: int(a != 0),
+    'sext.w': lambda m, a: m.sx(a, 32),
+    'brev8': brev8,
+    'rev8': rev8,
+    'zip': zip32,
+    'unzip': unzip32,
+    'zext.h': lambda m, a: a & 0xffff,
+}
+LOADS = {'lb': (1, 1), 'lh': (2, 1), 'lw': (4, 1), 'ld': (8, 1),
+         'lbu': (1, 0), 'lhu': (2, 0), 'lwu': (4, 0)}
+STORES = {'sb': 1, 'sh': 2, 'sw': 4, 'sd': 8}
+BR = {
+    'beq': lambda a, b, ua, ub: a == b,
+    'bne': lambda a, b, ua, ub: a != b,
+    'blt': lambda a, b, ua, ub: a < b,
+    'bge': lambda a, b, ua, ub: a >= b,
+    'bltu': lambda a, b, ua, ub: ua < ub,
+    'bgeu': lambda a, b, ua, ub: ua >= ub,
+    'bgt': lambda a, b, ua, ub: a > b,
+    'ble': lambda a, b, ua, ub: a <= b,
+    'bgtu': lambda a, b, ua, ub: ua > ub,
+    'bleu': lambda a, b, ua, ub: ua <= ub,
+}
+BRZ = {
+    'beqz': lambda a: a == 0, 'bnez': lambda a: a != 0,
+    'bltz': lambda a: a < 0, 'bgez': lambda a: a >= 0,
+    'blez': lambda a: a <= 0, 'bgtz': lambda a: a > 0,
+}
+VOPS = {
+    'xor': lambda p, q: p ^ q, 'and': lambda p, q: p & q,
+    'or': lambda p, q: p | q, 'add': lambda p, q: p + q,
+    'sub': lambda p, q: p - q,
+    'sll': lambda p, q: p << (q & 31), 'srl': lambda p, q: p >> (q & 31),
+}
@@ -0,0 +1,545 @@
+#!/usr/bin/env python3
+###############################################################################
+# Bitslice circuit code generator.
+#
+# Takes a boolean netlist (e.g. an S-box circuit or one of the fixsliced
+# MixColumns) written with C-like statements and emits a scheduled kernel for
+# one of the following targets:
+#   - c32:   portable C on 32-bit words (uint32_t)
+#   - c64:   portable C on 64-bit words, i.e. two 32-bit slices per word
+#   - sse:   x86 SSE2 intrinsics (__m128i), i.e. four 32-bit slices per word
+#   - avx2:  x86 AVX2 intrinsics (__m256i), i.e. eight 32-bit slices per word
+#   - rv32:  RV32I assembly, register-allocated, following the calling
+#            convention (state pointer in a0)
+# The emitted kernel loads the state words, computes the circuit and stores
+# the result back in place: 'void name(T* state)'.
+#
+# Netlist format (see the 'netlists' directory):
+#   .inputs  x0 x1 ...      names of the state words, in memory order
+#   .outputs x0 x1 ...      names holding the result, in memory order
+#   t0 = x3 ^ x5;           XOR (^), AND (&), OR (|), NOT (~ or ^ 0xffffffff)
+#   x2 ^= t10;              in-place updates are allowed
+#   t1 = ROR(x0, 8);        32-bit rotation to the right
+#   t2 = BYTE_ROR_6(x0);    rotation to the right within each byte
+# Expressions can be nested, comments start with '//' or '#'.
+#
+# Usage:
+#   bitgen.py netlists/sbox_bpc113.txt --target rv32 --name sbox
+#   bitgen.py netlists/sbox_bpc113.txt --check-sbox --stats
+#
+# @author   Alexandre Adomnicai, Nanyang Technological University, Singapore
+#           alexandre.adomnicai@ntu.edu.sg
+#
+# @date     October 2026
+###############################################################################
+import argparse
+import ast
+import random
+import re
+import sys
+
+MASK32 = 0xffffffff
+COMMUTATIVE = ('xor', 'and', 'or')
+
+class Circuit:
+    """Netlist in SSA form: each node is a tuple (op, args, imm)."""
+
+    def __init__(self):
+        self.nodes = []
+        self.cse = {}
+        self.inputs = []        # node ids of the state words
+        self.outputs = []       # node ids of the results
+
+    def add(self, op, args=(), imm=None):
+        if op in COMMUTATIVE:
+            args = tuple(sorted(args))
+        key = (op, tuple(args), imm)
+        if op != 'in' and key in self.cse:
+            return self.cse[key]
+        self.nodes.append(key)
+        self.cse[key] = len(self.nodes) - 1
+        return len(self.nodes) - 1
+
+    def live(self):
+        """Returns the ids of the nodes required to compute the outputs."""
+        used = set(self.outputs)
+        for i in range(len(self.nodes) - 1, -1, -1):
+            if i in used:
+                used.update(self.nodes[i][1])
+        return sorted(used | set(self.inputs))
+
+    def depth(self):
+        d = {}
+        for i in self.live():
+            op, args, _ = self.nodes[i]
+            d[i] = 0 if op in ('in', 'const') else \
+                max([d[a] for a in args]) + 1
+        return max(d[o] for o in self.outputs)
+
+    def evaluate(self, state):
+        """Evaluates the circuit on a list of 32-bit words."""
+        v = {}
+        for i in self.live():
+            op, args, imm = self.nodes[i]
+            a = [v[x] for x in args]
+            if op == 'in':      v[i] = state[imm]
+            elif op == 'const': v[i] = imm
+            elif op == 'xor':   v[i] = a[0] ^ a[1]
+            elif op == 'and':   v[i] = a[0] & a[1]
+            elif op == 'or':    v[i] = a[0] | a[1]
+            elif op == 'not':   v[i] = a[0] ^ MASK32
+            elif op == 'shr':   v[i] = a[0] >> imm
+            elif op == 'shl':   v[i] = (a[0] << imm) & MASK32
+            elif op == 'ror':   v[i] = ror32(a[0], imm)
+            elif op == 'bror':  v[i] = byte_ror32(a[0], imm)
+        return [v[o] for o in self.outputs]
+
+def ror32(x, n):
+    return ((x >> n) | (x << (32 - n))) & MASK32
+
+def byte_mask(n, width=32):
+    """Mask of the (8-n) least significant bits of each byte."""
+    return ((0xff >> n) * 0x0101010101010101) & ((1 << width) - 1)
+
+def byte_ror32(x, n):
+    m = byte_mask(n)
+    return ((x >> n) & m) | ((x << (8 - n)) & ~m & MASK32)
+
+###############################################################################
+# Parsing
+###############################################################################
+def parse(path):
+    c = Circuit()
+    env = {}
+    outputs = None
+    with open(path) as f:
+        lines = f.read().split('\n')
+    for lineno, line in enumerate(lines, 1):
+        line = re.split(r'//|#', line)[0].strip()
+        if not line:
+            continue
+        err = '%s:%d: ' % (path, lineno)
+        if line.startswith('.inputs'):
+            for i, name in enumerate(line.split()[1:]):
+                env[name] = c.add('in', (), i)
+                c.inputs.append(env[name])
+            continue
+        if line.startswith('.outputs'):
+            outputs = line.split()[1:]
+            continue
+        m = re.match(r'^(\w+)\s*([\^&|]?)=\s*(.+?);?$', line)
+        if not m:
+            sys.exit(err + 'syntax error')
+        dst, op, expr = m.groups()
+        try:
+            val = lower(c, env, ast.parse(expr, mode='eval').body)
+        except (SyntaxError, KeyError, ValueError) as e:
+            sys.exit(err + 'invalid expression (%s)' % e)
+        if op:
+            if dst not in env:
+                sys.exit(err + "'%s' used before definition" % dst)
+            val = binop(c, {'^': 'xor', '&': 'and', '|': 'or'}[op],
+                        env[dst], val)
+        env[dst] = val
+    if outputs is None or not c.inputs:
+        sys.exit(path + ': missing .inputs/.outputs')
+    c.outputs = [env[o] for o in outputs]
+    return c
+
+def binop(c, op, a, b):
+    na, nb = c.nodes[a], c.nodes[b]
+    if op == 'xor' and nb[0] == 'const' and nb[2] == MASK32:
+        return c.add('not', (a,))
+    if op == 'xor' and na[0] == 'const' and na[2] == MASK32:
+        return c.add('not', (b,))
+    return c.add(op, (a, b))
+
+def lower(c, env, e):
+    if isinstance(e, ast.Name):
+        return env[e.id]
+    if isinstance(e, ast.Constant) and isinstance(e.value, int):
+        return c.add('const', (), e.value & MASK32)
+    if isinstance(e, ast.UnaryOp) and isinstance(e.op, ast.Invert):
+        return c.add('not', (lower(c, env, e.operand),))
+    if isinstance(e, ast.BinOp):
+        ops = {ast.BitXor: 'xor', ast.BitAnd: 'and', ast.BitOr: 'or'}
+        if type(e.op) not in ops:
+            raise ValueError('unsupported operator')
+        return binop(c, ops[type(e.op)], lower(c, env, e.left),
+                     lower(c, env, e.right))
+    if isinstance(e, ast.Call) and isinstance(e.func, ast.Name):
+        name = e.func.id.upper()
+        if name == 'ROR' and len(e.args) == 2:
+            return c.add('ror', (lower(c, env, e.args[0]),),
+                         e.args[1].value % 32)
+        m = re.match(r'^BYTE_ROR_(\d)$', name)
+        if m and len(e.args) == 1:
+            return c.add('bror', (lower(c, env, e.args[0]),), int(m.group(1)))
+    raise ValueError(ast.dump(e))
+
+###############################################################################
+# Scheduling
+###############################################################################
+def schedule(c, policy):
+    """
+    'source' keeps the order of the netlist, which usually minimizes the
+    register pressure. 'depth' sorts the nodes by ASAP level so that
+    independent operations are interleaved, which suits superscalar cores.
+    """
+    order = [i for i in c.live() if c.nodes[i][0] not in ('in', 'const')]
+    if policy == 'depth':
+        level = {}
+        for i in c.live():
+            op, args, _ = c.nodes[i]
+            level[i] = 0 if op in ('in', 'const') else \
+                max(level[a] for a in args) + 1
+        order.sort(key=lambda i: (level[i], i))
+    res, done = [], set()
+    for i in order:             # constants are materialized right before use
+        for a in c.nodes[i][1]:
+            if c.nodes[a][0] == 'const' and a not in done:
+                res.append(a)
+                done.add(a)
+        res.append(i)
+    return res
+
+def expand_shifts(c):
+    """
+    Rewrites rotations with shifts, masks and ORs for targets that lack them
+    (RV32I). Returns a new circuit.
+    """
+    n = Circuit()
+    remap = {}
+    for i in c.live():
+        op, args, imm = c.nodes[i]
+        a = [remap[x] for x in args]
+        if op == 'ror':
+            r = n.add('or', (n.add('shr', (a[0],), imm),
+                             n.add('shl', (a[0],), 32 - imm)))
+        elif op == 'bror':
+            m = byte_mask(imm)
+            r = n.add('or', (
+                n.add('and', (n.add('shr', (a[0],), imm),
+                              n.add('const', (), m))),
+                n.add('and', (n.add('shl', (a[0],), 8 - imm),
+                              n.add('const', (), ~m & MASK32)))))
+        else:
+            r = n.add(op, tuple(a), imm)
+        remap[i] = r
+    n.inputs = [remap[i] for i in c.inputs]
+    n.outputs = [remap[o] for o in c.outputs]
+    return n
+
+###############################################################################
+# C backends
+###############################################################################
+class CTarget:
+    def __init__(self, word, lanes):
+        self.word = word
+        self.lanes = lanes      # number of 32-bit slices per word
+
+    def const(self, v):
+        width = 32 * self.lanes
+        rep = sum(v << (32 * k) for k in range(self.lanes))
+        return '0x%0*x' % (width // 4, rep) + ('ULL' if width > 32 else '')
+
+    def expr(self, op, a, imm):
+        if op == 'xor': return '%s ^ %s' % tuple(a)
+        if op == 'and': return '%s & %s' % tuple(a)
+        if op == 'or':  return '%s | %s' % tuple(a)
+        if op == 'not': return '~%s' % a[0]
+        if op == 'const': return self.const(imm)
+        if op == 'ror':
+            if self.lanes == 1:
+                return '(%s >> %d) | (%s << %d)' % (a[0], imm, a[0], 32 - imm)
+            lo = self.const(MASK32 >> imm)
+            return '((%s >> %d) & %s) | ((%s << %d) & ~%s)' % \
+                (a[0], imm, lo, a[0], 32 - imm, lo)
+        if op == 'bror':
+            m = self.const(byte_mask(imm))
+            return '((%s >> %d) & %s) | ((%s << %d) & ~%s)' % \
+                (a[0], imm, m, a[0], 8 - imm, m)
+        raise ValueError(op)
+
+class SimdTarget:
+    def __init__(self, prefix, word):
+        self.p = prefix
+        self.word = word
+
+    def const(self, v):
+        return '%s_set1_epi32(0x%08x)' % (self.p, v)
+
+    def expr(self, op, a, imm):
+        p = self.p
+        if op == 'xor': return '%s_xor_si%s(%s, %s)' % (p, self.bits, *a)
+        if op == 'and': return '%s_and_si%s(%s, %s)' % (p, self.bits, *a)
+        if op == 'or':  return '%s_or_si%s(%s, %s)' % (p, self.bits, *a)
+        if op == 'not':
+            return '%s_xor_si%s(%s, %s_set1_epi32(-1))' % \
+                (p, self.bits, a[0], p)
+        if op == 'const': return self.const(imm)
+        if op == 'ror':
+            return '%s_or_si%s(%s_srli_epi32(%s, %d), %s_slli_epi32(%s, %d))' \
+                % (p, self.bits, p, a[0], imm, p, a[0], 32 - imm)
+        if op == 'bror':
+            m = byte_mask(imm)
+            return ('%s_or_si%s(%s_and_si%s(%s_srli_epi32(%s, %d), %s), '
+                '%s_and_si%s(%s_slli_epi32(%s, %d), %s))') % \
+                (p, self.bits, p, self.bits, p, a[0], imm, self.const(m),
+                 p, self.bits, p, a[0], 8 - imm, self.const(~m & MASK32))
+        raise ValueError(op)
+
+    @property
+    def bits(self):
+        return '128' if self.p == '_mm' else '256'
+
+def emit_c(c, order, target, name, header):
+    out = [header]
+    out.append('static inline void %s(%s* state) {' % (name, target.word))
+    names = {}
+    for k, i in enumerate(c.inputs):
+        names[i] = 'x%d' % k
+        out.append('\t%s x%d = state[%d];' % (target.word, k, k))
+    for i in order:
+        op, args, imm = c.nodes[i]
+        if op == 'const':
+            continue
+        a = [names[x] if c.nodes[x][0] != 'const' else
+             target.const(c.nodes[x][2]) for x in args]
+        names[i] = 'v%d' % i
+        out.append('\t%s v%d = %s;' % (target.word, i, target.expr(op, a, imm)))
+    for k, o in enumerate(c.outputs):
+        out.append('\tstate[%d] = %s;' % (k, names[o]))
+    out.append('}')
+    return '\n'.join(out) + '\n'
+
+###############################################################################
+# RV32I backend
+###############################################################################
+RV_POOL = ['t0', 't1', 't2', 't3', 't4', 'a1', 'a2', 'a3', 'a4', 'a5', 'a6',
+           'a7', 's0', 's1', 's2', 's3', 's4', 's5', 's6', 's7', 's8', 's9',
+           's10', 's11']
+RV_SCRATCH = ['t5', 't6']       # to reload/store spilled values
+RV_OPS = {'xor': 'xor', 'and': 'and', 'or': 'or'}
+
+def allocate(c, order):
+    """
+    Linear-scan register allocation over the schedule. Returns the register
+    (or stack slot) of each value.
+    """
+    pos = {}
+    seq = list(c.inputs) + order
+    for p, i in enumerate(seq):
+        pos[i] = p
+    end = {i: pos[i] for i in seq}
+    for p, i in enumerate(seq):
+        for a in c.nodes[i][1]:
+            end[a] = max(end[a], p)
+    for o in c.outputs:
+        end[o] = len(seq)
+    free = list(RV_POOL)
+    active = []                 # (end, value)
+    loc = {}
+    slots = 0
+    for i in seq:
+        p = pos[i]
+        for e, v in list(active):
+            if e < p or (e == p and v != i):
+                active.remove((e, v))
+                free.append(loc[v])
+        if free:                # caller-saved registers first
+            loc[i] = min(free, key=RV_POOL.index)
+            free.remove(loc[i])
+            active.append((end[i], i))
+        else:                   # spills the value that is used the latest
+            active.sort()
+            e, v = active[-1]
+            if e > end[i]:
+                loc[i] = loc[v]
+                loc[v] = ('slot', slots)
+                active[-1] = (end[i], i)
+            else:
+                loc[i] = ('slot', slots)
+            slots += 1
+    return loc, slots
+
+def emit_rv32(c, order, name, header):
+    c = expand_shifts(c)
+    order = schedule(c, ORDER_POLICY)
+    loc, slots = allocate(c, order)
+    saved = sorted({r for r in loc.values()
+                    if isinstance(r, str) and r.startswith('s')},
+                   key=lambda r: int(r[1:]))
+    frame = ((len(saved) + slots) * 4 + 15) // 16 * 16
+    body = []
+    def reg(v, scratch):
+        if isinstance(loc[v], tuple):
+            body.append('    lw      %s, %d(sp)' %
+                        (scratch, 4 * (len(saved) + loc[v][1])))
+            return scratch
+        return loc[v]
+    def dst(v):
+        return RV_SCRATCH[1] if isinstance(loc[v], tuple) else loc[v]
+    def spill(v):
+        if isinstance(loc[v], tuple):
+            body.append('    sw      %s, %d(sp)' %
+                        (RV_SCRATCH[1], 4 * (len(saved) + loc[v][1])))
+    for k, i in enumerate(c.inputs):
+        body.append('    lw      %s, %d(a0)' % (dst(i), 4 * k))
+        spill(i)
+    for i in order:
+        op, args, imm = c.nodes[i]
+        if op == 'const':
+            body.append('    li      %s, 0x%08x' % (dst(i), imm))
+        else:
+            a = [reg(x, RV_SCRATCH[k]) for k, x in enumerate(args)]
+            if op in RV_OPS:
+                body.append('    %-7s %s, %s, %s' % (RV_OPS[op], dst(i), *a))
+            elif op == 'not':
+                body.append('    xori    %s, %s, -1' % (dst(i), a[0]))
+            elif op == 'shr':
+                body.append('    srli    %s, %s, %d' % (dst(i), a[0], imm))
+            elif op == 'shl':
+                body.append('    slli    %s, %s, %d' % (dst(i), a[0], imm))
+            else:
+                raise ValueError(op)
+        spill(i)
+    for k, o in enumerate(c.outputs):
+        body.append('    sw      %s, %d(a0)' % (reg(o, RV_SCRATCH[0]), 4 * k))
+    out = [header, '.text', '.globl %s' % name, '.type %s, %%function' % name,
+           '.align 2', '%s:' % name]
+    if frame:
+        out.append('    addi    sp, sp, -%d' % frame)
+    for k, r in enumerate(saved):
+        out.append('    sw      %s, %d(sp)' % (r, 4 * k))
+    out += body
+    for k, r in enumerate(saved):
+        out.append('    lw      %s, %d(sp)' % (r, 4 * k))
+    if frame:
+        out.append('    addi    sp, sp, %d' % frame)
+    out.append('    ret')
+    out.append('.size %s, .-%s' % (name, name))
+    return '\n'.join(out) + '\n', slots
+
+###############################################################################
+# Checks
+###############################################################################
+def aes_sbox():
+    def gmul(a, b):
+        r = 0
+        while b:
+            if b & 1:
+                r ^= a
+            a = (a << 1) ^ (0x11b if a & 0x80 else 0)
+            b >>= 1
+        return r
+    inv = [0] * 256
+    for a in range(1, 256):
+        for b in range(1, 256):
+            if gmul(a, b) == 1:
+                inv[a] = b
+    rotl = lambda x, n: ((x << n) | (x >> (8 - n))) & 0xff
+    return [b ^ rotl(b, 1) ^ rotl(b, 2) ^ rotl(b, 3) ^ rotl(b, 4) ^ 0x63
+            for b in inv]
+
+def check_sbox(c):
+    """
+    Checks that the circuit computes the AES S-box on all bytes, where
+    state[k] holds bit 7-k, up to the 4 NOT moved to the key schedule.
+    """
+    sbox = aes_sbox()
+    for base in range(0, 256, 32):
+        state = [sum(((base + j) >> (7 - k) & 1) << j for j in range(32))
+                 for k in range(8)]
+        res = c.evaluate(state)
+        for k in range(8):
+            exp = sum((sbox[base + j] >> (7 - k) & 1) << j for j in range(32))
+            if res[k] not in (exp, exp ^ MASK32):
+                return False
+    return True
+
+def check_rv32(c, text):
+    """Runs the RV32I kernel on random inputs against the netlist."""
+    for _ in range(16):
+        state = [random.getrandbits(32) for _ in c.inputs]
+        mem, reg = dict(enumerate(state)), {'sp': 1 << 20, 'a0': 0}
+        for line in text.split('\n'):
+            m = re.match(r'^\s+(\w+)\s+(.*)$', line)
+            if not m or m.group(1) == 'ret':
+                continue
+            ins, ops = m.group(1), [o.strip() for o in m.group(2).split(',')]
+            val = lambda r: reg.get(r, 0)
+            if ins in ('lw', 'sw'):
+                off, base = re.match(r'(-?\d+)\((\w+)\)', ops[1]).groups()
+                addr = (val(base) + int(off)) // 4
+                if ins == 'lw':
+                    reg[ops[0]] = mem.get(addr, 0)
+                else:
+                    mem[addr] = val(ops[0])
+            elif ins == 'li':   reg[ops[0]] = int(ops[1], 0)
+            elif ins == 'addi': reg[ops[0]] = val(ops[1]) + int(ops[2])
+            elif ins == 'xori': reg[ops[0]] = val(ops[1]) ^ MASK32
+            elif ins == 'srli': reg[ops[0]] = val(ops[1]) >> int(ops[2])
+            elif ins == 'slli':
+                reg[ops[0]] = (val(ops[1]) << int(ops[2])) & MASK32
+            elif ins == 'xor':  reg[ops[0]] = val(ops[1]) ^ val(ops[2])
+            elif ins == 'and':  reg[ops[0]] = val(ops[1]) & val(ops[2])
+            elif ins == 'or':   reg[ops[0]] = val(ops[1]) | val(ops[2])
+        if [mem[k] for k in range(len(c.outputs))] != c.evaluate(state):
+            return False
+    return True
+
+###############################################################################
+# Main
+###############################################################################
+ORDER_POLICY = 'source'
+
+def main():
+    global ORDER_POLICY
+    ap = argparse.ArgumentParser(description='Bitslice circuit code generator')
+    ap.add_argument('netlist')
+    ap.add_argument('--target', choices=['c32', 'c64', 'sse', 'avx2', 'rv32'],
+                    default='c32')
+    ap.add_argument('--name', default='kernel', help='name of the function')
+    ap.add_argument('--schedule', choices=['source', 'depth'],
+                    default='source')
+    ap.add_argument('--check-sbox', action='store_true',
+                    help='checks that the netlist computes the AES S-box')
+    ap.add_argument('--stats', action='store_true',
+                    help='prints the gate count and depth on stderr')
+    ap.add_argument('-o', '--output', help='output file (default: stdout)')
+    args = ap.parse_args()
+    ORDER_POLICY = args.schedule
+    c = parse(args.netlist)
+    if args.check_sbox and not check_sbox(c):
+        sys.exit('%s: does not compute the AES S-box' % args.netlist)
+    if args.stats:
+        ops = [c.nodes[i][0] for i in c.live()]
+        print('%s: %d gates (%d AND/OR), depth %d' % (args.netlist,
+            sum(op not in ('in', 'const') for op in ops),
+            sum(op in ('and', 'or') for op in ops), c.depth()),
+            file=sys.stderr)
+    header = '%s Generated by bitgen.py from %s (--schedule %s) %s' % (
+        ('#' if args.target == 'rv32' else '/*'), args.netlist.split('/')[-1],
+        args.schedule, ('' if args.target == 'rv32' else '*/'))
+    order = schedule(c, args.schedule)
+    if args.target == 'rv32':
+        text, slots = emit_rv32(c, order, args.name, header.rstrip())
+        if not check_rv32(c, text):
+            sys.exit('internal error: RV32I kernel mismatch')
+        if args.stats:
+            print('%s: %d spilled values' % (args.name, slots),
+                  file=sys.stderr)
+    else:
+        target = {'c32': CTarget('uint32_t', 1), 'c64': CTarget('uint64_t', 2),
+                  'sse': SimdTarget('_mm', '__m128i'),
+                  'avx2': SimdTarget('_mm256', '__m256i')}[args.target]
+        text = emit_c(c, order, target, args.name, header)
+    if args.output:
+        with open(args.output, 'w') as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,65 @@
+#ifndef AES_AESNI_H_
+#define AES_AESNI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Encryption functions (8 blocks), same shape as the barrel-shiftrows ones */
+void aes128_encrypt_aesni(unsigned char ctext[128], const unsigned char ptext[128],
+				const uint32_t rkeys[44]);
+void aes192_encrypt_aesni(unsigned char ctext[128], const unsigned char ptext[128],
+				const uint32_t rkeys[52]);
+void aes256_encrypt_aesni(unsigned char ctext[128], const unsigned char ptext[128],
+				const uint32_t rkeys[60]);
+
+/* ECB encryption of any number of blocks */
+void aes128_ecb_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t rkeys[44]);
+void aes192_ecb_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t rkeys[52]);
+void aes256_ecb_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t rkeys[60]);
+
+/* CTR with a 32-bit big-endian counter (updated) */
+void aes128_ctr32_aesni(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char ctr[16], const uint32_t rkeys[44]);
+void aes192_ctr32_aesni(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char ctr[16], const uint32_t rkeys[52]);
+void aes256_ctr32_aesni(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char ctr[16], const uint32_t rkeys[60]);
+
+/* AES-GCM authenticated encryption with 96-bit nonces and 16-byte tags */
+int aes128_gcm_encrypt_aesni(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[44]);
+int aes128_gcm_decrypt_aesni(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[44]);
+int aes192_gcm_encrypt_aesni(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[52]);
+int aes192_gcm_decrypt_aesni(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[52]);
+int aes256_gcm_encrypt_aesni(unsigned char* ctext, unsigned char tag[16],
+				const unsigned char* ptext, size_t ptext_len,
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[60]);
+int aes256_gcm_decrypt_aesni(unsigned char* ptext, const unsigned char* ctext,
+				size_t ctext_len, const unsigned char tag[16],
+				const unsigned char* ad, size_t ad_len,
+				const unsigned char nonce[12], const uint32_t rkeys[60]);
+
+/* Key schedule functions (standard round keys) */
+void aes128_keyschedule_aesni(uint32_t rkeys[44], const unsigned char key[16]);
+void aes192_keyschedule_aesni(uint32_t rkeys[52], const unsigned char key[24]);
+void aes256_keyschedule_aesni(uint32_t rkeys[60], const unsigned char key[32]);
+
+/* Name of the code path the library is built with (aesni, vaes256, vaes512) */
+extern const char aes_aesni_impl[];
+
+#endif 	// AES_AESNI_H_
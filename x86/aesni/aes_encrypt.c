@@ -0,0 +1,191 @@
+/******************************************************************************
+* AES-128, AES-192 and AES-256 (encryption-only) relying on the x86 AES-NI
+* instructions (build with e.g. -maes -mssse3), and on VAES if available
+* (e.g. -mvaes -mavx2, or -mvaes -mavx512f -mavx512bw).
+*
+* Unlike the bitsliced implementations, the round keys are the ones from the
+* standard key schedule (see 'aes_keyschedule.c') and the blocks are processed
+* independently. The bulk ECB and CTR functions interleave AES_VEC_WAYS
+* vectors (i.e. 8 blocks with AES-NI, 8 or 16 blocks with VAES) so that the
+* latency of AESENC is hidden, the remaining blocks being processed up to 8
+* at a time with AES-NI.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include "aes.h"
+#include "internal-aes.h"
+
+const char aes_aesni_impl[] = AES_IMPL;
+
+/******************************************************************************
+* Broadcasts the round keys to all the blocks of a vector.
+******************************************************************************/
+static void bcast_rkeys(aes_vec* rkv, const __m128i* rk, int nr) {
+	for(int i = 0; i <= nr; i++)
+		rkv[i] = VEC_BCAST(rk[i]);
+}
+
+/******************************************************************************
+* ECB encryption of nblocks blocks.
+******************************************************************************/
+void ecb_aesni(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys, int nr) {
+	__m128i rk[15], b[AES_TAIL_WAYS];
+	aes_vec rkv[15], v[AES_VEC_WAYS];
+	size_t n;
+	load_rkeys(rk, rkeys, nr);
+	bcast_rkeys(rkv, rk, nr);
+	for(; nblocks >= AES_BULK_BLOCKS; nblocks -= AES_BULK_BLOCKS) {
+		for(int j = 0; j < AES_VEC_WAYS; j++)
+			v[j] = VEC_LOAD(ptext + 16*AES_VEC_BLOCKS*j);
+		aes_enc_bulk(v, rkv, nr);
+		for(int j = 0; j < AES_VEC_WAYS; j++)
+			VEC_STORE(ctext + 16*AES_VEC_BLOCKS*j, v[j]);
+		ptext += 16*AES_BULK_BLOCKS;
+		ctext += 16*AES_BULK_BLOCKS;
+	}
+	for(; nblocks; nblocks -= n) {
+		n = nblocks < AES_TAIL_WAYS ? nblocks : AES_TAIL_WAYS;
+		for(size_t j = 0; j < n; j++)
+			b[j] = _mm_loadu_si128((const __m128i*)(ptext + 16*j));
+		aes_enc(b, n, rk, nr);
+		for(size_t j = 0; j < n; j++)
+			_mm_storeu_si128((__m128i*)(ctext + 16*j), b[j]);
+		ptext += 16*n;
+		ctext += 16*n;
+	}
+}
+
+/******************************************************************************
+* CTR encryption of len bytes, where the last 4 bytes of ctr are incremented
+* as a big-endian counter (modulo 2^32) for each block. On return, ctr holds
+* the counter block following the last one used.
+* The counter blocks are kept with their last word byte-swapped, so that they
+* are incremented with 32-bit additions and swapped back before encryption.
+******************************************************************************/
+void ctr32_aesni(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys, int nr) {
+	const __m128i bswap = ctr_bswap_mask(), one = _mm_setr_epi32(0, 0, 0, 1);
+	__m128i rk[15], b[AES_TAIL_WAYS], iv;
+	aes_vec rkv[15], v[AES_VEC_WAYS], c, step, bswapv;
+	unsigned char ks[16];
+	size_t n;
+	load_rkeys(rk, rkeys, nr);
+	bcast_rkeys(rkv, rk, nr);
+	iv = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)ctr), bswap);
+	step = VEC_BCAST(_mm_setr_epi32(0, 0, 0, AES_VEC_BLOCKS));
+	bswapv = VEC_BCAST(bswap);
+	for(; len >= 16*AES_BULK_BLOCKS; len -= 16*AES_BULK_BLOCKS) {
+		c = VEC_ADD32(VEC_BCAST(iv), VEC_CTR_OFFSETS);
+		for(int j = 0; j < AES_VEC_WAYS; j++) {
+			v[j] = VEC_SHUFFLE8(c, bswapv);
+			c = VEC_ADD32(c, step);
+		}
+		aes_enc_bulk(v, rkv, nr);
+		for(int j = 0; j < AES_VEC_WAYS; j++)
+			VEC_STORE(out + 16*AES_VEC_BLOCKS*j,
+				VEC_XOR(v[j], VEC_LOAD(in + 16*AES_VEC_BLOCKS*j)));
+		iv = _mm_add_epi32(iv, _mm_setr_epi32(0, 0, 0, AES_BULK_BLOCKS));
+		in += 16*AES_BULK_BLOCKS;
+		out += 16*AES_BULK_BLOCKS;
+	}
+	while (len) {
+		n = (len + 15) / 16;
+		n = n < AES_TAIL_WAYS ? n : AES_TAIL_WAYS;
+		for(size_t j = 0; j < n; j++) {
+			b[j] = _mm_shuffle_epi8(iv, bswap);
+			iv = _mm_add_epi32(iv, one);
+		}
+		aes_enc(b, n, rk, nr);
+		for(size_t j = 0; j < n; j++) {
+			if (len < 16) { 					// last partial block
+				_mm_storeu_si128((__m128i*)ks, b[j]);
+				for(size_t i = 0; i < len; i++)
+					out[i] = in[i] ^ ks[i];
+				len = 0;
+			} else {
+				_mm_storeu_si128((__m128i*)out, _mm_xor_si128(b[j],
+					_mm_loadu_si128((const __m128i*)in)));
+				in += 16;
+				out += 16;
+				len -= 16;
+			}
+		}
+	}
+	_mm_storeu_si128((__m128i*)ctr, _mm_shuffle_epi8(iv, bswap));
+}
+
+/******************************************************************************
+* AES-128 encryption of the 8 blocks ptext into ctext (which may overlap).
+******************************************************************************/
+void aes128_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				const uint32_t* rkeys) {
+	ecb_aesni(ctext, ptext, 8, rkeys, 10);
+}
+
+/******************************************************************************
+* AES-192 encryption of the 8 blocks ptext into ctext (which may overlap).
+******************************************************************************/
+void aes192_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				const uint32_t* rkeys) {
+	ecb_aesni(ctext, ptext, 8, rkeys, 12);
+}
+
+/******************************************************************************
+* AES-256 encryption of the 8 blocks ptext into ctext (which may overlap).
+******************************************************************************/
+void aes256_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				const uint32_t* rkeys) {
+	ecb_aesni(ctext, ptext, 8, rkeys, 14);
+}
+
+/******************************************************************************
+* AES-128 encryption of nblocks blocks without any operating mode.
+******************************************************************************/
+void aes128_ecb_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys) {
+	ecb_aesni(ctext, ptext, nblocks, rkeys, 10);
+}
+
+/******************************************************************************
+* AES-192 encryption of nblocks blocks without any operating mode.
+******************************************************************************/
+void aes192_ecb_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys) {
+	ecb_aesni(ctext, ptext, nblocks, rkeys, 12);
+}
+
+/******************************************************************************
+* AES-256 encryption of nblocks blocks without any operating mode.
+******************************************************************************/
+void aes256_ecb_encrypt_aesni(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys) {
+	ecb_aesni(ctext, ptext, nblocks, rkeys, 14);
+}
+
+/******************************************************************************
+* AES-128 in CTR mode over len bytes (see 'ctr32_aesni').
+******************************************************************************/
+void aes128_ctr32_aesni(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys) {
+	ctr32_aesni(out, in, len, ctr, rkeys, 10);
+}
+
+/******************************************************************************
+* AES-192 in CTR mode over len bytes (see 'ctr32_aesni').
+******************************************************************************/
+void aes192_ctr32_aesni(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys) {
+	ctr32_aesni(out, in, len, ctr, rkeys, 12);
+}
+
+/******************************************************************************
+* AES-256 in CTR mode over len bytes (see 'ctr32_aesni').
+******************************************************************************/
+void aes256_ctr32_aesni(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys) {
+	ctr32_aesni(out, in, len, ctr, rkeys, 14);
+}
@@ -0,0 +1,66 @@
+/******************************************************************************
+* AES-128, AES-192 and AES-256 key schedules relying on the AESENCLAST
+* instruction of AES-NI for SubWord. The round keys are stored as in the
+* standard (i.e. 4*(Nr+1) words, the bytes being in the FIPS-197 order).
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h> 	// for memcpy
+#include "aes.h"
+#include "internal-aes.h"
+
+#define ROR(x,y) 		(((x) >> (y)) | ((x) << (32 - (y))))
+
+/******************************************************************************
+* Computes SubWord(w). The word is copied in the 4 columns so that ShiftRows
+* has no effect, and the round key of AESENCLAST is zero.
+******************************************************************************/
+static uint32_t subword(uint32_t w) {
+	__m128i x = _mm_set1_epi32((int)w);
+	x = _mm_aesenclast_si128(x, _mm_setzero_si128());
+	return (uint32_t)_mm_cvtsi128_si32(x);
+}
+
+/******************************************************************************
+* Key expansion of FIPS-197, where nk is the number of 32-bit words in the
+* key (4, 6 or 8) and nr the number of rounds.
+******************************************************************************/
+static void keyschedule(uint32_t* rkeys, const unsigned char* key, int nk,
+				int nr) {
+	uint32_t tmp, rconst = 0x01;
+	memcpy(rkeys, key, 4*nk);
+	for(int i = nk; i < 4*(nr+1); i++) {
+		tmp = rkeys[i-1];
+		if (i % nk == 0) { 					// RotWord, SubWord and rconst
+			tmp = subword(ROR(tmp, 8)) ^ rconst;
+			rconst = (rconst << 1) ^ ((rconst >> 7) * 0x11b);
+		} else if (nk == 8 && i % nk == 4) {
+			tmp = subword(tmp);
+		}
+		rkeys[i] = rkeys[i-nk] ^ tmp;
+	}
+}
+
+/******************************************************************************
+* AES-128 key schedule.
+******************************************************************************/
+void aes128_keyschedule_aesni(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 4, 10);
+}
+
+/******************************************************************************
+* AES-192 key schedule.
+******************************************************************************/
+void aes192_keyschedule_aesni(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 6, 12);
+}
+
+/******************************************************************************
+* AES-256 key schedule.
+******************************************************************************/
+void aes256_keyschedule_aesni(uint32_t* rkeys, const unsigned char* key) {
+	keyschedule(rkeys, key, 8, 14);
+}
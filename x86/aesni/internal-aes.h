@@ -0,0 +1,131 @@
+#ifndef INTERNAL_AES_H_
+#define INTERNAL_AES_H_
+
+#if !defined(__AES__) || !defined(__SSSE3__)
+#error "AES-NI is required (e.g. -maes -mssse3, or -march=native)"
+#endif
+
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define BE_LOAD_32(x) 										\
+    ((((uint32_t)((x)[0])) << 24) | 						\
+     (((uint32_t)((x)[1])) << 16) | 						\
+     (((uint32_t)((x)[2])) << 8) | 							\
+      ((uint32_t)((x)[3])))
+
+#define BE_STORE_32(x, y)									\
+	(x)[0] = ((y) >> 24) & 0xff; 							\
+	(x)[1] = ((y) >> 16) & 0xff; 							\
+	(x)[2] = ((y) >> 8) & 0xff; 							\
+	(x)[3] = (y) & 0xff;
+
+/******************************************************************************
+* Vectors processed by the bulk functions, selected at build time:
+* - VAES with AVX-512 (-mvaes -mavx512f -mavx512bw): 4 blocks per vector
+* - VAES with AVX2 (-mvaes -mavx2): 2 blocks per vector
+* - AES-NI only: 1 block per vector
+* AES_VEC_WAYS vectors are interleaved to hide the latency of AESENC, i.e.
+* AES_BULK_BLOCKS = 16, 8 and 8 blocks respectively.
+******************************************************************************/
+#if defined(__VAES__) && defined(__AVX512F__) && defined(__AVX512BW__)
+#define AES_IMPL 			"vaes512"
+#define AES_VEC_BLOCKS 		4
+#define AES_VEC_WAYS 		4
+typedef __m512i aes_vec;
+#define VEC_LOAD(p) 		_mm512_loadu_si512((const void*)(p))
+#define VEC_STORE(p, x) 	_mm512_storeu_si512((void*)(p), x)
+#define VEC_XOR(x, y) 		_mm512_xor_si512(x, y)
+#define VEC_ADD32(x, y) 	_mm512_add_epi32(x, y)
+#define VEC_SHUFFLE8(x, y) 	_mm512_shuffle_epi8(x, y)
+#define VEC_BCAST(x) 		_mm512_broadcast_i32x4(x)
+#define VEC_AESENC(x, k) 	_mm512_aesenc_epi128(x, k)
+#define VEC_AESENCLAST(x, k) _mm512_aesenclast_epi128(x, k)
+#define VEC_CTR_OFFSETS 	_mm512_set_epi32(3,0,0,0, 2,0,0,0, 1,0,0,0, 0,0,0,0)
+#elif defined(__VAES__) && defined(__AVX2__)
+#define AES_IMPL 			"vaes256"
+#define AES_VEC_BLOCKS 		2
+#define AES_VEC_WAYS 		4
+typedef __m256i aes_vec;
+#define VEC_LOAD(p) 		_mm256_loadu_si256((const __m256i*)(p))
+#define VEC_STORE(p, x) 	_mm256_storeu_si256((__m256i*)(p), x)
+#define VEC_XOR(x, y) 		_mm256_xor_si256(x, y)
+#define VEC_ADD32(x, y) 	_mm256_add_epi32(x, y)
+#define VEC_SHUFFLE8(x, y) 	_mm256_shuffle_epi8(x, y)
+#define VEC_BCAST(x) 		_mm256_broadcastsi128_si256(x)
+#define VEC_AESENC(x, k) 	_mm256_aesenc_epi128(x, k)
+#define VEC_AESENCLAST(x, k) _mm256_aesenclast_epi128(x, k)
+#define VEC_CTR_OFFSETS 	_mm256_set_epi32(1,0,0,0, 0,0,0,0)
+#else
+#define AES_IMPL 			"aesni"
+#define AES_VEC_BLOCKS 		1
+#define AES_VEC_WAYS 		8
+typedef __m128i aes_vec;
+#define VEC_LOAD(p) 		_mm_loadu_si128((const __m128i*)(p))
+#define VEC_STORE(p, x) 	_mm_storeu_si128((__m128i*)(p), x)
+#define VEC_XOR(x, y) 		_mm_xor_si128(x, y)
+#define VEC_ADD32(x, y) 	_mm_add_epi32(x, y)
+#define VEC_SHUFFLE8(x, y) 	_mm_shuffle_epi8(x, y)
+#define VEC_BCAST(x) 		(x)
+#define VEC_AESENC(x, k) 	_mm_aesenc_si128(x, k)
+#define VEC_AESENCLAST(x, k) _mm_aesenclast_si128(x, k)
+#define VEC_CTR_OFFSETS 	_mm_setzero_si128()
+#endif
+
+#define AES_BULK_BLOCKS 	(AES_VEC_WAYS * AES_VEC_BLOCKS)
+
+/* Maximum number of single blocks interleaved for the remaining blocks */
+#define AES_TAIL_WAYS 		8
+
+/******************************************************************************
+* Byte-swaps the last 32-bit word of each block, so that the big-endian
+* counter of a counter block can be incremented with a 32-bit addition (and
+* the other way around).
+******************************************************************************/
+static inline __m128i ctr_bswap_mask(void) {
+	return _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 15, 14, 13, 12);
+}
+
+/******************************************************************************
+* Loads the nr+1 round keys into registers.
+******************************************************************************/
+static inline void load_rkeys(__m128i* rk, const uint32_t* rkeys, int nr) {
+	for(int i = 0; i <= nr; i++)
+		rk[i] = _mm_loadu_si128((const __m128i*)(rkeys + 4*i));
+}
+
+/******************************************************************************
+* Encrypts the n single blocks b[0], ..., b[n-1] with nr rounds.
+******************************************************************************/
+static inline void aes_enc(__m128i* b, int n, const __m128i* rk, int nr) {
+	for(int j = 0; j < n; j++)
+		b[j] = _mm_xor_si128(b[j], rk[0]);
+	for(int i = 1; i < nr; i++)
+		for(int j = 0; j < n; j++)
+			b[j] = _mm_aesenc_si128(b[j], rk[i]);
+	for(int j = 0; j < n; j++)
+		b[j] = _mm_aesenclast_si128(b[j], rk[nr]);
+}
+
+/******************************************************************************
+* Encrypts the AES_VEC_WAYS vectors b[0], ..., b[AES_VEC_WAYS-1], where the
+* round keys rk have been broadcast to all the blocks of a vector.
+******************************************************************************/
+static inline void aes_enc_bulk(aes_vec* b, const aes_vec* rk, int nr) {
+	for(int j = 0; j < AES_VEC_WAYS; j++)
+		b[j] = VEC_XOR(b[j], rk[0]);
+	for(int i = 1; i < nr; i++)
+		for(int j = 0; j < AES_VEC_WAYS; j++)
+			b[j] = VEC_AESENC(b[j], rk[i]);
+	for(int j = 0; j < AES_VEC_WAYS; j++)
+		b[j] = VEC_AESENCLAST(b[j], rk[nr]);
+}
+
+void ecb_aesni(unsigned char* ctext, const unsigned char* ptext,
+				size_t nblocks, const uint32_t* rkeys, int nr);
+
+void ctr32_aesni(unsigned char* out, const unsigned char* in, size_t len,
+				unsigned char* ctr, const uint32_t* rkeys, int nr);
+
+#endif 	// INTERNAL_AES_H_
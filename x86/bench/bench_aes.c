@@ -0,0 +1,137 @@
+/******************************************************************************
+* Throughput of the AES-NI/VAES backend (ECB, CTR and GCM over 4096 bytes)
+* compared with the 8-block barrel-shiftrows C implementation of 'opt32',
+* together with a known-answer test from FIPS-197.
+*
+* Build (from the 'x86' directory):
+*	gcc -O3 -march=native -o bench_aes bench/bench_aes.c aesni/aes_encrypt.c \
+*		aesni/aes_keyschedule.c aesni/aes_gcm.c \
+*		../opt32/gf128/gf128.c ../opt32/gf128/gf128_clmul.c \
+*		../opt32/barrel_shiftrows/aes_encrypt.c \
+*		../opt32/barrel_shiftrows/aes_keyschedule_lut.c \
+*		../opt32/profile/profile.c
+* The AES-NI, VAES/AVX2 and VAES/AVX-512 code paths can be compared by
+* building with e.g. -maes -mssse3 -mpclmul instead of -march=native.
+*
+* @author 	Alexandre Adomnicai, Nanyang Technological University, Singapore
+*			alexandre.adomnicai@ntu.edu.sg
+*
+* @date		October 2026
+******************************************************************************/
+#include <string.h>
+#include "../aesni/aes.h"
+#include "../../opt32/barrel_shiftrows/aes.h"
+#include "../../opt32/gf128/gf128.h"
+#include "../../opt32/bench/bench.h"
+
+/* FIPS-197, appendix C.1, C.2 and C.3 */
+static const unsigned char key[32] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+	0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+	0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+};
+static const unsigned char ptext[16] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+	0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+};
+static const unsigned char ctext128[16] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+	0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+};
+static const unsigned char ctext192[16] = {
+	0xdd, 0xa9, 0x7c, 0xa4, 0x86, 0x4c, 0xdf, 0xe0,
+	0x6e, 0xaf, 0x70, 0xa0, 0xec, 0x0d, 0x71, 0x91
+};
+static const unsigned char ctext256[16] = {
+	0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf,
+	0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89
+};
+
+static int failures;
+
+static void check(const char* name, const unsigned char* out,
+				const unsigned char* expected, int nblocks) {
+	for(int i = 0; i < nblocks; i++) {
+		if (memcmp(out + 16*i, expected, 16)) {
+			printf("  %s: KAT FAILED\n", name);
+			failures++;
+			return;
+		}
+	}
+}
+
+/******************************************************************************
+* Prints the elapsed time, and the cost per byte if 'nblocks' were processed.
+******************************************************************************/
+static void report(const char* name, uint64_t t, int nblocks) {
+	printf("  %-28s %8llu %s", name, (unsigned long long)t, BENCH_UNIT);
+	if (nblocks)
+		printf(" (%.2f %s per byte)", (double)t / (16*nblocks), BENCH_UNIT);
+	printf("\n");
+}
+
+static void bench_aesni(void) {
+	static unsigned char in[4096], out[4096];
+	unsigned char ctr[16] = {0}, tag[16], nonce[12] = {0};
+	const int nblocks = sizeof(in)/16;
+	uint32_t rkeys[60];
+	uint64_t t;
+	printf("%s, gf128 %s (%d bytes)\n", aes_aesni_impl, gf128_impl,
+		(int)sizeof(in));
+	for(int i = 0; i < nblocks; i++)
+		memcpy(in + 16*i, ptext, 16);
+	BENCH(t, aes128_keyschedule_aesni(rkeys, key));
+	report("aes128_keyschedule_aesni", t, 0);
+	BENCH(t, aes128_ecb_encrypt_aesni(out, in, nblocks, rkeys));
+	report("aes128_ecb_encrypt_aesni", t, nblocks);
+	check("aes128_ecb_encrypt_aesni", out, ctext128, nblocks);
+	BENCH(t, aes128_ctr32_aesni(out, in, sizeof(in), ctr, rkeys));
+	report("aes128_ctr32_aesni", t, nblocks);
+	BENCH(t, aes128_gcm_encrypt_aesni(out, tag, in, sizeof(in), NULL, 0,
+				nonce, rkeys));
+	report("aes128_gcm_encrypt_aesni", t, nblocks);
+	BENCH(t, aes192_keyschedule_aesni(rkeys, key));
+	report("aes192_keyschedule_aesni", t, 0);
+	BENCH(t, aes192_ecb_encrypt_aesni(out, in, nblocks, rkeys));
+	report("aes192_ecb_encrypt_aesni", t, nblocks);
+	check("aes192_ecb_encrypt_aesni", out, ctext192, nblocks);
+	BENCH(t, aes192_ctr32_aesni(out, in, sizeof(in), ctr, rkeys));
+	report("aes192_ctr32_aesni", t, nblocks);
+	BENCH(t, aes192_gcm_encrypt_aesni(out, tag, in, sizeof(in), NULL, 0,
+				nonce, rkeys));
+	report("aes192_gcm_encrypt_aesni", t, nblocks);
+	BENCH(t, aes256_keyschedule_aesni(rkeys, key));
+	report("aes256_keyschedule_aesni", t, 0);
+	BENCH(t, aes256_ecb_encrypt_aesni(out, in, nblocks, rkeys));
+	report("aes256_ecb_encrypt_aesni", t, nblocks);
+	check("aes256_ecb_encrypt_aesni", out, ctext256, nblocks);
+	BENCH(t, aes256_ctr32_aesni(out, in, sizeof(in), ctr, rkeys));
+	report("aes256_ctr32_aesni", t, nblocks);
+	BENCH(t, aes256_gcm_encrypt_aesni(out, tag, in, sizeof(in), NULL, 0,
+				nonce, rkeys));
+	report("aes256_gcm_encrypt_aesni", t, nblocks);
+}
+
+static void bench_opt32(void) {
+	unsigned char in[128], out[128];
+	uint32_t rkeys[480];
+	uint64_t t;
+	printf("opt32 barrel-shiftrows (8 blocks)\n");
+	for(int i = 0; i < 8; i++)
+		memcpy(in + 16*i, ptext, 16);
+	aes128_keyschedule_lut(rkeys, key);
+	BENCH(t, aes128_encrypt(out, in, rkeys));
+	report("aes128_encrypt", t, 8);
+	check("aes128_encrypt", out, ctext128, 8);
+	aes256_keyschedule_lut(rkeys, key);
+	BENCH(t, aes256_encrypt(out, in, rkeys));
+	report("aes256_encrypt", t, 8);
+	check("aes256_encrypt", out, ctext256, 8);
+}
+
+int main(void) {
+	bench_aesni();
+	bench_opt32();
+	return failures != 0;
+}